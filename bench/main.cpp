@@ -0,0 +1,483 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+// Kernel micro-benchmarks.
+// This executable replaces the usual idefix main. It builds synthetic 3D states and times
+// the hot components of the code in isolation (reconstruction, Riemann solvers, corner EMFs,
+// MPI exchanges, Fargo, RKL and the Laplacian stencil). Each component is run on a freshly
+// allocated DataBlock, so that modules which are only enabled from the input file
+// (Fargo, RKL, EMF averaging scheme...) can be switched on for a single benchmark.
+// Results are shown on screen and written to a JSON file, see [Bench] in idefix.ini.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "idefix.hpp"
+#include "profiler.hpp"
+#include "input.hpp"
+#include "grid.hpp"
+#include "gridHost.hpp"
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+#include "laplacian.hpp"
+#include "version.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+using Phys = DefaultPhysics;
+
+struct BenchResult {
+  std::string kernel;   // component being benchmarked
+  std::string variant;  // solver, limiter, averaging scheme...
+  int dir;              // direction of the kernel (-1 if not relevant)
+  int size;             // number of cells in each direction
+  int64_t cells;        // total number of active cells (all ranks)
+  double tMin;          // fastest call (s)
+  double tMean;         // average call (s)
+  double tMax;          // slowest call (s)
+};
+
+class BenchRecorder {
+ public:
+  BenchRecorder(int warmup, int repeat) : warmup(warmup), repeat(repeat) {}
+
+  // Time the function f on the datablock data
+  template<typename Function>
+  void Measure(const std::string &kernel, const std::string &variant, int dir,
+               DataBlock &data, Function f);
+
+  void Show();
+  void WriteJson(const std::string &);
+
+  int size{0};              // current problem size
+  std::vector<BenchResult> results;
+
+ private:
+  int warmup;
+  int repeat;
+};
+
+template<typename Function>
+void BenchRecorder::Measure(const std::string &kernel, const std::string &variant, int dir,
+                            DataBlock &data, Function f) {
+  idfx::pushRegion("Bench::"+kernel);
+  for(int n = 0 ; n < warmup ; n++) {
+    f();
+  }
+  Kokkos::fence();
+
+  BenchResult result;
+  result.kernel = kernel;
+  result.variant = variant;
+  result.dir = dir;
+  result.size = size;
+  result.cells = static_cast<int64_t>(data.np_int[IDIR])
+                 *static_cast<int64_t>(data.np_int[JDIR])
+                 *static_cast<int64_t>(data.np_int[KDIR]);
+  result.tMin = 1e30;
+  result.tMean = 0;
+  result.tMax = 0;
+
+  for(int n = 0 ; n < repeat ; n++) {
+    Kokkos::Timer timer;
+    f();
+    Kokkos::fence();
+    double t = timer.seconds();
+    #ifdef WITH_MPI
+      // The slowest rank sets the pace
+      MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    #endif
+    result.tMin = std::fmin(result.tMin, t);
+    result.tMax = std::fmax(result.tMax, t);
+    result.tMean += t/repeat;
+  }
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &result.cells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+  results.push_back(result);
+
+  idfx::cout << "Bench: " << std::setw(24) << std::left << kernel
+             << std::setw(24) << variant
+             << std::setw(4) << (dir >= 0 ? "X"+std::to_string(dir+1) : "-")
+             << std::right << std::setw(6) << size
+             << std::scientific << std::setprecision(3)
+             << std::setw(14) << result.tMean
+             << std::setw(14) << result.cells/result.tMin
+             << std::defaultfloat << std::endl;
+  idfx::popRegion();
+}
+
+void BenchRecorder::Show() {
+  idfx::cout << "Bench: completed " << results.size() << " benchmarks." << std::endl;
+}
+
+// Loop pattern name, following the cmake Idefix_LOOP_PATTERN option
+static std::string LoopPatternName() {
+  switch(defaultLoop) {
+    case LoopPattern::SIMDFOR:
+      return("SIMD");
+    case LoopPattern::RANGE:
+      return("Range");
+    case LoopPattern::MDRANGE:
+      return("MDRange");
+    case LoopPattern::TPX:
+      return("TeamPolicy");
+    case LoopPattern::TPTTRTVR:
+      return("TeamPolicyInnerVector");
+    default:
+      return("Undefined");
+  }
+}
+
+void BenchRecorder::WriteJson(const std::string &filename) {
+  if(idfx::prank != 0) return;
+  std::ofstream file(filename);
+  if(!file) {
+    IDEFIX_ERROR("Bench: cannot open "+filename);
+  }
+  file << std::setprecision(9);
+  file << "{" << std::endl;
+  file << "  \"version\": \"" << IDEFIX_VERSION << "\"," << std::endl;
+  file << "  \"commit\": \"" << IDEFIX_GIT_COMMIT << "\"," << std::endl;
+  file << "  \"executionSpace\": \"" << Kokkos::DefaultExecutionSpace::name() << "\","
+       << std::endl;
+  file << "  \"loopPattern\": \"" << LoopPatternName() << "\"," << std::endl;
+  file << "  \"mhd\": " << (Phys::mhd ? "true" : "false") << "," << std::endl;
+  file << "  \"order\": " << ORDER << "," << std::endl;
+  file << "  \"realBytes\": " << sizeof(real) << "," << std::endl;
+  file << "  \"nproc\": " << idfx::psize << "," << std::endl;
+  file << "  \"results\": [" << std::endl;
+  for(size_t n = 0 ; n < results.size() ; n++) {
+    const BenchResult &r = results[n];
+    file << "    {\"kernel\": \"" << r.kernel << "\", "
+         << "\"variant\": \"" << r.variant << "\", "
+         << "\"dir\": " << r.dir << ", "
+         << "\"size\": " << r.size << ", "
+         << "\"cells\": " << r.cells << ", "
+         << "\"tMin\": " << r.tMin << ", "
+         << "\"tMean\": " << r.tMean << ", "
+         << "\"tMax\": " << r.tMax << ", "
+         << "\"cellsPerSecond\": " << r.cells/r.tMin << "}";
+    if(n+1 < results.size()) file << ",";
+    file << std::endl;
+  }
+  file << "  ]" << std::endl;
+  file << "}" << std::endl;
+  file.close();
+  idfx::cout << "Bench: results written to " << filename << std::endl;
+}
+
+// Fill the datablock with a smooth, non-trivial state
+void InitFlow(DataBlock &data) {
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray1D<real> x1 = data.x[IDIR];
+  IdefixArray1D<real> x2 = data.x[JDIR];
+  IdefixArray1D<real> x3 = data.x[KDIR];
+  const real k0 = 2.0*M_PI;
+
+  idefix_for("Bench_InitFlow",
+             0, data.np_tot[KDIR], 0, data.np_tot[JDIR], 0, data.np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      Vc(RHO,k,j,i) = 1.0 + 0.2*sin(k0*x1(i))*cos(k0*x2(j))*cos(k0*x3(k));
+      #if HAVE_ENERGY
+        Vc(PRS,k,j,i) = 1.0 + 0.1*cos(k0*x1(i))*sin(k0*x2(j));
+      #endif
+      EXPAND( Vc(VX1,k,j,i) = 0.3*sin(k0*x2(j));  ,
+              Vc(VX2,k,j,i) = 0.3*sin(k0*x3(k));  ,
+              Vc(VX3,k,j,i) = 0.3*sin(k0*x1(i));  )
+    });
+
+  #if MHD == YES
+    // Each face-centered component only depends on the transverse coordinates: div(B)=0
+    IdefixArray4D<real> Vs = data.hydro->Vs;
+    idefix_for("Bench_InitField",
+               0, data.np_tot[KDIR], 0, data.np_tot[JDIR], 0, data.np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        D_EXPAND( Vs(BX1s,k,j,i) = 0.2 + 0.1*sin(k0*x2(j));  ,
+                  Vs(BX2s,k,j,i) = 0.1*sin(k0*x3(k));        ,
+                  Vs(BX3s,k,j,i) = 0.1*sin(k0*x1(i));        )
+      });
+  #endif
+
+  data.hydro->boundary->SetBoundaries(data.t);
+  data.hydro->ConvertPrimToCons();
+  // A CFL-like timestep for the modules which need one (Fargo, RKL)
+  Grid *grid = data.mygrid;
+  data.dt = 0.2*(grid->xend[IDIR]-grid->xbeg[IDIR])/grid->np_int[IDIR];
+}
+
+// Allocate a cubic grid of the requested size and a datablock on which func is called.
+// configure can be used to enable modules in the input parameters of this case
+void RunCase(Input &baseInput, int size,
+             std::function<void(Input &)> configure,
+             std::function<void(DataBlock &)> func) {
+  Input input = baseInput;
+  configure(input);
+  // default choices when the case does not require anything specific
+  input.GetOrSet<std::string>("Hydro","solver",0,"hll");
+
+  for(std::string label : {"X1-grid", "X2-grid", "X3-grid"}) {
+    input.GetOrSet<int>("Grid",label,0,1);
+    input.GetOrSet<real>("Grid",label,1,-0.5);
+    input.GetOrSet<int>("Grid",label,2,size);
+    input.GetOrSet<std::string>("Grid",label,3,"u");
+    input.GetOrSet<real>("Grid",label,4,0.5);
+  }
+
+  Grid grid(input);
+  GridHost gridHost(grid);
+  gridHost.MakeGrid(input);
+  gridHost.SyncToDevice();
+
+  DataBlock data(grid, input);
+  data.t = 0.0;
+  InitFlow(data);
+  func(data);
+}
+
+// The benchmarks use a regular cartesian grid without shock flattening, see
+// RiemannSolver::CalcFlux for the variants of the reconstruction
+template<int dir, PLMLimiter limiter>
+void BenchExtrapolate(DataBlock &data, BenchRecorder &bench, const std::string &name) {
+  constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+  constexpr int joffset = (dir==JDIR) ? 1 : 0;
+  constexpr int koffset = (dir==KDIR) ? 1 : 0;
+
+  ExtrapolateToFaces<Phys, dir, limiter> extrapol(data.hydro->rSolver.get());
+  IdefixArray4D<real> flux = data.hydro->FluxRiemann;
+
+  bench.Measure("ExtrapolateToFaces", "order"+std::to_string(ORDER)+"-"+name, dir, data,
+    [&]() {
+      // the high order schemes reconstruct the face states of each cell beforehand
+      if constexpr(ExtrapolateToFaces<Phys, dir, limiter>::precompute) {
+        extrapol.template ComputeFaceStates<false>(0);
+      }
+      idefix_for("Bench_ExtrapolateToFaces",
+                 data.beg[KDIR],data.end[KDIR]+koffset,
+                 data.beg[JDIR],data.end[JDIR]+joffset,
+                 data.beg[IDIR],data.end[IDIR]+ioffset,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          real vL[Phys::nvar];
+          real vR[Phys::nvar];
+          extrapol.template ExtrapolatePrimVar<false, true>(i, j, k, vL, vR);
+          // store the jump so that the compiler cannot skip the reconstruction
+          for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+            flux(nv,k,j,i) = vR[nv] - vL[nv];
+          }
+        });
+    });
+}
+
+template<int dir>
+void BenchReconstruction(DataBlock &data, BenchRecorder &bench) {
+  BenchExtrapolate<dir, PLMLimiter::VanLeer>(data, bench, "vanleer");
+  BenchExtrapolate<dir, PLMLimiter::MinMod>(data, bench, "minmod");
+  BenchExtrapolate<dir, PLMLimiter::McLim>(data, bench, "mc");
+}
+
+// The Riemann solvers are timed through CalcFlux, as in a run: at ORDER>=3 this includes the
+// reconstruction of the face states (with their transverse ghost cells in MHD) which the
+// solver kernels read, at ORDER 2 the reconstruction is done inside the solver kernels.
+template<int dir>
+void BenchRiemann(DataBlock &data, BenchRecorder &bench, const std::string &solver) {
+  RiemannSolver<Phys> *rSolver = data.hydro->rSolver.get();
+  IdefixArray4D<real> flux = data.hydro->FluxRiemann;
+  bench.Measure("RiemannSolver::CalcFlux", solver, dir, data,
+                [&]() { rSolver->template CalcFlux<dir>(flux); });
+}
+
+void BenchLaplacian(DataBlock &data, BenchRecorder &bench) {
+  std::array<Laplacian::LaplacianBoundaryType,3> bounds = {Laplacian::periodic,
+                                                          Laplacian::periodic,
+                                                          Laplacian::periodic};
+  Laplacian laplacian(&data, bounds, bounds, false);
+
+  IdefixArray3D<real> in("Bench_LaplacianIn",
+                         data.np_tot[KDIR], data.np_tot[JDIR], data.np_tot[IDIR]);
+  IdefixArray3D<real> out("Bench_LaplacianOut",
+                          data.np_tot[KDIR], data.np_tot[JDIR], data.np_tot[IDIR]);
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  idefix_for("Bench_LaplacianInit",
+             0, data.np_tot[KDIR], 0, data.np_tot[JDIR], 0, data.np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      in(k,j,i) = Vc(RHO,k,j,i);
+    });
+  bench.Measure("Laplacian", "periodic", -1, data, [&]() { laplacian(in, out); });
+}
+
+#ifdef WITH_MPI
+void BenchMpi(DataBlock &data, BenchRecorder &bench) {
+  Mpi &mpi = data.hydro->boundary->mpi;
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray4D<real> Vs = data.hydro->Vs;
+  #if MHD == YES
+    bench.Measure("Mpi::ExchangeX1", "", IDIR, data, [&]() { mpi.ExchangeX1(Vc, Vs); });
+  #else
+    bench.Measure("Mpi::ExchangeX1", "", IDIR, data, [&]() { mpi.ExchangeX1(Vc); });
+  #endif
+  #if DIMENSIONS >= 2
+    #if MHD == YES
+      bench.Measure("Mpi::ExchangeX2", "", JDIR, data, [&]() { mpi.ExchangeX2(Vc, Vs); });
+    #else
+      bench.Measure("Mpi::ExchangeX2", "", JDIR, data, [&]() { mpi.ExchangeX2(Vc); });
+    #endif
+  #endif
+  #if DIMENSIONS == 3
+    #if MHD == YES
+      bench.Measure("Mpi::ExchangeX3", "", KDIR, data, [&]() { mpi.ExchangeX3(Vc, Vs); });
+    #else
+      bench.Measure("Mpi::ExchangeX3", "", KDIR, data, [&]() { mpi.ExchangeX3(Vc); });
+    #endif
+  #endif
+}
+#endif
+
+void RunBenchmarks(Input &input, int size, BenchRecorder &bench) {
+  bench.size = size;
+  auto noConfig = [](Input &) {};
+
+  // Reconstruction, MPI exchanges and Laplacian on the default setup
+  RunCase(input, size, noConfig, [&](DataBlock &data) {
+    D_EXPAND( BenchReconstruction<IDIR>(data, bench);  ,
+              BenchReconstruction<JDIR>(data, bench);  ,
+              BenchReconstruction<KDIR>(data, bench);  )
+
+    #ifdef WITH_MPI
+      BenchMpi(data, bench);
+    #endif
+    BenchLaplacian(data, bench);
+  });
+
+  // Riemann solvers: the solver is chosen when the fluid is built, hence one case each
+  #if MHD == YES
+    const std::vector<std::string> solvers = {"tvdlf", "hll", "hlld", "roe"};
+  #else
+    const std::vector<std::string> solvers = {"tvdlf", "hll", "hllc", "roe"};
+  #endif
+  for(const std::string &solver : solvers) {
+    auto config = [&](Input &in) { in.GetOrSet<std::string>("Hydro","solver",0,solver); };
+    RunCase(input, size, config, [&](DataBlock &data) {
+      D_EXPAND( BenchRiemann<IDIR>(data, bench, solver);  ,
+                BenchRiemann<JDIR>(data, bench, solver);  ,
+                BenchRiemann<KDIR>(data, bench, solver);  )
+    });
+  }
+
+  #if MHD == YES
+    // Corner EMFs: the averaging scheme sets which arrays are allocated, hence one case each
+    for(std::string averaging : {"arithmetic", "uct0", "uct_contact", "uct_hll", "uct_hlld"}) {
+      auto config = [&](Input &in) {
+        in.GetOrSet<std::string>("Hydro","emf",0,averaging);
+        in.GetOrSet<std::string>("Hydro","solver",0,"hlld");
+      };
+      RunCase(input, size, config, [&](DataBlock &data) {
+        // Fill the face-centered EMFs required by the averaging schemes
+        IdefixArray4D<real> flux = data.hydro->FluxRiemann;
+        D_EXPAND( data.hydro->rSolver->template CalcFlux<IDIR>(flux);  ,
+                  data.hydro->rSolver->template CalcFlux<JDIR>(flux);  ,
+                  data.hydro->rSolver->template CalcFlux<KDIR>(flux);  )
+        bench.Measure("CalcCornerEMF", averaging, -1, data,
+                      [&]() { data.hydro->emf->CalcCornerEMF(data.t); });
+      });
+    }
+  #endif
+
+  #if DIMENSIONS >= 2
+    // Fargo advection in a shearing box
+    auto fargoConfig = [](Input &in) {
+      in.GetOrSet<real>("Hydro","rotation",0,1.0);
+      in.GetOrSet<real>("Hydro","shearingBox",0,-1.5);
+      in.GetOrSet<std::string>("Fargo","velocity",0,"shearingbox");
+    };
+    RunCase(input, size, fargoConfig, [&](DataBlock &data) {
+      bench.Measure("Fargo::ShiftSolution", "shearingbox", -1, data,
+                    [&]() { data.fargo->ShiftSolution(data.t, data.dt); });
+    });
+  #endif
+
+  // Super time-stepping of a constant viscosity
+  auto rklConfig = [](Input &in) {
+    in.GetOrSet<std::string>("Hydro","viscosity",0,"rkl");
+    in.GetOrSet<std::string>("Hydro","viscosity",1,"constant");
+    in.GetOrSet<real>("Hydro","viscosity",2,1e-3);
+  };
+  RunCase(input, size, rklConfig, [&](DataBlock &data) {
+    bench.Measure("RKLegendre::Cycle", "viscosity", -1, data,
+                  [&]() { data.hydro->rkl->Cycle(); });
+  });
+}
+
+int main( int argc, char* argv[] ) {
+  bool initKokkosBeforeMPI = false;
+
+  // When running on GPUS with Omnipath network,
+  // Kokkos needs to be initialised *before* the MPI layer
+#ifdef KOKKOS_ENABLE_CUDA
+  if(std::getenv("PSM2_CUDA") != NULL) {
+    initKokkosBeforeMPI = true;
+  }
+#endif
+
+  if(initKokkosBeforeMPI)  Kokkos::initialize( argc, argv );
+
+#ifdef WITH_MPI
+  MPI_Init(&argc,&argv);
+#endif
+
+  if(!initKokkosBeforeMPI) Kokkos::initialize( argc, argv );
+
+  {
+    idfx::initialize();
+
+    Input input(argc, argv);
+    input.PrintLogo();
+    input.ShowConfig();
+    idfx::cout << "Bench: loop pattern " << LoopPatternName() << ", order " << ORDER
+               << (Phys::mhd ? ", MHD" : ", HD") << std::endl;
+
+    const int warmup = input.GetOrSet<int>("Bench","warmup",0,2);
+    const int repeat = input.GetOrSet<int>("Bench","repeat",0,10);
+    const std::string filename = input.GetOrSet<std::string>("Bench","output",0,"bench.json");
+    if(input.CheckEntry("Bench","size") < 0) {
+      input.GetOrSet<int>("Bench","size",0,64);
+    }
+
+    BenchRecorder bench(warmup, repeat);
+
+    idfx::cout << "Bench: " << std::setw(24) << std::left << "kernel"
+               << std::setw(24) << "variant"
+               << std::setw(4) << "dir"
+               << std::right << std::setw(6) << "size"
+               << std::setw(14) << "time (s)"
+               << std::setw(14) << "cells/s" << std::endl;
+
+    for(int n = 0 ; n < input.CheckEntry("Bench","size") ; n++) {
+      RunBenchmarks(input, input.Get<int>("Bench","size",n), bench);
+    }
+
+    bench.Show();
+    bench.WriteJson(filename);
+    idfx::prof.Show();
+  }
+
+  Kokkos::finalize();
+
+#ifdef WITH_MPI
+  MPI_Finalize();
+#endif
+
+  return(0);
+}
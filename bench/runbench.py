@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+
+"""
+Build and run the kernel micro-benchmarks for one or several loop patterns,
+gather the results in a single JSON file and optionally compare them to a
+previous run.
+
+Usage (from the bench directory):
+  ./runbench.py -patterns Default MDRange -output results.json [-compare ref.json]
+All the options of the test suite (-cmake, -mpi, -dec, -reconstruction...) are accepted.
+"""
+import argparse
+import json
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-patterns",
+                    default=["Default"],
+                    help="loop patterns to benchmark (see Idefix_LOOP_PATTERN)",
+                    nargs='+')
+parser.add_argument("-input",
+                    default="idefix.ini",
+                    help="input file of the benchmarks")
+parser.add_argument("-output",
+                    default="bench-all.json",
+                    help="file gathering the results of all the runs")
+parser.add_argument("-compare",
+                    default="",
+                    help="reference file produced by a previous call to this script")
+parser.add_argument("-tolerance",
+                    type=float,
+                    default=0.1,
+                    help="relative slowdown above which a benchmark is reported as a regression")
+
+args, unknown = parser.parse_known_args()
+
+# Name of the JSON file written by the benchmarks, set by [Bench]:output in the input file
+def benchOutput(inputFile):
+  block = ""
+  with open(inputFile, "r") as f:
+    for line in f:
+      line = line.split("#")[0].split()
+      if not line:
+        continue
+      if line[0].startswith("["):
+        block = " ".join(line).strip("[]")
+      elif block == "Bench" and line[0] == "output" and len(line) > 1:
+        return line[1]
+  return "bench.json"
+
+benchFile = benchOutput(args.input)
+
+test = tst.idfxTest()
+baseCmake = list(test.cmake)
+
+runs = []
+for pattern in args.patterns:
+  test.cmake = baseCmake + ["Idefix_LOOP_PATTERN="+pattern]
+  test.configure()
+  test.compile()
+  # do not pick up the results of a previous run if this one fails to write them
+  if os.path.exists(benchFile):
+    os.remove(benchFile)
+  test.run(inputFile=args.input)
+  with open(benchFile, "r") as f:
+    run = json.load(f)
+  # keep track of what was asked, the default pattern depends on the target
+  run["requestedLoopPattern"] = pattern
+  runs.append(run)
+
+with open(args.output, "w") as f:
+  json.dump({"runs": runs}, f, indent=2)
+print("Results written to "+args.output)
+
+if args.compare:
+  def key(run, r):
+    return (run["loopPattern"], r["kernel"], r["variant"], r["dir"], r["size"])
+
+  with open(args.compare, "r") as f:
+    reference = {}
+    for run in json.load(f)["runs"]:
+      for r in run["results"]:
+        reference[key(run, r)] = r["cellsPerSecond"]
+
+  regressions = 0
+  for run in runs:
+    for r in run["results"]:
+      k = key(run, r)
+      if k not in reference:
+        continue
+      ratio = r["cellsPerSecond"]/reference[k]
+      if ratio < 1.0-args.tolerance:
+        regressions += 1
+        print(tst.bcolors.FAIL+"Regression: "+str(k)+" runs at {:.2f}x the reference speed"
+              .format(ratio)+tst.bcolors.ENDC)
+  if regressions > 0:
+    sys.exit(1)
+  print(tst.bcolors.OKGREEN+"No performance regression found."+tst.bcolors.ENDC)
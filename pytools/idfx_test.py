@@ -73,7 +73,7 @@ class idfxTest:
     parser.add_argument("-reconstruction",
                         type=int,
                         default=2,
-                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM)")
+                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM, 5=WENOZ, 6=MP5)")
 
     parser.add_argument("-idefixDir",
                         default=idefix_dir_env,
@@ -158,6 +158,10 @@ class idfxTest:
       comm.append("-DIdefix_RECONSTRUCTION=LimO3")
     elif(self.reconstruction==4):
       comm.append("-DIdefix_RECONSTRUCTION=Parabolic")
+    elif(self.reconstruction==5):
+      comm.append("-DIdefix_RECONSTRUCTION=WENOZ")
+    elif(self.reconstruction==6):
+      comm.append("-DIdefix_RECONSTRUCTION=MP5")
 
 
     try:
@@ -250,6 +254,12 @@ class idfxTest:
     if "4th order (PPM)" in log:
       self.reconstruction = 4
 
+    if "5th order (WENO-Z)" in log:
+      self.reconstruction = 5
+
+    if "5th order (MP5)" in log:
+      self.reconstruction = 6
+
     self.mpi=False
     if "MPI ENABLED" in log:
       self.mpi=True
@@ -372,6 +382,10 @@ class idfxTest:
       print("Reconstruction: LimO3")
     elif(self.reconstruction==4):
       print("Reconstruction: PPM")
+    elif(self.reconstruction==5):
+      print("Reconstruction: WENO-Z")
+    elif(self.reconstruction==6):
+      print("Reconstruction: MP5")
     if(self.vectPot):
       print("Vector Potential: ON")
     else:
@@ -389,6 +403,10 @@ class idfxTest:
       strReconstruction = "limo3"
     if self.reconstruction == 4:
       strReconstruction= "ppm"
+    if self.reconstruction == 5:
+      strReconstruction= "wenoz"
+    if self.reconstruction == 6:
+      strReconstruction= "mp5"
 
     strPrecision="double"
     if self.single:
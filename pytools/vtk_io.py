@@ -339,7 +339,36 @@ class VTKDataset(object):
             fh.readline()  # extra line feed
 
     def _load_particles(self, fh):
-        raise NotImplementedError("Particles vtk are not supported yet !")
+        s = fh.readline()  # POINTS NP float
+        slist = s.decode("utf-8").split()
+        self.npart = int(slist[1])
+        # cartesian coordinates of the particles
+        self.points = np.fromfile(fh, dt, 3 * self.npart).reshape(self.npart, 3)
+        fh.readline()  # Extra line feed added by idefix
+
+        s = fh.readline()  # VERTICES NP 2NP
+        slist = s.decode("utf-8").split()
+        np.fromfile(fh, dint, int(slist[2]))  # one vertex per particle, not needed
+        fh.readline()  # Extra line feed added by idefix
+
+        fh.readline()  # POINT_DATA NP
+        fh.readline()  # Extra line feed added by idefix
+
+        while 1:
+            s = fh.readline()  # SCALARS name data_type
+            if len(s) < 2:  # leave if end of file
+                break
+            slist = s.split()
+            datatype = str(slist[0].decode("utf-8"))
+            varname = str(slist[1].decode("utf-8"))
+            vartype = str(slist[2].decode("utf-8"))
+            if datatype != "SCALARS":
+                raise RuntimeError("Unknown datatype '{}'".format(datatype))
+            fh.readline()  # LOOKUP TABLE
+            self.data[varname] = np.fromfile(
+                fh, dint if vartype == "int" else dt, self.npart
+            )
+            fh.readline()  # extra line feed
 
     def __repr__(self):
         return "VTKDataset('%s')" % self.filename
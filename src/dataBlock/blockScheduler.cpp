@@ -0,0 +1,302 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <array>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "blockScheduler.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "gravity.hpp"
+
+// dst(n,k,j,i) = src(n,k+shift[KDIR],j+shift[JDIR],i+shift[IDIR]) for the variables [nb,ne)
+// and the cells [lo,hi) of dst
+static void CopyRegion(IdefixArray4D<real> dst, IdefixArray4D<real> src, int nb, int ne,
+                       std::array<int,3> lo, std::array<int,3> hi, std::array<int,3> shift) {
+  const int si = shift[IDIR];
+  const int sj = shift[JDIR];
+  const int sk = shift[KDIR];
+  idefix_for("BlockCopy", nb, ne, lo[KDIR], hi[KDIR], lo[JDIR], hi[JDIR], lo[IDIR], hi[IDIR],
+    KOKKOS_LAMBDA (int n, int k, int j, int i) {
+      dst(n,k,j,i) = src(n,k+sk,j+sj,i+si);
+    });
+}
+
+// Full extent of an array in each direction
+static std::array<int,3> Extent(const IdefixArray4D<real> &arr) {
+  return {static_cast<int>(arr.extent(3)),
+          static_cast<int>(arr.extent(2)),
+          static_cast<int>(arr.extent(1))};
+}
+
+// Copy the ghost zones of a block on one side along dir from the active zones of its
+// neighbour on that side. normal is set for the face-centered fields normal to dir, for which
+// the face shared by the two blocks is not copied.
+static void CopyGhostZones(IdefixArray4D<real> dst, IdefixArray4D<real> src, int nb, int ne,
+                           const DataBlock &block, int dir, BoundarySide side, bool normal) {
+  std::array<int,3> lo = {0, 0, 0};
+  std::array<int,3> hi = Extent(dst);
+  std::array<int,3> shift = {0, 0, 0};
+  if(side == left) {
+    lo[dir] = 0;
+    shift[dir] = block.np_int[dir];
+  } else {
+    lo[dir] = block.end[dir] + (normal ? 1 : 0);
+    shift[dir] = -block.np_int[dir];
+  }
+  hi[dir] = lo[dir] + block.nghost[dir];
+  CopyRegion(dst, src, nb, ne, lo, hi, shift);
+}
+
+// Call func on each fluid of a block, dust first (same order as DataBlock::SetBoundaries)
+template<typename Function>
+static void ForEachFluid(DataBlock &block, Function func) {
+  for(int n = 0 ; n < block.dust.size() ; n++) {
+    func(*block.dust[n]);
+  }
+  func(*block.hydro);
+}
+
+BlockScheduler::BlockScheduler(Grid &grid, Input &input, DataBlock *data) {
+  idfx::pushRegion("BlockScheduler::BlockScheduler");
+  this->data = data;
+  nblocks = input.GetOrSet<int>("Grid", "dataBlocks", 0, 1);
+  if(nblocks < 1) {
+    IDEFIX_ERROR("[Grid]:dataBlocks should be at least 1");
+  }
+  if(nblocks == 1) {
+    blocks.push_back(data);
+    idfx::popRegion();
+    return;
+  }
+
+  // Split the first direction which is not decomposed between processes: the MPI exchanges
+  // of the following directions then overlap the computation of the previous blocks.
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(grid.nproc[dir] == 1 && data->np_int[dir] % nblocks == 0
+                            && data->np_int[dir]/nblocks >= data->nghost[dir]) {
+      splitDir = dir;
+      break;
+    }
+  }
+  if(splitDir < 0) {
+    std::stringstream msg;
+    msg << "Cannot split the domain of each process into " << nblocks << " blocks." << std::endl
+        << "This requires a direction which is not decomposed between processes (see the -dec "
+        << "option)," << std::endl
+        << "with a number of cells multiple of the number of blocks and at least nghost cells "
+        << "per block.";
+    IDEFIX_ERROR(msg);
+  }
+
+  // Modules which need the full domain of the process
+  if(data->haveAxis) IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with axis boundaries");
+  if(data->haveFargo) IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with Fargo");
+  if(data->haveParticles) IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with particles");
+  if(data->haveplanetarySystem) IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with planets");
+  if(data->haveGravity && data->gravity->haveSelfGravityPotential) {
+    IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with self-gravity");
+  }
+  if(data->haveGridCoarsening != GridCoarsening::disabled) {
+    IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with grid coarsening");
+  }
+  if(data->hydro->haveRKLParabolicTerms || data->hydro->haveImplicitParabolicTerms) {
+    IDEFIX_ERROR("[Grid]:dataBlocks requires explicit parabolic terms");
+  }
+  if(data->lbound[IDIR] == shearingbox || data->rbound[IDIR] == shearingbox) {
+    IDEFIX_ERROR("[Grid]:dataBlocks is not compatible with shearing box boundaries");
+  }
+
+  for(int b = 0 ; b < nblocks ; b++) {
+    children.emplace_back(std::make_unique<DataBlock>(grid, input, this, b));
+    blocks.push_back(children.back().get());
+  }
+
+  #if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+    // One stream per block, so that the kernels of the blocks overlap each other
+    spaces = Kokkos::Experimental::partition_space(Kokkos::DefaultExecutionSpace(),
+                                                   std::vector<int>(nblocks, 1));
+  #else
+    // Host backends execute the kernels in the calling thread: partitioning the threads
+    // between the blocks would only reduce the parallelism of each kernel.
+    spaces.assign(nblocks, Kokkos::DefaultExecutionSpace());
+  #endif
+
+  idfx::popRegion();
+}
+
+BlockScheduler::~BlockScheduler() {
+  idfx::ResetExecutionSpace();
+}
+
+void BlockScheduler::Select(int b) {
+  if(nblocks > 1) idfx::SetExecutionSpace(spaces[b]);
+}
+
+void BlockScheduler::Fence() {
+  if(nblocks == 1) {
+    Kokkos::fence();
+  } else {
+    for(auto &space : spaces) space.fence();
+  }
+}
+
+// The ghost zones of each block are set direction by direction, as in Boundary::SetBoundaries.
+// The directions before the split one only involve each block, the split direction requires
+// the blocks on both sides to be ready, and the task of each block is launched once it has its
+// following directions set: on GPUs, it then runs while the next blocks wait for their MPI
+// exchanges.
+void BlockScheduler::SetBoundaries(const std::function<void(DataBlock &)> &task) {
+  idfx::pushRegion("BlockScheduler::SetBoundaries");
+  if(nblocks == 1) {
+    data->SetBoundaries();
+    task(*data);
+    idfx::popRegion();
+    return;
+  }
+
+  ForEach([&](DataBlock &block) {
+    ForEachFluid(block, [&](auto &fluid) {
+      fluid.boundary->EnforceInternalBoundary(block.t);
+      for(int dir = 0 ; dir < splitDir ; dir++) {
+        fluid.boundary->SetBoundariesDir(block.t, dir);
+      }
+    });
+  });
+  Fence();
+
+  for(int b = 0 ; b < nblocks ; b++) {
+    Select(b);
+    CopyGhosts(b);
+    ForEachFluid(*blocks[b], [&](auto &fluid) {
+      fluid.boundary->SetBoundariesDir(blocks[b]->t, splitDir);
+    });
+  }
+  // The active zones of a block should not change before its neighbours are done copying them
+  Fence();
+
+  ForEach([&](DataBlock &block) {
+    ForEachFluid(block, [&](auto &fluid) {
+      for(int dir = splitDir+1 ; dir < DIMENSIONS ; dir++) {
+        fluid.boundary->SetBoundariesDir(block.t, dir);
+      }
+    });
+    if constexpr(DefaultPhysics::mhd) {
+      block.hydro->boundary->ReconstructVcField(block.hydro->Vc);
+    }
+    task(block);
+  });
+  idfx::popRegion();
+}
+
+void BlockScheduler::CopyGhosts(int b) {
+  const int dir = splitDir;
+  const bool isPeriodic = (data->lbound[dir] == periodic);
+  DataBlock &block = *blocks[b];
+  std::array<int,2> neighbour;
+  neighbour[left] = (b > 0) ? b-1 : (isPeriodic ? nblocks-1 : -1);
+  neighbour[right] = (b < nblocks-1) ? b+1 : (isPeriodic ? 0 : -1);
+
+  for(BoundarySide side : {left, right}) {
+    if(neighbour[side] < 0) continue;
+    DataBlock &src = *blocks[neighbour[side]];
+    for(int n = 0 ; n < block.dust.size() ; n++) {
+      CopyGhostZones(block.dust[n]->Vc, src.dust[n]->Vc, 0, block.dust[n]->Vc.extent(0),
+                     block, dir, side, false);
+    }
+    CopyGhostZones(block.hydro->Vc, src.hydro->Vc, 0, block.hydro->Vc.extent(0),
+                   block, dir, side, false);
+    if constexpr(DefaultPhysics::mhd) {
+      for(int c = 0 ; c < DIMENSIONS ; c++) {
+        CopyGhostZones(block.hydro->Vs, src.hydro->Vs, c, c+1, block, dir, side, c == dir);
+      }
+    }
+  }
+}
+
+void BlockScheduler::Scatter() {
+  if(nblocks == 1) return;
+  idfx::pushRegion("BlockScheduler::Scatter");
+  Kokkos::fence();
+  for(int b = 0 ; b < nblocks ; b++) {
+    DataBlock &block = *blocks[b];
+    std::array<int,3> shift = {0, 0, 0};
+    shift[splitDir] = b*block.np_int[splitDir];
+    auto copy = [&](IdefixArray4D<real> dst, IdefixArray4D<real> src) {
+      CopyRegion(dst, src, 0, dst.extent(0), {0, 0, 0}, Extent(dst), shift);
+    };
+    copy(block.hydro->Vc, data->hydro->Vc);
+    if constexpr(DefaultPhysics::mhd) {
+      copy(block.hydro->Vs, data->hydro->Vs);
+      #ifdef EVOLVE_VECTOR_POTENTIAL
+        copy(block.hydro->Ve, data->hydro->Ve);
+      #endif
+    }
+    for(int n = 0 ; n < block.dust.size() ; n++) {
+      copy(block.dust[n]->Vc, data->dust[n]->Vc);
+    }
+    block.t = data->t;
+    block.dt = data->dt;
+  }
+  Kokkos::fence();
+  evolved = false;
+  idfx::popRegion();
+}
+
+// Only the active zones of the blocks are copied along the split direction (and the ghost
+// zones at the edges of the process domain). The blocks are copied in order so that the
+// values at the upper edge of a block are overwritten by the following block.
+void BlockScheduler::Gather() {
+  if(nblocks == 1 || !evolved) return;
+  idfx::pushRegion("BlockScheduler::Gather");
+  Fence();
+  for(int b = 0 ; b < nblocks ; b++) {
+    DataBlock &block = *blocks[b];
+    const int offset = b*block.np_int[splitDir];
+    auto copy = [&](IdefixArray4D<real> dst, IdefixArray4D<real> src, int upper) {
+      std::array<int,3> lo = {0, 0, 0};
+      std::array<int,3> hi = Extent(src);
+      std::array<int,3> shift = {0, 0, 0};
+      if(b > 0) lo[splitDir] = block.beg[splitDir];
+      if(b < nblocks-1) hi[splitDir] = upper;
+      lo[splitDir] += offset;
+      hi[splitDir] += offset;
+      shift[splitDir] = -offset;
+      CopyRegion(dst, src, 0, dst.extent(0), lo, hi, shift);
+    };
+    const int end = block.end[splitDir];
+    copy(data->hydro->Vc, block.hydro->Vc, end);
+    if constexpr(DefaultPhysics::mhd) {
+      copy(data->hydro->Vs, block.hydro->Vs, end+1);
+      #ifdef EVOLVE_VECTOR_POTENTIAL
+        copy(data->hydro->Ve, block.hydro->Ve, end+1);
+      #endif
+    }
+    for(int n = 0 ; n < block.dust.size() ; n++) {
+      copy(data->dust[n]->Vc, block.dust[n]->Vc, end);
+    }
+  }
+  Kokkos::fence();
+  evolved = false;
+  idfx::popRegion();
+}
+
+void BlockScheduler::SetEvolved() {
+  evolved = true;
+}
+
+void BlockScheduler::ShowConfig() {
+  if(nblocks == 1) return;
+  idfx::cout << "BlockScheduler: " << nblocks << " blocks of " << blocks[0]->np_int[splitDir]
+             << " cells along X" << splitDir+1 << " in each process";
+  #if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+    idfx::cout << ", each with its own execution space instance";
+  #endif
+  idfx::cout << "." << std::endl;
+}
@@ -0,0 +1,69 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_BLOCKSCHEDULER_HPP_
+#define DATABLOCK_BLOCKSCHEDULER_HPP_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "grid.hpp"
+
+class DataBlock;
+
+// Split the domain of each process into several DataBlocks (entry dataBlocks of [Grid]), which
+// are evolved as separate tasks. Each block has its own fluids, boundaries and MPI exchanges,
+// and launches its kernels in its own Kokkos execution space instance, so that a block can
+// compute while the next one waits for its MPI halos.
+// The blocks split a direction which is not decomposed between processes: the ghost zones
+// shared by the blocks of a process are filled with device copies instead of MPI messages.
+// The process DataBlock is kept as an image of its blocks: the initial conditions and the
+// restarts are copied from it to the blocks (Scatter) and the outputs are written from it once
+// the blocks have been copied back (Gather). The blocks are only gathered when an output is
+// due. Without blocks, the process DataBlock is evolved directly and the scheduler does nothing.
+class BlockScheduler {
+ public:
+  BlockScheduler(Grid &, Input &, DataBlock *);
+  ~BlockScheduler();
+
+  // Call func on each block, its kernels being launched in the instance of the block
+  template<typename Function>
+  void ForEach(Function func) {
+    for(int b = 0 ; b < nblocks ; b++) {
+      Select(b);
+      func(*blocks[b]);
+    }
+    idfx::ResetExecutionSpace();
+  }
+
+  // Set the boundaries of all of the blocks, and launch task on each block as soon as its own
+  // boundaries are set
+  void SetBoundaries(const std::function<void(DataBlock &)> &);
+  void Fence();          ///< Wait for the kernels of all of the blocks
+  void Scatter();        ///< Copy the state of the process DataBlock to the blocks
+  void Gather();         ///< Copy the state of the blocks back to the process DataBlock
+  void SetEvolved();     ///< The blocks have been evolved since the last Scatter/Gather
+  void ShowConfig();
+
+  int nblocks{1};                   ///< # of blocks in this process
+  int splitDir{-1};                 ///< direction split between the blocks (-1 without blocks)
+  std::vector<DataBlock *> blocks;  ///< blocks evolved by the time integrator
+
+ private:
+  void Select(int);                 // launch the next kernels in the instance of a block
+  void CopyGhosts(int);             // fill the ghost zones of a block shared with its neighbours
+
+  DataBlock *data;                  // the process DataBlock
+  bool evolved{false};              // whether the process DataBlock is outdated
+  std::vector<std::unique_ptr<DataBlock>> children;
+  std::vector<Kokkos::DefaultExecutionSpace> spaces;
+};
+
+#endif // DATABLOCK_BLOCKSCHEDULER_HPP_
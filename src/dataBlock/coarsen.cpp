@@ -33,7 +33,6 @@ void DataBlock::EnrollGridCoarseningLevels(GridCoarseningFunc func) {
 
 void DataBlock::ComputeGridCoarseningLevels() {
   idfx::pushRegion("DataBlock::ComputeGridCoarseningLevels");
-  static bool levelsHaveBeenComputedOnce = false;
   if((gridCoarseningFunc == NULL) && (haveGridCoarsening == GridCoarsening::dynamic)) {
     IDEFIX_ERROR("Dynamic grid Coarsening is enabled, "
                  "but no function has been enrolled to compute coarsening levels");
@@ -41,7 +40,7 @@ void DataBlock::ComputeGridCoarseningLevels() {
   // if grid coarsening is enabled(=static), we compute the levels once
   // levels can be either initialised with the initial conditions, or with a dedicated
   // Coarsening function (if Enrollment has been called)
-  if((haveGridCoarsening == GridCoarsening::enabled) && (!levelsHaveBeenComputedOnce)) {
+  if((haveGridCoarsening == GridCoarsening::enabled) && (!coarseningLevelsComputed)) {
     if(gridCoarseningFunc != NULL) {
       idfx::pushRegion("User-defined Coarsening function");
         gridCoarseningFunc(*this);
@@ -51,13 +50,13 @@ void DataBlock::ComputeGridCoarseningLevels() {
     } else {
       IDEFIX_ERROR("Grid coarsening requires the enrollment of a grid coarsening function");
     }
-    levelsHaveBeenComputedOnce = true;
+    coarseningLevelsComputed = true;
   }
   if(haveGridCoarsening == GridCoarsening::dynamic) {
     idfx::pushRegion("User-defined Coarsening function");
       gridCoarseningFunc(*this);
     idfx::popRegion();
-    levelsHaveBeenComputedOnce = true;
+    coarseningLevelsComputed = true;
   }
   idfx::popRegion();
 }
@@ -19,7 +19,7 @@
 #include "xdmf.hpp"
 #endif
 
-DataBlock::DataBlock(Grid &grid, Input &input) {
+DataBlock::DataBlock(Grid &grid, Input &input, const BlockScheduler *owner, int block) {
   idfx::pushRegion("DataBlock::DataBlock");
 
   this->mygrid=&grid;
@@ -60,6 +60,18 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
     gbeg[dir] = grid.nghost[dir] + grid.xproc[dir]*np_int[dir];
     gend[dir] = grid.nghost[dir] + (grid.xproc[dir]+1)*np_int[dir];
 
+    // The blocks of a process share its domain along the split direction
+    if(owner != nullptr && dir == owner->splitDir) {
+      np_int[dir] /= owner->nblocks;
+      np_tot[dir] = np_int[dir]+2*nghost[dir];
+      end[dir] = beg[dir]+np_int[dir];
+      gbeg[dir] += block*np_int[dir];
+      gend[dir] = gbeg[dir]+np_int[dir];
+      // The ghost zones shared between blocks (also when periodic) are set by the scheduler
+      if(block > 0 || lbound[dir] == periodic) lbound[dir] = internal;
+      if(block < owner->nblocks-1 || rbound[dir] == periodic) rbound[dir] = internal;
+    }
+
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
     xend[dir] = gridHost.xr[dir](gend[dir]-1);
@@ -152,10 +164,21 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
       dust.emplace_back(std::make_unique<Fluid<DustPhysics>>(grid, input, this, i));
     }
   }
+
+  // Initialise Lagrangian particles if needed
+  if(input.CheckBlock("Particles")) {
+    this->particles = std::make_unique<Particles>(input, this);
+    this->haveParticles = true;
+  }
   // Register variables that need to be saved in case of restart dump
   dump->RegisterVariable(&t, "time");
   dump->RegisterVariable(&dt, "dt");
 
+  // Split the process domain into blocks if required
+  if(owner == nullptr) {
+    this->scheduler = std::make_unique<BlockScheduler>(grid, input, this);
+  }
+
   idfx::popRegion();
 }
 
@@ -327,6 +350,8 @@ void DataBlock::ShowConfig() {
       dust[i]->ShowConfig();
     }*/
   }
+  if(haveParticles) particles->ShowConfig();
+  if(scheduler) scheduler->ShowConfig();
 }
 
 
@@ -359,6 +384,9 @@ real DataBlock::ComputeTimestep() {
       dt = std::min(dt,dtDust);
     }
   }
+  if(haveParticles) {
+    dt = std::min(dt, particles->ComputeTimestep());
+  }
   Kokkos::fence();
   return(dt);
 }
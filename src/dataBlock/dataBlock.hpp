@@ -19,7 +19,9 @@
 #include "gridHost.hpp"
 #include "planetarySystem.hpp"
 #include "gravity.hpp"
+#include "particles.hpp"
 #include "stateContainer.hpp"
+#include "blockScheduler.hpp"
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /// The DataBlock class is designed to store the data and child class instances that belongs to the
@@ -105,6 +107,8 @@ class DataBlock {
 
   real dt;                     ///< Current timestep
   real t;                      ///< Current time
+  int64_t cycleCount{0};       ///< Current integration cycle
+  int64_t stageCount{0};       ///< # of stages (including RKL and implicit sub-stages) so far
 
   Grid *mygrid;                ///< Parent grid object
 
@@ -123,7 +127,8 @@ class DataBlock {
   #endif
 
 
-  DataBlock(Grid &, Input &);     ///< init from a Grid object
+  DataBlock(Grid &, Input &, const BlockScheduler * = nullptr, int = 0);
+                                  ///< init from a Grid object (or as block #n of a process)
   explicit DataBlock(SubGrid *);           ///< init a minimal datablock for a subgrid
 
   void ExtractSubdomain();        ///< initialise datablock sub-domain according to domain decomp.
@@ -138,9 +143,11 @@ class DataBlock {
 
 
   bool rklCycle{false};           ///<  // Set to true when we're inside a RKL call
+  bool implicitCycle{false};      ///< Set to true when we're inside an implicit parabolic step
 
   void EvolveStage();             ///< Evolve this DataBlock by dt
   void EvolveRKLStage();          ///< Evolve this DataBlock by dt for terms impacted by RKL
+  void EvolveImplicitStage();     ///< Evolve this DataBlock by dt for implicit parabolic terms
   void SetBoundaries();       ///< Enforce boundary conditions to this datablock
   void ConsToPrim();       ///< Convert conservative to primitive variables
   void PrimToCons();       ///< Convert primitive to conservative variables
@@ -155,6 +162,9 @@ class DataBlock {
                                   ///< Enroll a user function to compute coarsening levels
   void CheckCoarseningLevels();   ///< Check that coarsening levels satisfy requirements
 
+  // Blocks of this process (only set for the process DataBlock)
+  std::unique_ptr<BlockScheduler> scheduler;
+
   // Do we use fargo-like scheme ? (orbital advection)
   bool haveFargo{false};
   std::unique_ptr<Fargo> fargo;
@@ -163,6 +173,10 @@ class DataBlock {
   bool haveGravity{false};
   std::unique_ptr<Gravity> gravity;
 
+  // Do we have Lagrangian particles ?
+  bool haveParticles{false};
+  std::unique_ptr<Particles> particles;
+
   // User step functions (before or after the main integrator step)
   void LaunchUserStepFirst();     ///< perform user-defined step before main integration step
   void LaunchUserStepLast();      ///< Perform user-defined step after main integration step
@@ -173,6 +187,7 @@ class DataBlock {
  private:
   void WriteVariable(FILE* , int , int *, char *, void*);
   void ComputeGridCoarseningLevels();   ///< Call user defined function to define Coarsening levels
+  bool coarseningLevelsComputed{false};  ///< whether the static coarsening levels are known
 
   // User Steps (either before or after the main integration loop)
   bool haveUserStepFirst{false};
@@ -0,0 +1,249 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "diagnostics.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+// Diagnostics of one fluid, reduced in an array following the Diagnostics::Slot layout
+template<typename Phys>
+struct DiagnosticsReducer {
+  using value_type = real[];
+  const unsigned value_count;
+
+  IdefixArray4D<real> Vc;
+  IdefixArray4D<real> Vs;
+  IdefixArray3D<real> InvDt;
+  IdefixArray3D<real> dV;
+  IdefixArray3D<real> Ax1, Ax2, Ax3;
+  IdefixArray1D<int> quantities;
+  int nScalars;
+  bool wantDt;
+  bool wantNan;
+  bool wantDivB;
+  int iend, jend, kend;
+  real dtMax;
+
+  DiagnosticsReducer(DataBlock &data, Fluid<Phys> &fluid, IdefixArray1D<int> quantities,
+                     int nScalars, bool wantDt, bool wantNan, bool wantDivB):
+                      value_count(Diagnostics::scalarSlot+quantities.extent(0)),
+                      Vc(fluid.Vc),
+                      Vs(fluid.Vs),
+                      InvDt(fluid.InvDt),
+                      dV(data.dV),
+                      Ax1(data.A[IDIR]),
+                      Ax2(data.A[JDIR]),
+                      Ax3(data.A[KDIR]),
+                      quantities(quantities),
+                      nScalars(nScalars),
+                      wantDt(wantDt),
+                      wantNan(wantNan),
+                      wantDivB(wantDivB),
+                      iend(data.end[IDIR]),
+                      jend(data.end[JDIR]),
+                      kend(data.end[KDIR]),
+                      dtMax(std::numeric_limits<real>::max()) {}
+
+  KOKKOS_INLINE_FUNCTION void init(value_type v) const {
+    v[Diagnostics::dtSlot] = dtMax;
+    for(unsigned n = Diagnostics::nanSlot ; n < value_count ; n++) v[n] = ZERO_F;
+  }
+
+  KOKKOS_INLINE_FUNCTION void join(value_type dst, const value_type src) const {
+    dst[Diagnostics::dtSlot] = FMIN(dst[Diagnostics::dtSlot], src[Diagnostics::dtSlot]);
+    dst[Diagnostics::nanSlot] += src[Diagnostics::nanSlot];
+    dst[Diagnostics::divBSlot] = FMAX(dst[Diagnostics::divBSlot], src[Diagnostics::divBSlot]);
+    for(unsigned n = Diagnostics::scalarSlot ; n < value_count ; n++) dst[n] += src[n];
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int k, const int j, const int i,
+                                         value_type v) const {
+    if(wantDt) v[Diagnostics::dtSlot] = FMIN(ONE_F/InvDt(k,j,i), v[Diagnostics::dtSlot]);
+
+    if(wantNan) {
+      int nnan = 0;
+      for(int n = 0 ; n < Phys::nvar ; n++) {
+        if(std::isnan(Vc(n,k,j,i))) nnan++;
+      }
+      if constexpr(Phys::mhd) {
+        for(int n = 0 ; n < DIMENSIONS ; n++) {
+          if(std::isnan(Vs(n,k,j,i))) nnan++;
+        }
+        // The last faces of the domain
+        D_EXPAND( if(i == iend-1 && std::isnan(Vs(BX1s,k,j,i+1))) nnan++;  ,
+                  if(j == jend-1 && std::isnan(Vs(BX2s,k,j+1,i))) nnan++;  ,
+                  if(k == kend-1 && std::isnan(Vs(BX3s,k+1,j,i))) nnan++;  )
+      }
+      v[Diagnostics::nanSlot] += nnan;
+    }
+
+    if constexpr(Phys::mhd) {
+      if(wantDivB) {
+        [[maybe_unused]] real dB1,dB2,dB3;
+        dB1=dB2=dB3=ZERO_F;
+        D_EXPAND( dB1=(Ax1(k,j,i+1)*Vs(BX1s,k,j,i+1)-Ax1(k,j,i)*Vs(BX1s,k,j,i));  ,
+                  dB2=(Ax2(k,j+1,i)*Vs(BX2s,k,j+1,i)-Ax2(k,j,i)*Vs(BX2s,k,j,i));  ,
+                  dB3=(Ax3(k+1,j,i)*Vs(BX3s,k+1,j,i)-Ax3(k,j,i)*Vs(BX3s,k,j,i));  )
+        v[Diagnostics::divBSlot] = FMAX(FABS(D_EXPAND(dB1, +dB2, +dB3))/dV(k,j,i),
+                                        v[Diagnostics::divBSlot]);
+      }
+    }
+
+    for(int s = 0 ; s < nScalars ; s++) {
+      real q = ZERO_F;
+      switch(quantities(s)) {
+        case Diagnostics::mass:
+          q = Vc(RHO,k,j,i);
+          break;
+        case Diagnostics::kineticEnergy:
+          q = HALF_F*Vc(RHO,k,j,i)*(EXPAND( Vc(VX1,k,j,i)*Vc(VX1,k,j,i)  ,
+                                           +Vc(VX2,k,j,i)*Vc(VX2,k,j,i)  ,
+                                           +Vc(VX3,k,j,i)*Vc(VX3,k,j,i)  ));
+          break;
+        case Diagnostics::magneticEnergy:
+          if constexpr(Phys::mhd) {
+            q = HALF_F*(EXPAND( Vc(BX1,k,j,i)*Vc(BX1,k,j,i)  ,
+                               +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)  ,
+                               +Vc(BX3,k,j,i)*Vc(BX3,k,j,i)  ));
+          }
+          break;
+      }
+      v[Diagnostics::scalarSlot+s] += q*dV(k,j,i);
+    }
+  }
+};
+
+template<typename Phys>
+static void ReduceFluid(DataBlock &data, Fluid<Phys> &fluid, IdefixArray1D<int> quantities,
+                        int nScalars, bool wantDt, bool wantNan, bool wantDivB,
+                        std::vector<real> &values) {
+  std::vector<real> fluidValues(values.size());
+  idefix_reduce("Diagnostics",
+                data.beg[KDIR], data.end[KDIR],
+                data.beg[JDIR], data.end[JDIR],
+                data.beg[IDIR], data.end[IDIR],
+                DiagnosticsReducer<Phys>(data, fluid, quantities, nScalars, wantDt, wantNan,
+                                         wantDivB),
+                fluidValues.data());
+  values[Diagnostics::dtSlot] = std::min(values[Diagnostics::dtSlot],
+                                         fluidValues[Diagnostics::dtSlot]);
+  values[Diagnostics::nanSlot] += fluidValues[Diagnostics::nanSlot];
+  values[Diagnostics::divBSlot] = std::max(values[Diagnostics::divBSlot],
+                                           fluidValues[Diagnostics::divBSlot]);
+  for(int n = Diagnostics::scalarSlot ; n < values.size() ; n++) values[n] += fluidValues[n];
+}
+
+#ifdef WITH_MPI
+// MPI counterpart of DiagnosticsReducer::join
+static void JoinDiagnostics(void *in, void *inout, int *len, MPI_Datatype *) {
+  const real *src = reinterpret_cast<real *>(in);
+  real *dst = reinterpret_cast<real *>(inout);
+  dst[Diagnostics::dtSlot] = std::min(dst[Diagnostics::dtSlot], src[Diagnostics::dtSlot]);
+  dst[Diagnostics::nanSlot] += src[Diagnostics::nanSlot];
+  dst[Diagnostics::divBSlot] = std::max(dst[Diagnostics::divBSlot], src[Diagnostics::divBSlot]);
+  for(int n = Diagnostics::scalarSlot ; n < *len ; n++) dst[n] += src[n];
+}
+#endif
+
+Diagnostics::Diagnostics(Input &input, DataBlock &data) {
+  idfx::pushRegion("Diagnostics::Diagnostics");
+  const int nScalars = std::max(input.CheckEntry("Output","log_scalars"), 0);
+  for(int s = 0 ; s < nScalars ; s++) {
+    std::string name = input.Get<std::string>("Output","log_scalars",s);
+    if(name.compare("mass") == 0) {
+      quantities.push_back(mass);
+    } else if(name.compare("kinetic") == 0) {
+      quantities.push_back(kineticEnergy);
+    } else if(name.compare("magnetic") == 0) {
+      if(!DefaultPhysics::mhd) {
+        IDEFIX_ERROR("The magnetic energy can only be logged in MHD");
+      }
+      quantities.push_back(magneticEnergy);
+    } else {
+      IDEFIX_ERROR("Unknown log scalar "+name+". Should be mass, kinetic or magnetic.");
+    }
+    scalarNames.push_back(name);
+  }
+  std::vector<int> quantityIndices(quantities.begin(), quantities.end());
+  quantitiesDevice = idfx::ConvertVectorToIdefixArray(quantityIndices);
+  values.resize(scalarSlot+nScalars);
+  scalars.resize(nScalars);
+  #ifdef WITH_MPI
+  MPI_Op_create(&JoinDiagnostics, 1, &op);
+  #endif
+  idfx::popRegion();
+}
+
+Diagnostics::~Diagnostics() {
+  #ifdef WITH_MPI
+  MPI_Op_free(&op);
+  #endif
+}
+
+void Diagnostics::Reduce(DataBlock &data, bool wantDt, bool wantNan, bool wantLog) {
+  idfx::pushRegion("Diagnostics::Reduce");
+  if(!haveValues) {
+    values[dtSlot] = std::numeric_limits<real>::max();
+    std::fill(values.begin()+nanSlot, values.end(), ZERO_F);
+    haveValues = true;
+  }
+  const int nScalars = wantLog ? quantities.size() : 0;
+
+  data.scheduler->ForEach([&](DataBlock &block) {
+    ReduceFluid(block, *block.hydro, quantitiesDevice, nScalars, wantDt, wantNan, wantLog,
+                values);
+    for(int n = 0 ; n < block.dust.size() ; n++) {
+      ReduceFluid(block, *block.dust[n], quantitiesDevice, 0, wantDt, wantNan, false, values);
+    }
+    if(wantDt && block.haveParticles) {
+      values[dtSlot] = std::min(values[dtSlot], block.particles->ComputeTimestep());
+    }
+  });
+  idfx::popRegion();
+}
+
+void Diagnostics::Start() {
+  if(!haveValues) return;
+  idfx::pushRegion("Diagnostics::Start");
+  #ifdef WITH_MPI
+  if(idfx::psize>1) {
+    MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, values.data(), values.size(), realMPI, op,
+                                 MPI_COMM_WORLD, &request));
+  }
+  #endif
+  haveValues = false;
+  reducing = true;
+  idfx::popRegion();
+}
+
+void Diagnostics::Wait() {
+  if(!reducing) return;
+  idfx::pushRegion("Diagnostics::Wait");
+  #ifdef WITH_MPI
+  if(idfx::psize>1) {
+    MPI_SAFE_CALL(MPI_Wait(&request, MPI_STATUS_IGNORE));
+  }
+  #endif
+  reducing = false;
+  dt = values[dtSlot];
+  nNans = static_cast<int>(values[nanSlot]);
+  divB = values[divBSlot];
+  for(int s = 0 ; s < scalars.size() ; s++) scalars[s] = values[scalarSlot+s];
+  idfx::popRegion();
+}
+
+void Diagnostics::ShowConfig() {
+  if(scalarNames.size() == 0) return;
+  idfx::cout << "Diagnostics: logging the volume integral of";
+  for(auto const &name : scalarNames) idfx::cout << " " << name;
+  idfx::cout << "." << std::endl;
+}
@@ -0,0 +1,59 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_DIAGNOSTICS_HPP_
+#define DATABLOCK_DIAGNOSTICS_HPP_
+
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+// Diagnostics of the time integrator, computed in a single pass over each fluid: the time step,
+// the number of Nans, the maximum of div B and the volume integrals listed in the log_scalars
+// entry of [Output]. The results of all of the blocks and processes are combined with a single
+// (non-blocking) MPI reduction. Several passes (e.g. the time step of the first stage and the
+// Nans at the end of the cycle) can be accumulated before the reduction is started.
+class Diagnostics {
+ public:
+  // Layout of the reduced values
+  enum Slot {dtSlot, nanSlot, divBSlot, scalarSlot};
+  // Quantities which can be integrated over the domain
+  enum Quantity {mass, kineticEnergy, magneticEnergy};
+
+  Diagnostics(Input &, DataBlock &);
+  ~Diagnostics();
+
+  // Reduce the diagnostics of all of the blocks of a process
+  void Reduce(DataBlock &, bool wantDt, bool wantNan, bool wantLog);
+  void Start();                     ///< Start the reduction between the processes
+  void Wait();                      ///< Wait for the end of the reduction
+
+  void ShowConfig();
+
+  real dt;                          ///< minimum time step allowed by the fluids and particles
+  int nNans;                        ///< # of Nans in the fluids
+  real divB;                        ///< maximum of |div B|
+  std::vector<real> scalars;        ///< volume integrals
+  std::vector<std::string> scalarNames;
+
+ private:
+  std::vector<Quantity> quantities;
+  IdefixArray1D<int> quantitiesDevice;
+  std::vector<real> values;         // reduced values, following the Slot layout
+  bool haveValues{false};           // values of this process, not yet reduced between processes
+  bool reducing{false};
+  #ifdef WITH_MPI
+  MPI_Request request;
+  MPI_Op op;                        // min/sum/max of the slots
+  #endif
+};
+
+#endif // DATABLOCK_DIAGNOSTICS_HPP_
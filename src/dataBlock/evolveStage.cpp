@@ -12,6 +12,7 @@
 // Evolve one step forward in time of hydro
 void DataBlock::EvolveStage() {
   idfx::pushRegion("DataBlock::EvolveStage");
+  stageCount++;
 
   hydro->EvolveStage(this->t,this->dt);
 
@@ -31,3 +32,11 @@ void DataBlock::EvolveRKLStage() {
   }
   idfx::popRegion();
 }
+
+void DataBlock::EvolveImplicitStage() {
+  idfx::pushRegion("DataBlock::EvolveImplicitStage");
+  if(hydro->haveImplicitParabolicTerms) {
+    hydro->implicit->Cycle();
+  }
+  idfx::popRegion();
+}
@@ -0,0 +1,340 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "particles.hpp"
+#include "dataBlock.hpp"
+
+// Status of a particle during a migration
+enum ParticleStatus {KEEP = 0, SEND_LEFT = 1, SEND_RIGHT = 2, LOST = 3};
+
+// Number of reals and ints sent per particle
+constexpr int nRealPerParticle = 6;
+constexpr int nIntPerParticle = 2;
+
+// Send the particles which left the local domain to the process which owns them
+void Particles::Migrate() {
+  idfx::pushRegion("Particles::Migrate");
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    // Particles which crossed several sub-domains are sent several times
+    while(MigrateDir(dir) > 0) {}
+  }
+  idfx::popRegion();
+}
+
+// Give consecutive slots, from offset, to the particles which have a given flag.
+// Return the number of such particles.
+int Particles::Enumerate(int value, int offset) {
+  auto flag = this->flag;
+  auto slot = this->slot;
+  int total = 0;
+  Kokkos::parallel_scan("Particles::Enumerate", count,
+    KOKKOS_LAMBDA (const int p, int &n, const bool final) {
+      if(flag(p) == value) {
+        if(final) slot(p) = offset + n;
+        n++;
+      }
+    }, total);
+  return(total);
+}
+
+// Apply the boundary conditions to the particles which left the local domain in direction dir,
+// and exchange them with the neighbouring processes. Return the total number of exchanged
+// particles.
+int Particles::MigrateDir(int dir) {
+  const real xl = data->xbeg[dir];
+  const real xr = data->xend[dir];
+  const real length = data->mygrid->xend[dir] - data->mygrid->xbeg[dir];
+  const BoundaryType lbound = data->lbound[dir];
+  const BoundaryType rbound = data->rbound[dir];
+  const bool alone = (data->mygrid->nproc[dir] == 1);
+
+  auto flag = this->flag;
+  auto xd = x[dir];
+  auto vd = v[dir];
+  auto x3 = x[KDIR];
+  auto v3 = v[KDIR];
+
+  idefix_for("Particles::Boundaries", 0, count,
+    KOKKOS_LAMBDA (int p) {
+      int status = KEEP;
+      const bool left = xd(p) < xl;
+      const bool right = xd(p) >= xr;
+      if(left || right) {
+        const BoundaryType bound = left ? lbound : rbound;
+        const real edge = left ? xl : xr;
+        if(bound == internal) {
+          status = left ? SEND_LEFT : SEND_RIGHT;
+        } else if(bound == periodic) {
+          xd(p) += left ? length : -length;
+          if(!alone) status = left ? SEND_LEFT : SEND_RIGHT;
+        } else if(bound == reflective || bound == axis) {
+          xd(p) = 2*edge - xd(p);
+          vd(p) = -vd(p);
+          if(bound == axis) {
+            // The particle went through the axis, on the opposite side in phi
+            #if DIMENSIONS == 3
+              x3(p) += M_PI;
+            #endif
+            v3(p) = -v3(p);
+          }
+        } else {
+          // The particle left the domain
+          status = LOST;
+        }
+      }
+      flag(p) = status;
+    });
+
+  const int nKeep = Enumerate(KEEP, 0);
+  const int nLeft = Enumerate(SEND_LEFT, 0);
+  const int nRight = Enumerate(SEND_RIGHT, nLeft);
+
+  int nMoving = nLeft + nRight;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &nMoving, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD));
+  #endif
+
+  if(nMoving == 0) {
+    if(nKeep < count) Move(slot, nKeep);
+    return(0);
+  }
+
+  #ifdef WITH_MPI
+    MPI_Comm comm = data->mygrid->CartComm;
+    int procLeft, procRight;
+    MPI_SAFE_CALL(MPI_Cart_shift(comm, dir, 1, &procLeft, &procRight));
+
+    // Number of particles received from each side
+    int nFromLeft = 0;
+    int nFromRight = 0;
+    MPI_SAFE_CALL(MPI_Sendrecv(&nLeft, 1, MPI_INT, procLeft, 310,
+                               &nFromRight, 1, MPI_INT, procRight, 310,
+                               comm, MPI_STATUS_IGNORE));
+    MPI_SAFE_CALL(MPI_Sendrecv(&nRight, 1, MPI_INT, procRight, 311,
+                               &nFromLeft, 1, MPI_INT, procLeft, 311,
+                               comm, MPI_STATUS_IGNORE));
+    const int nSend = nLeft + nRight;
+    const int nRecv = nFromLeft + nFromRight;
+
+    if(sendReal.extent(0) < nRealPerParticle*nSend) {
+      Kokkos::realloc(sendReal, nRealPerParticle*nSend);
+      Kokkos::realloc(sendInt, nIntPerParticle*nSend);
+    }
+    if(recvReal.extent(0) < nRealPerParticle*nRecv) {
+      Kokkos::realloc(recvReal, nRealPerParticle*nRecv);
+      Kokkos::realloc(recvInt, nIntPerParticle*nRecv);
+    }
+
+    // Pack the leaving particles, those going to the left first
+    {
+      auto slot = this->slot;
+      auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+      auto v1 = v[IDIR], v2 = v[JDIR], v3 = v[KDIR];
+      auto id = this->id;
+      auto species = this->species;
+      auto sendReal = this->sendReal;
+      auto sendInt = this->sendInt;
+      idefix_for("Particles::Pack", 0, count,
+        KOKKOS_LAMBDA (int p) {
+          if(flag(p) == SEND_LEFT || flag(p) == SEND_RIGHT) {
+            const int q = slot(p);
+            sendReal(nRealPerParticle*q  ) = x1(p);
+            sendReal(nRealPerParticle*q+1) = x2(p);
+            sendReal(nRealPerParticle*q+2) = x3(p);
+            sendReal(nRealPerParticle*q+3) = v1(p);
+            sendReal(nRealPerParticle*q+4) = v2(p);
+            sendReal(nRealPerParticle*q+5) = v3(p);
+            sendInt(nIntPerParticle*q  ) = id(p);
+            sendInt(nIntPerParticle*q+1) = species(p);
+          }
+        });
+      Kokkos::fence();
+    }
+
+    // Particles going left arrive from the right and the other way round
+    MPI_Request requests[8];
+    real *sr = sendReal.data();
+    real *rr = recvReal.data();
+    int *si = sendInt.data();
+    int *ri = recvInt.data();
+    MPI_SAFE_CALL(MPI_Irecv(rr, nRealPerParticle*nFromRight, realMPI, procRight, 320,
+                            comm, &requests[0]));
+    MPI_SAFE_CALL(MPI_Irecv(rr + nRealPerParticle*nFromRight, nRealPerParticle*nFromLeft,
+                            realMPI, procLeft, 321, comm, &requests[1]));
+    MPI_SAFE_CALL(MPI_Irecv(ri, nIntPerParticle*nFromRight, MPI_INT, procRight, 322,
+                            comm, &requests[2]));
+    MPI_SAFE_CALL(MPI_Irecv(ri + nIntPerParticle*nFromRight, nIntPerParticle*nFromLeft,
+                            MPI_INT, procLeft, 323, comm, &requests[3]));
+    MPI_SAFE_CALL(MPI_Isend(sr, nRealPerParticle*nLeft, realMPI, procLeft, 320,
+                            comm, &requests[4]));
+    MPI_SAFE_CALL(MPI_Isend(sr + nRealPerParticle*nLeft, nRealPerParticle*nRight,
+                            realMPI, procRight, 321, comm, &requests[5]));
+    MPI_SAFE_CALL(MPI_Isend(si, nIntPerParticle*nLeft, MPI_INT, procLeft, 322,
+                            comm, &requests[6]));
+    MPI_SAFE_CALL(MPI_Isend(si + nIntPerParticle*nLeft, nIntPerParticle*nRight,
+                            MPI_INT, procRight, 323, comm, &requests[7]));
+    MPI_SAFE_CALL(MPI_Waitall(8, requests, MPI_STATUSES_IGNORE));
+
+    // Drop the particles which left, and append the ones which arrived
+    Move(slot, nKeep);
+    Reserve(nKeep + nRecv);
+    {
+      auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+      auto v1 = v[IDIR], v2 = v[JDIR], v3 = v[KDIR];
+      auto id = this->id;
+      auto species = this->species;
+      auto recvReal = this->recvReal;
+      auto recvInt = this->recvInt;
+      idefix_for("Particles::Unpack", 0, nRecv,
+        KOKKOS_LAMBDA (int q) {
+          const int p = nKeep + q;
+          x1(p) = recvReal(nRealPerParticle*q  );
+          x2(p) = recvReal(nRealPerParticle*q+1);
+          x3(p) = recvReal(nRealPerParticle*q+2);
+          v1(p) = recvReal(nRealPerParticle*q+3);
+          v2(p) = recvReal(nRealPerParticle*q+4);
+          v3(p) = recvReal(nRealPerParticle*q+5);
+          id(p) = recvInt(nIntPerParticle*q  );
+          species(p) = recvInt(nIntPerParticle*q+1);
+        });
+    }
+    count = nKeep + nRecv;
+  #endif
+  return(nMoving);
+}
+
+// Add the feedback of the cells of the box [lo,hi) to the cells obtained by changing the
+// index in direction dir from idx to sign*idx+shift
+static void AddBox(IdefixArray4D<real> fb, const int dir, const int lo[3], const int hi[3],
+                   const int sign, const int shift) {
+  idefix_for("Particles::FoldFeedback",
+    lo[KDIR], hi[KDIR],
+    lo[JDIR], hi[JDIR],
+    lo[IDIR], hi[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      int idx[3] = {i, j, k};
+      idx[dir] = sign*idx[dir] + shift;
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        fb(n,idx[KDIR],idx[JDIR],idx[IDIR]) += fb(n,k,j,i);
+      }
+    });
+}
+
+#ifdef WITH_MPI
+static void PackBox(IdefixArray4D<real> fb, const int lo[3], const int hi[3],
+                    IdefixArray1D<real> buffer) {
+  const int ni = hi[IDIR]-lo[IDIR];
+  const int nj = hi[JDIR]-lo[JDIR];
+  const int i0 = lo[IDIR], j0 = lo[JDIR], k0 = lo[KDIR];
+  idefix_for("Particles::PackFeedback",
+    lo[KDIR], hi[KDIR],
+    lo[JDIR], hi[JDIR],
+    lo[IDIR], hi[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int idx = ((k-k0)*nj + (j-j0))*ni + (i-i0);
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        buffer(COMPONENTS*idx+n) = fb(n,k,j,i);
+      }
+    });
+}
+
+static void UnpackBox(IdefixArray4D<real> fb, const int lo[3], const int hi[3],
+                      IdefixArray1D<real> buffer) {
+  const int ni = hi[IDIR]-lo[IDIR];
+  const int nj = hi[JDIR]-lo[JDIR];
+  const int i0 = lo[IDIR], j0 = lo[JDIR], k0 = lo[KDIR];
+  idefix_for("Particles::UnpackFeedback",
+    lo[KDIR], hi[KDIR],
+    lo[JDIR], hi[JDIR],
+    lo[IDIR], hi[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int idx = ((k-k0)*nj + (j-j0))*ni + (i-i0);
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        fb(n,k,j,i) += buffer(COMPONENTS*idx+n);
+      }
+    });
+}
+#endif
+
+// The particles deposit their momentum in ghost cells, which belong to the neighbouring
+// processes (or to the periodic images of the domain). Add these contributions to the active
+// cells they overlap, one direction after the other so that the corners are handled. At the
+// other boundaries, the contributions are added to the mirror active cells.
+void Particles::FoldFeedback() {
+  idfx::pushRegion("Particles::FoldFeedback");
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    const int beg = data->beg[dir];
+    const int end = data->end[dir];
+    const int nint = data->np_int[dir];
+
+    // Ghost slabs: active cells in the directions already folded, all the cells otherwise
+    int loL[3], hiL[3], loR[3], hiR[3];
+    for(int d = 0 ; d < 3 ; d++) {
+      loL[d] = loR[d] = (d < dir) ? data->beg[d] : 0;
+      hiL[d] = hiR[d] = (d < dir) ? data->end[d] : data->np_tot[d];
+    }
+    loL[dir] = 0;
+    hiL[dir] = beg;
+    loR[dir] = end;
+    hiR[dir] = data->np_tot[dir];
+
+    if(data->mygrid->nproc[dir] == 1) {
+      if(data->lbound[dir] == periodic) {
+        AddBox(feedback, dir, loL, hiL, 1, nint);
+        AddBox(feedback, dir, loR, hiR, 1, -nint);
+      } else {
+        AddBox(feedback, dir, loL, hiL, -1, 2*beg-1);
+        AddBox(feedback, dir, loR, hiR, -1, 2*end-1);
+      }
+      continue;
+    }
+    #ifdef WITH_MPI
+      const int ng = data->nghost[dir];
+      MPI_Comm comm = data->mygrid->CartComm;
+      int procLeft, procRight;
+      MPI_SAFE_CALL(MPI_Cart_shift(comm, dir, 1, &procLeft, &procRight));
+
+      const int size = COMPONENTS*(hiL[IDIR]-loL[IDIR])*(hiL[JDIR]-loL[JDIR])
+                                 *(hiL[KDIR]-loL[KDIR]);
+      IdefixArray1D<real> sendL("FeedbackSendLeft", size);
+      IdefixArray1D<real> sendR("FeedbackSendRight", size);
+      IdefixArray1D<real> recvL("FeedbackRecvLeft", size);
+      IdefixArray1D<real> recvR("FeedbackRecvRight", size);
+      PackBox(feedback, loL, hiL, sendL);
+      PackBox(feedback, loR, hiR, sendR);
+      Kokkos::fence();
+      MPI_SAFE_CALL(MPI_Sendrecv(sendL.data(), size, realMPI, procLeft, 330,
+                                 recvR.data(), size, realMPI, procRight, 330,
+                                 comm, MPI_STATUS_IGNORE));
+      MPI_SAFE_CALL(MPI_Sendrecv(sendR.data(), size, realMPI, procRight, 331,
+                                 recvL.data(), size, realMPI, procLeft, 331,
+                                 comm, MPI_STATUS_IGNORE));
+
+      // The left ghosts of the right neighbour overlap our last active cells, and so on
+      int lo[3], hi[3];
+      for(int d = 0 ; d < 3 ; d++) {
+        lo[d] = loL[d];
+        hi[d] = hiL[d];
+      }
+      if(procLeft != MPI_PROC_NULL) {
+        lo[dir] = beg;
+        hi[dir] = beg+ng;
+        UnpackBox(feedback, lo, hi, recvL);
+      } else {
+        AddBox(feedback, dir, loL, hiL, -1, 2*beg-1);
+      }
+      if(procRight != MPI_PROC_NULL) {
+        lo[dir] = end-ng;
+        hi[dir] = end;
+        UnpackBox(feedback, lo, hi, recvR);
+      } else {
+        AddBox(feedback, dir, loR, hiR, -1, 2*end-1);
+      }
+    #endif
+  }
+  idfx::popRegion();
+}
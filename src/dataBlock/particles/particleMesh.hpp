@@ -0,0 +1,154 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_PARTICLES_PARTICLEMESH_HPP_
+#define DATABLOCK_PARTICLES_PARTICLEMESH_HPP_
+
+#include "idefix.hpp"
+
+// Weights of the cells surrounding a particle, in each direction
+struct ParticleWeights {
+  int start[3];       // first cell of the stencil
+  int size[3];        // number of cells of the stencil
+  real w[3][3];       // weight of each cell of the stencil
+};
+
+// Interpolation and deposition kernels between the particles and the grid of a datablock.
+// This is a light object, which is meant to be captured by value in device kernels.
+class ParticleMesh {
+ public:
+  enum Scheme {CIC, TSC};
+
+  IdefixArray1D<real> x[3];     // cell centers
+  IdefixArray1D<real> xl[3];    // cell left interfaces
+  IdefixArray1D<real> dx[3];    // cell widths
+  int np_tot[3];
+  int beg[3];
+  int end[3];
+  Scheme scheme{CIC};
+
+  // Index of the cell which contains a point (clamped to the local grid, ghost cells included)
+  KOKKOS_INLINE_FUNCTION int FindCell(const int dir, const real xp) const {
+    int lo = 0;
+    int hi = np_tot[dir]-1;
+    while(lo < hi) {
+      const int mid = (lo+hi+1)/2;
+      if(xl[dir](mid) <= xp) {
+        lo = mid;
+      } else {
+        hi = mid-1;
+      }
+    }
+    return(lo);
+  }
+
+  // Cloud-in-cell (linear) or triangular-shaped-cloud (quadratic) weights
+  KOKKOS_INLINE_FUNCTION void GetWeights(const real xp[3], ParticleWeights &pw) const {
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      if(dir >= DIMENSIONS) {
+        pw.start[dir] = 0;
+        pw.size[dir] = 1;
+        pw.w[dir][0] = ONE_F;
+        continue;
+      }
+      int i = FindCell(dir, xp[dir]);
+      if(scheme == TSC) {
+        const real d = (xp[dir] - x[dir](i))/dx[dir](i);
+        pw.start[dir] = i-1;
+        pw.size[dir] = 3;
+        pw.w[dir][0] = HALF_F*(HALF_F-d)*(HALF_F-d);
+        pw.w[dir][1] = static_cast<real>(0.75)-d*d;
+        pw.w[dir][2] = HALF_F*(HALF_F+d)*(HALF_F+d);
+      } else {
+        if(xp[dir] < x[dir](i)) i--;
+        const real f = (xp[dir] - x[dir](i))/(x[dir](i+1) - x[dir](i));
+        pw.start[dir] = i;
+        pw.size[dir] = 2;
+        pw.w[dir][0] = ONE_F-f;
+        pw.w[dir][1] = f;
+      }
+    }
+  }
+
+  // Value of a field at the particle position
+  KOKKOS_INLINE_FUNCTION real Interpolate(const IdefixArray4D<real> &q, const int var,
+                                          const ParticleWeights &pw) const {
+    real result = ZERO_F;
+    for(int kk = 0 ; kk < pw.size[KDIR] ; kk++) {
+      const int k = pw.start[KDIR]+kk;
+      for(int jj = 0 ; jj < pw.size[JDIR] ; jj++) {
+        const int j = pw.start[JDIR]+jj;
+        const real wjk = pw.w[KDIR][kk]*pw.w[JDIR][jj];
+        for(int ii = 0 ; ii < pw.size[IDIR] ; ii++) {
+          result += wjk*pw.w[IDIR][ii]*q(var,k,j,pw.start[IDIR]+ii);
+        }
+      }
+    }
+    return(result);
+  }
+
+  // Gradient of a scalar field at the particle position (derivatives along the coordinates)
+  KOKKOS_INLINE_FUNCTION void Gradient(const IdefixArray3D<real> &phi, const ParticleWeights &pw,
+                                       real grad[3]) const {
+    for(int dir = 0 ; dir < 3 ; dir++) grad[dir] = ZERO_F;
+    for(int kk = 0 ; kk < pw.size[KDIR] ; kk++) {
+      const int k = pw.start[KDIR]+kk;
+      for(int jj = 0 ; jj < pw.size[JDIR] ; jj++) {
+        const int j = pw.start[JDIR]+jj;
+        const real wjk = pw.w[KDIR][kk]*pw.w[JDIR][jj];
+        for(int ii = 0 ; ii < pw.size[IDIR] ; ii++) {
+          const int i = pw.start[IDIR]+ii;
+          const real w = wjk*pw.w[IDIR][ii];
+          grad[IDIR] += w*(phi(k,j,i+1)-phi(k,j,i-1))/(x[IDIR](i+1)-x[IDIR](i-1));
+          #if DIMENSIONS >= 2
+          grad[JDIR] += w*(phi(k,j+1,i)-phi(k,j-1,i))/(x[JDIR](j+1)-x[JDIR](j-1));
+          #endif
+          #if DIMENSIONS == 3
+          grad[KDIR] += w*(phi(k+1,j,i)-phi(k-1,j,i))/(x[KDIR](k+1)-x[KDIR](k-1));
+          #endif
+        }
+      }
+    }
+  }
+
+  // Scale factors of the coordinates, so that dx/dt = v/h
+  KOKKOS_INLINE_FUNCTION static void Metric(const real xp[3], real h[3]) {
+    h[IDIR] = ONE_F;
+    h[JDIR] = ONE_F;
+    h[KDIR] = ONE_F;
+    #if GEOMETRY == POLAR
+      h[JDIR] = xp[IDIR];
+    #elif GEOMETRY == CYLINDRICAL
+      h[KDIR] = xp[IDIR];
+    #elif GEOMETRY == SPHERICAL
+      h[JDIR] = xp[IDIR];
+      h[KDIR] = xp[IDIR]*sin(xp[JDIR]);
+    #endif
+  }
+
+  // Fictitious accelerations due to the curvilinear coordinates
+  KOKKOS_INLINE_FUNCTION static void GeometricAcceleration(const real xp[3], const real vp[3],
+                                                           real a[3]) {
+    a[IDIR] = ZERO_F;
+    a[JDIR] = ZERO_F;
+    a[KDIR] = ZERO_F;
+    #if GEOMETRY == POLAR
+      a[IDIR] = vp[JDIR]*vp[JDIR]/xp[IDIR];
+      a[JDIR] = -vp[IDIR]*vp[JDIR]/xp[IDIR];
+    #elif GEOMETRY == CYLINDRICAL
+      a[IDIR] = vp[KDIR]*vp[KDIR]/xp[IDIR];
+      a[KDIR] = -vp[IDIR]*vp[KDIR]/xp[IDIR];
+    #elif GEOMETRY == SPHERICAL
+      const real cotth = cos(xp[JDIR])/sin(xp[JDIR]);
+      a[IDIR] = (vp[JDIR]*vp[JDIR] + vp[KDIR]*vp[KDIR])/xp[IDIR];
+      a[JDIR] = (vp[KDIR]*vp[KDIR]*cotth - vp[IDIR]*vp[JDIR])/xp[IDIR];
+      a[KDIR] = -(vp[IDIR]*vp[KDIR] + vp[JDIR]*vp[KDIR]*cotth)/xp[IDIR];
+    #endif
+  }
+};
+
+#endif // DATABLOCK_PARTICLES_PARTICLEMESH_HPP_
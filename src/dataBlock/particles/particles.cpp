@@ -0,0 +1,510 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "particles.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "gravity.hpp"
+#include "dump.hpp"
+#include "vtkParticles.hpp"
+
+Particles::Particles(Input &input, DataBlock *datain) {
+  idfx::pushRegion("Particles::Particles");
+  this->data = datain;
+
+  std::string scheme = input.GetOrSet<std::string>("Particles","interpolation",0,"tsc");
+  if(scheme.compare("cic") == 0) {
+    mesh.scheme = ParticleMesh::CIC;
+  } else if(scheme.compare("tsc") == 0) {
+    mesh.scheme = ParticleMesh::TSC;
+  } else {
+    IDEFIX_ERROR("Unknown particle interpolation scheme "+scheme+". Use either cic or tsc.");
+  }
+
+  // Species: tracers have a vanishing stopping time
+  nSpecies = std::max(input.CheckEntry("Particles","stoppingTime"), 1);
+  haveFeedback = input.GetOrSet<bool>("Particles","feedback",0, false);
+  stoppingTime = IdefixArray1D<real>("ParticlesStoppingTime", nSpecies);
+  mass = IdefixArray1D<real>("ParticlesMass", nSpecies);
+  stoppingTimeHost = Kokkos::create_mirror_view(stoppingTime);
+  massHost = Kokkos::create_mirror_view(mass);
+  for(int s = 0 ; s < nSpecies ; s++) {
+    stoppingTimeHost(s) = input.GetOrSet<real>("Particles","stoppingTime",s, ZERO_F);
+    if(haveFeedback) {
+      if(input.CheckEntry("Particles","mass") != nSpecies) {
+        IDEFIX_ERROR("[Particles]:mass should give the mass of a particle of each species");
+      }
+      massHost(s) = input.Get<real>("Particles","mass",s);
+    } else {
+      massHost(s) = ZERO_F;
+    }
+  }
+  Kokkos::deep_copy(stoppingTime, stoppingTimeHost);
+  Kokkos::deep_copy(mass, massHost);
+
+  sortPeriod = input.GetOrSet<int>("Particles","sortPeriod",0, 100);
+  if(sortPeriod < 1) {
+    IDEFIX_ERROR("[Particles]:sortPeriod should be a positive integer");
+  }
+
+  // Particles are pushed in the inertial frame, on the whole velocity
+  if(data->haveFargo) {
+    IDEFIX_ERROR("Particles are not compatible with Fargo");
+  }
+  if(data->hydro->haveRotation || data->hydro->haveShearingBox) {
+    IDEFIX_ERROR("Particles are not compatible with rotating frames and shearing boxes");
+  }
+
+  // Interpolation kernels
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    mesh.x[dir] = data->x[dir];
+    mesh.xl[dir] = data->xl[dir];
+    mesh.dx[dir] = data->dx[dir];
+    mesh.np_tot[dir] = data->np_tot[dir];
+    mesh.beg[dir] = data->beg[dir];
+    mesh.end[dir] = data->end[dir];
+  }
+
+  // Particle arrays, which grow with the number of particles
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const std::string suffix = std::to_string(dir+1);
+    x[dir] = IdefixArray1D<real>("ParticlesX"+suffix, 0);
+    v[dir] = IdefixArray1D<real>("ParticlesV"+suffix, 0);
+    xSpare[dir] = IdefixArray1D<real>("ParticlesX"+suffix, 0);
+    vSpare[dir] = IdefixArray1D<real>("ParticlesV"+suffix, 0);
+  }
+  id = IdefixArray1D<int>("ParticlesId", 0);
+  species = IdefixArray1D<int>("ParticlesSpecies", 0);
+  idSpare = IdefixArray1D<int>("ParticlesId", 0);
+  speciesSpare = IdefixArray1D<int>("ParticlesSpecies", 0);
+  flag = IdefixArray1D<int>("ParticlesFlag", 0);
+  slot = IdefixArray1D<int>("ParticlesSlot", 0);
+  sendReal = IdefixArray1D<real>("ParticlesSendReal", 0);
+  recvReal = IdefixArray1D<real>("ParticlesRecvReal", 0);
+  sendInt = IdefixArray1D<int>("ParticlesSendInt", 0);
+  recvInt = IdefixArray1D<int>("ParticlesRecvInt", 0);
+
+  const int ncells = data->np_int[IDIR]*data->np_int[JDIR]*data->np_int[KDIR];
+  cellCount = IdefixArray1D<int>("ParticlesCellCount", ncells);
+  cellStart = IdefixArray1D<int>("ParticlesCellStart", ncells);
+
+  if(haveFeedback) {
+    feedback = IdefixArray4D<real>("ParticlesFeedback", COMPONENTS, data->np_tot[KDIR],
+                                                                    data->np_tot[JDIR],
+                                                                    data->np_tot[IDIR]);
+  }
+
+  // Particles in restart dumps
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const std::string suffix = std::to_string(dir+1);
+    data->dump->RegisterVariable(&xHost[dir], "PartX"+suffix);
+    data->dump->RegisterVariable(&vHost[dir], "PartV"+suffix);
+  }
+  data->dump->RegisterVariable(&idHost, "PartId");
+  data->dump->RegisterVariable(&speciesHost, "PartSpecies");
+
+  vtk = std::make_unique<VtkParticles>(input, data, this);
+
+  idfx::popRegion();
+}
+
+Particles::~Particles() = default;
+
+void Particles::ShowConfig() {
+  int ntot = count;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &ntot, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD));
+  #endif
+  idfx::cout << "Particles: " << nSpecies << " species, using "
+             << (mesh.scheme == ParticleMesh::TSC ? "TSC" : "CIC") << " interpolation."
+             << std::endl;
+  for(int s = 0 ; s < nSpecies ; s++) {
+    if(stoppingTimeHost(s) > ZERO_F) {
+      idfx::cout << "Particles: species " << s << " are dust grains with stopping time "
+                 << stoppingTimeHost(s) << "." << std::endl;
+    } else {
+      idfx::cout << "Particles: species " << s << " are tracers." << std::endl;
+    }
+  }
+  if(haveFeedback) {
+    idfx::cout << "Particles: drag feedback on the gas is enabled." << std::endl;
+  }
+  idfx::cout << "Particles: sorted by cell every " << sortPeriod << " steps." << std::endl;
+  if(ntot > 0) {
+    idfx::cout << "Particles: " << ntot << " particles in the domain." << std::endl;
+  }
+}
+
+void Particles::Add(real x1, real x2, real x3, real v1, real v2, real v3, int s) {
+  if(s < 0 || s >= nSpecies) {
+    IDEFIX_ERROR("Particles::Add: unknown particle species");
+  }
+  const real xp[3] = {x1, x2, x3};
+  const real vp[3] = {v1, v2, v3};
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    xHost[dir].push_back(xp[dir]);
+    vHost[dir].push_back(vp[dir]);
+  }
+  idHost.push_back(-1);     // the identifier is given by SyncToDevice()
+  speciesHost.push_back(s);
+}
+
+template<typename T>
+static void CopyToDevice(const std::vector<T> &in, IdefixArray1D<T> &out) {
+  const int n = in.size();
+  auto sub = Kokkos::subview(out, std::make_pair(0, n));
+  auto host = Kokkos::create_mirror_view(sub);
+  for(int i = 0 ; i < n ; i++) {
+    host(i) = in[i];
+  }
+  Kokkos::deep_copy(sub, host);
+}
+
+template<typename T>
+static void CopyToHost(IdefixArray1D<T> &in, std::vector<T> &out, int n) {
+  auto sub = Kokkos::subview(in, std::make_pair(0, n));
+  auto host = Kokkos::create_mirror_view(sub);
+  Kokkos::deep_copy(host, sub);
+  out.resize(n);
+  for(int i = 0 ; i < n ; i++) {
+    out[i] = host(i);
+  }
+}
+
+// Replace the particles on the device by the ones on the host, which can be anywhere in the
+// domain (they are sent to the process which owns them). This should be called by all of the
+// processes, even those which have not added any particle.
+void Particles::SyncToDevice() {
+  idfx::pushRegion("Particles::SyncToDevice");
+  const int n = idHost.size();
+
+  // Give an identifier to the new particles
+  int maxId = -1;
+  int nNew = 0;
+  for(int i = 0 ; i < n ; i++) {
+    if(idHost[i] < 0) {
+      nNew++;
+    } else {
+      maxId = std::max(maxId, idHost[i]);
+    }
+  }
+  int firstNew = 0;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &maxId, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD));
+    MPI_SAFE_CALL(MPI_Exscan(&nNew, &firstNew, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD));
+    if(idfx::prank == 0) firstNew = 0;
+  #endif
+  int nextId = maxId + 1 + firstNew;
+  for(int i = 0 ; i < n ; i++) {
+    if(idHost[i] < 0) idHost[i] = nextId++;
+  }
+
+  Reserve(n);
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    CopyToDevice(xHost[dir], x[dir]);
+    CopyToDevice(vHost[dir], v[dir]);
+  }
+  CopyToDevice(idHost, id);
+  CopyToDevice(speciesHost, species);
+  count = n;
+
+  Migrate();
+  Sort();
+  idfx::popRegion();
+}
+
+void Particles::SyncToHost() {
+  idfx::pushRegion("Particles::SyncToHost");
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    CopyToHost(x[dir], xHost[dir], count);
+    CopyToHost(v[dir], vHost[dir], count);
+  }
+  CopyToHost(id, idHost, count);
+  CopyToHost(species, speciesHost, count);
+  idfx::popRegion();
+}
+
+// Make room for n particles. The arrays grow geometrically to limit the reallocations.
+void Particles::Reserve(int n) {
+  if(n <= capacity) return;
+  const int newCapacity = std::max(n, 2*capacity);
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    Kokkos::resize(x[dir], newCapacity);
+    Kokkos::resize(v[dir], newCapacity);
+    Kokkos::realloc(xSpare[dir], newCapacity);
+    Kokkos::realloc(vSpare[dir], newCapacity);
+  }
+  Kokkos::resize(id, newCapacity);
+  Kokkos::resize(species, newCapacity);
+  Kokkos::realloc(idSpare, newCapacity);
+  Kokkos::realloc(speciesSpare, newCapacity);
+  Kokkos::realloc(flag, newCapacity);
+  Kokkos::realloc(slot, newCapacity);
+  capacity = newCapacity;
+}
+
+// Move the particles flagged as kept to their new position dest, the others being dropped.
+// The particles are written in the spare arrays, which then become the particle arrays.
+void Particles::Move(IdefixArray1D<int> dest, int newCount) {
+  auto flag = this->flag;
+  auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+  auto v1 = v[IDIR], v2 = v[JDIR], v3 = v[KDIR];
+  auto x1s = xSpare[IDIR], x2s = xSpare[JDIR], x3s = xSpare[KDIR];
+  auto v1s = vSpare[IDIR], v2s = vSpare[JDIR], v3s = vSpare[KDIR];
+  auto id = this->id, species = this->species;
+  auto ids = this->idSpare, speciess = this->speciesSpare;
+
+  idefix_for("Particles::Move", 0, count,
+    KOKKOS_LAMBDA (int p) {
+      if(flag(p) == 0) {
+        const int q = dest(p);
+        x1s(q) = x1(p);
+        x2s(q) = x2(p);
+        x3s(q) = x3(p);
+        v1s(q) = v1(p);
+        v2s(q) = v2(p);
+        v3s(q) = v3(p);
+        ids(q) = id(p);
+        speciess(q) = species(p);
+      }
+    });
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    std::swap(x[dir], xSpare[dir]);
+    std::swap(v[dir], vSpare[dir]);
+  }
+  std::swap(this->id, idSpare);
+  std::swap(this->species, speciesSpare);
+  count = newCount;
+}
+
+// Counting sort of the particles by cell, so that the particles which interpolate from
+// (and deposit to) the same cells are contiguous in memory
+void Particles::Sort() {
+  idfx::pushRegion("Particles::Sort");
+  const int ncells = cellCount.extent(0);
+  auto cellCount = this->cellCount;
+  auto cellStart = this->cellStart;
+  auto flag = this->flag;
+  auto slot = this->slot;
+  auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+  auto mesh = this->mesh;
+  const int ni = data->np_int[IDIR];
+  const int nj = data->np_int[JDIR];
+
+  Kokkos::deep_copy(cellCount, 0);
+  idefix_for("Particles::CountCells", 0, count,
+    KOKKOS_LAMBDA (int p) {
+      int idx[3];
+      const real xp[3] = {x1(p), x2(p), x3(p)};
+      for(int dir = 0 ; dir < 3 ; dir++) {
+        idx[dir] = mesh.FindCell(dir, xp[dir]);
+        if(idx[dir] < mesh.beg[dir]) idx[dir] = mesh.beg[dir];
+        if(idx[dir] >= mesh.end[dir]) idx[dir] = mesh.end[dir]-1;
+        idx[dir] -= mesh.beg[dir];
+      }
+      const int cell = (idx[KDIR]*nj + idx[JDIR])*ni + idx[IDIR];
+      flag(p) = cell;
+      slot(p) = Kokkos::atomic_fetch_add(&cellCount(cell), 1);
+    });
+
+  Kokkos::parallel_scan("Particles::CellStart", ncells,
+    KOKKOS_LAMBDA (const int c, int &start, const bool final) {
+      if(final) cellStart(c) = start;
+      start += cellCount(c);
+    });
+
+  idefix_for("Particles::SortSlots", 0, count,
+    KOKKOS_LAMBDA (int p) {
+      slot(p) += cellStart(flag(p));
+      flag(p) = 0;
+    });
+  Move(slot, count);
+  idfx::popRegion();
+}
+
+void Particles::Evolve(const real t, const real dt) {
+  idfx::pushRegion("Particles::Evolve");
+
+  const bool haveGravity = data->haveGravity;
+  bool havePotential = false;
+  bool haveBodyForce = false;
+  IdefixArray3D<real> phiP;
+  IdefixArray4D<real> bodyForce;
+  if(haveGravity) {
+    // The gravitational field is otherwise the one computed during the previous step
+    if(firstStep) data->gravity->ComputeGravity(0);
+    havePotential = data->gravity->havePotential;
+    haveBodyForce = data->gravity->haveBodyForce;
+    phiP = data->gravity->phiP;
+    bodyForce = data->gravity->bodyForceVector;
+  }
+  firstStep = false;
+
+  auto Vc = data->hydro->Vc;
+  auto mesh = this->mesh;
+  auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+  auto v1 = v[IDIR], v2 = v[JDIR], v3 = v[KDIR];
+  auto species = this->species;
+  auto stoppingTime = this->stoppingTime;
+  auto mass = this->mass;
+  auto feedback = this->feedback;
+  const bool haveFeedback = this->haveFeedback;
+
+  idefix_for("Particles::Evolve", 0, count,
+    KOKKOS_LAMBDA (int p) {
+      real xp[3] = {x1(p), x2(p), x3(p)};
+      real vp[3] = {v1(p), v2(p), v3(p)};
+      const int s = species(p);
+      const real tau = stoppingTime(s);
+
+      ParticleWeights pw;
+      mesh.GetWeights(xp, pw);
+      real u[3] = {ZERO_F, ZERO_F, ZERO_F};
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        u[n] = mesh.Interpolate(Vc, VX1+n, pw);
+      }
+      real h[3];
+      ParticleMesh::Metric(xp, h);
+
+      if(tau <= ZERO_F) {
+        // Tracer: midpoint rule along the gas velocity
+        real xm[3];
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          xm[dir] = xp[dir] + HALF_F*dt*u[dir]/h[dir];
+        }
+        mesh.GetWeights(xm, pw);
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          u[n] = mesh.Interpolate(Vc, VX1+n, pw);
+        }
+        ParticleMesh::Metric(xm, h);
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          xp[dir] += dt*u[dir]/h[dir];
+          vp[dir] = u[dir];
+        }
+      } else {
+        // Dust grain: the drag is integrated exactly for a constant gas velocity and
+        // acceleration, so that stiff (small stopping time) grains are stable
+        real g[3];
+        ParticleMesh::GeometricAcceleration(xp, vp, g);
+        if(havePotential) {
+          real grad[3];
+          mesh.Gradient(phiP, pw, grad);
+          for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+            g[dir] -= grad[dir]/h[dir];
+          }
+        }
+        if(haveBodyForce) {
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            g[n] += mesh.Interpolate(bodyForce, n, pw);
+          }
+        }
+        const real decay = exp(-dt/tau);
+        real vn[3];
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          vn[dir] = u[dir] + g[dir]*tau + (vp[dir] - u[dir] - g[dir]*tau)*decay;
+          xp[dir] += HALF_F*dt*(vp[dir]+vn[dir])/h[dir];
+        }
+        if(haveFeedback) {
+          // Momentum given to the gas by the drag force during the step
+          const real m = mass(s);
+          real dp[3];
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            dp[n] = -m*(vn[n] - vp[n] - g[n]*dt);
+          }
+          for(int kk = 0 ; kk < pw.size[KDIR] ; kk++) {
+            const int k = pw.start[KDIR]+kk;
+            for(int jj = 0 ; jj < pw.size[JDIR] ; jj++) {
+              const int j = pw.start[JDIR]+jj;
+              for(int ii = 0 ; ii < pw.size[IDIR] ; ii++) {
+                const int i = pw.start[IDIR]+ii;
+                const real w = pw.w[KDIR][kk]*pw.w[JDIR][jj]*pw.w[IDIR][ii];
+                for(int n = 0 ; n < COMPONENTS ; n++) {
+                  Kokkos::atomic_add(&feedback(n,k,j,i), w*dp[n]);
+                }
+              }
+            }
+          }
+        }
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          vp[dir] = vn[dir];
+        }
+      }
+      x1(p) = xp[IDIR];
+      x2(p) = xp[JDIR];
+      x3(p) = xp[KDIR];
+      v1(p) = vp[IDIR];
+      v2(p) = vp[JDIR];
+      v3(p) = vp[KDIR];
+    });
+
+  if(haveFeedback) {
+    ApplyFeedback();
+  }
+
+  Migrate();
+
+  nsteps++;
+  if(nsteps % sortPeriod == 0) Sort();
+
+  idfx::popRegion();
+}
+
+// Give the momentum deposited by the particles to the gas, at constant density and pressure
+void Particles::ApplyFeedback() {
+  idfx::pushRegion("Particles::ApplyFeedback");
+  FoldFeedback();
+
+  auto Vc = data->hydro->Vc;
+  auto dV = data->dV;
+  auto feedback = this->feedback;
+  idefix_for("Particles::ApplyFeedback",
+    data->beg[KDIR], data->end[KDIR],
+    data->beg[JDIR], data->end[JDIR],
+    data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real dm = Vc(RHO,k,j,i)*dV(k,j,i);
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        Vc(VX1+n,k,j,i) += feedback(n,k,j,i)/dm;
+      }
+    });
+  Kokkos::deep_copy(feedback, ZERO_F);
+
+  // The ghost cells have to be consistent with the new velocities
+  data->SetBoundaries();
+  idfx::popRegion();
+}
+
+// Particles should not cross more than one cell per step
+real Particles::ComputeTimestep() {
+  auto mesh = this->mesh;
+  auto x1 = x[IDIR], x2 = x[JDIR], x3 = x[KDIR];
+  auto v1 = v[IDIR], v2 = v[JDIR], v3 = v[KDIR];
+  real dt = 1.0e30;
+  if(count == 0) return(dt);
+  idefix_reduce("Particles::Timestep", 0, count,
+    KOKKOS_LAMBDA (int p, real &dtmin) {
+      const real xp[3] = {x1(p), x2(p), x3(p)};
+      const real vp[3] = {v1(p), v2(p), v3(p)};
+      real h[3];
+      ParticleMesh::Metric(xp, h);
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        const int i = mesh.FindCell(dir, xp[dir]);
+        const real speed = std::fabs(vp[dir]);
+        if(speed > ZERO_F) dtmin = FMIN(h[dir]*mesh.dx[dir](i)/speed, dtmin);
+      }
+    },
+    Kokkos::Min<real>(dt));
+  return(dt);
+}
+
+void Particles::WriteVtk() {
+  vtk->Write();
+}
@@ -0,0 +1,109 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_PARTICLES_PARTICLES_HPP_
+#define DATABLOCK_PARTICLES_PARTICLES_HPP_
+
+#include <array>
+#include <memory>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "particleMesh.hpp"
+
+// forward class declaration
+class DataBlock;
+class VtkParticles;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Lagrangian particles, either tracers following the gas or dust grains coupled to the gas by
+/// a drag force. Particles are stored on the device as a structure of arrays, and each process
+/// holds the particles which are located in its own sub-domain. Particle coordinates are the
+/// coordinates of the grid, while particle velocities are the physical components of the
+/// velocity, as in Vc.
+/// Particles are created on the host with Add(), and sent to the device with SyncToDevice().
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class Particles {
+ public:
+  Particles(Input &, DataBlock *);
+  ~Particles();
+
+  void ShowConfig();                  ///< Show the particle configuration
+  void Evolve(const real, const real);  ///< Push the particles from t to t+dt
+  real ComputeTimestep();             ///< Timestep for particles not to cross more than a cell
+
+  // Host side of the particles, used to initialise them and by dump I/Os
+  void Add(real, real, real, real, real, real, int species = 0); ///< add a particle on the host
+  void SyncToDevice();                ///< Replace the particles by the ones on the host
+  void SyncToHost();                  ///< Copy the particles back to the host
+
+  void WriteVtk();                    ///< Write a vtk file of the particles
+
+  int count{0};                       ///< number of particles held by this process
+  int nSpecies{0};                    ///< number of particle species
+
+  // Particle arrays on the device (only the count first elements are meaningful)
+  std::array<IdefixArray1D<real>,3> x;  ///< particle coordinates
+  std::array<IdefixArray1D<real>,3> v;  ///< particle velocities
+  IdefixArray1D<int> id;                ///< particle unique identifier
+  IdefixArray1D<int> species;           ///< particle species
+
+  // Host copies, filled by SyncToHost()
+  std::array<std::vector<real>,3> xHost;
+  std::array<std::vector<real>,3> vHost;
+  std::vector<int> idHost;
+  std::vector<int> speciesHost;
+
+ private:
+  friend class VtkParticles;
+
+  void Reserve(int);                  ///< make room for a given number of particles
+  void Migrate();                     ///< send the particles to the process which owns them
+  int MigrateDir(int);                ///< exchange the particles which left in a direction
+  int Enumerate(int, int);            ///< give a slot to the particles with a given flag
+  void Move(IdefixArray1D<int>, int); ///< move the kept particles to their new position
+  void Sort();                        ///< sort the particles by cell
+  void ApplyFeedback();               ///< give the drag back-reaction to the gas
+  void FoldFeedback();                ///< add the ghost cells of feedback to their owner
+
+  DataBlock *data;
+  ParticleMesh mesh;
+
+  int capacity{0};                    ///< allocated size of the particle arrays
+  int sortPeriod;                     ///< # of steps between two sorts by cell
+  int64_t nsteps{0};
+  bool haveFeedback{false};
+  bool firstStep{true};
+
+  IdefixArray1D<real> stoppingTime;   ///< stopping time of each species (<=0 for tracers)
+  IdefixArray1D<real> mass;           ///< mass of one particle of each species
+  IdefixHostArray1D<real> stoppingTimeHost;
+  IdefixHostArray1D<real> massHost;
+
+  // Spare arrays used to reorder the particles
+  std::array<IdefixArray1D<real>,3> xSpare;
+  std::array<IdefixArray1D<real>,3> vSpare;
+  IdefixArray1D<int> idSpare;
+  IdefixArray1D<int> speciesSpare;
+  IdefixArray1D<int> flag;            ///< status of each particle during a migration
+  IdefixArray1D<int> slot;            ///< new position of each particle
+
+  // Momentum given to the gas by the particles during a step
+  IdefixArray4D<real> feedback;
+
+  // Migration buffers
+  IdefixArray1D<real> sendReal, recvReal;
+  IdefixArray1D<int> sendInt, recvInt;
+
+  // Counting sort by cell
+  IdefixArray1D<int> cellCount;
+  IdefixArray1D<int> cellStart;
+
+  std::unique_ptr<VtkParticles> vtk;
+};
+
+#endif // DATABLOCK_PARTICLES_PARTICLES_HPP_
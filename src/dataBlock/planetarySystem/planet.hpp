@@ -51,6 +51,7 @@ class Planet {
 
  protected:
     friend class PlanetarySystem;
+    Point accelFromForce() const;
     DataBlock *data;
     PointSpeed state;
 
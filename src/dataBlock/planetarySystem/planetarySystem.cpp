@@ -14,6 +14,11 @@
 #include "fluid.hpp"
 #include "gravity.hpp"
 
+// Parameters of each planet, as stored in planetParams
+enum {PX=0, PY, PZ, PQ, PDIST, PSMOOTH, PHILL, PNPARAM};
+
+// Components of the force on each planet: f_inner, f_ex_inner, f_outer and f_ex_outer
+constexpr int nForceComponents = 12;
 
 PlanetarySystem::PlanetarySystem(Input &input, DataBlock *datain) {
   idfx::pushRegion("PlanetarySystem::Init");
@@ -79,6 +84,8 @@ indirect term, with multiple planets that don't feel each others.");
     for(int ip = 0 ; ip < this->nbp ; ip++) {
       this->planet[ip].RegisterInDump();
     }
+    this->planetParams = IdefixArray2D<real>("PlanetParams", this->nbp, PNPARAM);
+    this->planetParamsHost = Kokkos::create_mirror_view(this->planetParams);
   } else {
     IDEFIX_ERROR("need to define a planet-to-primary mass ratio via planetToPrimary");
   }
@@ -170,21 +177,16 @@ void PlanetarySystem::EvolveSystem(DataBlock& data, const real& dt) {
 
 void PlanetarySystem::AdvancePlanetFromDisk(DataBlock& data, const real& dt) {
   idfx::pushRegion("PlanetarySystem::AdvancePlanetFromDisk");
+  std::vector<int> activePlanets;
   for(int ip=0; ip< this->nbp ; ip++) {
-    if (!(planet[ip].m_isActive)) continue;
-    Point gamma;
-    bool isp = true;
+    if (planet[ip].m_isActive) activePlanets.push_back(ip);
+  }
 
-    real qp = planet[ip].m_qp;
-    real xp = planet[ip].m_xp;
-    real yp = planet[ip].m_yp;
-    real zp = planet[ip].m_zp;
-    real vxp = planet[ip].m_vxp;
-    real vyp = planet[ip].m_vyp;
-    real vzp = planet[ip].m_vzp;
-    real r = sqrt(xp*xp + yp*yp + zp*zp);
+  // Forces on all the planets at once
+  ComputeForces(data, activePlanets);
 
-    gamma = planet[ip].computeAccel (data, isp);
+  for(int ip : activePlanets) {
+    Point gamma = planet[ip].accelFromForce();
 
     planet[ip].m_vxp += dt * gamma.x*this->torqueNormalization;
     planet[ip].m_vyp += dt * gamma.y*this->torqueNormalization;
@@ -193,6 +195,197 @@ void PlanetarySystem::AdvancePlanetFromDisk(DataBlock& data, const real& dt) {
   idfx::popRegion();
 }
 
+// Disk force on several planets, reduced in a single traversal of the grid.
+// The reduction result is an array holding nForceComponents values per planet.
+struct PlanetForceReducer {
+  using value_type = real[];
+  const unsigned value_count;
+
+  int nPlanets;
+  IdefixArray2D<real> params;
+  IdefixArray1D<real> x1, x2, x3;
+  IdefixArray4D<real> Vc;
+  IdefixArray3D<real> dV;
+  PlanetarySystem::SmoothingFunction smoothingFunction;
+  bool excludeHill;
+
+  PlanetForceReducer(DataBlock &data, IdefixArray2D<real> params, int nPlanets,
+                     PlanetarySystem::SmoothingFunction smoothingFunction, bool excludeHill):
+                      value_count(nForceComponents*nPlanets),
+                      nPlanets(nPlanets),
+                      params(params),
+                      x1(data.x[IDIR]),
+                      x2(data.x[JDIR]),
+                      x3(data.x[KDIR]),
+                      Vc(data.hydro->Vc),
+                      dV(data.dV),
+                      smoothingFunction(smoothingFunction),
+                      excludeHill(excludeHill) {}
+
+  KOKKOS_INLINE_FUNCTION void init(value_type force) const {
+    for(unsigned n = 0 ; n < value_count ; n++) force[n] = ZERO_F;
+  }
+
+  KOKKOS_INLINE_FUNCTION void join(value_type dst, const value_type src) const {
+    for(unsigned n = 0 ; n < value_count ; n++) dst[n] += src[n];
+  }
+
+  KOKKOS_INLINE_FUNCTION void operator()(const int k, const int j, const int i,
+                                         value_type force) const {
+    real cellMass = dV(k,j,i)*Vc(RHO,k,j,i);
+    real xc, yc, zc;
+    #if GEOMETRY == CARTESIAN
+      xc = x1(i);
+      yc = x2(j);
+      zc = x3(k);
+    #elif GEOMETRY == POLAR
+      xc = x1(i)*cos(x2(j));
+      yc = x1(i)*sin(x2(j));
+      zc = x3(k);
+    #elif GEOMETRY == SPHERICAL
+      xc = x1(i)*sin(x2(j))*cos(x3(k));
+      yc = x1(i)*sin(x2(j))*sin(x3(k));
+      zc = x1(i)*cos(x2(j));
+    #endif
+    real distc = sqrt(xc*xc+yc*yc+zc*zc);
+
+    for(int ip = 0 ; ip < nPlanets ; ip++) {
+      const real xp = params(ip,PX);
+      const real yp = params(ip,PY);
+      const real zp = params(ip,PZ);
+      const real smoothing = params(ip,PSMOOTH);
+      const real rh = params(ip,PHILL);
+
+      real dist2 = ((xc-xp)*(xc-xp) + (yc-yp)*(yc-yp) + (zc-zp)*(zc-zp));
+      real hillcut = ONE_F;
+
+      if(excludeHill) {
+        real squaredist2 = sqrt(dist2);
+        if (squaredist2/rh < 0.5) {
+          hillcut = ZERO_F;
+        } else {
+          if (squaredist2 > rh) {
+            hillcut = ONE_F;
+          } else {
+            hillcut = pow(sin((squaredist2/rh-.5)*M_PI),2.);
+          }
+        }
+      }
+
+      real forceCell = ZERO_F;
+      switch(smoothingFunction) {
+        case PlanetarySystem::SmoothingFunction::PLUMMER:
+          {
+            dist2 += smoothing*smoothing;
+            real distance = sqrt(dist2);
+            real InvDist3 = ONE_F/(dist2*distance);
+            forceCell = cellMass * InvDist3;
+            break;
+          }
+        case PlanetarySystem::SmoothingFunction::POLYNOMIAL:
+          {
+            real rmrp = sqrt(dist2);
+            if (rmrp/smoothing < 1) {
+              forceCell = -cellMass*(3.0*rmrp/smoothing - 4.0)/smoothing/smoothing/smoothing;
+            } else {
+              forceCell = cellMass/rmrp/rmrp/rmrp;
+            }
+            break;
+          }
+        default: // do nothing
+          break;
+      }
+
+      // inner (0-5) or outer (6-11) force, with and without the Hill sphere
+      real *f = force + nForceComponents*ip + (distc < params(ip,PDIST) ? 0 : 6);
+      f[0] += (xc-xp)*forceCell;
+      f[1] += (yc-yp)*forceCell;
+      f[2] += (zc-zp)*forceCell;
+      if(excludeHill) {
+        f[3] += (xc-xp)*forceCell*hillcut;
+        f[4] += (yc-yp)*forceCell*hillcut;
+        f[5] += (zc-zp)*forceCell*hillcut;
+      }
+    }
+  }
+};
+
+/*
+Be careful: you need to substract
+the azimuthally averaged density
+prior to the torque evaluation (BM08 trick)
+*/
+void PlanetarySystem::ComputeForces(DataBlock& data, const std::vector<int>& planetList,
+                                    bool isPlanet) {
+  idfx::pushRegion("PlanetarySystem::ComputeForces");
+  // since we cannot throw an error in kokkos kernel, with throw this one before the kernel.
+  #if GEOMETRY == CYLINDRICAL
+    IDEFIX_ERROR("Planet::ComputeForce is not compatible with the GEOMETRY you intend to use");
+  #endif
+
+  const int nPlanets = planetList.size();
+  if(nPlanets == 0) {
+    idfx::popRegion();
+    return;
+  }
+
+  for(int n = 0 ; n < nPlanets ; n++) {
+    const Planet &p = this->planet[planetList[n]];
+    real xp = ZERO_F;
+    real yp = ZERO_F;
+    real zp = ZERO_F;
+    real qp = ZERO_F;
+    if(isPlanet) {
+      xp = p.m_xp;
+      yp = p.m_yp;
+      zp = p.m_zp;
+      qp = p.m_qp;
+    }
+    real distPlanet = sqrt(xp*xp+yp*yp+zp*zp);
+    planetParamsHost(n,PX) = xp;
+    planetParamsHost(n,PY) = yp;
+    planetParamsHost(n,PZ) = zp;
+    planetParamsHost(n,PQ) = qp;
+    planetParamsHost(n,PDIST) = distPlanet;
+    planetParamsHost(n,PSMOOTH) = smoothingValue * pow(distPlanet,ONE_F+smoothingExponent);
+    planetParamsHost(n,PHILL) = pow(qp/3., 1./3.)*distPlanet;
+  }
+  Kokkos::deep_copy(planetParams, planetParamsHost);
+
+  std::vector<real> force(nForceComponents*nPlanets);
+  Kokkos::parallel_reduce("ComputeForces",
+    Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+    ({data.beg[KDIR],data.beg[JDIR],data.beg[IDIR]},
+      {data.end[KDIR], data.end[JDIR], data.end[IDIR]}),
+    PlanetForceReducer(data, planetParams, nPlanets, myPlanetarySmoothing, excludeHill),
+    force.data());
+
+  if(halfdisk) {
+    // Cancel vertical component and multiply by 2 the remaining components
+    for(int n = 0 ; n < force.size() ; n++) {
+      force[n] = (n%3 == 2) ? ZERO_F : 2*force[n];
+    }
+  }
+
+  #ifdef WITH_MPI
+    // A single reduction for all the planets
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, force.data(), force.size(), realMPI, MPI_SUM,
+                                MPI_COMM_WORLD));
+  #endif
+
+  for(int n = 0 ; n < nPlanets ; n++) {
+    Force &f = this->planet[planetList[n]].m_force;
+    const real *fp = force.data() + nForceComponents*n;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      f.f_inner[dir] = fp[dir];
+      f.f_ex_inner[dir] = fp[3+dir];
+      f.f_outer[dir] = fp[6+dir];
+      f.f_ex_outer[dir] = fp[9+dir];
+    }
+  }
+  idfx::popRegion();
+}
+
 void PlanetarySystem::IntegratePlanets(DataBlock& data, const real& dt) {
     switch(this->myPlanetaryIntegrator) {
         case ANALYTICAL:
@@ -421,7 +614,10 @@ void PlanetarySystem::AddPlanetsPotential(IdefixArray3D<real> &phiP, real t) {
   IdefixArray1D<real> x1 = this->data->x[IDIR];
   IdefixArray1D<real> x2 = this->data->x[JDIR];
   IdefixArray1D<real> x3 = this->data->x[KDIR];
+  IdefixArray2D<real> params = this->planetParams;
 
+  // Gather the active planets, so that their potentials are added in a single pass
+  int nPlanets = 0;
   for(Planet& p : this->planet) {
     // update mass according to mass taper
     p.updateMp(t);
@@ -430,34 +626,55 @@ void PlanetarySystem::AddPlanetsPotential(IdefixArray3D<real> &phiP, real t) {
     bool isActive = p.getIsActive();
     if (!(isActive)) continue;
 
-    real qp = p.getMp();
     real xp = p.getXp();
     real yp = p.getYp();
     real zp = p.getZp();
-
     real distPlanet = sqrt(xp*xp+yp*yp+zp*zp);
-    real smoothing = smoothingValue * pow(distPlanet,1.0+smoothingExponent);
-    real Mcentral = this->data->gravity->centralMass;
-
-    idefix_for("PlanetPotential",
-      0,this->data->np_tot[KDIR],
-      0, this->data->np_tot[JDIR],
-      0, this->data->np_tot[IDIR],
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          real xc, yc, zc;
-          #if GEOMETRY == CARTESIAN
-            xc = x1(i);
-            yc = x2(j);
-            zc = x3(k);
-          #elif GEOMETRY == POLAR
-            xc = x1(i)*cos(x2(j));
-            yc = x1(i)*sin(x2(j));
-            zc = x3(k);
-          #elif GEOMETRY == SPHERICAL
-            xc = x1(i)*sin(x2(j))*cos(x3(k));
-            yc = x1(i)*sin(x2(j))*sin(x3(k));
-            zc = x1(i)*cos(x2(j));
-          #endif
+
+    planetParamsHost(nPlanets,PX) = xp;
+    planetParamsHost(nPlanets,PY) = yp;
+    planetParamsHost(nPlanets,PZ) = zp;
+    planetParamsHost(nPlanets,PQ) = p.getMp();
+    planetParamsHost(nPlanets,PDIST) = distPlanet;
+    planetParamsHost(nPlanets,PSMOOTH) = smoothingValue * pow(distPlanet,1.0+smoothingExponent);
+    nPlanets++;
+  }
+  if(nPlanets == 0) {
+    idfx::popRegion();
+    return;
+  }
+  Kokkos::deep_copy(planetParams, planetParamsHost);
+
+  real Mcentral = this->data->gravity->centralMass;
+
+  idefix_for("PlanetPotential",
+    0,this->data->np_tot[KDIR],
+    0, this->data->np_tot[JDIR],
+    0, this->data->np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real xc, yc, zc;
+        #if GEOMETRY == CARTESIAN
+          xc = x1(i);
+          yc = x2(j);
+          zc = x3(k);
+        #elif GEOMETRY == POLAR
+          xc = x1(i)*cos(x2(j));
+          yc = x1(i)*sin(x2(j));
+          zc = x3(k);
+        #elif GEOMETRY == SPHERICAL
+          xc = x1(i)*sin(x2(j))*cos(x3(k));
+          yc = x1(i)*sin(x2(j))*sin(x3(k));
+          zc = x1(i)*cos(x2(j));
+        #endif
+
+      real phi = phiP(k,j,i);
+      for(int ip = 0 ; ip < nPlanets ; ip++) {
+        const real xp = params(ip,PX);
+        const real yp = params(ip,PY);
+        const real zp = params(ip,PZ);
+        const real qp = params(ip,PQ);
+        const real distPlanet = params(ip,PDIST);
+        const real smoothing = params(ip,PSMOOTH);
 
         real dist = ((xc-xp)*(xc-xp)+
                     (yc-yp)*(yc-yp)+
@@ -467,18 +684,18 @@ void PlanetarySystem::AddPlanetsPotential(IdefixArray3D<real> &phiP, real t) {
         switch(myPlanetarySmoothing) {
             case PLUMMER:
               {
-                phiP(k,j,i) += -Mcentral*qp/sqrt(dist+smoothing*smoothing);
+                phi += -Mcentral*qp/sqrt(dist+smoothing*smoothing);
                 break;
               }
             case POLYNOMIAL:
               {
                 real rmrp = sqrt(dist);
                 if (rmrp/smoothing < 1) {
-                  phiP(k,j,i) += -(Mcentral*qp/rmrp)*(pow(rmrp/smoothing,4.0) -
-                                                     2.0*pow(rmrp/smoothing,3.0)+
-                                                     2.0*rmrp/smoothing);
+                  phi += -(Mcentral*qp/rmrp)*(pow(rmrp/smoothing,4.0) -
+                                             2.0*pow(rmrp/smoothing,3.0)+
+                                             2.0*rmrp/smoothing);
                 } else {
-                  phiP(k,j,i) += -(Mcentral*qp/rmrp);
+                  phi += -(Mcentral*qp/rmrp);
                 }
                 break;
               }
@@ -487,10 +704,11 @@ void PlanetarySystem::AddPlanetsPotential(IdefixArray3D<real> &phiP, real t) {
         }
         // indirect term due to planet
         if (indirectPlanetsTerm) {
-          phiP(k,j,i) += Mcentral*qp*(xc*xp+yc*yp+zc*zp)/(distPlanet*distPlanet*distPlanet);
+          phi += Mcentral*qp*(xc*xp+yc*yp+zc*zp)/(distPlanet*distPlanet*distPlanet);
         }
-    });
-  }
+      }
+      phiP(k,j,i) = phi;
+  });
 
   idfx::popRegion();
 }
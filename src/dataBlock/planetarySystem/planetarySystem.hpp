@@ -37,6 +37,8 @@ class PlanetarySystem {
     void IntegrateRK5(DataBlock&, const real&);
     void ShowConfig();
     void AddPlanetsPotential(IdefixArray3D<real> &, real);
+    // Compute the disk forces on the listed planets in a single pass over the grid
+    void ComputeForces(DataBlock&, const std::vector<int>&, bool = true);
     std::vector<PointSpeed> ComputeRHS(real&, std::vector<Planet>);
 
     // number of planets
@@ -61,6 +63,10 @@ class PlanetarySystem {
     Integrator myPlanetaryIntegrator;
     SmoothingFunction myPlanetarySmoothing;
     DataBlock *data;
+
+    // Planet parameters used by the fused force and potential kernels
+    IdefixArray2D<real> planetParams;
+    IdefixArray2D<real>::HostMirror planetParamsHost;
 };
 
 #endif // DATABLOCK_PLANETARYSYSTEM_PLANETARYSYSTEM_HPP_
@@ -0,0 +1,149 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#if __has_include(<filesystem>)
+  #include <filesystem> // NOLINT [build/c++17]
+  namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+  #include <experimental/filesystem>
+  namespace fs = std::experimental::filesystem;
+#else
+  error "Missing the <filesystem> header."
+#endif
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ensemble.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+static std::string StatusOf(int returnCode) {
+  if(returnCode > 0) return("aborted");
+  if(returnCode < 0) return("interrupted");
+  return("completed");
+}
+
+Ensemble::Ensemble(Input &input) : input(input) {
+  if(!input.CheckBlock("Ensemble")) return;
+  idfx::pushRegion("Ensemble::Ensemble");
+
+  this->nmembers = input.CheckEntry("Ensemble","members");
+  if(nmembers < 1) {
+    IDEFIX_ERROR("[Ensemble] requires a members entry, with the name of each member");
+  }
+  for(int m = 0 ; m < nmembers ; m++) {
+    std::string name = input.Get<std::string>("Ensemble","members",m);
+    for(auto const &other : members) {
+      if(other == name) IDEFIX_ERROR("[Ensemble]: member "+name+" is defined twice");
+    }
+    members.push_back(name);
+  }
+
+  for(auto const &entry : input.GetEntries("Ensemble")) {
+    if(entry == "members") continue;
+    // Entry names are Block:entry or Block:entry:n
+    std::vector<std::string> fields;
+    std::stringstream stream(entry);
+    std::string field;
+    while(std::getline(stream, field, ':')) fields.push_back(field);
+    if(fields.size() < 2 || fields.size() > 3 || fields[0].empty() || fields[1].empty()) {
+      IDEFIX_ERROR("[Ensemble]: "+entry+" should be written Block:entry or Block:entry:n");
+    }
+    if(input.CheckEntry("Ensemble", entry) != nmembers) {
+      std::stringstream msg;
+      msg << "[Ensemble]: " << entry << " should have one value per member (" << nmembers
+          << " values).";
+      IDEFIX_ERROR(msg);
+    }
+    Override param;
+    param.block = fields[0];
+    param.entry = fields[1];
+    param.num = 0;
+    if(fields.size() == 3) {
+      try {
+        param.num = std::stoi(fields[2]);
+      } catch(const std::exception &e) {
+        IDEFIX_ERROR("[Ensemble]: "+fields[2]+" is not a valid parameter number in "+entry);
+      }
+    }
+    for(int m = 0 ; m < nmembers ; m++) {
+      param.values.push_back(input.Get<std::string>("Ensemble", entry, m));
+    }
+    overrides.push_back(param);
+  }
+
+  this->rootDirectory = fs::current_path().string();
+  returnCodes.assign(nmembers, 0);
+  haveRun.assign(nmembers, false);
+  idfx::popRegion();
+}
+
+Input Ensemble::GetInput(int m) {
+  Input memberInput = input;
+  for(auto const &param : overrides) {
+    memberInput.Set(param.block, param.entry, param.num, param.values[m]);
+  }
+  return(memberInput);
+}
+
+void Ensemble::Enter(int m) {
+  idfx::pushRegion("Ensemble::Enter");
+  idfx::cout << "Ensemble: running member " << m+1 << "/" << nmembers << " in directory "
+             << members[m] << std::endl;
+  fs::path directory(members[m]);
+  if(idfx::prank == 0 && !fs::is_directory(directory)) {
+    try {
+      if(!fs::create_directories(directory)) {
+        IDEFIX_ERROR("Cannot create directory "+members[m]);
+      }
+    } catch(std::exception &e) {
+      IDEFIX_ERROR("Cannot create directory "+members[m]);
+    }
+  }
+  #ifdef WITH_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+  // The previous members are gone, so are their Mpi instances (and their message tags)
+  Mpi::ResetInstances();
+  #endif
+  fs::current_path(directory);
+  idfx::inputDirectory = rootDirectory;
+  idfx::cout.moveLogFile(".");
+  idfx::popRegion();
+}
+
+void Ensemble::Leave(int m, int returnCode) {
+  fs::current_path(rootDirectory);
+  idfx::inputDirectory.clear();
+  idfx::cout.moveLogFile(".", true);
+  returnCodes[m] = returnCode;
+  haveRun[m] = true;
+  idfx::cout << "Ensemble: member " << members[m] << " " << StatusOf(returnCode) << "."
+             << std::endl;
+}
+
+void Ensemble::ShowConfig() {
+  if(nmembers == 0) return;
+  idfx::cout << "Ensemble: " << nmembers << " members sharing the initialisation of the process, "
+             << "run one after the other." << std::endl;
+  for(auto const &param : overrides) {
+    idfx::cout << "Ensemble: [" << param.block << "]:" << param.entry << "(" << param.num
+               << ") =";
+    for(auto const &value : param.values) idfx::cout << " " << value;
+    idfx::cout << std::endl;
+  }
+}
+
+void Ensemble::ShowSummary() {
+  if(nmembers == 0) return;
+  idfx::cout << "Ensemble: summary of the members" << std::endl;
+  for(int m = 0 ; m < nmembers ; m++) {
+    idfx::cout << "    " << members[m] << ": "
+               << (haveRun[m] ? StatusOf(returnCodes[m]) : std::string("not run")) << std::endl;
+  }
+}
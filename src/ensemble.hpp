@@ -0,0 +1,60 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef ENSEMBLE_HPP_
+#define ENSEMBLE_HPP_
+
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+// Run several independent simulations (the members of an ensemble) in the same executable.
+// The members are listed in the [Ensemble] block of the input file, along with the parameters
+// that differ from one member to the other:
+//   [Ensemble]
+//   members        lowMass  midMass  highMass
+//   Setup:mass     1e-5     1e-4     1e-3
+//   Hydro:csiso:1  0.05     0.05     0.07
+// Each parameter is given as Block:entry (first parameter of the entry) or Block:entry:n.
+// The members are run one after the other, each in its own directory (named after the member),
+// in which its outputs, dumps and log files are written, while the relative paths of the tables
+// are still relative to the ensemble directory (see idfx::inputPath).
+// An ensemble only shares the initialisation of the process (Kokkos, MPI and the devices) between
+// its members. They are neither run concurrently nor batched in common kernels: the setups keep
+// their parameters in global variables, and the members write their outputs relative to the
+// current directory, so that a single member can be alive at a time.
+class Ensemble {
+ public:
+  explicit Ensemble(Input &);
+
+  Input GetInput(int);          ///< input parameters of a member
+  void Enter(int);              ///< move to the directory of a member
+  void Leave(int, int);         ///< back to the ensemble directory (with the member return code)
+  void ShowConfig();
+  void ShowSummary();
+
+  int nmembers{0};              ///< # of members (0 without [Ensemble] block)
+  std::vector<std::string> members;  ///< member names (also their directories)
+
+ private:
+  struct Override {
+    std::string block;
+    std::string entry;
+    int num;
+    std::vector<std::string> values;  // one value per member
+  };
+
+  Input &input;
+  std::string rootDirectory;          // directory of the ensemble (where idefix was launched)
+  std::vector<Override> overrides;
+  std::vector<int> returnCodes;       // return code of each member (unset before it runs)
+  std::vector<bool> haveRun;
+};
+
+#endif // ENSEMBLE_HPP_
@@ -16,7 +16,7 @@
 
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::HllDust(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_Dust");
 
@@ -33,6 +33,9 @@ void RiemannSolver<Phys>::HllDust(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
+  // each face reads the cell states (reused by the neighbouring faces), and writes its flux
+  // and its signal speed. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("HLL_Kernel", (2*Phys::nvar+1)*sizeof(real), 36*Phys::nvar+15);
   idefix_for("HLL_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -55,7 +58,7 @@ void RiemannSolver<Phys>::HllDust(IdefixArray4D<real> &Flux) {
 
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
 
       // 2-- Get the wave speed
 
@@ -16,7 +16,7 @@
 
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_Solver");
 
@@ -33,6 +33,9 @@ void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
   IdefixArray1D<real> dx = this->data->dx[DIR];
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+  // each face reads the cell states (reused by the neighbouring faces), and writes its flux
+  // and its signal speed. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("HLL_Kernel", (2*Phys::nvar+1)*sizeof(real), 36*Phys::nvar+15);
   idefix_for("HLL_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -57,12 +60,13 @@ void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
       real cL, cR, cmax;
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
 
       // 2-- Get the wave speed
       #if HAVE_ENERGY
-        cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
-        cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+        cL = std::sqrt(GetCellGamma(eos, vL[PRS], vL[RHO], k-koffset, j-joffset, i-ioffset)
+                       *(vL[PRS]/vL[RHO]));
+        cR = std::sqrt(GetCellGamma(eos, vR[PRS], vR[RHO], k, j, i)*(vR[PRS]/vR[RHO]));
       #else
         cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
                     +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
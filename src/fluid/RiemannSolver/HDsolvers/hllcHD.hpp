@@ -16,7 +16,7 @@
 
 // Compute Riemann fluxes from states using HLLC solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLLC_Solver");
 
@@ -32,6 +32,9 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
+  // each face reads the cell states (reused by the neighbouring faces), and writes its flux
+  // and its signal speed. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("HLLC_Kernel", (2*Phys::nvar+1)*sizeof(real), 40*Phys::nvar+30);
   idefix_for("HLLC_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -58,12 +61,13 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
       real cL, cR, cmax;
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
 
       // 2-- Get the wave speed
       #if HAVE_ENERGY
-        cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
-        cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+        cL = std::sqrt(GetCellGamma(eos, vL[PRS], vL[RHO], k-koffset, j-joffset, i-ioffset)
+                       *(vL[PRS]/vL[RHO]));
+        cR = std::sqrt(GetCellGamma(eos, vR[PRS], vR[RHO], k, j, i)*(vR[PRS]/vR[RHO]));
       #else
         cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
                     +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
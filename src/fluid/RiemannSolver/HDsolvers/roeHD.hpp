@@ -37,7 +37,7 @@
 
 // Compute Riemann fluxes from states using ROE solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::ROE_Solver");
 
@@ -53,6 +53,11 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
+  // each face reads the cell states (reused by the neighbouring faces), and writes its flux
+  // and its signal speed. The flops include the linear reconstruction of both states.
+  // The characteristic decomposition adds O(nvar^2) flops.
+  IDEFIX_KERNEL_COST("ROE_Kernel", (2*Phys::nvar+1)*sizeof(real),
+                     4*Phys::nvar*Phys::nvar+20*Phys::nvar+60);
   idefix_for("ROE_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -80,7 +85,7 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       real um[Phys::nvar];
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
 #pragma unroll
       for(int nv = 0 ; nv < Phys::nvar; nv++) {
         dv[nv] = vR[nv] - vL[nv];
@@ -89,8 +94,9 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       // --- Compute the square of the sound speed
       real a, a2, a2L, a2R;
 #if HAVE_ENERGY
-      a2L = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
-      a2R = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+      a2L = std::sqrt(GetCellGamma(eos, vL[PRS], vL[RHO], k-koffset, j-joffset, i-ioffset)
+                      *(vL[PRS]/vL[RHO]));
+      a2R = std::sqrt(GetCellGamma(eos, vR[PRS], vR[RHO], k, j, i)*(vR[PRS]/vR[RHO]));
       real h, vel2;
 #else
       a2L = HALF_F*(eos.GetWaveSpeed(k,j,i)
@@ -112,7 +118,8 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
       // Compute gamma of this interface
       // todo(glesur): check that it's not the internal energy that should be used there instead
       #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]), 0.5*(vL[RHO]+vR[RHO]));
+      real gamma = GetFaceGamma<DIR>(eos, 0.5*(vL[PRS]+vR[PRS]),
+                                      0.5*(vL[RHO]+vR[RHO]), k, j, i);
       real gamma_m1 = gamma-1;
       #endif
 
@@ -16,7 +16,7 @@
 
 // Compute Riemann fluxes from states using TVDLF solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::TVDLF_Solver");
 
@@ -34,6 +34,9 @@ void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
+  // each face reads the cell states (reused by the neighbouring faces), and writes its flux
+  // and its signal speed. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("TVDLF_Kernel", (2*Phys::nvar+1)*sizeof(real), 34*Phys::nvar+10);
   idefix_for("TVDLF_Kernel",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -59,7 +62,7 @@ void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
       real cRL, cmax;
 
       // 1-- Read primitive variables
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
 
 #pragma unroll
       for(int nv = 0 ; nv < Phys::nvar; nv++) {
@@ -68,7 +71,7 @@ void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
 
       // 2-- Get the wave speed
 #if HAVE_ENERGY
-      cRL = std::sqrt(eos.GetGamma(vRL[PRS],vRL[RHO])*(vRL[PRS]/vRL[RHO]));
+      cRL = std::sqrt(GetFaceGamma<DIR>(eos, vRL[PRS], vRL[RHO], k, j, i)*(vRL[PRS]/vRL[RHO]));
 #else
       cRL = HALF_F*(eos.GetWaveSpeed(k,j,i)
                    +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
@@ -17,7 +17,7 @@
 
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_MHD");
 
@@ -151,6 +151,9 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   }
 
 
+  // each face reads the cell states and its normal field, and writes its flux, its signal speed
+  // and its EMFs. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("CalcRiemannFlux", (2*Phys::nvar+DIMENSIONS+1)*sizeof(real), 36*Phys::nvar+40);
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -180,7 +183,7 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       c2Iso = ZERO_F;
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
       vL[BXn] = Vs(DIR,k,j,i);
       vR[BXn] = vL[BXn];
 
@@ -188,7 +191,8 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
       real gpr, b1, b2, b3, Btmag2, Bmag2;
       real xH;
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      real gamma = GetFaceGamma<DIR>(eos, 0.5*(vL[PRS]+vR[PRS]),
+                                      0.5*(vL[RHO]+vR[RHO]), k, j, i);
       gpr = gamma*vL[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
@@ -19,7 +19,7 @@
 
 // Compute Riemann fluxes from states using HLLD solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLLD_MHD");
 
@@ -144,6 +144,10 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // each face reads the cell states and its normal field, and writes its flux, its signal speed
+  // and its EMFs. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("CalcRiemannFlux", (2*Phys::nvar+DIMENSIONS+1)*sizeof(real),
+                                        50*Phys::nvar+120);
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -162,7 +166,7 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       real vL[Phys::nvar];
       real vR[Phys::nvar];
 
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
       vL[BXn] = Vs(DIR,k,j,i);
       vR[BXn] = vL[BXn];
 
@@ -183,7 +187,8 @@ void RiemannSolver<Phys>::HlldMHD(IdefixArray4D<real> &Flux) {
       // 2-- Get the wave speed
       real gpr, b1, b2, b3, Btmag2, Bmag2;
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      real gamma = GetFaceGamma<DIR>(eos, 0.5*(vL[PRS]+vR[PRS]),
+                                      0.5*(vL[RHO]+vR[RHO]), k, j, i);
       gpr = gamma*vL[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
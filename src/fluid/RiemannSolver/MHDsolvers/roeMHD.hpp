@@ -49,7 +49,7 @@
 
 // Compute Riemann fluxes from states using ROE solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::ROE_MHD");
 
@@ -172,6 +172,11 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // each face reads the cell states and its normal field, and writes its flux, its signal speed
+  // and its EMFs. The flops include the linear reconstruction of both states.
+  // The characteristic decomposition adds O(nvar^2) flops.
+  IDEFIX_KERNEL_COST("CalcRiemannFlux", (2*Phys::nvar+DIMENSIONS+1)*sizeof(real),
+                     4*Phys::nvar*Phys::nvar+20*Phys::nvar+150);
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -205,7 +210,7 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
 
 
       // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
       vL[BXn] = Vs(DIR,k,j,i);
       vR[BXn] = vL[BXn];
 
@@ -224,7 +229,8 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
         // These are actually not used, but are initialised to avoid warnings
         a2L = ONE_F;
         a2R = ONE_F;
-        real gamma = eos.GetGamma(0.5*(vL[RHO]+vR[RHO]),0.5*(vL[PRS]+vR[PRS]));
+        real gamma = GetFaceGamma<DIR>(eos, 0.5*(vL[PRS]+vR[PRS]),
+                                        0.5*(vL[RHO]+vR[RHO]), k, j, i);
       #else
         a2L = HALF_F*(eos.GetWaveSpeed(k,j,i)
                     +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
@@ -17,7 +17,7 @@
 
 // Compute Riemann fluxes from states using TVDLF solver
 template <typename Phys>
-template<const int DIR>
+template<const int DIR, bool flattening, bool regular>
 void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::TVDLF_MHD");
 
@@ -135,6 +135,9 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
+  // each face reads the cell states and its normal field, and writes its flux, its signal speed
+  // and its EMFs. The flops include the linear reconstruction of both states.
+  IDEFIX_KERNEL_COST("CalcRiemannFlux", (2*Phys::nvar+DIMENSIONS+1)*sizeof(real), 34*Phys::nvar+40);
   idefix_for("CalcRiemannFlux",
              data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
              data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
@@ -157,7 +160,7 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
       real fluxR[Phys::nvar];
 
       // Load primitive variables
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      extrapol.template ExtrapolatePrimVar<flattening, regular>(i, j, k, vL, vR);
       vL[BXn] = Vs(DIR,k,j,i);
       vR[BXn] = vL[BXn];
 #pragma unroll
@@ -174,7 +177,7 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
       c2Iso = ZERO_F;
 
 #if HAVE_ENERGY
-      real gamma = eos.GetGamma(v[PRS],v[RHO]);
+      real gamma = GetFaceGamma<DIR>(eos, v[PRS], v[RHO], k, j, i);
       gpr=gamma*v[PRS];
 #else
       c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
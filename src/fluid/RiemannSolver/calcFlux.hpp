@@ -33,19 +33,67 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
     if(haveShockFlattening) shockFlattening->FindShock();
   }
 
+  if constexpr(ExtrapolateToFaces<Phys,dir>::precompute) {
+    // Reconstruct the face states once per cell. MHD solvers also need them in the
+    // transverse ghost cells for the EMF averaging
+    int perpExtension = 0;
+    if constexpr(Phys::mhd) {
+      using EMF = ConstrainedTransport<Phys>;
+      perpExtension = 1;
+      if (hydro->emf->averaging == EMF::uct_hll
+          || hydro->emf->averaging == EMF::uct_hlld) {
+        perpExtension = data->nghost[dir];
+      }
+    }
+    if(haveShockFlattening) {
+      GetExtrapolator<dir>()->template ComputeFaceStates<true>(perpExtension);
+    } else {
+      GetExtrapolator<dir>()->template ComputeFaceStates<false>(perpExtension);
+    }
+  }
+
+  // Select the Riemann kernels of the reconstruction of this run. The shock flattening and the
+  // regularity of the grid only change the second order reconstruction, and a grid can only be
+  // regular in cartesian geometry.
+  if constexpr(ORDER == 2 && GEOMETRY == CARTESIAN) {
+    const bool regular = GetExtrapolator<dir>()->isRegularGrid;
+    if(haveShockFlattening && regular) {
+      CalcFlux<dir, true, true>(flux);
+    } else if(haveShockFlattening) {
+      CalcFlux<dir, true, false>(flux);
+    } else if(regular) {
+      CalcFlux<dir, false, true>(flux);
+    } else {
+      CalcFlux<dir, false, false>(flux);
+    }
+  } else if constexpr(ORDER == 2) {
+    if(haveShockFlattening) {
+      CalcFlux<dir, true, false>(flux);
+    } else {
+      CalcFlux<dir, false, false>(flux);
+    }
+  } else {
+    CalcFlux<dir, false, false>(flux);
+  }
+  idfx::popRegion();
+}
+
+template <typename Phys>
+template <int dir, bool flattening, bool regular>
+void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
   if constexpr(Phys::mhd) {
     switch (mySolver) {
       case TVDLF_MHD:
-        TvdlfMHD<dir>(flux);
+        TvdlfMHD<dir, flattening, regular>(flux);
         break;
       case HLL_MHD:
-        HllMHD<dir>(flux);
+        HllMHD<dir, flattening, regular>(flux);
         break;
       case HLLD_MHD:
-        HlldMHD<dir>(flux);
+        HlldMHD<dir, flattening, regular>(flux);
         break;
       case ROE_MHD:
-        RoeMHD<dir>(flux);
+        RoeMHD<dir, flattening, regular>(flux);
         break;
       default:
         break;
@@ -54,7 +102,7 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
     if constexpr(Phys::dust) {
       switch (mySolver) {
         case HLL_DUST:
-          HllDust<dir>(flux);
+          HllDust<dir, flattening, regular>(flux);
           break;
         default: // do nothing
           IDEFIX_ERROR("Internal error: Unknown solver");
@@ -64,16 +112,16 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
       // Default hydro solvers
       switch (mySolver) {
         case TVDLF:
-          TvdlfHD<dir>(flux);
+          TvdlfHD<dir, flattening, regular>(flux);
           break;
         case HLL:
-          HllHD<dir>(flux);
+          HllHD<dir, flattening, regular>(flux);
           break;
         case HLLC:
-          HllcHD<dir>(flux);
+          HllcHD<dir, flattening, regular>(flux);
           break;
         case ROE:
-          RoeHD<dir>(flux);
+          RoeHD<dir, flattening, regular>(flux);
           break;
         default: // do nothing
           IDEFIX_ERROR("Internal error: Unknown solver");
@@ -81,6 +129,5 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
       }
     }// Dust
   }
-  idfx::popRegion();
 }
 #endif // FLUID_RIEMANNSOLVER_CALCFLUX_HPP_
@@ -0,0 +1,234 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+#ifndef FLUID_RIEMANNSOLVER_CHARACTERISTICS_HPP_
+#define FLUID_RIEMANNSOLVER_CHARACTERISTICS_HPP_
+
+#include "idefix.hpp"
+
+// Left and right eigenvectors of the primitive equations along direction dir, used to
+// reconstruct the characteristic fields instead of the primitive variables.
+// The primitive variables are ordered as (rho, vn, vt, vb, [p], [Bt, Bb]), where n is the
+// direction of reconstruction and t, b the transverse directions. Components which don't
+// exist (COMPONENTS < 3) are set to zero and the normal field is not projected.
+// The MHD eigenvectors follow Stone, J. M. et al. (2008), ApJS 178, 137, appendix A,
+// with magnetic fields in units where the Alfven speed is B/sqrt(rho).
+template<typename Phys, const int dir>
+struct Characteristics {
+  static constexpr int nchar = 4 + (Phys::pressure ? 1 : 0) + (Phys::mhd ? 2 : 0);
+  static constexpr int iBt = 4 + (Phys::pressure ? 1 : 0);
+
+  // Index in Vc of the nth projected variable (>= Phys::nvar when it doesn't exist)
+  KOKKOS_FORCEINLINE_FUNCTION static constexpr int Var(const int n) {
+    if(n == 0) return(RHO);
+    if(n == 1) return(VX1+dir);
+    if(n == 2) return(dir == IDIR ? VX2 : VX1);
+    if(n == 3) return(dir == KDIR ? VX2 : VX3);
+    if(Phys::pressure && n == 4) return(PRS);
+    if(n == iBt) return(dir == IDIR ? BX2 : BX1);
+    return(dir == KDIR ? BX2 : BX3);
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static constexpr bool Exists(const int n) {
+    return(Var(n) < Phys::nvar);
+  }
+
+  // Compute the eigenvectors at state v (Phys::nvar primitive variables), a2 being the
+  // square of the sound speed. L holds the left eigenvectors in rows, R the right
+  // eigenvectors in columns, normalised so that L.R = 1.
+  KOKKOS_INLINE_FUNCTION static void GetEigenvectors(const real v[], const real a2,
+                                                     real L[nchar][nchar],
+                                                     real R[nchar][nchar]) {
+    for(int n = 0 ; n < nchar ; n++) {
+      for(int m = 0 ; m < nchar ; m++) {
+        L[n][m] = ZERO_F;
+        R[n][m] = ZERO_F;
+      }
+    }
+
+    const real rho = v[RHO];
+    const real a = std::sqrt(a2);
+    constexpr int ip = 4;   // pressure (when it exists)
+
+    if constexpr(!Phys::mhd) {
+      // Waves: u-a, (entropy), shear t, shear b, u+a
+      constexpr int nf = nchar-1;
+      R[0][0] = ONE_F;
+      R[1][0] = -a/rho;
+      R[0][nf] = ONE_F;
+      R[1][nf] = a/rho;
+      R[2][1] = ONE_F;
+      R[3][2] = ONE_F;
+      L[1][2] = ONE_F;
+      L[2][3] = ONE_F;
+      L[0][1] = -HALF_F*rho/a;
+      L[nf][1] = HALF_F*rho/a;
+      if constexpr(Phys::pressure) {
+        R[ip][0] = a2;
+        R[ip][nf] = a2;
+        R[0][3] = ONE_F;
+        L[3][0] = ONE_F;
+        L[3][ip] = -ONE_F/a2;
+        L[0][ip] = HALF_F/a2;
+        L[nf][ip] = HALF_F/a2;
+      } else {
+        L[0][0] = HALF_F;
+        L[nf][0] = HALF_F;
+      }
+    } else {
+      // Waves: fast-, alfven-, slow-, (entropy), slow+, alfven+, fast+
+      constexpr int iBb = iBt+1;
+      constexpr int ifm = 0;
+      constexpr int iam = 1;
+      constexpr int ism = 2;
+      constexpr int isp = nchar-3;
+      constexpr int iap = nchar-2;
+      constexpr int ifp = nchar-1;
+
+      const real Bn = v[BX1+dir];
+      const real Bt = Exists(iBt) ? v[Var(iBt)] : ZERO_F;
+      const real Bb = Exists(iBb) ? v[Var(iBb)] : ZERO_F;
+      const real sqrtRho = std::sqrt(rho);
+
+      // Wave speeds
+      const real cax2 = Bn*Bn/rho;
+      const real ct2 = (Bt*Bt + Bb*Bb)/rho;
+      const real c2 = a2 + cax2 + ct2;
+      const real disc = std::sqrt(FMAX(c2*c2 - 4.0*a2*cax2, ZERO_F));
+      const real cf2 = HALF_F*(c2 + disc);
+      const real cs2 = a2*cax2/cf2;
+      const real cf = std::sqrt(cf2);
+      const real cs = std::sqrt(cs2);
+
+      // Normalisation of the fast and slow eigenvectors, handling the degeneracies
+      real alphaF, alphaS;
+      if(cf2 - cs2 <= 1e-12*cf2) {
+        alphaF = ONE_F;
+        alphaS = ZERO_F;
+      } else {
+        alphaF = std::sqrt(FMAX(a2 - cs2, ZERO_F)/(cf2 - cs2));
+        alphaS = std::sqrt(FMAX(cf2 - a2, ZERO_F)/(cf2 - cs2));
+      }
+
+      real betaT, betaB;
+      const real bPerp = std::sqrt(Bt*Bt + Bb*Bb);
+      if(bPerp > 1e-12*std::sqrt(Bn*Bn + a2*rho)) {
+        betaT = Bt/bPerp;
+        betaB = Bb/bPerp;
+      } else {
+        betaT = ONE_F/std::sqrt(2.0);
+        betaB = betaT;
+      }
+      const real s = (Bn >= ZERO_F ? ONE_F : -ONE_F);
+
+      const real Cff = cf*alphaF;
+      const real Css = cs*alphaS;
+      const real Qf = s*Cff;
+      const real Qs = s*Css;
+      const real Af = a*alphaF*sqrtRho;
+      const real As = a*alphaS*sqrtRho;
+
+      // Right eigenvectors (columns)
+      R[0][ifm] = rho*alphaF;
+      R[1][ifm] = -Cff;
+      R[2][ifm] = Qs*betaT;
+      R[3][ifm] = Qs*betaB;
+      R[iBt][ifm] = As*betaT;
+      R[iBb][ifm] = As*betaB;
+
+      R[2][iam] = -betaB;
+      R[3][iam] = betaT;
+      R[iBt][iam] = -s*sqrtRho*betaB;
+      R[iBb][iam] = s*sqrtRho*betaT;
+
+      R[0][ism] = rho*alphaS;
+      R[1][ism] = -Css;
+      R[2][ism] = -Qf*betaT;
+      R[3][ism] = -Qf*betaB;
+      R[iBt][ism] = -Af*betaT;
+      R[iBb][ism] = -Af*betaB;
+
+      R[0][isp] = rho*alphaS;
+      R[1][isp] = Css;
+      R[2][isp] = Qf*betaT;
+      R[3][isp] = Qf*betaB;
+      R[iBt][isp] = -Af*betaT;
+      R[iBb][isp] = -Af*betaB;
+
+      R[2][iap] = betaB;
+      R[3][iap] = -betaT;
+      R[iBt][iap] = -s*sqrtRho*betaB;
+      R[iBb][iap] = s*sqrtRho*betaT;
+
+      R[0][ifp] = rho*alphaF;
+      R[1][ifp] = Cff;
+      R[2][ifp] = -Qs*betaT;
+      R[3][ifp] = -Qs*betaB;
+      R[iBt][ifp] = As*betaT;
+      R[iBb][ifp] = As*betaB;
+
+      // Left eigenvectors (rows)
+      const real norm = HALF_F/a2;
+      L[ifm][1] = -norm*Cff;
+      L[ifm][2] = norm*Qs*betaT;
+      L[ifm][3] = norm*Qs*betaB;
+      L[ifm][iBt] = norm*As*betaT/rho;
+      L[ifm][iBb] = norm*As*betaB/rho;
+
+      L[iam][2] = -HALF_F*betaB;
+      L[iam][3] = HALF_F*betaT;
+      L[iam][iBt] = -HALF_F*s*betaB/sqrtRho;
+      L[iam][iBb] = HALF_F*s*betaT/sqrtRho;
+
+      L[ism][1] = -norm*Css;
+      L[ism][2] = -norm*Qf*betaT;
+      L[ism][3] = -norm*Qf*betaB;
+      L[ism][iBt] = -norm*Af*betaT/rho;
+      L[ism][iBb] = -norm*Af*betaB/rho;
+
+      L[isp][1] = norm*Css;
+      L[isp][2] = norm*Qf*betaT;
+      L[isp][3] = norm*Qf*betaB;
+      L[isp][iBt] = -norm*Af*betaT/rho;
+      L[isp][iBb] = -norm*Af*betaB/rho;
+
+      L[iap][2] = HALF_F*betaB;
+      L[iap][3] = -HALF_F*betaT;
+      L[iap][iBt] = -HALF_F*s*betaB/sqrtRho;
+      L[iap][iBb] = HALF_F*s*betaT/sqrtRho;
+
+      L[ifp][1] = norm*Cff;
+      L[ifp][2] = -norm*Qs*betaT;
+      L[ifp][3] = -norm*Qs*betaB;
+      L[ifp][iBt] = norm*As*betaT/rho;
+      L[ifp][iBb] = norm*As*betaB/rho;
+
+      if constexpr(Phys::pressure) {
+        constexpr int ie = 3;   // entropy wave
+        R[ip][ifm] = rho*a2*alphaF;
+        R[ip][ism] = rho*a2*alphaS;
+        R[ip][isp] = rho*a2*alphaS;
+        R[ip][ifp] = rho*a2*alphaF;
+        R[0][ie] = ONE_F;
+
+        L[ifm][ip] = norm*alphaF/rho;
+        L[ism][ip] = norm*alphaS/rho;
+        L[isp][ip] = norm*alphaS/rho;
+        L[ifp][ip] = norm*alphaF/rho;
+        L[ie][0] = ONE_F;
+        L[ie][ip] = -ONE_F/a2;
+      } else {
+        // Isothermal: the pressure perturbation is a2 times the density perturbation
+        L[ifm][0] = HALF_F*alphaF/rho;
+        L[ism][0] = HALF_F*alphaS/rho;
+        L[isp][0] = HALF_F*alphaS/rho;
+        L[ifp][0] = HALF_F*alphaF/rho;
+      }
+    }
+  }
+};
+
+#endif // FLUID_RIEMANNSOLVER_CHARACTERISTICS_HPP_
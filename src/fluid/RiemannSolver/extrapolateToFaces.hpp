@@ -11,6 +11,7 @@
 #include "dataBlock.hpp"
 #include "shockFlattening.hpp"
 #include "slopeLimiter.hpp"
+#include "characteristics.hpp"
 
 // Build a left and right extrapolation of the primitive variables along direction dir
 
@@ -31,10 +32,22 @@ class ExtrapolateToFaces {
           Vc(rSolver->hydro->Vc),
           dx(rSolver->hydro->data->dx[dir]),
           shockFlattening(rSolver->haveShockFlattening),
+          characteristic(rSolver->haveCharacteristic),
           isRegularGrid(rSolver->hydro->data->mygrid->isRegularCartesian) {
             if(shockFlattening) {
               flags = rSolver->shockFlattening->flagArray;
             }
+            if constexpr(Phys::eos) {
+              eos = *(rSolver->hydro->eos.get());
+            }
+            if constexpr(precompute) {
+              faceL = rSolver->faceL;
+              faceR = rSolver->faceR;
+            }
+            for(int n = 0 ; n < 3 ; n++) {
+              beg[n] = rSolver->hydro->data->beg[n];
+              end[n] = rSolver->hydro->data->end[n];
+            }
             if(!isRegularGrid) {
               ComputePLMweights(rSolver->hydro->data);
             }
@@ -72,6 +85,10 @@ class ExtrapolateToFaces {
 
 
 
+  // The shock flattening and the regularity of the grid are template parameters, so that the
+  // Riemann kernels are free of per-cell tests on them. They must match shockFlattening and
+  // isRegularGrid, and are only relevant for the second order reconstruction.
+  template<bool flattening, bool regular>
   KOKKOS_FORCEINLINE_FUNCTION void ExtrapolatePrimVar(const int i,
                                                     const int j,
                                                     const int k,
@@ -81,12 +98,21 @@ class ExtrapolateToFaces {
     constexpr int joffset = (dir==JDIR ? 1 : 0);
     constexpr int koffset = (dir==KDIR ? 1 : 0);
 
+    if constexpr(precompute) {
+      // vL= right face of cell i-1, vR= left face of cell i
+      for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+        vL[nv] = faceR(nv,k-koffset,j-joffset,i-ioffset);
+        vR[nv] = faceL(nv,k,j,i);
+      }
+      return;
+    }
+
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
       if constexpr(order == 1) {
         vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset);
         vR[nv] = Vc(nv,k,j,i);
       } else if constexpr(order == 2) {
-        if(isRegularGrid) {
+        if constexpr(regular) {
           /////////////////////////////////////
           // Regular Grid, PLM reconstruction
           /////////////////////////////////////
@@ -95,7 +121,7 @@ class ExtrapolateToFaces {
           real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
 
           real dv;
-          if(shockFlattening) {
+          if constexpr(flattening) {
             if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
               // Force slope limiter to minmod
               dv = SL::MinModLim(dvp,dvm);
@@ -111,7 +137,7 @@ class ExtrapolateToFaces {
           dvm = dvp;
           dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
 
-          if(shockFlattening) {
+          if constexpr(flattening) {
             if(flags(k,j,i) == FlagShock::Shock) {
               dv = SL::MinModLim(dvp,dvm);
             } else {
@@ -138,7 +164,7 @@ class ExtrapolateToFaces {
           real cm = cmArray(index-1);
 
           real dv;
-          if(shockFlattening) {
+          if constexpr(flattening) {
             if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
               // Force slope limiter to minmod
               dv = SL::MinModLim(dvp,dvm);
@@ -158,7 +184,7 @@ class ExtrapolateToFaces {
           cp = cpArray(index);
           cm = cmArray(index);
 
-          if(shockFlattening) {
+          if constexpr(flattening) {
             if(flags(k,j,i) == FlagShock::Shock) {
               dv = SL::MinModLim(dvp,dvm);
             } else {
@@ -170,147 +196,266 @@ class ExtrapolateToFaces {
           vR[nv] = Vc(nv,k,j,i) - dmArray(index)*dv;
         } // Regular grid
 
-      } else if constexpr(order == 3) {
-          // 1D index along the chosen direction
-          const int index = ioffset*i + joffset*j + koffset*k;
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
-
-          // Limo3 limiter
-          real dv;
-          if(shockFlattening) {
-            if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
-              // Force slope limiter to minmod
-              dv = SL::MinModLim(dvp,dvm);
-            } else {
-              dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index-1));
-            }
-          } else { // No shock flattening
-              dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index-1));
-          }
+      }
+    }
+  }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+  // Reconstruct the left and right face states of all of the cells along dir, once per cell.
+  // Fluxes are also computed on perpExtension cells outside of the active domain in the
+  // transverse directions (required by constrained transport).
+  // The shock flattening is a template parameter, as in ExtrapolatePrimVar.
+  template<bool flattening>
+  void ComputeFaceStates(const int perpExtension) {
+    idfx::pushRegion("ExtrapolateToFaces::ComputeFaceStates");
+    constexpr int ioffset = (dir==IDIR ? 1 : 0);
+    constexpr int joffset = (dir==JDIR ? 1 : 0);
+    constexpr int koffset = (dir==KDIR ? 1 : 0);
 
-          // Check positivity
-          if(nv==RHO) {
-            // If face element is negative, revert to minmod
-            if(vL[nv] <= 0.0) {
-              dv = SL::MinModLim(dvp,dvm);
-              vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
-            }
-          }
-          if constexpr(Phys::pressure) {
-            if(nv==PRS) {
-              // If face element is negative, revert to minmod
-              if(vL[nv] <= 0.0) {
-                dv = SL::MinModLim(dvp,dvm);
-                vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
-              }
-            }
-          }
+    const int iextend = (dir==IDIR) ? 0 : perpExtension;
+    #if DIMENSIONS > 1
+      const int jextend = (dir==JDIR) ? 0 : perpExtension;
+    #else
+      const int jextend = 0;
+    #endif
+    #if DIMENSIONS > 2
+      const int kextend = (dir==KDIR) ? 0 : perpExtension;
+    #else
+      const int kextend = 0;
+    #endif
+
+    ExtrapolateToFaces extrapol = *this;
+    IdefixArray4D<real> faceL = this->faceL;
+    IdefixArray4D<real> faceR = this->faceR;
+
+    // Cells on both sides of the faces beg..end (+ transverse extension)
+    idefix_for("ComputeFaceStates",
+               beg[KDIR]-koffset-kextend, end[KDIR]+koffset+kextend,
+               beg[JDIR]-joffset-jextend, end[JDIR]+joffset+jextend,
+               beg[IDIR]-ioffset-iextend, end[IDIR]+ioffset+iextend,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real vl[Phys::nvar];
+        real vr[Phys::nvar];
+        extrapol.template ReconstructCell<flattening>(i, j, k, vl, vr);
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          faceL(nv,k,j,i) = vl[nv];
+          faceR(nv,k,j,i) = vr[nv];
+        }
+      });
+    idfx::popRegion();
+  }
 
-          dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+  // Left (vl) and right (vr) face states of cell (i,j,k) along dir
+  template<bool flattening>
+  KOKKOS_FORCEINLINE_FUNCTION void ReconstructCell(const int i,
+                                                   const int j,
+                                                   const int k,
+                                                   real vl[], real vr[]) const {
+    constexpr int ioffset = (dir==IDIR ? 1 : 0);
+    constexpr int joffset = (dir==JDIR ? 1 : 0);
+    constexpr int koffset = (dir==KDIR ? 1 : 0);
 
-          // Limo3 limiter
-          if(shockFlattening) {
-            if(flags(k,j,i) == FlagShock::Shock) {
-              // Force slope limiter to minmod
-              dv = SL::MinModLim(dvp,dvm);
-            } else {
-              dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
-            }
-          } else { // No shock flattening
-            dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
-          }
+    if constexpr(order >= 5) {
+      ReconstructCellHighOrder<flattening>(i, j, k, vl, vr);
+      return;
+    }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      if constexpr(order == 3) {
+        // 1D index along the chosen direction
+        const int index = ioffset*i + joffset*j + koffset*k;
+        const real v0 = Vc(nv,k,j,i);
+        const real dvm = v0 - Vc(nv,k-koffset,j-joffset,i-ioffset);
+        const real dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - v0;
+
+        // Limo3 limiter
+        real dv;
+        bool shock = false;
+        if constexpr(flattening) {
+          shock = (flags(k,j,i) == FlagShock::Shock);
+        }
+        if(shock) {
+          // Force slope limiter to minmod
+          dv = SL::MinModLim(dvp,dvm);
+        } else {
+          dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index));
+        }
+        vr[nv] = v0 + HALF_F*dv;
 
-          // Check positivity
-          if(nv==RHO) {
-            // If face element is negative, revert to vanleer
-            if(vR[nv] <= 0.0) {
-              dv = SL::MinModLim(dvp,dvm);
-              vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
-            }
+        if(shock) {
+          dv = SL::MinModLim(dvp,dvm);
+        } else {
+          dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
+        }
+        vl[nv] = v0 - HALF_F*dv;
+
+        // Check positivity
+        bool positive = (nv==RHO);
+        if constexpr(Phys::pressure) {
+          positive = positive || (nv==PRS);
+        }
+        if(positive) {
+          // If face element is negative, revert to minmod
+          if(vr[nv] <= 0.0) {
+            dv = SL::MinModLim(dvp,dvm);
+            vr[nv] = v0 + HALF_F*dv;
           }
-          if constexpr(Phys::pressure) {
-            if(nv==PRS) {
-              // If face element is negative, revert to vanleer
-              if(vR[nv] <= 0.0) {
-                dv = SL::MinModLim(dvp,dvm);
-                vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
-              }
-            }
+          if(vl[nv] <= 0.0) {
+            dv = SL::MinModLim(dvp,dvm);
+            vl[nv] = v0 - HALF_F*dv;
           }
+        }
       } else if constexpr(order == 4) {
-          // Reconstruction in cell i-1
-          real vm2 = Vc(nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
-          real vm1 = Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real v0 = Vc(nv,k-koffset,j-joffset,i-ioffset);
-          real vp1 = Vc(nv,k,j,i);
-          real vp2 = Vc(nv,k+koffset,j+joffset,i+ioffset);
-
-          real vr,vl;
-          SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
-          // vL= left side of current interface (i-1/2)= right side of cell i-1
-
-          // Check positivity
-          if(nv==RHO) {
-            // If face element is negative, revert to vanleer
-            if(vr <= 0.0) {
-              real dv = SL::PLMLim(vp1-v0,v0-vm1);
-              vr = v0+HALF_F*dv;
-            }
+        const real vm2 = Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+        const real vm1 = Vc(nv,k-koffset,j-joffset,i-ioffset);
+        const real v0 = Vc(nv,k,j,i);
+        const real vp1 = Vc(nv,k+koffset,j+joffset,i+ioffset);
+        const real vp2 = Vc(nv,k+2*koffset,j+2*joffset,i+2*ioffset);
+
+        SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl[nv], vr[nv]);
+
+        // Check positivity
+        bool positive = (nv==RHO);
+        if constexpr(Phys::pressure) {
+          positive = positive || (nv==PRS);
+        }
+        if(positive) {
+          // If face element is negative, revert to vanleer
+          if(vr[nv] <= 0.0) {
+            real dv = SL::PLMLim(vp1-v0,v0-vm1);
+            vr[nv] = v0+HALF_F*dv;
           }
-          if constexpr(Phys::pressure) {
-            if(nv==PRS) {
-              // If face element is negative, revert to vanleer
-              if(vr <= 0.0) {
-                real dv = SL::PLMLim(vp1-v0,v0-vm1);
-                vr = v0+HALF_F*dv;
-              }
-            }
+          if(vl[nv] <= 0.0) {
+            real dv = SL::PLMLim(vp1-v0,v0-vm1);
+            vl[nv] = v0-HALF_F*dv;
           }
+        }
+      }
+    }
+  }
+
+  // Fifth order reconstruction (WENO-Z or MP5) of both faces of cell (i,j,k)
+  template<bool flattening>
+  KOKKOS_FORCEINLINE_FUNCTION void ReconstructCellHighOrder(const int i,
+                                                            const int j,
+                                                            const int k,
+                                                            real vl[], real vr[]) const {
+    constexpr int ioffset = (dir==IDIR ? 1 : 0);
+    constexpr int joffset = (dir==JDIR ? 1 : 0);
+    constexpr int koffset = (dir==KDIR ? 1 : 0);
 
-          vL[nv] = vr;
-          // Reconstruction in cell i
+    real q[Phys::nvar][5];
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      for(int m = 0 ; m < 5 ; m++) {
+        q[nv][m] = Vc(nv,k+(m-2)*koffset,j+(m-2)*joffset,i+(m-2)*ioffset);
+      }
+    }
+
+    if constexpr(flattening) {
+      if(flags(k,j,i) == FlagShock::Shock) {
+        // Force slope limiter to minmod
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          vr[nv] = q[nv][2] + HALF_F*SL::MinModLim(q[nv][3]-q[nv][2], q[nv][2]-q[nv][1]);
+          vl[nv] = q[nv][2] + HALF_F*SL::MinModLim(q[nv][1]-q[nv][2], q[nv][2]-q[nv][3]);
+        }
+        return;
+      }
+    }
 
-          vm2 = vm1;
-          vm1 = v0;
-          v0 = vp1;
-          vp1 = vp2;
-          vp2 = Vc(nv,k+2*koffset,j+2*joffset,i+2*ioffset);
+    bool projected[Phys::nvar];
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) projected[nv] = false;
 
-          SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+    if constexpr(Phys::eos) {
+      if(characteristic) {
+        using CH = Characteristics<Phys,dir>;
+        real L[CH::nchar][CH::nchar];
+        real R[CH::nchar][CH::nchar];
 
-          // Check positivity
-          if(nv==RHO) {
-            // If face element is negative, revert to vanleer
-            if(vl <= 0.0) {
-              real dv = SL::PLMLim(vp1-v0,v0-vm1);
-              vl = v0-HALF_F*dv;
+        real v0[Phys::nvar];
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) v0[nv] = q[nv][2];
+        real a2;
+        if constexpr(Phys::pressure) {
+          a2 = GetCellGamma(eos, v0[PRS], v0[RHO], k, j, i)*v0[PRS]/v0[RHO];
+        } else {
+          a2 = eos.GetWaveSpeed(k,j,i);
+          a2 = a2*a2;
+        }
+        CH::GetEigenvectors(v0, a2, L, R);
+
+        // Reconstruct the characteristic fields, and project them back
+        real wl[CH::nchar];
+        real wr[CH::nchar];
+        for(int n = 0 ; n < CH::nchar ; n++) {
+          real w[5];
+          for(int m = 0 ; m < 5 ; m++) {
+            w[m] = ZERO_F;
+            for(int c = 0 ; c < CH::nchar ; c++) {
+              if(CH::Exists(c)) w[m] += L[n][c]*q[CH::Var(c)][m];
             }
           }
-          if constexpr(Phys::pressure) {
-            if(nv==PRS) {
-              // If face element is negative, revert to vanleer
-              if(vl <= 0.0) {
-                real dv = SL::PLMLim(vp1-v0,v0-vm1);
-                vl = v0-HALF_F*dv;
-              }
+          GetHighOrderStates(w, wl[n], wr[n]);
+        }
+        for(int c = 0 ; c < CH::nchar ; c++) {
+          if(CH::Exists(c)) {
+            const int nv = CH::Var(c);
+            vl[nv] = ZERO_F;
+            vr[nv] = ZERO_F;
+            for(int n = 0 ; n < CH::nchar ; n++) {
+              vl[nv] += R[c][n]*wl[n];
+              vr[nv] += R[c][n]*wr[n];
             }
+            projected[nv] = true;
           }
+        }
+      }
+    }
+
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      if(!projected[nv]) GetHighOrderStates(q[nv], vl[nv], vr[nv]);
+    }
 
-          vR[nv] = vl;
+    // Check positivity
+    if(vr[RHO] <= 0.0) {
+      // If face element is negative, revert to vanleer
+      vr[RHO] = q[RHO][2] + HALF_F*SL::PLMLim(q[RHO][3]-q[RHO][2], q[RHO][2]-q[RHO][1]);
+    }
+    if(vl[RHO] <= 0.0) {
+      vl[RHO] = q[RHO][2] + HALF_F*SL::PLMLim(q[RHO][1]-q[RHO][2], q[RHO][2]-q[RHO][3]);
+    }
+    if constexpr(Phys::pressure) {
+      if(vr[PRS] <= 0.0) {
+        vr[PRS] = q[PRS][2] + HALF_F*SL::PLMLim(q[PRS][3]-q[PRS][2], q[PRS][2]-q[PRS][1]);
+      }
+      if(vl[PRS] <= 0.0) {
+        vl[PRS] = q[PRS][2] + HALF_F*SL::PLMLim(q[PRS][1]-q[PRS][2], q[PRS][2]-q[PRS][3]);
       }
     }
   }
 
+  // Left and right face values of the central cell of a 5-cell stencil
+  KOKKOS_FORCEINLINE_FUNCTION static void GetHighOrderStates(const real q[5],
+                                                             real &vl, real &vr) {
+    if constexpr(order == 5) {
+      vr = SL::getWENOZFace(q[0], q[1], q[2], q[3], q[4]);
+      vl = SL::getWENOZFace(q[4], q[3], q[2], q[1], q[0]);
+    } else {
+      vr = SL::getMP5Face(q[0], q[1], q[2], q[3], q[4]);
+      vl = SL::getMP5Face(q[4], q[3], q[2], q[1], q[0]);
+    }
+  }
+
+  // Face states are computed once per cell by ComputeFaceStates for the high order schemes
+  static constexpr bool precompute = (order >= 3);
+
   IdefixArray4D<real> Vc;
   IdefixArray1D<real> dx;
   IdefixArray3D<FlagShock> flags;
+  EquationOfState eos;
+
+  // Left and right face states of each cell (only used when precompute)
+  IdefixArray4D<real> faceL;
+  IdefixArray4D<real> faceR;
+  int beg[3];
+  int end[3];
 
   IdefixArray1D<real> cpArray;
   IdefixArray1D<real> cmArray;
@@ -321,6 +466,7 @@ class ExtrapolateToFaces {
 
   bool isRegularGrid{true};
   bool shockFlattening{false};
+  bool characteristic{false};
 };
 
 
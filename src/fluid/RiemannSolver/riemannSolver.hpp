@@ -30,6 +30,7 @@ class RiemannSolver {
   RiemannSolver(Input &input, Fluid<Phys>* hydro);
 
   template <int> void CalcFlux(IdefixArray4D<real> &);
+  template <int, bool, bool> void CalcFlux(IdefixArray4D<real> &);
 
   Solver GetSolver() {
     return(mySolver);
@@ -37,26 +38,26 @@ class RiemannSolver {
 
   void ShowConfig();
 
-  // Riemann Solvers
-  template<const int>
+  // Riemann Solvers, for a given shock flattening and grid regularity (see ExtrapolatePrimVar)
+  template<const int, bool, bool>
     void HlldMHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void HllMHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void RoeMHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void TvdlfMHD(IdefixArray4D<real> &);
 
-  template<const int>
+  template<const int, bool, bool>
     void HllcHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void HllHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void RoeHD(IdefixArray4D<real> &);
-  template<const int>
+  template<const int, bool, bool>
     void TvdlfHD(IdefixArray4D<real> &);
 
-  template<const int>
+  template<const int, bool, bool>
     void HllDust(IdefixArray4D<real> &);
   // Get the right slope limiter
   template<int dir>
@@ -83,6 +84,11 @@ class RiemannSolver {
   std::unique_ptr<ExtrapolateToFaces<Phys,KDIR>> slopeLimKDIR;
 
   bool haveShockFlattening;
+  bool haveCharacteristic{false};
+
+  // Left and right face states of each cell, shared by the extrapolators of all directions
+  IdefixArray4D<real> faceL;
+  IdefixArray4D<real> faceR;
 };
 
 #include "shockFlattening.hpp"
@@ -143,6 +149,14 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
         if(mySolver != HLL_MHD )
           IDEFIX_ERROR("Hall effect is only compatible with HLL Riemann solver.");
     }
+    // Reconstruction of the characteristic fields
+    this->haveCharacteristic = input.GetOrSet<bool>(std::string(Phys::prefix),
+                                                    "characteristic",0,false);
+    #if ORDER < 5
+      if(haveCharacteristic) {
+        IDEFIX_ERROR("Characteristic reconstruction requires the WENOZ or MP5 reconstruction.");
+      }
+    #endif
   } else {
     // We're dealing with dust grains
     mySolver = HLL_DUST;
@@ -158,6 +172,14 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
                               hydro,input.Get<real>(std::string(Phys::prefix),"shockFlattening",0));
   }
 
+  // Face states, when they are computed once per cell
+  if constexpr(ExtrapolateToFaces<Phys,IDIR>::precompute) {
+    faceL = IdefixArray4D<real>(hydro->prefix+"_faceL", Phys::nvar,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    faceR = IdefixArray4D<real>(hydro->prefix+"_faceR", Phys::nvar,
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  }
+
   // init slope limiters
   slopeLimIDIR = std::make_unique<ExtrapolateToFaces<Phys,IDIR>>(this);
   #if DIMENSIONS >= 2
@@ -206,6 +228,9 @@ void RiemannSolver<Phys>::ShowConfig() {
   if(haveShockFlattening) {
     idfx::cout << Phys::prefix << ": Shock Flattening ENABLED." << std::endl;
   }
+  if(haveCharacteristic) {
+    idfx::cout << Phys::prefix << ": Characteristic reconstruction ENABLED." << std::endl;
+  }
 }
 
 template <typename Phys>
@@ -189,6 +189,91 @@ class SlopeLimiter {
       }
     }
   }
+
+  // Fifth order schemes. Both functions return the value at the right face of the cell v0,
+  // the value at the left face being obtained by reversing the stencil.
+  // BCCD08: Borges, R., Carmona, M., Costa, B. & Don, W. S. An improved weighted essentially
+  //         non-oscillatory scheme for hyperbolic conservation laws. Journal of Computational
+  //         Physics 227, 3191–3211 (2008).
+  // SH97: Suresh, A. & Huynh, H. T. Accurate monotonicity-preserving schemes with Runge-Kutta
+  //       time stepping. Journal of Computational Physics 136, 83–99 (1997).
+
+  KOKKOS_FORCEINLINE_FUNCTION static real getWENOZFace(const real vm2, const real vm1,
+                                                      const real v0, const real vp1,
+                                                      const real vp2) {
+    // Third order candidate interpolants
+    const real q0 = (2.0*vm2 - 7.0*vm1 + 11.0*v0)/6.0;
+    const real q1 = (-vm1 + 5.0*v0 + 2.0*vp1)/6.0;
+    const real q2 = (2.0*v0 + 5.0*vp1 - vp2)/6.0;
+
+    // Smoothness indicators
+    const real b0 = 13.0/12.0*(vm2 - 2.0*vm1 + v0)*(vm2 - 2.0*vm1 + v0)
+                  + 0.25*(vm2 - 4.0*vm1 + 3.0*v0)*(vm2 - 4.0*vm1 + 3.0*v0);
+    const real b1 = 13.0/12.0*(vm1 - 2.0*v0 + vp1)*(vm1 - 2.0*v0 + vp1)
+                  + 0.25*(vm1 - vp1)*(vm1 - vp1);
+    const real b2 = 13.0/12.0*(v0 - 2.0*vp1 + vp2)*(v0 - 2.0*vp1 + vp2)
+                  + 0.25*(3.0*v0 - 4.0*vp1 + vp2)*(3.0*v0 - 4.0*vp1 + vp2);
+
+    // WENO-Z weights (BCCD08 eq. 27, with p=2 to keep fifth order at critical points).
+    // eps is scaled by the stencil values so that the weights can't overflow
+    const real eps = 1e-12*(vm2*vm2 + vm1*vm1 + v0*v0 + vp1*vp1 + vp2*vp2) + 1e-30;
+    const real tau = FABS(b0 - b2);
+    real r;
+    r = tau/(b0 + eps);
+    const real a0 = 0.1*(1.0 + r*r);
+    r = tau/(b1 + eps);
+    const real a1 = 0.6*(1.0 + r*r);
+    r = tau/(b2 + eps);
+    const real a2 = 0.3*(1.0 + r*r);
+
+    return((a0*q0 + a1*q1 + a2*q2)/(a0 + a1 + a2));
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static real MinMod4(const real a, const real b,
+                                                  const real c, const real d) {
+    const real sa = sign(a);
+    const real sb = sign(b);
+    const real sc = sign(c);
+    const real sd = sign(d);
+    return(0.125*(sa + sb)*FABS((sa + sc)*(sa + sd))
+                 *FMIN(FMIN(FABS(a),FABS(b)),FMIN(FABS(c),FABS(d))));
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static real MinMod2(const real a, const real b) {
+    return(0.5*(sign(a) + sign(b))*FMIN(FABS(a),FABS(b)));
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static real getMP5Face(const real vm2, const real vm1,
+                                                    const real v0, const real vp1,
+                                                    const real vp2) {
+    const real alpha = 4.0;
+
+    // Unlimited fifth order interpolant (SH97 eq. 2.1)
+    const real vor = (2.0*vm2 - 13.0*vm1 + 47.0*v0 + 27.0*vp1 - 3.0*vp2)/60.0;
+
+    // Monotonicity-preserving bound (SH97 eq. 2.12)
+    const real vmp = v0 + MinMod2(vp1 - v0, alpha*(v0 - vm1));
+    if((vor - v0)*(vor - vmp) <= 1e-12*(v0*v0 + vp1*vp1)) return(vor);
+
+    // Curvatures (SH97 eqs. 2.19 and 2.27)
+    const real djm1 = vm2 - 2.0*vm1 + v0;
+    const real dj = vm1 - 2.0*v0 + vp1;
+    const real djp1 = v0 - 2.0*vp1 + vp2;
+    const real dm4p = MinMod4(4.0*dj - djp1, 4.0*djp1 - dj, dj, djp1);
+    const real dm4m = MinMod4(4.0*dj - djm1, 4.0*djm1 - dj, dj, djm1);
+
+    // Accuracy-preserving constraints (SH97 eqs. 2.8, 2.16, 2.20, 2.24)
+    const real vul = v0 + alpha*(v0 - vm1);
+    const real vav = 0.5*(v0 + vp1);
+    const real vmd = vav - 0.5*dm4p;
+    const real vlc = v0 + 0.5*(v0 - vm1) + 4.0/3.0*dm4m;
+
+    const real vmin = FMAX(FMIN(FMIN(v0, vp1), vmd), FMIN(FMIN(v0, vul), vlc));
+    const real vmax = FMIN(FMAX(FMAX(v0, vp1), vmd), FMAX(FMAX(v0, vul), vlc));
+
+    // median(vor, vmin, vmax)
+    return(vor + MinMod2(vmin - vor, vmax - vor));
+  }
 };
 
 #endif // FLUID_RIEMANNSOLVER_SLOPELIMITER_HPP_
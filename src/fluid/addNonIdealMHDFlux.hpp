@@ -38,6 +38,9 @@ void Fluid<Phys>::AddNonIdealMHDFlux(const real t) {
     if(data->rklCycle) {
       haveResistivity = resistivityStatus.isRKL;
       haveAmbipolar = ambipolarStatus.isRKL;
+    } else if(data->implicitCycle) {
+      haveResistivity = resistivityStatus.isImplicit;
+      haveAmbipolar = ambipolarStatus.isImplicit;
     } else {
       haveResistivity = resistivityStatus.isExplicit;
       haveAmbipolar = ambipolarStatus.isExplicit;
@@ -64,17 +67,19 @@ void Fluid<Phys>::AddNonIdealMHDFlux(const real t) {
 
     // Load the diffusivity array when required
     if(resistivity == UserDefFunction && dir == IDIR) {
-      if(ohmicDiffusivityFunc)
-        ohmicDiffusivityFunc(*data, t, etaArr);
-      else
+      if(ohmicDiffusivityFunc) {
+        if(ohmicRefresh.NeedsRefresh(*data)) ohmicDiffusivityFunc(*data, t, etaArr);
+      } else {
         IDEFIX_ERROR("No user-defined Ohmic diffusivity function has been enrolled");
+      }
     }
 
     if(ambipolar == UserDefFunction && dir == IDIR) {
-      if(ambipolarDiffusivityFunc)
-        ambipolarDiffusivityFunc(*data, t, xAmbiArr);
-      else
+      if(ambipolarDiffusivityFunc) {
+        if(ambipolarRefresh.NeedsRefresh(*data)) ambipolarDiffusivityFunc(*data, t, xAmbiArr);
+      } else {
         IDEFIX_ERROR("No user-defined ambipolar diffusivity function has been enrolled");
+      }
     }
 
     // Note the flux follows the same sign convention as the hyperbolic flux
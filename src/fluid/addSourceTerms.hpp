@@ -12,7 +12,9 @@
 #include "dataBlock.hpp"
 #include "fargo.hpp"
 
-template<typename Phys>
+// Fargo and the rotation of the frame are template parameters, so that the kernel of a run only
+// contains the source terms it needs
+template<typename Phys, bool haveFargo, bool haveRotation>
 struct Fluid_AddSourceTermsFunctor {
   /// @brief Functor for Add source terms
   /// @param hydro
@@ -34,12 +36,12 @@ struct Fluid_AddSourceTermsFunctor {
     if constexpr(Phys::isothermal) {
       eos = *(hydro->eos.get());
     }
-    haveRotation = hydro->haveRotation;
     OmegaZ = hydro->OmegaZ;
-    haveFargo = hydro->data->haveFargo;
-    if(haveFargo) {
-      fargoVelocity = hydro->data->fargo->meanVelocity;
-    }
+    #if GEOMETRY == POLAR || GEOMETRY == SPHERICAL
+      if constexpr(haveFargo) {
+        fargoVelocity = hydro->data->fargo->meanVelocity;
+      }
+    #endif
     // shearing box (only with fargo&cartesian)
     sbS = hydro->sbS;
   }
@@ -62,11 +64,9 @@ struct Fluid_AddSourceTermsFunctor {
 
   EquationOfState eos;
 
-  bool haveRotation;
   real OmegaZ;
 
   // Fargo
-  bool haveFargo;
   IdefixArray2D<real> fargoVelocity;
 
   // shearing box (only with fargo&cartesian)
@@ -79,17 +79,17 @@ struct Fluid_AddSourceTermsFunctor {
     #if GEOMETRY == CARTESIAN
       // Manually add Coriolis force in cartesian geometry. Otherwise
       // Coriolis is treated as a modification to the fluxes
-      if(haveRotation) {
+      if constexpr(haveRotation) {
         Uc(MX1,k,j,i) +=   TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * Vc(VX2,k,j,i);
         Uc(MX2,k,j,i) += - TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * Vc(VX1,k,j,i);
       }
-      if(haveFargo) {
+      if constexpr(haveFargo) {
         Uc(MX1,k,j,i) +=   TWO_F * dt * Vc(RHO,k,j,i) * OmegaZ * sbS * x1(i);
       }
     #endif
       // fetch fargo velocity when required
       [[maybe_unused]] real fargoV = ZERO_F;
-      if(haveFargo) {
+      if constexpr(haveFargo) {
         // No source term when CARTESIAN+Fargo
         #if GEOMETRY == POLAR
           fargoV = fargoVelocity(k,i);
@@ -101,7 +101,7 @@ struct Fluid_AddSourceTermsFunctor {
   #if COMPONENTS == 3
       real vphi,Sm;
       vphi = Vc(iVPHI,k,j,i);
-      if(haveRotation) vphi += OmegaZ*x1(i);
+      if constexpr(haveRotation) vphi += OmegaZ*x1(i);
       Sm = Vc(RHO,k,j,i) * vphi*vphi; // Centrifugal
       // Presure (because pressure is included in the flux, additional source terms arise)
       if constexpr(Phys::isothermal) {
@@ -125,7 +125,7 @@ struct Fluid_AddSourceTermsFunctor {
 #elif GEOMETRY == POLAR
       real vphi,Sm;
       vphi = Vc(iVPHI,k,j,i) + fargoV;
-      if(haveRotation) vphi += OmegaZ*x1(i);
+      if constexpr(haveRotation) vphi += OmegaZ*x1(i);
       Sm = Vc(RHO,k,j,i) * vphi*vphi;     // Centrifugal
       // Pressure (because we're including pressure in the flux,
       // we need that to get the radial pressure gradient)
@@ -148,7 +148,7 @@ struct Fluid_AddSourceTermsFunctor {
 #elif GEOMETRY == SPHERICAL
       real vphi,Sm;
       vphi = SELECT(ZERO_F, ZERO_F, Vc(iVPHI,k,j,i))+fargoV;
-      if(haveRotation) vphi += OmegaZ*x1(i)*FABS(sinx2(j));
+      if constexpr(haveRotation) vphi += OmegaZ*x1(i)*FABS(sinx2(j));
       // Centrifugal
       Sm = Vc(RHO,k,j,i) * (EXPAND( ZERO_F, + Vc(VX2,k,j,i)*Vc(VX2,k,j,i), + vphi*vphi));
       // Pressure curvature
@@ -212,14 +212,29 @@ void Fluid<Phys>::AddSourceTerms(real t, real dt) {
     }
   }
 
-  auto func = Fluid_AddSourceTermsFunctor<Phys>(this,dt);
+  // Select the kernel of the Fargo and rotation options of this run
+  if(data->haveFargo && haveRotation) {
+    AddSourceTerms<true, true>(dt);
+  } else if(data->haveFargo) {
+    AddSourceTerms<true, false>(dt);
+  } else if(haveRotation) {
+    AddSourceTerms<false, true>(dt);
+  } else {
+    AddSourceTerms<false, false>(dt);
+  }
+
+  idfx::popRegion();
+}
+
+template <typename Phys>
+template <bool fargo, bool rotation>
+void Fluid<Phys>::AddSourceTerms(real dt) {
+  auto func = Fluid_AddSourceTermsFunctor<Phys,fargo,rotation>(this,dt);
 
   idefix_for("AddSourceTerms",
              data->beg[KDIR],data->end[KDIR],
              data->beg[JDIR],data->end[JDIR],
              data->beg[IDIR],data->end[IDIR],
             func);
-
-  idfx::popRegion();
 }
 #endif //FLUID_ADDSOURCETERMS_HPP_
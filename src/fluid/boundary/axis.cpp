@@ -22,46 +22,55 @@ void Axis::ShowConfig() {
 }
 
 
-void Axis::SymmetrizeEx1Side(int jref) {
-#if DIMENSIONS == 3
+// Start the reduction of the sums around the axis over the processes sharing it
+void Axis::StartAxisSum(int ncomp) {
+  #ifdef WITH_MPI
+  if(needMPIExchange) {
+    // The sums should be complete before MPI reads them
+    Kokkos::fence();
+    double tStart = MPI_Wtime();
+    MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, axisSum.data(), ncomp*2*data->np_tot[IDIR],
+                                 realMPI, MPI_SUM, data->mygrid->AxisComm, &sumRequest));
+    idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  }
+  #endif
+}
 
-  IdefixArray3D<real> Ex1 = this->ex;
-  IdefixArray1D<real> Ex1Avg = this->Ex1Avg;
+void Axis::WaitAxisSum() {
+  #ifdef WITH_MPI
+  if(needMPIExchange) {
+    double tStart = MPI_Wtime();
+    MPI_SAFE_CALL(MPI_Wait(&sumRequest, MPI_STATUS_IGNORE));
+    idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  }
+  #endif
+}
 
+void Axis::StartRegularizeEMFs() {
+  idfx::pushRegion("Axis::StartRegularizeEMFs");
+#if DIMENSIONS == 3
   if(isTwoPi) {
-    idefix_for("Ex1_ini",0,data->np_tot[IDIR],
-        KOKKOS_LAMBDA(int i) {
-          Ex1Avg(i) = ZERO_F;
-        });
-
-    idefix_for("Ex1_Symmetrize",data->beg[KDIR],data->end[KDIR],0,data->np_tot[IDIR],
-      KOKKOS_LAMBDA(int k,int i) {
-        Kokkos::atomic_add(&Ex1Avg(i),  Ex1(k,jref,i));
+    IdefixArray3D<real> Ex1 = this->ex;
+    IdefixArray3D<real> sum = this->axisSum;
+    const int jleft = data->beg[JDIR];
+    const int jright = data->end[JDIR];
+    const int kbeg = data->beg[KDIR];
+    const int kend = data->end[KDIR];
+
+    idefix_for("Axis:SumEx1",sideBeg,sideEnd,0,data->np_tot[IDIR],
+      KOKKOS_LAMBDA(int s, int i) {
+        const int jref = (s == 0) ? jleft : jright;
+        real Ex1Sum = ZERO_F;
+        for(int k = kbeg ; k < kend ; k++) {
+          Ex1Sum += Ex1(k,jref,i);
+        }
+        sum(0,s,i) = Ex1Sum;
       });
-    if(needMPIExchange) {
-      #ifdef WITH_MPI
-        Kokkos::fence();
-        // sum along all of the processes on the same r
-        MPI_Allreduce(MPI_IN_PLACE, Ex1Avg.data(), data->np_tot[IDIR], realMPI,
-                      MPI_SUM, data->mygrid->AxisComm);
-      #endif
-    }
-
-    int ncells=data->mygrid->np_int[KDIR];
-
-    idefix_for("Ex1_Store",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
-    KOKKOS_LAMBDA(int k,int i) {
-      Ex1(k,jref,i) = Ex1Avg(i)/((real) ncells);
-    });
-  } else {
-    // if we're not doing full two pi, the flow is symmetric with respect to the axis, and the axis
-    // EMF is simply zero
-    idefix_for("Ex1_Store",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
-    KOKKOS_LAMBDA(int k,int i) {
-      Ex1(k,jref,i) = ZERO_F;
-    });
+    // sum along all of the processes on the same r
+    StartAxisSum(1);
   }
 #endif
+  idfx::popRegion();
 }
 
 // Ex3 (=Ephi) on the axis is ill-defined. However, the length of cell edges along the phi
@@ -70,167 +79,135 @@ void Axis::SymmetrizeEx1Side(int jref) {
 // in Ve(AX3e...), leading potentially numerical instabilities in that region.
 // Hence, we enforce a regularisation of Ex3 for consistancy.
 
-
-void Axis::RegularizeEx3side(int jref) {
+void Axis::FinishRegularizeEMFs() {
+  idfx::pushRegion("Axis::FinishRegularizeEMFs");
   IdefixArray3D<real> Ex3 = this->ez;
+  const int jleft = data->beg[JDIR];
+  const int jright = data->end[JDIR];
+#if DIMENSIONS == 3
+  IdefixArray3D<real> Ex1 = this->ex;
+  IdefixArray3D<real> sum = this->axisSum;
+  const bool isTwoPi = this->isTwoPi;
+  const real ncells = data->mygrid->np_int[KDIR];
+  if(isTwoPi) WaitAxisSum();
+#endif
 
-  idefix_for("Ex3_Regularise",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
-    KOKKOS_LAMBDA(int k,int i) {
-      Ex3(k,jref,i) = 0.0;
+  idefix_for("Axis:RegularizeEMFs",sideBeg,sideEnd,0,data->np_tot[KDIR],0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA(int s, int k, int i) {
+      const int jref = (s == 0) ? jleft : jright;
+      #if DIMENSIONS == 3
+        // if we're not doing full two pi, the flow is symmetric with respect to the axis, and
+        // the axis EMF is simply zero
+        Ex1(k,jref,i) = isTwoPi ? sum(0,s,i)/ncells : ZERO_F;
+      #endif
+      Ex3(k,jref,i) = ZERO_F;
     });
+  idfx::popRegion();
 }
 
+// Compute the values of Jx, Jy and Jz that are consistent for all cells touching the axis
+void Axis::StartRegularizeCurrent() {
+  idfx::pushRegion("Axis::StartRegularizeCurrent");
+  #if DIMENSIONS == 3
+    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray3D<real> sum = this->axisSum;
+    IdefixArray1D<real> dx3 = data->dx[KDIR];
+    const int jleft = data->beg[JDIR];
+    const int jright = data->end[JDIR]-1;
+    const int kbeg = data->beg[KDIR];
+    const int kend = data->end[KDIR];
+
+    idefix_for("Axis:SumBcirculation",sideBeg,sideEnd,0,data->np_tot[IDIR],
+      KOKKOS_LAMBDA(int s, int i) {
+        const int jc = (s == 0) ? jleft : jright;
+        // Compute the circulation of Bphi around the pole
+        real circulation = ZERO_F;
+        for(int k = kbeg ; k < kend ; k++) {
+          circulation += Vs(BX3s,k,jc,i)*dx3(k);
+        }
+        sum(0,s,i) = circulation;
+      });
+    // sum along all of the processes on the same r
+    StartAxisSum(1);
+  #endif // DIMENSIONS
+  idfx::popRegion();
+}
 
-void Axis::RegularizeCurrentSide(int side) {
-  // Compute the values of Jx, Jy and Jz that are consistent for all cells touching the axis
+void Axis::FinishRegularizeCurrent() {
+  idfx::pushRegion("Axis::FinishRegularizeCurrent");
   #if DIMENSIONS == 3
     IdefixArray4D<real> J = this->J;
-    IdefixArray4D<real> Vs = this->Vs;
-    int js = 0;
-    int jc = 0;
-    int sign = 0;
-    if(side == left) {
-      js = data->beg[JDIR];
-      jc = data->beg[JDIR];
-      sign = 1;
-    }
-    if(side == right) {
-      js = data->end[JDIR];
-      jc = data->end[JDIR]-1;
-      sign = -1;
-    }
-    IdefixArray1D<real> BAvg = this->Ex1Avg;
+    IdefixArray3D<real> sum = this->axisSum;
     IdefixArray1D<real> x2 = data->x[JDIR];
     IdefixArray1D<real> x1 = data->x[IDIR];
-    IdefixArray1D<real> dx3 = data->dx[KDIR];
-
-    idefix_for("B_ini",0,data->np_tot[IDIR],
-          KOKKOS_LAMBDA(int i) {
-            BAvg(i) = ZERO_F;
-    });
-    idefix_for("Compute_Bcirculation",data->beg[KDIR],data->end[KDIR],0,data->np_tot[IDIR],
-        KOKKOS_LAMBDA(int k,int i) {
-          Kokkos::atomic_add(&BAvg(i), Vs(BX3s,k,jc,i)*dx3(k) ); // Compute the circulation of
-                                                                 // Bphi around the pole
-    });
-
-    if(needMPIExchange) {
-      #ifdef WITH_MPI
-        Kokkos::fence();
-        // sum along all of the processes on the same r
-        MPI_Allreduce(MPI_IN_PLACE, BAvg.data(), data->np_tot[IDIR], realMPI,
-                      MPI_SUM, data->mygrid->AxisComm);
-      #endif
-    }
-
-    const int ncells=data->mygrid->np_int[KDIR];
+    const int jleft = data->beg[JDIR];
+    const int jright = data->end[JDIR];
 
     real deltaPhi = data->mygrid->xend[KDIR] - data->mygrid->xbeg[KDIR];
 
+    WaitAxisSum();
+
     // Use the circulation around the pole of Bphi to determine Jr on the pole:
     // Delta phi r^2(1-cos theta) Jr = int r sin(theta) Bphi dphi
 
-    idefix_for("fixJ",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
-        KOKKOS_LAMBDA(int k,int i) {
-          real th = x2(jc);
-          real fact = sign*sin(th)/(deltaPhi*x1(i)*(1-cos(th)));
-          J(IDIR, k,js,i) = BAvg(i)*fact;
-        });
-
+    idefix_for("Axis:FixJ",sideBeg,sideEnd,0,data->np_tot[KDIR],0,data->np_tot[IDIR],
+      KOKKOS_LAMBDA(int s, int k, int i) {
+        const int js = (s == 0) ? jleft : jright;
+        const int jc = (s == 0) ? jleft : jright-1;
+        const real sign = (s == 0) ? ONE_F : -ONE_F;
+        real th = x2(jc);
+        real fact = sign*sin(th)/(deltaPhi*x1(i)*(1-cos(th)));
+        J(IDIR, k,js,i) = sum(0,s,i)*fact;
+      });
   #endif // DIMENSIONS
-}
-
-// Average the Emf component along the axis
-
-void Axis::RegularizeEMFs() {
-  idfx::pushRegion("Axis::RegularizeEMFs");
-
-  if(this->axisLeft) {
-    int jref = data->beg[JDIR];
-    SymmetrizeEx1Side(jref);
-    RegularizeEx3side(jref);
-  }
-  if(this->axisRight) {
-    int jref = data->end[JDIR];
-    SymmetrizeEx1Side(jref);
-    RegularizeEx3side(jref);
-  }
-
-  idfx::popRegion();
-}
-
-// Average the Emf component along the axis
-
-void Axis::RegularizeCurrent() {
-  idfx::pushRegion("Axis::RegularizeCurrent");
-
-  if(this->axisLeft) {
-    RegularizeCurrentSide(left);
-  }
-  if(this->axisRight) {
-    RegularizeCurrentSide(right);
-  }
-
   idfx::popRegion();
 }
 
 
-void Axis::FixBx2sAxis(int side) {
+void Axis::FixBx2sAxis() {
   // Compute the values of Bx and By that are consistent with BX2 along the axis
   #if DIMENSIONS == 3
     IdefixArray4D<real> Vs = this->Vs;
-    IdefixArray2D<real> BAvg = this->BAvg;
+    IdefixArray3D<real> sum = this->axisSum;
     IdefixArray1D<real> phi = data->x[KDIR];
-
-    int jin = 0;
-    int jout = 0;
-    int jaxe = 0;
-    int sign = 0;
-
-    if(side == left) {
-      jin = data->beg[JDIR];
-      jout = jin-1;
-      jaxe = jin;
-      sign = 1;
-    }
-    if(side == right) {
-      jin = data->end[JDIR]-1;
-      jout = jin+1;
-      jaxe = jout;
-      sign = -1;
-    }
-
-    idefix_for("B_ini",0,data->np_tot[IDIR],0,2,
-          KOKKOS_LAMBDA(int i, int n) {
-            BAvg(i,n) = ZERO_F;
-    });
-    idefix_for("BHorizontal_compute",data->beg[KDIR],data->end[KDIR],0,data->np_tot[IDIR],
-        KOKKOS_LAMBDA(int k,int i) {
+    const int jleft = data->beg[JDIR];
+    const int jright = data->end[JDIR];
+    const int kbeg = data->beg[KDIR];
+    const int kend = data->end[KDIR];
+
+    idefix_for("Axis:BHorizontal_compute",sideBeg,sideEnd,0,data->np_tot[IDIR],
+      KOKKOS_LAMBDA(int s, int i) {
+        const int jin = (s == 0) ? jleft : jright-1;
+        const int jout = (s == 0) ? jin-1 : jin+1;
+        const int jaxe = (s == 0) ? jin : jout;
+        const real sign = (s == 0) ? ONE_F : -ONE_F;
+        real Bx = ZERO_F;
+        real By = ZERO_F;
+        for(int k = kbeg ; k < kend ; k++) {
           real Bthmid = sign*HALF_F*(Vs(BX2s,k,jaxe-1,i) + Vs(BX2s,k,jaxe+1,i));
           real Bphimid = HALF_F*(Vs(BX3s,k,jin,i) + Vs(BX3s,k,jout,i));
-          //Bthmid = 0.0;
-          //Bphimid = 0.0;
 
-          Kokkos::atomic_add(&BAvg(i,IDIR), Bthmid * cos(phi(k)) - Bphimid * sin(phi(k)));
-          Kokkos::atomic_add(&BAvg(i,JDIR), Bthmid * sin(phi(k)) + Bphimid * cos(phi(k)));
-    });
-    if(needMPIExchange) {
-      Kokkos::fence();
-      #ifdef WITH_MPI
-        // sum along all of the processes on the same r
-        MPI_Allreduce(MPI_IN_PLACE, BAvg.data(), 2*data->np_tot[IDIR], realMPI,
-                      MPI_SUM, data->mygrid->AxisComm);
-      #endif
-    }
-    int ncells=data->mygrid->np_int[KDIR];
+          Bx += Bthmid * cos(phi(k)) - Bphimid * sin(phi(k));
+          By += Bthmid * sin(phi(k)) + Bphimid * cos(phi(k));
+        }
+        sum(IDIR,s,i) = Bx;
+        sum(JDIR,s,i) = By;
+      });
+    // sum along all of the processes on the same r
+    StartAxisSum(2);
+    WaitAxisSum();
 
-    idefix_for("fixBX2s",data->beg[KDIR],data->end[KDIR],0,data->np_tot[IDIR],
-        KOKKOS_LAMBDA(int k,int i) {
-          real Bx = BAvg(i,IDIR) / ((real) ncells);
-          real By = BAvg(i,JDIR) / ((real) ncells);
+    const real ncells = data->mygrid->np_int[KDIR];
 
-          Vs(BX2s,k,jaxe,i) = sign*(cos(phi(k))*Bx + sin(phi(k))*By);
-        });
+    idefix_for("Axis:fixBX2s",sideBeg,sideEnd,kbeg,kend,0,data->np_tot[IDIR],
+      KOKKOS_LAMBDA(int s, int k, int i) {
+        const int jaxe = (s == 0) ? jleft : jright;
+        const real sign = (s == 0) ? ONE_F : -ONE_F;
+        real Bx = sum(IDIR,s,i) / ncells;
+        real By = sum(JDIR,s,i) / ncells;
+
+        Vs(BX2s,k,jaxe,i) = sign*(cos(phi(k))*Bx + sin(phi(k))*By);
+      });
   #endif // DIMENSIONS
 }
 
@@ -295,7 +272,8 @@ void Axis::EnforceAxisBoundary(int side) {
 
   if(isTwoPi) {
     if(needMPIExchange) {
-      ExchangeMPI(side);
+      // When both sides lie on the axis, they are both exchanged with the left one
+      if(side == left || !axisLeft) ExchangeMPI();
     } else { // no MPI exchange
       idefix_for("BoundaryAxis",0,this->nVar,kbeg,kend,jbeg,jend,ibeg,iend,
               KOKKOS_LAMBDA (int n, int k, int j, int i) {
@@ -413,8 +391,7 @@ void Axis::ReconstructBx2s() {
         if(haveleft) FixBx2sAxisGhostAverage(left);
         if(haveright) FixBx2sAxisGhostAverage(right);
       #else
-        if(haveleft) FixBx2sAxis(left);
-        if(haveright) FixBx2sAxis(right);
+        FixBx2sAxis();
       #endif
     } else {
       idefix_for("Axis:BoundaryAvg",0,data->np_tot[KDIR],0,data->np_tot[IDIR],
@@ -435,7 +412,9 @@ void Axis::ReconstructBx2s() {
 
 
 
-void Axis::ExchangeMPI(int side) {
+// Exchange the ghost zones of all of the sides lying on the axis with the processes on the other
+// side of the axis. Each side takes sideSize elements of the buffers.
+void Axis::ExchangeMPI() {
   idfx::pushRegion("Axis::ExchangeMPI");
   #ifdef WITH_MPI
   // Load  the buffers with data
@@ -445,6 +424,10 @@ void Axis::ExchangeMPI(int side) {
   IdefixArray1D<int> map = this->mapVars;
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
+  const int nvars = this->mapNVars;
+  const bool haveMHD = this->haveMHD;
+  const int sideBeg = this->sideBeg;
+  const int sideSize = bufferSize/(sideEnd-sideBeg);
 
 // If MPI Persistent, start receiving even before the buffers are filled
 
@@ -466,56 +449,40 @@ void Axis::ExchangeMPI(int side) {
   kbeg   = data->beg[KDIR];
   kend   = data->end[KDIR];
   nz     = kend - kbeg;
-  if(side==left) {
-    idefix_for("LoadBufferX2Vc",0,mapNVars,kbeg,kend,jbeg,jend,ibeg,iend,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        bufferSend(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz ) =
-                                                          Vc(map(n),k,j+ny,i);
-      }
-    );
-    if (haveMHD) {
-      int VsIndex = mapNVars*nx*ny*nz;
-      idefix_for("LoadBufferX2IDIR",kbeg,kend,jbeg,jend,ibeg,iend+1,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          bufferSend(i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndex ) =
-                                                          Vs(IDIR,k,j+ny,i);
-        }
-      );
-      VsIndex = mapNVars*nx*ny*nz + (nx+1)*ny*nz;
-      idefix_for("LoadBufferX2KDIR",kbeg,kend+1,jbeg,jend,ibeg,iend,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          bufferSend(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndex ) =
-                                                          Vs(KDIR,k,j+ny,i);
+
+  // Position of the face-centered field in the buffer of a side
+  const int VsIndexX1 = nvars*nx*ny*nz;
+  #if DIMENSIONS == 3
+  const int VsIndexX3 = nvars*nx*ny*nz + (nx+1)*ny*nz;
+  #endif
+
+  // A single kernel loads Vc and the face-centered field of all of the sides. The extra
+  // faces of Vs (i==iend for IDIR, k==kend for KDIR) are part of the iteration space.
+  idefix_for("LoadBufferAxis",sideBeg,sideEnd,kbeg,kend+1,jbeg,jend,ibeg,iend+1,
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      // First active cells along the axis
+      const int jsrc = (s == 0) ? j+ny : j+offset-ny;
+      const int start = (s-sideBeg)*sideSize;
+      if(k < kend && i < iend) {
+        for(int n = 0 ; n < nvars ; n++) {
+          bufferSend(start + i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz ) =
+                                                          Vc(map(n),k,jsrc,i);
         }
-      );
-    } // MHD
-  } else if(side==right) {
-    idefix_for("LoadBufferX2Vc",0,mapNVars,kbeg,kend,jbeg,jend,ibeg,iend,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        bufferSend(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz ) =
-                                                          Vc(map(n),k,j+offset-ny,i);
       }
-    );
-
-    // Load face-centered field in the buffer
-     if (haveMHD) {
-      int VsIndex = mapNVars*nx*ny*nz;
-      idefix_for("LoadBufferX2IDIR",kbeg,kend,jbeg,jend,ibeg,iend+1,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          bufferSend(i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndex ) =
-                                                          Vs(IDIR,k,j+offset-ny,i);
+      if(haveMHD) {
+        if(k < kend) {
+          bufferSend(start + i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndexX1 ) =
+                                                          Vs(IDIR,k,jsrc,i);
         }
-      );
-      VsIndex = mapNVars*nx*ny*nz + (nx+1)*ny*nz;
-
-      idefix_for("LoadBufferX2KDIR",kbeg,kend+1,jbeg,jend,ibeg,iend,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          bufferSend(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndex ) =
-                                                          Vs(KDIR,k,j+offset-ny,i);
+        #if DIMENSIONS == 3
+        if(i < iend) {
+          bufferSend(start + i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndexX3 ) =
+                                                          Vs(KDIR,k,jsrc,i);
         }
-      );
-    } // MHD
-  } // side==right
+        #endif
+      }
+    }
+  );
 
   Kokkos::fence();
 
@@ -527,67 +494,38 @@ void Axis::ExchangeMPI(int side) {
   // Unpack
   auto bufferRecv=this->bufferRecv;
   auto sVc = this->symmetryVc;
-
-  if(side==left) {
-    idefix_for("StoreBufferAxis",0,mapNVars,kbeg,kend,jbeg,jend,ibeg,iend,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        Vc(map(n),k,jend-(j-jbeg)-1,i) =
-                    sVc(map(n))*bufferRecv(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz );
-      }
-    );
-
-    // Load face-centered field in the buffer
-    if (haveMHD) {
-      int VsIndex = mapNVars*nx*ny*nz;
-      auto sVs = this->symmetryVs;
-      idefix_for("StoreBufferX2IDIR",kbeg,kend,jbeg,jend,ibeg,iend+1,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          Vs(IDIR,k,jend-(j-jbeg)-1,i) =
-                    sVs(IDIR)*bufferRecv(i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndex );
-        }
-      );
-
-      VsIndex = mapNVars*nx*ny*nz + (nx+1)*ny*nz;
-
-      idefix_for("StoreBufferX2KDIR",kbeg,kend+1,jbeg,jend,ibeg,iend,
-        KOKKOS_LAMBDA ( int k, int j, int i) {
-          Vs(KDIR,k,jend-(j-jbeg)-1,i) =
-                      sVs(KDIR)*bufferRecv(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndex );
+  auto sVs = this->symmetryVs;
+
+  idefix_for("StoreBufferAxis",sideBeg,sideEnd,kbeg,kend+1,jbeg,jend,ibeg,iend+1,
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      // Ghost cells, mirrored accross the axis
+      const int jdst = (s == 0) ? jend-(j-jbeg)-1 : jend-(j-jbeg)-1+offset;
+      const int start = (s-sideBeg)*sideSize;
+      if(k < kend && i < iend) {
+        for(int n = 0 ; n < nvars ; n++) {
+          Vc(map(n),k,jdst,i) =
+                sVc(map(n))*bufferRecv(start + i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz );
         }
-      );
-    }
-  } else if(side==right) {
-    idefix_for("StoreBufferAxis",0,mapNVars,kbeg,kend,jbeg,jend,ibeg,iend,
-      KOKKOS_LAMBDA (int n, int k, int j, int i) {
-        Vc(map(n),k,jend-(j-jbeg)-1+offset,i) =
-                    sVc(map(n))*bufferRecv(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + n*nx*ny*nz );
       }
-    );
-
-    // Load face-centered field in the buffer
-    if (haveMHD) {
-      int VsIndex = mapNVars*nx*ny*nz;
-      auto sVs = this->symmetryVs;
-      idefix_for("StoreBufferX2IDIR",kbeg,kend,jbeg,jend,ibeg,iend+1,
-        KOKKOS_LAMBDA (int k, int j, int i) {
-          Vs(IDIR,k,jend-(j-jbeg)-1+offset,i) =
-                      sVs(IDIR)*bufferRecv(i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndex );
+      if(haveMHD) {
+        if(k < kend) {
+          Vs(IDIR,k,jdst,i) =
+                sVs(IDIR)*bufferRecv(start + i + (j-jbeg)*(nx+1) + (k-kbeg)*(nx+1)*ny + VsIndexX1);
         }
-      );
-      VsIndex = mapNVars*nx*ny*nz + (nx+1)*ny*nz;
-
-      idefix_for("StoreBufferX2KDIR",kbeg,kend+1,jbeg,jend,ibeg,iend,
-        KOKKOS_LAMBDA ( int k, int j, int i) {
-          Vs(KDIR,k,jend-(j-jbeg)-1+offset,i) =
-                      sVs(KDIR)*bufferRecv(i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndex );
+        #if DIMENSIONS == 3
+        if(i < iend) {
+          Vs(KDIR,k,jdst,i) =
+                sVs(KDIR)*bufferRecv(start + i + (j-jbeg)*nx + (k-kbeg)*nx*ny + VsIndexX3 );
         }
-      );
-    } // MHD
-  }
+        #endif
+      }
+    }
+  );
 
   MPI_Wait(&sendRequest, &sendStatus);
 
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  idfx::mpiCallsBytes += bufferSize*sizeof(real);
 
 
   #endif  //MPI
@@ -632,14 +570,16 @@ void Axis::InitMPI() {
 
   this->mapVars = idfx::ConvertVectorToIdefixArray(mapVars);
 
-  this->bufferSize = data->np_tot[IDIR] * data->nghost[JDIR] * data->np_int[KDIR] * mapNVars;
+  int sideSize = data->np_tot[IDIR] * data->nghost[JDIR] * data->np_int[KDIR] * mapNVars;
   if (haveMHD) {
     // IDIR
-    bufferSize += (data->np_tot[IDIR]+1) * data->nghost[JDIR] * data->np_int[KDIR];
+    sideSize += (data->np_tot[IDIR]+1) * data->nghost[JDIR] * data->np_int[KDIR];
     #if DIMENSIONS==3
-    bufferSize += data->np_tot[IDIR] * data->nghost[JDIR] * (data->np_int[KDIR]+1);
+    sideSize += data->np_tot[IDIR] * data->nghost[JDIR] * (data->np_int[KDIR]+1);
     #endif  // DIMENSIONS
   }
+  // All of the sides lying on the axis are exchanged in the same message
+  this->bufferSize = sideSize * (sideEnd - sideBeg);
 
   this->bufferRecv = IdefixArray1D<real>("bufferRecvAxis", bufferSize);
   this->bufferSend = IdefixArray1D<real>("bufferSendAxis", bufferSize);
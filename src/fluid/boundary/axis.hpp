@@ -26,20 +26,22 @@ class Axis {
  public:
   template <typename Phys>
   explicit Axis(Boundary<Phys> *);  // Initialisation
-  void RegularizeEMFs();                 // Regularize the EMF sitting on the axis
-  void RegularizeCurrent();             // Regularize the currents along the axis
+  // The EMFs and currents along the axis depend on averages around it, summed by all of the
+  // processes sharing the axis. The regularisations are split in two steps so that this
+  // (non-blocking) reduction overlaps with the work done by the caller in between.
+  void StartRegularizeEMFs();           // Sum Ex1 around the axis, and start its reduction
+  void FinishRegularizeEMFs();          // Regularize the EMF sitting on the axis
+  void StartRegularizeCurrent();        // Sum the circulation of Bphi, and start its reduction
+  void FinishRegularizeCurrent();       // Regularize the currents along the axis
   void EnforceAxisBoundary(int side);   // Enforce the boundary conditions (along X2)
   void ReconstructBx2s();               // Reconstruct BX2s in the ghost zone using divB=0
   void ShowConfig();
 
 
-  void SymmetrizeEx1Side(int);         // Symmetrize on a specific side (internal method)
-  void RegularizeEx3side(int);         // Regularize Ex3 along the axis (internal method)
-  void RegularizeCurrentSide(int);      // Regularize J along the axis (internal method)
-  void FixBx2sAxis(int side);           // Fix BX2s on the axis using the field around it (internal)
+  void FixBx2sAxis();                   // Fix BX2s on the axis using the field around it (internal)
   void FixBx2sAxisGhostAverage(int side); //Fix BX2s on the axis using the average of neighbouring
                                           // cell in theta direction (like Athena)
-  void ExchangeMPI(int side);           // Function has to be public for GPU, but its technically
+  void ExchangeMPI();                   // Function has to be public for GPU, but its technically
                                         // a private function
 
 
@@ -50,9 +52,13 @@ class Axis {
   bool needMPIExchange = false;
   bool haveMHD = false;
   int nVar;
+  // Range of the sides lying on the axis (0: left, 1: right), treated by the same kernels
+  int sideBeg{0};
+  int sideEnd{0};
 
   enum {faceTop, faceBot};
 #ifdef WITH_MPI
+  // Ghost zones of all of the sides lying on the axis, exchanged in a single message
   MPI_Request sendRequest;
   MPI_Request recvRequest;
 
@@ -64,13 +70,16 @@ class Axis {
   IdefixArray1D<int>  mapVars;
   int mapNVars{0};
 
+  MPI_Request sumRequest{MPI_REQUEST_NULL};
 #endif
   void InitMPI();
 
-  IdefixArray1D<real> Ex1Avg;
-  IdefixArray2D<real> BAvg;
-  bool haveCurrent;
-  IdefixArray2D<real> JAvg;
+  // Sums around the axis (component, side, i), reduced at once over the processes sharing the
+  // axis. Only one sum can be reduced at a time.
+  IdefixArray3D<real> axisSum;
+  void StartAxisSum(int ncomp);         // Start the reduction of the first ncomp components
+  void WaitAxisSum();
+
   IdefixArray1D<int> symmetryVc;
   IdefixArray1D<int> symmetryVs;
 
@@ -101,7 +110,6 @@ Axis::Axis(Boundary<Phys> *boundary) {
   data = boundary->data;
   haveMHD = Phys::mhd;
   nVar = boundary->nVar;
-  haveCurrent = boundary->fluid->haveCurrent;
 
 
   #if GEOMETRY != SPHERICAL
@@ -128,6 +136,8 @@ Axis::Axis(Boundary<Phys> *boundary) {
   // Check where the axis is lying.
   if(data->lbound[JDIR] == axis) axisLeft = true;
   if(data->rbound[JDIR] == axis) axisRight = true;
+  sideBeg = axisLeft ? 0 : 1;
+  sideEnd = axisRight ? 2 : 1;
 
   // Init the symmetry array (used to flip the signs of arrays accross the axis)
   symmetryVc = IdefixArray1D<int>("Axis:SymmetryVc",nVar);
@@ -160,11 +170,7 @@ Axis::Axis(Boundary<Phys> *boundary) {
     }
     Kokkos::deep_copy(symmetryVs, symmetryVsHost);
 
-    this->Ex1Avg = IdefixArray1D<real>("Axis:Ex1Avg",data->np_tot[IDIR]);
-    this->BAvg = IdefixArray2D<real>("Axis:BxAvg",data->np_tot[IDIR],2);
-    if(haveCurrent) {
-      this->JAvg = IdefixArray2D<real>("Axis:JAvg",data->np_tot[IDIR],3);
-    }
+    this->axisSum = IdefixArray3D<real>("Axis:Sum",2,2,data->np_tot[IDIR]);
   }
 
   #ifdef WITH_MPI
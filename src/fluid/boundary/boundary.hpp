@@ -39,6 +39,8 @@ class Boundary {
  public:
   explicit Boundary(Fluid<Phys>*);
   void SetBoundaries(real);                         ///< Set the ghost zones in all directions
+  void EnforceInternalBoundary(real);           ///< call the user-defined internal boundary
+  void SetBoundariesDir(real, int);      ///< exchange and set the ghost zones in direction dir
   void EnforceBoundaryDir(real, int);             ///< write in the ghost zone in specific direction
   void ReconstructVcField(IdefixArray4D<real> &);  ///< reconstruct cell-centered magnetic field
   void ReconstructNormalField(int dir);           ///< reconstruct normal field using divB=0
@@ -235,7 +237,22 @@ void Boundary<Phys>::EnforceFluxBoundaries(int dir,const real t) {
 template<typename Phys>
 void Boundary<Phys>::SetBoundaries(real t) {
   idfx::pushRegion("Boundary::SetBoundaries");
-  // set internal boundary conditions
+  EnforceInternalBoundary(t);
+  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
+    SetBoundariesDir(t, dir);
+  }
+
+  if constexpr(Phys::mhd) {
+    // Remake the cell-centered field.
+    ReconstructVcField(this->Vc);
+  }
+
+  idfx::popRegion();
+}
+
+// set internal boundary conditions
+template<typename Phys>
+void Boundary<Phys>::EnforceInternalBoundary(real t) {
   if(haveInternalBoundary) {
     idfx::pushRegion("Boundary::UserDefInternalBoundary");
     if(internalBoundaryFunc != NULL) {
@@ -245,36 +262,33 @@ void Boundary<Phys>::SetBoundaries(real t) {
     }
     idfx::popRegion();
   }
-  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
-      // MPI Exchange data when needed
-    #ifdef WITH_MPI
-    if(data->mygrid->nproc[dir]>1) {
-      switch(dir) {
-        case 0:
-          mpi.ExchangeX1(this->Vc, this->Vs);
-          break;
-        case 1:
-          mpi.ExchangeX2(this->Vc, this->Vs);
-          break;
-        case 2:
-          mpi.ExchangeX3(this->Vc, this->Vs);
-          break;
-      }
-    }
-    #endif
-    EnforceBoundaryDir(t, dir);
-    if constexpr(Phys::mhd) {
-      // Reconstruct the normal field component when using CT
-      ReconstructNormalField(dir);
-    }
-  } // Loop on dimension ends
+}
 
+// Set the ghost zones of a single direction. The directions should be processed in order, since
+// the exchanges of a direction include the ghost zones of the previous ones.
+template<typename Phys>
+void Boundary<Phys>::SetBoundariesDir(real t, int dir) {
+  // MPI Exchange data when needed
+  #ifdef WITH_MPI
+  if(data->mygrid->nproc[dir]>1) {
+    switch(dir) {
+      case 0:
+        mpi.ExchangeX1(this->Vc, this->Vs);
+        break;
+      case 1:
+        mpi.ExchangeX2(this->Vc, this->Vs);
+        break;
+      case 2:
+        mpi.ExchangeX3(this->Vc, this->Vs);
+        break;
+    }
+  }
+  #endif
+  EnforceBoundaryDir(t, dir);
   if constexpr(Phys::mhd) {
-    // Remake the cell-centered field.
-    ReconstructVcField(this->Vc);
+    // Reconstruct the normal field component when using CT
+    ReconstructNormalField(dir);
   }
-
-  idfx::popRegion();
 }
 
 
@@ -388,6 +402,8 @@ void Boundary<Phys>::ReconstructVcField(IdefixArray4D<real> &Vc) {
   IdefixArray4D<real> Vs=this->Vs;
 
   // Reconstruct cell average field when using CT
+  // (each component reads one face value and writes one cell value)
+  IDEFIX_KERNEL_COST("ReconstructVcMagField", 2*DIMENSIONS*sizeof(real), 2*DIMENSIONS);
   idefix_for("ReconstructVcMagField",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i) {
       D_EXPAND( Vc(BX1,k,j,i) = HALF_F * (Vs(BX1s,k,j,i) + Vs(BX1s,k,j,i+1)) ;  ,
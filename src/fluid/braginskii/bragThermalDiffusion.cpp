@@ -18,7 +18,31 @@
 #include "fluid.hpp"
 #include "eos.hpp"
 
-
+void BragThermalDiffusion::InitArrays() {
+  // Allocate and fill arrays when needed
+  #if GEOMETRY == SPHERICAL
+    one_sinx2 = IdefixArray1D<real>("BragThermalDiffusion_1sinx2", data->np_tot[JDIR]);
+    one_sinx2m = IdefixArray1D<real>("BragThermalDiffusion_1sinx2m", data->np_tot[JDIR]);
+    IdefixArray1D<real> s_1 = one_sinx2;
+    IdefixArray1D<real> sm_1 = one_sinx2m;
+    IdefixArray1D<real> sinx2 = data->sinx2;
+    IdefixArray1D<real> sinx2m = data->sinx2m;
+    idefix_for("BragThermalDiffusionInitGeometry",0,data->np_tot[JDIR],
+      KOKKOS_LAMBDA(int j) {
+        // Trick to ensure that the axis does not lead to Nans
+        s_1(j) = FABS(sinx2(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/sinx2(j);
+        sm_1(j) = FABS(sinx2m(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/sinx2m(j);
+      });
+  #endif
+  temperature = IdefixArray3D<real>("BragThermalDiffusion_temperature", data->np_tot[KDIR],
+                                                                        data->np_tot[JDIR],
+                                                                        data->np_tot[IDIR]);
+  if(haveSlopeLimiter) {
+    slopeT = IdefixArray4D<real>("BragThermalDiffusion_slopeT", DIMENSIONS, data->np_tot[KDIR],
+                                                                            data->np_tot[JDIR],
+                                                                            data->np_tot[IDIR]);
+  }
+}
 
 void BragThermalDiffusion::ShowConfig() {
   if(status.status==Constant) {
@@ -30,6 +54,7 @@ void BragThermalDiffusion::ShowConfig() {
     if(!diffusivityFunc) {
       IDEFIX_ERROR("No braginskii thermal diffusion function has been enrolled");
     }
+    refresh.ShowConfig("Braginskii Thermal Diffusion");
   } else {
     IDEFIX_ERROR("Unknown braginskii thermal diffusion mode");
   }
@@ -38,6 +63,8 @@ void BragThermalDiffusion::ShowConfig() {
   } else if(status.isRKL) {
     idfx::cout << "Braginskii Thermal Diffusion: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(status.isImplicit) {
+    idfx::cout << "Braginskii Thermal Diffusion: uses an implicit time integration." << std::endl;
   } else {
     IDEFIX_ERROR("Unknown time integrator for braginskii thermal diffusion.");
   }
@@ -14,6 +14,7 @@
 #include "input.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "diffusivityRefresh.hpp"
 #include "eos.hpp"
 #include "slopeLimiter.hpp"
 
@@ -37,12 +38,27 @@ class BragThermalDiffusion {
   // Enroll user-defined thermal conductivity
   void EnrollBragThermalDiffusivity(BragDiffusivityFunc);
 
+  // Functions for internal use (but public to allow for Cuda lambda capture)
+  void InitArrays();
+  template<const PLMLimiter>
+  void PrecomputeGradients();
+
   IdefixArray3D<real> heatSrc;  // Source terms of the thermal operator
   IdefixArray3D<real> knorArr;
   IdefixArray3D<real> kparArr;
 
+  // Temperature and its limited slopes in each direction, computed once per stage
+  // (in the IDIR sweep) and shared by the three flux sweeps
+  IdefixArray3D<real> temperature;
+  IdefixArray4D<real> slopeT;
+
+  // Refresh policy of knorArr and kparArr when they are user-defined
+  DiffusivityRefresh refresh;
+
   // pre-computed geometrical factors in non-cartesian geometry
   IdefixArray1D<real> one_dmu;
+  IdefixArray1D<real> one_sinx2;    // 1/sin(theta) in the cells (0 on the axis)
+  IdefixArray1D<real> one_sinx2m;   // 1/sin(theta) on the faces (0 on the axis)
 
  private:
   DataBlock *data;
@@ -110,6 +126,7 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
       this->knorArr = IdefixArray3D<real>("BragThermalDiffusionKnorArray",data->np_tot[KDIR],
                                                                data->np_tot[JDIR],
                                                                data->np_tot[IDIR]);
+      this->refresh = DiffusivityRefresh(input, "Hydro", "bragTDiffusion");
     } else {
       IDEFIX_ERROR("Unknown braginskii thermal diffusion definition in idefix.ini. "
                    "Can only be constant or userdef.");
@@ -127,55 +144,38 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
                  "with the ISOTHERMAL approximation");
   #endif
 
+  InitArrays();
+
   idfx::popRegion();
 }
 
 //We now define spatial derivative macros for the temperature field.
 //    The temperature is not a primitive variable
 //    and therefore not available as such in the DataBlock.
-//    It is rather defined as PRS/RHO.
+//    It is rather defined as PRS/RHO, and computed once per stage in the temperature array.
 //    Special spatial derivative macros are therefore needed and defined here
 //    directly at the right cell interface according to the direciton of the flux.
-#define D_DX_I_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j,i - 1)/q(RHO,k,j,i - 1))
-#define D_DY_J_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k,j - 1,i)/q(RHO,k,j - 1,i))
-#define D_DZ_K_T(q)  (q(PRS,k,j,i)/q(RHO,k,j,i) - q(PRS,k - 1,j,i)/q(RHO,k - 1,j,i))
-
-#define SL_DX_T(q,k,j,i)  (q(PRS,k,j,i)/q(RHO,k,j,i)           \
-                                        - q(PRS,k,j,i - 1)/q(RHO,k,j,i - 1))
-#define SL_DY_T(q,k,j,i)  (q(PRS,k,j,i)/q(RHO,k,j,i)            \
-                                        - q(PRS,k,j - 1,i)/q(RHO,k,j - 1,i))
-#define SL_DZ_T(q,k,j,i)  (q(PRS,k,j,i)/q(RHO,k,j,i)            \
-                                        - q(PRS,k - 1,j,i)/q(RHO,k - 1,j,i))
-
-#define D_DY_I_T(q)  (  0.25*(q(PRS,k,j + 1,i    ) / q(RHO,k,j + 1,i)          \
-                                  + q(PRS,k,j + 1,i - 1) / q(RHO,k,j + 1,i - 1))     \
-                            - 0.25*(q(PRS,k,j - 1,i)     / q(RHO,k,j - 1,i)          \
-                                  + q(PRS,k,j - 1,i - 1) / q(RHO,k,j - 1,i - 1)))
-
-#define D_DZ_I_T(q)  (  0.25*(q(PRS,k + 1,j,i)     / q(RHO,k + 1,j,i)       \
-                                  + q(PRS,k + 1,j,i - 1) / q(RHO,k + 1,j,i - 1))  \
-                            - 0.25*(q(PRS,k - 1,j,i)     / q(RHO,k - 1,j,i)       \
-                                  + q(PRS,k - 1,j,i - 1) / q(RHO,k - 1,j,i - 1)))
-
-#define D_DX_J_T(q)  (  0.25*(q(PRS,k,j,i + 1)     / q(RHO,k,j,i + 1)      \
-                                  + q(PRS,k,j - 1,i + 1) / q(RHO,k,j - 1,i + 1)) \
-                            - 0.25*(q(PRS,k,j,i - 1)     / q(RHO,k,j,i - 1)      \
-                                  + q(PRS,k,j - 1,i - 1) / q(RHO,k,j - 1,i - 1)))
-
-#define D_DZ_J_T(q)  (  0.25*(q(PRS,k + 1,j,i)     / q(RHO,k + 1,j,i)       \
-                                  + q(PRS,k + 1,j - 1,i) / q(RHO,k + 1,j - 1,i))  \
-                            - 0.25*(q(PRS,k - 1,j,i)     / q(RHO,k - 1,j,i)       \
-                                  + q(PRS,k - 1,j - 1,i) / q(RHO,k - 1,j - 1,i)))
-
-#define D_DX_K_T(q)  (  0.25*(q(PRS,k,j,i + 1)     / q(RHO,k,j,i + 1)      \
-                                  + q(PRS,k - 1,j,i + 1) / q(RHO,k - 1,j,i + 1)) \
-                            - 0.25*(q(PRS,k,j,i - 1)     / q(RHO,k,j,i - 1)      \
-                                  + q(PRS,k - 1,j,i - 1) / q(RHO,k - 1,j,i - 1)))
-
-#define D_DY_K_T(q)  (  0.25*(q(PRS,k,j + 1,i)     / q(RHO,k,j + 1,i)       \
-                                  + q(PRS,k - 1,j + 1,i) / q(RHO,k - 1,j + 1,i))  \
-                            - 0.25*(q(PRS,k,j - 1,i)     / q(RHO,k,j - 1,i)       \
-                                  + q(PRS,k - 1,j - 1,i) / q(RHO,k - 1,j - 1,i))) \
+#define D_DX_I_T(T)  (T(k,j,i) - T(k,j,i - 1))
+#define D_DY_J_T(T)  (T(k,j,i) - T(k,j - 1,i))
+#define D_DZ_K_T(T)  (T(k,j,i) - T(k - 1,j,i))
+
+#define D_DY_I_T(T)  (  0.25*(T(k,j + 1,i) + T(k,j + 1,i - 1))   \
+                            - 0.25*(T(k,j - 1,i) + T(k,j - 1,i - 1)))
+
+#define D_DZ_I_T(T)  (  0.25*(T(k + 1,j,i) + T(k + 1,j,i - 1))   \
+                            - 0.25*(T(k - 1,j,i) + T(k - 1,j,i - 1)))
+
+#define D_DX_J_T(T)  (  0.25*(T(k,j,i + 1) + T(k,j - 1,i + 1))   \
+                            - 0.25*(T(k,j,i - 1) + T(k,j - 1,i - 1)))
+
+#define D_DZ_J_T(T)  (  0.25*(T(k + 1,j,i) + T(k + 1,j - 1,i))   \
+                            - 0.25*(T(k - 1,j,i) + T(k - 1,j - 1,i)))
+
+#define D_DX_K_T(T)  (  0.25*(T(k,j,i + 1) + T(k - 1,j,i + 1))   \
+                            - 0.25*(T(k,j,i - 1) + T(k - 1,j,i - 1)))
+
+#define D_DY_K_T(T)  (  0.25*(T(k,j + 1,i) + T(k - 1,j + 1,i))   \
+                            - 0.25*(T(k,j - 1,i) + T(k - 1,j - 1,i)))
 
 //We now define spatial average macros for the magnetic field.
 //    The magnetic field appears in the expression of the Braginskii heat flux.
@@ -197,7 +197,63 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
              + Vs(BX2s,k - 1,j,i) + Vs(BX2s,k - 1,j + 1,i)))
 
 
-// (this avoids an extra array)
+// Compute the temperature and, with a slope limiter, its limited slope in each direction.
+// These only depend on Vc, so that they are computed once per stage and shared by the
+// three flux sweeps.
+template <PLMLimiter limTemplate>
+void BragThermalDiffusion::PrecomputeGradients() {
+  idfx::pushRegion("BragThermalDiffusion::PrecomputeGradients");
+
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray3D<real> T = this->temperature;
+  IdefixArray4D<real> slopeT = this->slopeT;
+  using SL = SlopeLimiter<limTemplate>;
+
+  idefix_for("BragTemperature",0,data->np_tot[KDIR],
+                               0,data->np_tot[JDIR],
+                               0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      T(k,j,i) = Vc(PRS,k,j,i)/Vc(RHO,k,j,i);
+    });
+
+  if(haveSlopeLimiter) {
+    IdefixArray1D<real> dx1 = this->data->dx[IDIR];
+    IdefixArray1D<real> dx2 = this->data->dx[JDIR];
+    IdefixArray1D<real> dx3 = this->data->dx[KDIR];
+
+    // The slopes are defined in every cell which has two neighbours in each direction
+    int jbeg = 0;
+    int jend = data->np_tot[JDIR];
+    int kbeg = 0;
+    int kend = data->np_tot[KDIR];
+    #if DIMENSIONS >= 2
+      jbeg++;
+      jend--;
+    #endif
+    #if DIMENSIONS == 3
+      kbeg++;
+      kend--;
+    #endif
+
+    idefix_for("BragTemperatureSlopes",kbeg,kend,jbeg,jend,1,data->np_tot[IDIR]-1,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        slopeT(IDIR,k,j,i) = SL::PLMLim((T(k,j,i) - T(k,j,i-1))/dx1(i),
+                                        (T(k,j,i+1) - T(k,j,i))/dx1(i+1));
+        #if DIMENSIONS >= 2
+          slopeT(JDIR,k,j,i) = SL::PLMLim((T(k,j,i) - T(k,j-1,i))/dx2(j),
+                                          (T(k,j+1,i) - T(k,j,i))/dx2(j+1));
+        #endif
+        #if DIMENSIONS == 3
+          slopeT(KDIR,k,j,i) = SL::PLMLim((T(k,j,i) - T(k-1,j,i))/dx3(k),
+                                          (T(k+1,j,i) - T(k,j,i))/dx3(k+1));
+        #endif
+      });
+  }
+  idfx::popRegion();
+}
+
+// The limited transverse gradients on a face are the limited average of the slopes of the two
+// cells sharing this face
 template <PLMLimiter limTemplate>
 void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
                                                 const IdefixArray4D<real> &Flux) {
@@ -225,28 +281,15 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
   if(dir==JDIR) jend++;
   if(dir==KDIR) kend++;
 
-  IdefixArray1D<real> dx = this->data->dx[dir];
-
-  #if GEOMETRY == SPHERICAL
-    IdefixArray1D<real> rt   = this->data->rt;
-    IdefixArray1D<real> dmu  = this->data->dmu;
-  #endif
-
   IdefixArray1D<real> x1 = this->data->x[IDIR];
-  IdefixArray1D<real> x2 = this->data->x[JDIR];
-  IdefixArray1D<real> x3 = this->data->x[KDIR];
   IdefixArray1D<real> x1l = this->data->xl[IDIR];
-  IdefixArray1D<real> x2l = this->data->xl[JDIR];
-  IdefixArray1D<real> x3l = this->data->xl[KDIR];
   IdefixArray1D<real> dx1 = this->data->dx[IDIR];
   IdefixArray1D<real> dx2 = this->data->dx[JDIR];
   IdefixArray1D<real> dx3 = this->data->dx[KDIR];
 
   #if GEOMETRY == SPHERICAL
-  IdefixArray1D<real> sinx2 = this->data->sinx2;
-  IdefixArray1D<real> tanx2 = this->data->tanx2;
-  IdefixArray1D<real> sinx2m = this->data->sinx2m;
-  IdefixArray1D<real> tanx2m = this->data->tanx2m;
+  IdefixArray1D<real> one_sinx2 = this->one_sinx2;
+  IdefixArray1D<real> one_sinx2m = this->one_sinx2m;
   #endif
   real knorConstant = this->knor;
   real kparConstant = this->kpar;
@@ -255,14 +298,22 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
 
   if(haveThermalDiffusion == UserDefFunction && dir == IDIR) {
     if(diffusivityFunc) {
-      idfx::pushRegion("UserDef::BragThermalDiffusivityFunction");
-      diffusivityFunc(*this->data, t, kparArr, knorArr);
-      idfx::popRegion();
+      if(refresh.NeedsRefresh(*this->data)) {
+        idfx::pushRegion("UserDef::BragThermalDiffusivityFunction");
+        diffusivityFunc(*this->data, t, kparArr, knorArr);
+        idfx::popRegion();
+      }
     } else {
       IDEFIX_ERROR("No user-defined thermal diffusion function has been enrolled");
     }
   }
 
+  // Vc does not change between the sweeps of a stage
+  if(dir == IDIR) PrecomputeGradients<limTemplate>();
+
+  IdefixArray3D<real> T = this->temperature;
+  IdefixArray4D<real> slopeT = this->slopeT;
+
   idefix_for("BragDiffusiveFlux",kbeg, kend, jbeg, jend, ibeg, iend,
     KOKKOS_LAMBDA (int k, int j, int i) {
       real knor, kpar;
@@ -298,97 +349,65 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
         Bn = BX_I;
 
         #if GEOMETRY == CARTESIAN
-          dTi = D_DX_I_T(Vc)/dx1(i);
+          dTi = D_DX_I_T(T)/dx1(i);
           #if DIMENSIONS >= 2
             if (haveSlopeLimiter) {
-              dTj = SL::PLMLim(SL_DY_T(Vc,k,j,i-1)/dx2(j),
-                                 SL_DY_T(Vc,k,j+1,i-1)/dx2(j+1));
-              dTj = SL::PLMLim(dTj,
-                                 SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                              SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
+              dTj = SL::PLMLim(slopeT(JDIR,k,j,i-1), slopeT(JDIR,k,j,i));
             } else {
-              dTj = D_DY_I_T(Vc)/dx2(j);
+              dTj = D_DY_I_T(T)/dx2(j);
             }
             #if DIMENSIONS == 3
               if (haveSlopeLimiter) {
-                dTk = SL::PLMLim(SL_DZ_T(Vc,k,j,i-1)/dx3(k),
-                                   SL_DZ_T(Vc,k+1,j,i-1)/dx3(k+1));
-                dTk = SL::PLMLim(dTk,
-                                   SL::PLMLim(SL_DZ_T(Vc,k,j,i)/dx3(k),
-                                                SL_DZ_T(Vc,k+1,j,i)/dx3(k+1)));
+                dTk = SL::PLMLim(slopeT(KDIR,k,j,i-1), slopeT(KDIR,k,j,i));
               } else {
-                dTk = D_DZ_I_T(Vc)/dx3(k);
+                dTk = D_DZ_I_T(T)/dx3(k);
               }
             #endif
           #endif
         #elif GEOMETRY == CYLINDRICAL
-          dTi = D_DX_I_T(Vc)/dx1(i);
+          dTi = D_DX_I_T(T)/dx1(i);
           #if DIMENSIONS >= 2
             if (haveSlopeLimiter) {
-              dTj = SL::PLMLim(SL_DY_T(Vc,k,j,i-1)/dx2(j),
-                                 SL_DY_T(Vc,k,j+1,i-1)/dx2(j+1));
-              dTj = SL::PLMLim(dTj,
-                                 SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                              SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
+              dTj = SL::PLMLim(slopeT(JDIR,k,j,i-1), slopeT(JDIR,k,j,i));
             } else {
-              dTj = D_DY_I_T(Vc)/dx2(j);
+              dTj = D_DY_I_T(T)/dx2(j);
             }
           #endif
           // No cylindrical geometry in 3D!
         #elif GEOMETRY == POLAR
-          dTi = D_DX_I_T(Vc)/dx1(i);
+          dTi = D_DX_I_T(T)/dx1(i);
           #if DIMENSIONS >= 2
             if (haveSlopeLimiter) {
-              dTj = 1./x1(i-1)*SL::PLMLim(SL_DY_T(Vc,k,j,i-1)/dx2(j),
-                                            SL_DY_T(Vc,k,j+1,i-1)/dx2(j+1));
-              dTj = SL::PLMLim(dTj,
-                                 1./x1(i)*SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                                       SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
+              dTj = SL::PLMLim(1./x1(i-1)*slopeT(JDIR,k,j,i-1),
+                               1./x1(i)*slopeT(JDIR,k,j,i));
             } else {
-              dTj = 1./x1l(i)*D_DY_I_T(Vc)/dx2(j); // 1/r dTj/dxj
+              dTj = 1./x1l(i)*D_DY_I_T(T)/dx2(j); // 1/r dTj/dxj
             }
             #if DIMENSIONS == 3
               if (haveSlopeLimiter) {
-                dTk = SL::PLMLim(SL_DZ_T(Vc,k,j,i-1)/dx3(k),
-                                   SL_DZ_T(Vc,k+1,j,i-1)/dx3(k+1));
-                dTk = SL::PLMLim(dTk,
-                                   SL::PLMLim(SL_DZ_T(Vc,k,j,i)/dx3(k),
-                                                SL_DZ_T(Vc,k+1,j,i)/dx3(k+1)));
+                dTk = SL::PLMLim(slopeT(KDIR,k,j,i-1), slopeT(KDIR,k,j,i));
               } else {
-                dTk = D_DZ_I_T(Vc)/dx3(k);
+                dTk = D_DZ_I_T(T)/dx3(k);
               }
             #endif
           #endif
         #elif GEOMETRY == SPHERICAL
-            real s_1 = sinx2(j);
-
-            // Trick to ensure that the axis does not lead to Nans
-          if(FABS(s_1) < SMALL_NUMBER) {
-              s_1 = ZERO_F;
-            } else {
-              s_1 = ONE_F/s_1;
-            }
+          [[maybe_unused]] real s_1 = one_sinx2(j);
 
-          dTi = D_DX_I_T(Vc)/dx1(i);
+          dTi = D_DX_I_T(T)/dx1(i);
           #if DIMENSIONS >= 2
             if (haveSlopeLimiter) {
-              dTj = 1./x1(i-1)*SL::PLMLim(SL_DY_T(Vc,k,j,i-1)/dx2(j),
-                                            SL_DY_T(Vc,k,j+1,i-1)/dx2(j+1));
-              dTj = SL::PLMLim(dTj,
-                    1./x1(i)*SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                          SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
+              dTj = SL::PLMLim(1./x1(i-1)*slopeT(JDIR,k,j,i-1),
+                               1./x1(i)*slopeT(JDIR,k,j,i));
             } else {
-              dTj = 1./x1l(i)*D_DY_I_T(Vc)/dx2(j); // 1/r dTj/dxj
+              dTj = 1./x1l(i)*D_DY_I_T(T)/dx2(j); // 1/r dTj/dxj
             }
             #if DIMENSIONS == 3
               if (haveSlopeLimiter) {
-                dTk = s_1/x1(i-1)*SL::PLMLim(SL_DZ_T(Vc,k,j,i-1)/dx3(k),
-                                               SL_DZ_T(Vc,k+1,j,i-1)/dx3(k+1));
-                dTk = SL::PLMLim(dTk,
-                                   s_1/x1(i)*SL::PLMLim(SL_DZ_T(Vc,k,j,i)/dx3(k),
-                                                          SL_DZ_T(Vc,k+1,j,i)/dx3(k+1)));
+                dTk = SL::PLMLim(s_1/x1(i-1)*slopeT(KDIR,k,j,i-1),
+                                 s_1/x1(i)*slopeT(KDIR,k,j,i));
               } else {
-                dTk = s_1/x1l(i)*D_DZ_I_T(Vc)/dx3(k);
+                dTk = s_1/x1l(i)*D_DZ_I_T(T)/dx3(k);
               }
             #endif
           #endif
@@ -421,109 +440,41 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
                 Bk = BZ_J; )
         Bn = BY_J;
 
+        if (haveSlopeLimiter) {
+          dTi = SL::PLMLim(slopeT(IDIR,k,j-1,i), slopeT(IDIR,k,j,i));
+        } else {
+          dTi = D_DX_J_T(T)/dx1(i);
+        }
         #if GEOMETRY == CARTESIAN
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx1(i),
-                              SL_DX_T(Vc,k,j-1,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-          } else {
-            dTi = D_DX_J_T(Vc)/dx1(i);
-          }
-          dTj = D_DY_J_T(Vc)/dx2(j);
+          dTj = D_DY_J_T(T)/dx2(j);
           #if DIMENSIONS == 3
             if (haveSlopeLimiter) {
-              dTk = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx3(k),
-                                 SL_DX_T(Vc,k+1,j-1,i)/dx3(k+1));
-              dTk = SL::PLMLim(dTk,
-                                 SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx3(k),
-                                              SL_DX_T(Vc,k+1,j,i)/dx3(k+1)));
+              dTk = SL::PLMLim(slopeT(KDIR,k,j-1,i), slopeT(KDIR,k,j,i));
             } else {
-              dTk = D_DZ_J_T(Vc)/dx3(k);
+              dTk = D_DZ_J_T(T)/dx3(k);
             }
           #endif
         #elif GEOMETRY == CYLINDRICAL
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx1(i),
-                               SL_DX_T(Vc,k,j-1,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-          } else {
-            dTi = D_DX_J_T(Vc)/dx1(i);
-          }
-          dTj = D_DY_J_T(Vc)/dx2(j);
+          dTj = D_DY_J_T(T)/dx2(j);
           // No cylindrical geometry in 3D!
         #elif GEOMETRY == POLAR
           //gradT = ... + 1/r dT/dtheta + ...
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx1(i),
-                               SL_DX_T(Vc,k,j-1,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-          } else {
-            dTi = D_DX_J_T(Vc)/dx1(i);
-          }
-          dTj = 1./x1(i)*D_DY_J_T(Vc)/dx2(j);
+          dTj = 1./x1(i)*D_DY_J_T(T)/dx2(j);
           #if DIMENSIONS == 3
             if (haveSlopeLimiter) {
-              dTk = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx3(k),
-                                 SL_DX_T(Vc,k+1,j-1,i)/dx3(k+1));
-              dTk = SL::PLMLim(dTk,
-                                 SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx3(k),
-                                              SL_DX_T(Vc,k+1,j,i)/dx3(k+1)));
+              dTk = SL::PLMLim(slopeT(KDIR,k,j-1,i), slopeT(KDIR,k,j,i));
             } else {
-              dTk = D_DZ_J_T(Vc)/dx3(k);
+              dTk = D_DZ_J_T(T)/dx3(k);
             }
           #endif
         #elif GEOMETRY == SPHERICAL
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx1(i),
-                               SL_DX_T(Vc,k,j-1,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-          } else {
-            dTi = D_DX_J_T(Vc)/dx1(i);
-          }
-          dTj = 1./x1(i)*D_DY_J_T(Vc)/dx2(j);
+          dTj = 1./x1(i)*D_DY_J_T(T)/dx2(j);
           #if DIMENSIONS == 3
             if (haveSlopeLimiter) {
-              real s_1 = sinx2(j-1);
-
-              // Trick to ensure that the axis does not lead to Nans
-              if(FABS(s_1) < SMALL_NUMBER) {
-                s_1 = ZERO_F;
-              } else {
-                s_1 = ONE_F/s_1;
-              }
-              dTk = s_1/x1(i)*SL::PLMLim(SL_DX_T(Vc,k,j-1,i)/dx3(k),
-                                           SL_DX_T(Vc,k+1,j-1,i)/dx3(k+1));
-
-              s_1 = sinx2(j);
-
-              // Trick to ensure that the axis does not lead to Nans
-              if(FABS(s_1) < SMALL_NUMBER) {
-                s_1 = ZERO_F;
-              } else {
-                s_1 = ONE_F/s_1;
-              }
-              dTk = s_1/x1(i)*SL::PLMLim(dTk,
-                                           SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx3(k),
-                                                        SL_DX_T(Vc,k+1,j,i)/dx3(k+1)));
+              dTk = SL::PLMLim(one_sinx2(j-1)/x1(i)*slopeT(KDIR,k,j-1,i),
+                               one_sinx2(j)/x1(i)*slopeT(KDIR,k,j,i));
             } else {
-              real s_1 = sinx2m(j);
-
-              // Trick to ensure that the axis does not lead to Nans
-              if(FABS(s_1) < SMALL_NUMBER) {
-                s_1 = ZERO_F;
-              } else {
-                s_1 = ONE_F/s_1;
-              }
-
-              dTk = s_1/x1(i)*D_DZ_J_T(Vc)/dx3(k);
+              dTk = one_sinx2m(j)/x1(i)*D_DZ_J_T(T)/dx3(k);
             }
           #endif
         #endif // GEOMETRY
@@ -554,71 +505,27 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
         Bk = BZ_K;
         Bn = Bk;
 
-        #if GEOMETRY == CARTESIAN
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k-1,j,i)/dx1(i),
-                               SL_DX_T(Vc,k-1,j,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-            dTj = SL::PLMLim(SL_DY_T(Vc,k-1,j,i)/dx2(j),
-                               SL_DY_T(Vc,k-1,j+1,i)/dx2(j+1));
-            dTj = SL::PLMLim(dTj,
-                               SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                            SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
-          } else {
-            dTi = D_DX_K_T(Vc)/dx1(i);
-            dTj = D_DY_K_T(Vc)/dx2(j);
-          }
-          dTk = D_DZ_K_T(Vc)/dx3(k);
-        // No cylindrical geometry in 3D!
-        #elif GEOMETRY == POLAR
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k-1,j,i)/dx1(i),
-                               SL_DX_T(Vc,k-1,j,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-            dTj = SL::PLMLim(SL_DY_T(Vc,k-1,j,i)/dx2(j),
-                               SL_DY_T(Vc,k-1,j+1,i)/dx2(j+1));
-            dTj = SL::PLMLim(dTj,
-                               SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                            SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
-            dTj *= 1./x1(i);
-          } else {
-            dTi = D_DX_K_T(Vc)/dx1(i);
-            dTj = 1./x1(i)*D_DY_K_T(Vc)/dx2(j); // 1/r dTj/dxj
-          }
-          dTk = D_DZ_K_T(Vc)/dx3(k);
-        #elif GEOMETRY == SPHERICAL
-            real s_1 = sinx2(j);
-
-          // Trick to ensure that the axis does not lead to Nans
-          if(FABS(s_1) < SMALL_NUMBER) {
-            s_1 = ZERO_F;
-          } else {
-            s_1 = ONE_F/s_1;
-          }
-
-          if (haveSlopeLimiter) {
-            dTi = SL::PLMLim(SL_DX_T(Vc,k-1,j,i)/dx1(i),
-                               SL_DX_T(Vc,k-1,j,i+1)/dx1(i+1));
-            dTi = SL::PLMLim(dTi,
-                               SL::PLMLim(SL_DX_T(Vc,k,j,i)/dx1(i),
-                                            SL_DX_T(Vc,k,j,i+1)/dx1(i+1)));
-            dTj = SL::PLMLim(SL_DY_T(Vc,k-1,j,i)/dx2(j),
-                               SL_DY_T(Vc,k-1,j+1,i)/dx2(j+1));
-            dTj = SL::PLMLim(dTj,
-                               SL::PLMLim(SL_DY_T(Vc,k,j,i)/dx2(j),
-                                            SL_DY_T(Vc,k,j+1,i)/dx2(j+1)));
+        if (haveSlopeLimiter) {
+          dTi = SL::PLMLim(slopeT(IDIR,k-1,j,i), slopeT(IDIR,k,j,i));
+          dTj = SL::PLMLim(slopeT(JDIR,k-1,j,i), slopeT(JDIR,k,j,i));
+          #if GEOMETRY == POLAR || GEOMETRY == SPHERICAL
             dTj *= 1./x1(i);
-          } else {
-            dTi = D_DX_K_T(Vc)/dx1(i);
-            dTj = 1./x1(i)*D_DY_K_T(Vc)/dx2(j); // 1/r dTj/dxj
-          }
-          dTk = s_1/x1(i)*D_DZ_K_T(Vc)/dx3(k);
+          #endif
+        } else {
+          dTi = D_DX_K_T(T)/dx1(i);
+          #if GEOMETRY == POLAR || GEOMETRY == SPHERICAL
+            dTj = 1./x1(i)*D_DY_K_T(T)/dx2(j); // 1/r dTj/dxj
+          #else
+            dTj = D_DY_K_T(T)/dx2(j);
+          #endif
+        }
+        #if GEOMETRY == SPHERICAL
           //gradT = ... + ... + 1/(r*sin(theta)) dTphi/dphi
-        #endif // GEOMETRY
+          dTk = one_sinx2(j)/x1(i)*D_DZ_K_T(T)/dx3(k);
+        #else
+          // No cylindrical geometry in 3D!
+          dTk = D_DZ_K_T(T)/dx3(k);
+        #endif
 
         real gamma_m1 = eos.GetGamma(Vc(PRS,k,j,i),Vc(RHO,k,j,i)) - ONE_F;
 
@@ -648,9 +555,6 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
 #undef D_DX_I_T
 #undef D_DY_J_T
 #undef D_DZ_K_T
-#undef SL_DX_T
-#undef SL_DY_T
-#undef SL_DZ_T
 #undef D_DY_I_T
 #undef D_DZ_I_T
 #undef D_DX_J_T
@@ -33,9 +33,199 @@ void BragViscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
+  #if GEOMETRY == SPHERICAL
+    one_sinx2 = IdefixArray1D<real>("BragViscosity_1sinx2", data->np_tot[JDIR]);
+    one_tanx2 = IdefixArray1D<real>("BragViscosity_1tanx2", data->np_tot[JDIR]);
+    one_sinx2m = IdefixArray1D<real>("BragViscosity_1sinx2m", data->np_tot[JDIR]);
+    one_tanx2m = IdefixArray1D<real>("BragViscosity_1tanx2m", data->np_tot[JDIR]);
+    IdefixArray1D<real> s_1 = one_sinx2;
+    IdefixArray1D<real> tan_1 = one_tanx2;
+    IdefixArray1D<real> sm_1 = one_sinx2m;
+    IdefixArray1D<real> tanm_1 = one_tanx2m;
+    IdefixArray1D<real> sinx2 = data->sinx2;
+    IdefixArray1D<real> tanx2 = data->tanx2;
+    IdefixArray1D<real> sinx2m = data->sinx2m;
+    IdefixArray1D<real> tanx2m = data->tanx2m;
+    idefix_for("BragViscosityInitAxis",0,data->np_tot[JDIR],
+      KOKKOS_LAMBDA(int j) {
+        // Trick to ensure that the axis does not lead to Nans
+        s_1(j) = FABS(sinx2(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/sinx2(j);
+        tan_1(j) = FABS(tanx2(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/tanx2(j);
+        sm_1(j) = FABS(sinx2m(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/sinx2m(j);
+        tanm_1(j) = FABS(tanx2m(j)) < SMALL_NUMBER ? ZERO_F : ONE_F/tanx2m(j);
+      });
+  #endif
   bragViscSrc = IdefixArray4D<real>("BragViscosity_source", COMPONENTS, data->np_tot[KDIR],
                                                                 data->np_tot[JDIR],
                                                                 data->np_tot[IDIR]);
+  #if GEOMETRY != CARTESIAN
+    stressSrc = IdefixArray4D<real>("BragViscosity_stressSource", COMPONENTS,
+                                                                  data->np_tot[KDIR],
+                                                                  data->np_tot[JDIR],
+                                                                  data->np_tot[IDIR]);
+  #endif
+}
+
+// Compute the cell-centred curvature source terms of the stress tensor in non-cartesian
+// geometries. They are stored in this->stressSrc, from which each flux sweep copies the
+// component of its direction.
+void BragViscosity::ComputeStressSource() {
+  #if GEOMETRY != CARTESIAN
+  idfx::pushRegion("BragViscosity::ComputeStressSource");
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<real> stressSrc = this->stressSrc;
+  IdefixArray3D<real> etaBragArr = this->etaBragArr;
+  IdefixArray1D<real> x1 = this->data->x[IDIR];
+  IdefixArray1D<real> dx1 = this->data->dx[IDIR];
+  IdefixArray1D<real> dx2 = this->data->dx[JDIR];
+  IdefixArray1D<real> dx3 = this->data->dx[KDIR];
+  #if GEOMETRY == SPHERICAL
+  IdefixArray1D<real> one_sinx2 = this->one_sinx2;
+  IdefixArray1D<real> one_tanx2 = this->one_tanx2;
+  #endif
+
+  HydroModuleStatus haveViscosity = this->status.status;
+  real etaBragConstant = this->etaBrag;
+
+  // The flux sweeps need the source terms up to the last face of their direction
+  int ibeg, iend, jbeg, jend, kbeg, kend;
+  ibeg = this->data->beg[IDIR];
+  iend = this->data->end[IDIR]+1;
+  jbeg = this->data->beg[JDIR];
+  jend = this->data->end[JDIR];
+  kbeg = this->data->beg[KDIR];
+  kend = this->data->end[KDIR];
+  #if DIMENSIONS >= 2
+    jend++;
+  #endif
+  #if DIMENSIONS == 3
+    kend++;
+  #endif
+
+  idefix_for("BragViscousStressSource",kbeg, kend, jbeg, jend, ibeg, iend,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real biC, bjC, bkC;
+      real BmagC;
+      real Pnor_parC;
+      real bbgradVC;
+      real etaBragC;
+
+      [[maybe_unused]] real tau_xyC, tau_yyC, tau_zzC;
+
+      [[maybe_unused]] real dVxiC, dVxjC, dVxkC;
+      [[maybe_unused]] real dVyiC, dVyjC, dVykC;
+      [[maybe_unused]] real dVziC, dVzjC, dVzkC;
+
+      real divVC;
+
+      biC = bjC = bkC = ZERO_F;
+      tau_xyC = tau_yyC = tau_zzC = ZERO_F;
+
+      dVxiC = dVxjC = dVxkC = ZERO_F;
+      dVyiC = dVyjC = dVykC = ZERO_F;
+      dVziC = dVzjC = dVzkC = ZERO_F;
+
+      if(haveViscosity == UserDefFunction) {
+        etaBragC = etaBragArr(k,j,i);
+      } else {
+        etaBragC = etaBragConstant;
+      }
+
+      //Compute values at the center of the cells, no slope limiter are used at this stage
+      EXPAND(  dVxiC = HALF_F*(Vc(VX1,k,j,i + 1) - Vc(VX1,k,j,i - 1))/dx1(i); ,
+               dVyiC = HALF_F*(Vc(VX2,k,j,i + 1) - Vc(VX2,k,j,i - 1))/dx1(i); ,
+               dVziC = HALF_F*(Vc(VX3,k,j,i + 1) - Vc(VX3,k,j,i - 1))/dx1(i); )
+      #if DIMENSIONS >= 2
+        EXPAND(  dVxjC = HALF_F*(Vc(VX1,k,j + 1,i) - Vc(VX1,k,j - 1,i))/dx2(j); ,
+                 dVyjC = HALF_F*(Vc(VX2,k,j + 1,i) - Vc(VX2,k,j - 1,i))/dx2(j); ,
+                 dVzjC = HALF_F*(Vc(VX3,k,j + 1,i) - Vc(VX3,k,j - 1,i))/dx2(j); )
+        #if DIMENSIONS == 3
+          EXPAND (  dVxkC = HALF_F*(Vc(VX1,k + 1,j,i) - Vc(VX1,k - 1,j,i))/dx3(k); ,
+                    dVykC = HALF_F*(Vc(VX2,k + 1,j,i) - Vc(VX2,k - 1,j,i))/dx3(k); ,
+                    dVzkC = HALF_F*(Vc(VX3,k + 1,j,i) - Vc(VX3,k - 1,j,i))/dx3(k); )
+        #endif
+      #endif
+
+      EXPAND(  biC = Vc(BX1,k,j,i); ,
+               bjC = Vc(BX2,k,j,i); ,
+               bkC = Vc(BX3,k,j,i); )
+
+      BmagC = EXPAND(  Vc(BX1,k,j,i)*Vc(BX1,k,j,i) ,
+                     + Vc(BX2,k,j,i)*Vc(BX2,k,j,i) ,
+                     + Vc(BX3,k,j,i)*Vc(BX3,k,j,i) );
+      if(BmagC< 0.001*SMALL_NUMBER) {
+         BmagC = sqrt(BmagC) + 0.000001*SMALL_NUMBER;
+      } else {
+         BmagC = sqrt(BmagC);
+      }
+      biC /= BmagC;
+      bjC /= BmagC;
+      bkC /= BmagC;
+
+      #if GEOMETRY == CYLINDRICAL
+        bbgradVC = D_EXPAND(
+                     biC*biC*dVxiC + biC*bjC*dVyiC + biC*bkC*(dVziC  - Vc(VX3,k,j,i)/x1(i)) ,
+                   + bjC*biC*dVxjC + bjC*bjC*dVyjC + bjC*bkC*dVzjC + bkC*bkC*Vc(VX1,k,j,i)/x1(i) ,
+                     );
+
+        divVC = D_EXPAND(dVxiC + Vc(VX1,k,j,i)/x1(i) ,
+                       + dVyjC ,
+                           );
+        // No cylindrical geometry in 3D!
+        Pnor_parC = 3.0*etaBragC*(bbgradVC - divVC/3.0);
+        tau_zzC = Pnor_parC*(bkC*bkC - 1./3.);
+
+        // No source term along the z-axis in cylindrical/polar coordinates
+        EXPAND( stressSrc(IDIR,k,j,i) = -tau_zzC/x1(i);  ,
+                stressSrc(JDIR,k,j,i) = ZERO_F;          ,
+                stressSrc(KDIR,k,j,i) = ZERO_F;          )
+      #elif GEOMETRY == POLAR
+        bbgradVC = EXPAND(
+          biC*biC*dVxiC                         + bjC*biC*1./x1(i)*dVxjC
+                                                                                + bkC*biC*dVxkC,
+        + biC*bjC*(dVyiC - Vc(VX2,k,j,i)/x1(i)) + bjC*bjC*(1./x1(i)*dVyjC + Vc(VX1,k,j,i)/x1(i))
+                                                                                + bkC*bjC*dVykC,
+        + biC*bkC*dVziC                         + bjC*bkC*1./x1(i)*dVzjC
+                                                                                + bkC*bkC*dVzkC
+                  );
+
+        divVC = D_EXPAND(dVxiC + Vc(VX1,k,j,i)/x1(i) ,
+                         + 1./x1(i)*dVyjC ,
+                         + dVzkC);
+        Pnor_parC = 3.0*etaBragC*(bbgradVC - divVC/3.0);
+        tau_yyC = Pnor_parC*(bjC*bjC - 1./3.);
+
+        // No source term along the z-axis in cylindrical/polar coordinates
+        EXPAND( stressSrc(IDIR,k,j,i) = -tau_yyC/x1(i);  ,
+                stressSrc(JDIR,k,j,i) = ZERO_F;          ,
+                stressSrc(KDIR,k,j,i) = ZERO_F;          )
+      #elif GEOMETRY == SPHERICAL
+        const real tan_1 = one_tanx2(j);
+        const real s_1 = one_sinx2(j);
+
+        bbgradVC = EXPAND(
+    biC*biC*dVxiC                         + bjC*biC*1./x1(i)*dVxjC
+                                                                          + bkC*biC*s_1/x1(i)*dVxkC,
+  + biC*bjC*(dVyiC - Vc(VX2,k,j,i)/x1(i)) + bjC*bjC*(1./x1(i)*dVyjC + Vc(VX1,k,j,i)/x1(i))
+                                                                          + bkC*bjC*s_1/x1(i)*dVykC,
+  + biC*bkC*(dVziC - Vc(VX3,k,j,i)/x1(i)) + bjC*bkC*(1./x1(i)*dVzjC - tan_1/x1(i)*Vc(VX3,k,j,i))
+                    + bkC*bkC*(s_1/x1(i)*dVzkC + Vc(VX1,k,j,i)/x1(i) + tan_1/x1(i)*Vc(VX2,k,j,i)));
+
+        divVC = D_EXPAND(2.*Vc(VX1,k,j,i)/x1(i) + dVxiC,
+                        + dVyjC/x1(i) + tan_1*Vc(VX2,k,j,i)/x1(i),
+                        + dVzkC/x1(i)*s_1 );
+        Pnor_parC = 3.0*etaBragC*(bbgradVC - divVC/3.0);
+        tau_xyC = Pnor_parC*biC*bjC;
+        tau_yyC = Pnor_parC*(bjC*bjC - 1./3.);
+        tau_zzC = Pnor_parC*(bkC*bkC - 1./3.);
+
+        EXPAND( stressSrc(IDIR,k,j,i) = -(tau_yyC + tau_zzC)/x1(i);          ,
+                stressSrc(JDIR,k,j,i) = (tau_xyC - tau_zzC*tan_1)/x1(i);     ,
+                stressSrc(KDIR,k,j,i) = ZERO_F;                               )
+      #endif
+    });
+  idfx::popRegion();
+  #endif // GEOMETRY != CARTESIAN
 }
 void BragViscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -47,6 +237,7 @@ void BragViscosity::ShowConfig() {
     if(!bragViscousDiffusivityFunc) {
       IDEFIX_ERROR("No braginskii viscosity function has been enrolled");
     }
+    refresh.ShowConfig("Braginskii Viscosity");
   } else {
     IDEFIX_ERROR("Unknown braginskii viscosity mode");
   }
@@ -55,6 +246,8 @@ void BragViscosity::ShowConfig() {
   } else if(this->status.isRKL) {
     idfx::cout << "Braginskii Viscosity: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(this->status.isImplicit) {
+    idfx::cout << "Braginskii Viscosity: uses an implicit time integration." << std::endl;
   } else {
     IDEFIX_ERROR("Unknown time integrator for braginskii viscosity.");
   }
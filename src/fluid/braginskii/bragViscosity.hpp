@@ -14,6 +14,7 @@
 #include "input.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "diffusivityRefresh.hpp"
 #include "slopeLimiter.hpp"
 
 // Forward class hydro declaration
@@ -33,15 +34,23 @@ class BragViscosity {
   // Enroll user-defined viscous diffusivity
   void EnrollBragViscousDiffusivity(DiffusivityFunc);
 
-  // Function for internal use (but public to allow for Cuda lambda capture)
+  // Functions for internal use (but public to allow for Cuda lambda capture)
   void InitArrays();
+  void ComputeStressSource();
 
   IdefixArray4D<real> bragViscSrc;  // Source terms of the viscous operator
+  IdefixArray4D<real> stressSrc;    // Cell-centred source terms, computed once per stage
   IdefixArray3D<real> etaBragArr;
 
+  // Refresh policy of etaBragArr when it is user-defined
+  DiffusivityRefresh refresh;
 
   // pre-computed geometrical factors in non-cartesian geometry
   IdefixArray1D<real> one_dmu;
+  IdefixArray1D<real> one_sinx2;    // 1/sin(theta) in the cells (0 on the axis)
+  IdefixArray1D<real> one_tanx2;    // 1/tan(theta) in the cells (0 on the axis)
+  IdefixArray1D<real> one_sinx2m;   // 1/sin(theta) on the faces (0 on the axis)
+  IdefixArray1D<real> one_tanx2m;   // 1/tan(theta) on the faces (0 on the axis)
 
  private:
   DataBlock* data;
@@ -97,6 +106,7 @@ BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
         this->etaBragArr = IdefixArray3D<real>("BragViscosityEtaArray",data->np_tot[KDIR],
                                                                  data->np_tot[JDIR],
                                                                  data->np_tot[IDIR]);
+        this->refresh = DiffusivityRefresh(input, "Hydro", "bragViscosity");
     } else {
       IDEFIX_ERROR("Unknown braginskii viscosity definition in idefix.ini. "
                    "Can only be constant or userdef.");
@@ -162,14 +172,16 @@ BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
 
 // This function computes the Braginskii viscous flux and stores it in hydro->fluxRiemann
 // (this avoids an extra array)
-// Associated source terms, present in non-cartesian geometry are also computed
-// and stored in this->bragViscSrc for later use (in calcRhs).
+// Associated source terms, present in non-cartesian geometry, are computed once per stage
+// in this->stressSrc, and the component of the current direction is copied
+// in this->bragViscSrc for later use (in calcRhs).
 template <PLMLimiter limTemplate>
 void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArray4D<real> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray4D<real> bragViscSrc = this->bragViscSrc;
+  IdefixArray4D<real> stressSrc = this->stressSrc;
   IdefixArray3D<real> dMax = this->dMax;
   IdefixArray3D<real> etaBragArr = this->etaBragArr;
   IdefixArray1D<real> one_dmu = this->one_dmu;
@@ -184,10 +196,10 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
   IdefixArray1D<real> dx3 = this->data->dx[KDIR];
 
   #if GEOMETRY == SPHERICAL
-  IdefixArray1D<real> sinx2 = this->data->sinx2;
-  IdefixArray1D<real> tanx2 = this->data->tanx2;
-  IdefixArray1D<real> sinx2m = this->data->sinx2m;
-  IdefixArray1D<real> tanx2m = this->data->tanx2m;
+  IdefixArray1D<real> one_sinx2 = this->one_sinx2;
+  IdefixArray1D<real> one_tanx2 = this->one_tanx2;
+  IdefixArray1D<real> one_sinx2m = this->one_sinx2m;
+  IdefixArray1D<real> one_tanx2m = this->one_tanx2m;
   #endif
 
   HydroModuleStatus haveViscosity = this->status.status;
@@ -199,12 +211,20 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
   // Compute viscosity if needed
   if(haveViscosity == UserDefFunction && dir == IDIR) {
     if(bragViscousDiffusivityFunc) {
-      bragViscousDiffusivityFunc(*this->data, t, etaBragArr);
+      if(refresh.NeedsRefresh(*this->data)) {
+        bragViscousDiffusivityFunc(*this->data, t, etaBragArr);
+      }
     } else {
       IDEFIX_ERROR("No user-defined Braginskii viscosity function has been enrolled");
     }
   }
 
+  // The cell-centred source terms only depend on Vc, which does not change between the sweeps
+  // of a stage
+  #if GEOMETRY != CARTESIAN
+    if(dir == IDIR) ComputeStressSource();
+  #endif
+
   int ibeg, iend, jbeg, jend, kbeg, kend;
   ibeg = this->data->beg[IDIR];
   iend = this->data->end[IDIR];
@@ -248,118 +268,11 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
       dVzi = dVzj = dVzk = ZERO_F;
 
       real etaBrag;
-      [[maybe_unused]] real etaBragC;
-
-
-      //Cell-centered values to compute source terms
-      #if GEOMETRY != CARTESIAN
-        real biC, bjC, bkC;
-        real BmagC;
-        real Pnor_parC;
-        real bbgradVC;
-
-        [[maybe_unused]] real tau_xxC, tau_xyC, tau_xzC;
-        [[maybe_unused]] real tau_yyC, tau_yzC;
-        [[maybe_unused]] real tau_zzC;
-
-        [[maybe_unused]] real dVxiC, dVxjC, dVxkC;
-        [[maybe_unused]] real dVyiC, dVyjC, dVykC;
-        [[maybe_unused]] real dVziC, dVzjC, dVzkC;
-
-        real divVC;
-
-        biC = bjC = bkC = ZERO_F;
-        tau_xxC = tau_xyC = tau_xzC = ZERO_F;
-        tau_yyC = tau_yzC = ZERO_F;
-        tau_zzC = ZERO_F;
-
-        dVxiC = dVxjC = dVxkC = ZERO_F;
-        dVyiC = dVyjC = dVykC = ZERO_F;
-        dVziC = dVzjC = dVzkC = ZERO_F;
-
-        //Compute values at the center of the cells, no slope limiter are used at this stage
-        EXPAND(  dVxiC = HALF_F*(Vc(VX1,k,j,i + 1) - Vc(VX1,k,j,i - 1))/dx1(i); ,
-                 dVyiC = HALF_F*(Vc(VX2,k,j,i + 1) - Vc(VX2,k,j,i - 1))/dx1(i); ,
-                 dVziC = HALF_F*(Vc(VX3,k,j,i + 1) - Vc(VX3,k,j,i - 1))/dx1(i); )
-        #if DIMENSIONS >= 2
-          EXPAND(  dVxjC = HALF_F*(Vc(VX1,k,j + 1,i) - Vc(VX1,k,j - 1,i))/dx2(j); ,
-                   dVyjC = HALF_F*(Vc(VX2,k,j + 1,i) - Vc(VX2,k,j - 1,i))/dx2(j); ,
-                   dVzjC = HALF_F*(Vc(VX3,k,j + 1,i) - Vc(VX3,k,j - 1,i))/dx2(j); )
-          #if DIMENSIONS == 3
-            EXPAND (  dVxkC = HALF_F*(Vc(VX1,k + 1,j,i) - Vc(VX1,k - 1,j,i))/dx3(k); ,
-                      dVykC = HALF_F*(Vc(VX2,k + 1,j,i) - Vc(VX2,k - 1,j,i))/dx3(k); ,
-                      dVzkC = HALF_F*(Vc(VX3,k + 1,j,i) - Vc(VX3,k - 1,j,i))/dx3(k); )
-          #endif
-        #endif
-
-        EXPAND(  biC = Vc(BX1,k,j,i); ,
-                 bjC = Vc(BX2,k,j,i); ,
-                 bkC = Vc(BX3,k,j,i); )
-
-        BmagC = EXPAND(  Vc(BX1,k,j,i)*Vc(BX1,k,j,i) ,
-                       + Vc(BX2,k,j,i)*Vc(BX2,k,j,i) ,
-                       + Vc(BX3,k,j,i)*Vc(BX3,k,j,i) );
-        if(BmagC< 0.001*SMALL_NUMBER) {
-           BmagC = sqrt(BmagC) + 0.000001*SMALL_NUMBER;
-        } else {
-           BmagC = sqrt(BmagC);
-        }
-        biC /= BmagC;
-        bjC /= BmagC;
-        bkC /= BmagC;
-      #endif //GEOMETRY != CARTESIAN
-
-      #if GEOMETRY == CYLINDRICAL
-        bbgradVC = D_EXPAND(
-                     biC*biC*dVxiC + biC*bjC*dVyiC + biC*bkC*(dVziC  - Vc(VX3,k,j,i)/x1(i)) ,
-                   + bjC*biC*dVxjC + bjC*bjC*dVyjC + bjC*bkC*dVzjC + bkC*bkC*Vc(VX1,k,j,i)/x1(i) ,
-                     );
-
-        divVC = D_EXPAND(dVxiC + Vc(VX1,k,j,i)/x1(i) ,
-                       + dVyjC ,
-                           );
-        // No cylindrical geometry in 3D!
-      #elif GEOMETRY == POLAR
-        bbgradVC = EXPAND(
-          biC*biC*dVxiC                         + bjC*biC*1./x1(i)*dVxjC
-                                                                                + bkC*biC*dVxkC,
-        + biC*bjC*(dVyiC - Vc(VX2,k,j,i)/x1(i)) + bjC*bjC*(1./x1(i)*dVyjC + Vc(VX1,k,j,i)/x1(i))
-                                                                                + bkC*bjC*dVykC,
-        + biC*bkC*dVziC                         + bjC*bkC*1./x1(i)*dVzjC
-                                                                                + bkC*bkC*dVzkC
-                  );
-
-        divVC = D_EXPAND(dVxiC + Vc(VX1,k,j,i)/x1(i) ,
-                         + 1./x1(i)*dVyjC ,
-                         + dVzkC);
-      #elif GEOMETRY == SPHERICAL
-        real tan_1 = tanx2(j);
-        real s_1 = sinx2(j);
-
-        // Trick to ensure that the axis does not lead to Nans
-        if(FABS(tan_1) < SMALL_NUMBER) {
-          tan_1 = ZERO_F;
-        } else {
-          tan_1 = ONE_F/tan_1;
-        }
-
-        if(FABS(s_1) < SMALL_NUMBER) {
-          s_1 = ZERO_F;
-        } else {
-          s_1 = ONE_F/s_1;
-        }
 
-        bbgradVC = EXPAND(
-    biC*biC*dVxiC                         + bjC*biC*1./x1(i)*dVxjC
-                                                                          + bkC*biC*s_1/x1(i)*dVxkC,
-  + biC*bjC*(dVyiC - Vc(VX2,k,j,i)/x1(i)) + bjC*bjC*(1./x1(i)*dVyjC + Vc(VX1,k,j,i)/x1(i))
-                                                                          + bkC*bjC*s_1/x1(i)*dVykC,
-  + biC*bkC*(dVziC - Vc(VX3,k,j,i)/x1(i)) + bjC*bkC*(1./x1(i)*dVzjC - tan_1/x1(i)*Vc(VX3,k,j,i))
-                    + bkC*bkC*(s_1/x1(i)*dVzkC + Vc(VX1,k,j,i)/x1(i) + tan_1/x1(i)*Vc(VX2,k,j,i)));
-
-        divVC = D_EXPAND(2.*Vc(VX1,k,j,i)/x1(i) + dVxiC,
-                        + dVyjC/x1(i) + tan_1*Vc(VX2,k,j,i)/x1(i),
-                        + dVzkC/x1(i)*s_1 );
+      #if GEOMETRY == SPHERICAL
+        // 1/sin(theta) and 1/tan(theta), on the face in the JDIR sweep, in the cell otherwise
+        const real s_1 = (dir == JDIR) ? one_sinx2m(j) : one_sinx2(j);
+        const real tan_1 = (dir == JDIR) ? one_tanx2m(j) : one_tanx2(j);
       #endif
 
       ///////////////////////////////////////////
@@ -367,7 +280,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
       ///////////////////////////////////////////
       if(dir == IDIR) {
         if(haveViscosity == UserDefFunction) {
-          etaBragC = etaBragArr(k,j,i);
           if(haveSlopeLimiter) {
             etaBrag = 2.*(etaBragArr(k,j,i-1)*etaBragArr(k,j,i)) /
                          (etaBragArr(k,j,i-1)+etaBragArr(k,j,i));
@@ -375,7 +287,7 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           etaBrag = HALF_F*(etaBragArr(k,j,i - 1)+etaBragArr(k,j,i));
           }
         } else {
-          etaBragC = etaBrag = etaBragConstant;
+          etaBrag = etaBragConstant;
         }
 
 
@@ -460,8 +372,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           EXPAND(  vx1i = 0.5*(Vc(VX1,k,j,i-1)+Vc(VX1,k,j,i)); ,
                    vx2i = 0.5*(Vc(VX2,k,j,i-1)+Vc(VX2,k,j,i)); ,
                    vx3i = 0.5*(Vc(VX3,k,j,i-1)+Vc(VX3,k,j,i)); )
-
-          Pnor_parC = 3.0*etaBragC*(bbgradVC - divVC/3.0);
         #endif // GEOMETRY != CARTESIAN
 
         #if GEOMETRY == CYLINDRICAL
@@ -475,13 +385,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                              );
           // No cylindrical geometry in 3D!
 
-          //cell-centered values for source terms
-          tau_zzC = Pnor_parC*(bkC*bkC - 1./3.);
-
-          EXPAND( bragViscSrc(IDIR,k,j,i) = -tau_zzC/x1(i);  ,
-                  bragViscSrc(JDIR,k,j,i) = ZERO_F;          ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;          )
-
         #elif GEOMETRY == POLAR
           bbgradV = EXPAND(
                       bi*bi*dVxi                         + bj*bi*1./x1l(i)*dVxj
@@ -496,13 +399,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                            + 1./x1l(i)*dVyj ,
                            + dVzk);
 
-          //cell-centered values for source terms
-          tau_yyC = Pnor_parC*(bjC*bjC - 1./3.);
-
-          EXPAND( bragViscSrc(IDIR,k,j,i) = -tau_yyC/x1(i);  ,
-                  bragViscSrc(JDIR,k,j,i) = ZERO_F;          ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;          )
-
         #elif GEOMETRY == SPHERICAL
           // NOLINT
           bbgradV = EXPAND(
@@ -514,14 +410,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           divV = D_EXPAND(2.0*vx1i/x1l(i) + dVxi,
                           + dVyj/x1l(i) + tan_1*vx2i/x1l(i),
                           + dVzk/x1l(i)*s_1 );
-
-          //cell-centered values for source terms
-          tau_yyC = Pnor_parC*(bjC*bjC - 1./3.);
-          tau_zzC = Pnor_parC*(bkC*bkC - 1./3.);
-
-          EXPAND( bragViscSrc(IDIR,k,j,i) = -(tau_yyC + tau_zzC)/x1(i);  ,
-                  bragViscSrc(JDIR,k,j,i) = ZERO_F;          ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;          )
         #endif
 
         Pnor_par = 3.0*etaBrag*(bbgradV - divV/3.0);
@@ -551,7 +439,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
       ///////////////////////////////////////////
       if(dir == JDIR) {
         if(haveViscosity == UserDefFunction) {
-          etaBragC = etaBragArr(k,j,i);
           if(haveSlopeLimiter) {
             etaBrag = 2.*(etaBragArr(k,j-1,i)*etaBragArr(k,j,i)) /
                          (etaBragArr(k,j-1,i)+etaBragArr(k,j,i));
@@ -559,7 +446,7 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           etaBrag = HALF_F*(etaBragArr(k,j - 1,i)+etaBragArr(k,j,i));
           }
         } else {
-          etaBragC = etaBrag = etaBragConstant;
+          etaBrag = etaBragConstant;
         }
 
         if (haveSlopeLimiter) {
@@ -651,8 +538,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           EXPAND(  vx1i = 0.5*(Vc(VX1,k,j-1,i)+Vc(VX1,k,j,i)); ,
                    vx2i = 0.5*(Vc(VX2,k,j-1,i)+Vc(VX2,k,j,i)); ,
                    vx3i = 0.5*(Vc(VX3,k,j-1,i)+Vc(VX3,k,j,i)); )
-
-          Pnor_parC = 3.0*etaBragC*(bbgradVC - divVC/3.0);
         #endif // GEOMETRY != CARTESIAN
 
         #if GEOMETRY == CYLINDRICAL
@@ -665,10 +550,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                             + dVyj ,
                              );
           // No cylindrical geometry in 3D!
-          // No source term along the z-axis in cylindrical/polar coordinates
-          EXPAND( bragViscSrc(IDIR,k,j,i) = ZERO_F;  ,
-                  bragViscSrc(JDIR,k,j,i) = ZERO_F;  ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;  )
         #elif GEOMETRY == POLAR
           bbgradV = EXPAND(
                       bi*bi*dVxi                         + bj*bi*1./x1(i)*dVxj
@@ -683,28 +564,7 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                            + 1./x1(i)*dVyj ,
                            + dVzk);
 
-          // See Geoffroy's trick for curvature source terms in curvilinear coordinates
-          EXPAND( bragViscSrc(IDIR,k,j,i) = ZERO_F;  ,
-                  bragViscSrc(JDIR,k,j,i) = ZERO_F;  ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;  )
-
         #elif GEOMETRY == SPHERICAL
-          tan_1 = tanx2m(j);
-          s_1 = sinx2m(j);
-
-          // Trick to ensure that the axis does not lead to Nans
-          if(FABS(tan_1) < SMALL_NUMBER) {
-            tan_1 = ZERO_F;
-          } else {
-            tan_1 = ONE_F/tan_1;
-          }
-
-          if(FABS(s_1) < SMALL_NUMBER) {
-            s_1 = ZERO_F;
-          } else {
-            s_1 = ONE_F/s_1;
-          }
-
           bbgradV = EXPAND(
       bi*bi*dVxi + bj*bi*1./x1(i)*dVxj + bk*bi*s_1/x1(i)*dVxk,
     + bi*bj*(dVyi - vx2i/x1(i)) + bj*bj*(1./x1(i)*dVyj + vx1i/x1(i)) + bk*bj*s_1/x1(i)*dVyk,
@@ -715,23 +575,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                           +(SIN(x2(j))*Vc(VX2,k,j,i) - FABS(SIN(x2(j-1)))*Vc(VX2,k,j-1,i))/x1(i)
                            *one_dmu(j) ,
                           + dVzk/x1(i)*s_1 );
-
-          //Cell-centered values for the source terms
-          tan_1 = tanx2(j);
-
-          // Trick to ensure that the axis does not lead to Nans
-          if(FABS(tan_1) < SMALL_NUMBER) {
-            tan_1 = ZERO_F;
-          } else {
-            tan_1 = ONE_F/tan_1;
-          }
-
-          tau_xyC = Pnor_parC*biC*bjC;
-          tau_zzC = Pnor_parC*(bkC*bkC - 1./3.);
-
-          EXPAND( bragViscSrc(IDIR,k,j,i) = ZERO_F;  ,
-                  bragViscSrc(JDIR,k,j,i) = (tau_xyC - tau_zzC*tan_1)/x1(i);  ,
-                  bragViscSrc(KDIR,k,j,i) = ZERO_F;  )
         #endif
 
         Pnor_par = 3.0*etaBrag*(bbgradV - divV/3.0);
@@ -761,7 +604,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
       ///////////////////////////////////////////
       if(dir == KDIR) {
         if(haveViscosity == UserDefFunction) {
-          etaBragC = etaBragArr(k,j,i);
           if(haveSlopeLimiter) {
             etaBrag = 2.*(etaBragArr(k-1,j,i)*etaBragArr(k,j,i)) /
                          (etaBragArr(k-1,j,i)+etaBragArr(k,j,i));
@@ -769,7 +611,7 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
           etaBrag = HALF_F*(etaBragArr(k - 1,j,i)+etaBragArr(k,j,i));
           }
         } else {
-          etaBragC = etaBrag = etaBragConstant;
+          etaBrag = etaBragConstant;
         }
 
         if (haveSlopeLimiter) {
@@ -871,10 +713,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                             + dVyj ,
                              );
           // No cylindrical geometry in 3D!
-          // See Geoffroy's trick for curvature source terms in cylindrical/polar coordinates
-          bragViscSrc(IDIR,k,j,i) = ZERO_F;
-          bragViscSrc(JDIR,k,j,i) = ZERO_F;
-          bragViscSrc(KDIR,k,j,i) = ZERO_F;
         #elif GEOMETRY == POLAR
           bbgradV = EXPAND(
                       bi*bi*dVxi                         + bj*bi*1./x1(i)*dVxj
@@ -889,11 +727,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                            + 1./x1(i)*dVyj ,
                            + dVzk);
 
-          // No source term along the z-axis in cylindrical/polar coordinates
-          bragViscSrc(IDIR,k,j,i) = ZERO_F;
-          bragViscSrc(JDIR,k,j,i) = ZERO_F;
-          bragViscSrc(KDIR,k,j,i) = ZERO_F;
-
         #elif GEOMETRY == SPHERICAL
           bbgradV = EXPAND(
       bi*bi*dVxi + bj*bi*1./x1(i)*dVxj + bk*bi*s_1/x1(i)*dVxk,
@@ -902,10 +735,6 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
                                         + bk*bk*(s_1/x1(i)*dVzk + vx1i/x1(i) + tan_1/x1(i)*vx2i));
 
           divV = 2.0*vx1i/x1(i) + dVxi + dVyj/x1(i) + tan_1*vx2i/x1(i) + dVzk/x1(i)*s_1;
-
-          bragViscSrc(IDIR,k,j,i) = ZERO_F;
-          bragViscSrc(JDIR,k,j,i) = ZERO_F;
-          bragViscSrc(KDIR,k,j,i) = ZERO_F;
         #endif
 
         Pnor_par = 3.0*etaBrag*(bbgradV - divV/3.0);
@@ -928,6 +757,13 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
         real locdmax = etaBrag/(0.5*(Vc(RHO,k,j,i)+Vc(RHO,k-1,j,i)));
         dMax(k,j,i) = FMAX(dMax(k,j,i),locdmax);
       }
+
+      #if GEOMETRY != CARTESIAN
+        // Only the source term of the current direction is added to the right hand side
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          bragViscSrc(n,k,j,i) = (n == dir) ? stressSrc(n,k,j,i) : ZERO_F;
+        }
+      #endif
   });
   idfx::popRegion();
 }
@@ -39,6 +39,12 @@ void Fluid<Phys>::CalcCurrent() {
   auto coarseningLevelX2 = data->coarseningLevel[JDIR];
   auto coarseningLevelX3 = data->coarseningLevel[KDIR];
 
+  // The current along the axis is regularised using the circulation of Bphi around it, which is
+  // reduced while the current is computed in the bulk.
+  if(this->haveAxis) {
+    boundary->axis->StartRegularizeCurrent();
+  }
+
   idefix_for("CalcCurrent",
              KOFFSET,data->np_tot[KDIR],
              JOFFSET,data->np_tot[JDIR],
@@ -187,7 +193,7 @@ void Fluid<Phys>::CalcCurrent() {
   // Regularize the current along the axis in cases where an axis is present.
   // This feature is not yet ready, so it is commented out
   if(this->haveAxis) {
-    boundary->axis->RegularizeCurrent();
+    boundary->axis->FinishRegularizeCurrent();
   }
 
   idfx::popRegion();
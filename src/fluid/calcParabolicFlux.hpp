@@ -29,15 +29,20 @@ void Fluid<Phys>::CalcParabolicFlux(const real t) {
       }
   );
 
-  if( (resistivityStatus.isExplicit  && (! data->rklCycle))
-    || (resistivityStatus.isRKL  && ( data->rklCycle))
-    || (ambipolarStatus.isExplicit  && (! data->rklCycle))
-    || (ambipolarStatus.isRKL  && ( data->rklCycle)) ) {
+  // Whether a module is integrated in the current cycle (explicit, RKL or implicit)
+  const bool rklCycle = data->rklCycle;
+  const bool implicitCycle = data->implicitCycle;
+  auto isActive = [rklCycle, implicitCycle](const ParabolicModuleStatus &module) {
+    if(rklCycle) return(module.isRKL);
+    if(implicitCycle) return(module.isImplicit);
+    return(module.isExplicit);
+  };
+
+  if(isActive(resistivityStatus) || isActive(ambipolarStatus)) {
       this->AddNonIdealMHDFlux<dir>(t);
   }
 
-  if( (viscosityStatus.isExplicit && (!data->rklCycle))
-    || (viscosityStatus.isRKL && data->rklCycle))  {
+  if(isActive(viscosityStatus)) {
       // Add fargo velocity if using fargo
     if(data->haveFargo && viscosityStatus.isExplicit) {
       data->fargo->AddVelocityFluid(t,this);
@@ -51,19 +56,16 @@ void Fluid<Phys>::CalcParabolicFlux(const real t) {
   }
 
   // Add thermal diffusion
-  if( (thermalDiffusionStatus.isExplicit && (!data->rklCycle))
-    || (thermalDiffusionStatus.isRKL && data->rklCycle))  {
+  if(isActive(thermalDiffusionStatus)) {
     this->thermalDiffusion->AddDiffusiveFlux(dir,t, this->FluxRiemann);
   }
 
-  if( (bragViscosityStatus.isExplicit && (!data->rklCycle))
-    || (bragViscosityStatus.isRKL && data->rklCycle))  {
+  if(isActive(bragViscosityStatus)) {
     this->bragViscosity->AddBragViscousFlux(dir,t, this->FluxRiemann);
   }
 
   // Add braginskii thermal diffusion
-  if( (bragThermalDiffusionStatus.isExplicit && (!data->rklCycle))
-    || (bragThermalDiffusionStatus.isRKL && data->rklCycle))  {
+  if(isActive(bragThermalDiffusionStatus)) {
     this->bragThermalDiffusion->AddBragDiffusiveFlux(dir,t, this->FluxRiemann);
   }
 
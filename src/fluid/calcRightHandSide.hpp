@@ -11,8 +11,12 @@
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "gravity.hpp"
+#include "fargo.hpp"
 
-template<typename Phys, int dir>
+// The Fargo type (a Fargo::FargoType) and the rotation of the frame are template parameters, so
+// that the kernel of a run only contains the corrections it needs. haveRotation is always false
+// in cartesian geometry, where Coriolis is treated as a source term.
+template<typename Phys, int dir, int fargoType, bool haveRotation>
 struct Fluid_CorrectFluxFunctor {
   // Correct the flux to take into account non-cartesian geometries and Fargo
   //*****************************************************************
@@ -31,18 +35,11 @@ struct Fluid_CorrectFluxFunctor {
 
     this->dt = dt;
     // Fargo
-    haveFargo  = hydro->data->haveFargo;
-    if(haveFargo) {
+    if constexpr(fargoType == Fargo::userdef) {
       fargoVelocity = hydro->data->fargo->meanVelocity;
-      fargoType = hydro->data->fargo->type;
     }
 
     // Rotation
-    haveRotation = hydro->haveRotation;
-    // disable rotation in cartesian geometry, as Coriolis is then treated as a source term
-    #if GEOMETRY == CARTESIAN
-      haveRotation = false;
-    #endif
     Omega = hydro->OmegaZ;
 
     // Shearing box shear rate
@@ -64,12 +61,9 @@ struct Fluid_CorrectFluxFunctor {
 
   // Fargo
   IdefixArray2D<real> fargoVelocity;
-  Fargo::FargoType fargoType;
-  bool haveFargo;
-
+  static constexpr bool haveFargo = (fargoType != Fargo::none);
 
   //Rotation
-  bool haveRotation;
   real Omega;
 
   // shearingBox
@@ -83,7 +77,7 @@ struct Fluid_CorrectFluxFunctor {
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
       // Add Fargo velocity to the fluxes
-      if(haveFargo || haveRotation) {
+      if constexpr(haveFargo || haveRotation) {
         // Set mean advection direction
         #if (GEOMETRY == CARTESIAN || GEOMETRY == POLAR) && DIMENSIONS >=2
           const int meanDir = JDIR;
@@ -97,42 +91,42 @@ struct Fluid_CorrectFluxFunctor {
         real meanV = ZERO_F;
         if constexpr(dir == IDIR) {
           #if (GEOMETRY == CARTESIAN || GEOMETRY == POLAR) && DIMENSIONS >=2
-            if(haveFargo) {
-              if(fargoType==Fargo::userdef) {
+            if constexpr(haveFargo) {
+              if constexpr(fargoType==Fargo::userdef) {
                 meanV = HALF_F*(fargoVelocity(k,i-1)+fargoVelocity(k,i));
-              } else if(fargoType==Fargo::shearingbox) {
+              } else if constexpr(fargoType==Fargo::shearingbox) {
                 meanV = sbS * x1m(i);
               }
             }
             #if GEOMETRY != CARTESIAN
-            if(haveRotation) {
+            if constexpr(haveRotation) {
               meanV += x1m(i)*Omega;
             }
             #endif
           #elif GEOMETRY == SPHERICAL && DIMENSIONS == 3
-            if(haveFargo) {
+            if constexpr(haveFargo) {
               meanV = HALF_F*(fargoVelocity(j,i-1)+fargoVelocity(j,i));
             }
-            if(haveRotation) {
+            if constexpr(haveRotation) {
               meanV += x1m(i)*sinx2(j)*Omega;
             }
           #endif// GEOMETRY
         }
         #if GEOMETRY == SPHERICAL && DIMENSIONS == 3
           if constexpr (dir == JDIR) {
-            if(haveFargo) {
+            if constexpr(haveFargo) {
               meanV = HALF_F*(fargoVelocity(j-1,i)+fargoVelocity(j,i));
             }
-            if(haveRotation) {
+            if constexpr(haveRotation) {
               meanV += x1(i)*sinx2m(j)*Omega;
             }
           }
         #elif (GEOMETRY == CARTESIAN || GEOMETRY == POLAR) && DIMENSIONS >=2
           if constexpr (dir == KDIR) {
-            if(haveFargo) {
-              if(fargoType==Fargo::userdef) {
+            if constexpr(haveFargo) {
+              if constexpr(fargoType==Fargo::userdef) {
                 meanV = HALF_F*(fargoVelocity(k-1,i)+fargoVelocity(k,i));
-              } else if (fargoType==Fargo::shearingbox) {
+              } else if constexpr(fargoType==Fargo::shearingbox) {
                 meanV = sbS*x1(i);
               }
             }
@@ -195,7 +189,8 @@ struct Fluid_CorrectFluxFunctor {
 
 
 
-template<typename Phys, int dir>
+// Same template parameters as Fluid_CorrectFluxFunctor
+template<typename Phys, int dir, int fargoType, bool haveRotation>
 struct Fluid_CalcRHSFunctor {
   //*****************************************************************
   // Functor constructor
@@ -248,18 +243,11 @@ struct Fluid_CalcRHSFunctor {
     if(haveBragViscosity) bragViscSrc = hydro->bragViscosity->bragViscSrc;
 
     // Fargo
-    haveFargo  = hydro->data->haveFargo;
-    if(haveFargo) {
+    if constexpr(fargoType == Fargo::userdef) {
       fargoVelocity = hydro->data->fargo->meanVelocity;
-      fargoType = hydro->data->fargo->type;
     }
 
     // Rotation
-    haveRotation = hydro->haveRotation;
-    // disable rotation in cartesian geometry, as Coriolis is then treated as a source term
-    #if GEOMETRY == CARTESIAN
-      haveRotation = false;
-    #endif
     Omega = hydro->OmegaZ;
 
     // Shearing box shear rate
@@ -311,12 +299,9 @@ struct Fluid_CalcRHSFunctor {
 
   // Fargo
   IdefixArray2D<real> fargoVelocity;
-  Fargo::FargoType fargoType;
-  bool haveFargo;
-
+  static constexpr bool haveFargo = (fargoType != Fargo::none);
 
   //Rotation
-  bool haveRotation;
   real Omega;
 
   // shearingBox
@@ -371,26 +356,26 @@ struct Fluid_CalcRHSFunctor {
 
     // Fargo terms to enfore conservation (actually substract back what was added in
     // Totalflux loop)
-    if(haveFargo || haveRotation) {
+    if constexpr(haveFargo || haveRotation) {
       // fetch fargo velocity when required
       real meanV = ZERO_F;
       #if (GEOMETRY == POLAR || GEOMETRY == CARTESIAN) && DIMENSIONS >=2
-        if((dir==IDIR || dir == KDIR) && haveFargo) {
-          if(fargoType==Fargo::userdef) {
+        if constexpr((dir==IDIR || dir == KDIR) && haveFargo) {
+          if constexpr(fargoType==Fargo::userdef) {
             meanV = fargoVelocity(k,i);
-          } else if(fargoType==Fargo::shearingbox) {
+          } else if constexpr(fargoType==Fargo::shearingbox) {
             meanV = sbS * x1(i);
           }
         }
         #if GEOMETRY != CARTESIAN
-          if((dir==IDIR) && haveRotation) {
+          if constexpr((dir==IDIR) && haveRotation) {
             meanV += Omega*x1(i);
           }
         #endif
         const int meanDir = JDIR;
       #elif GEOMETRY == SPHERICAL && DIMENSIONS ==3
-        if((dir==IDIR || dir == JDIR) && haveFargo) meanV = fargoVelocity(j,i);
-        if((dir==IDIR || dir == JDIR) && haveRotation) {
+        if constexpr((dir==IDIR || dir == JDIR) && haveFargo) meanV = fargoVelocity(j,i);
+        if constexpr((dir==IDIR || dir == JDIR) && haveRotation) {
           meanV += Omega*x1(i)*sinx2(j);
         }
         const int meanDir = KDIR;
@@ -555,7 +540,36 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
     data->fargo->GetFargoVelocity(t);
   }
 
-  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir>(this,dt);
+  // Select the kernels of the Fargo and rotation options of this run. In cartesian geometry,
+  // rotation is a source term and Fargo is either a shearing box or user-defined. Other
+  // geometries only allow a user-defined Fargo velocity.
+  #if GEOMETRY == CARTESIAN
+    if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+      CalcRightHandSide<dir, Fargo::userdef, false>(t, dt);
+    } else if(data->haveFargo) {
+      CalcRightHandSide<dir, Fargo::shearingbox, false>(t, dt);
+    } else {
+      CalcRightHandSide<dir, Fargo::none, false>(t, dt);
+    }
+  #else
+    if(data->haveFargo && haveRotation) {
+      CalcRightHandSide<dir, Fargo::userdef, true>(t, dt);
+    } else if(data->haveFargo) {
+      CalcRightHandSide<dir, Fargo::userdef, false>(t, dt);
+    } else if(haveRotation) {
+      CalcRightHandSide<dir, Fargo::none, true>(t, dt);
+    } else {
+      CalcRightHandSide<dir, Fargo::none, false>(t, dt);
+    }
+  #endif
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+template<int dir, int fargoType, bool rotation>
+void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir,fargoType,rotation>(this,dt);
 
   /////////////////////////////////////////////////////////////////////////////
   // Flux correction (for fargo/non-cartesian geometry)
@@ -563,6 +577,8 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
   const int ioffset = (dir==IDIR) ? 1 : 0;
   const int joffset = (dir==JDIR) ? 1 : 0;
   const int koffset = (dir==KDIR) ? 1 : 0;
+  // each face scales its flux by its area
+  IDEFIX_KERNEL_COST("Correct Flux", (2*Phys::nvar+1)*sizeof(real), Phys::nvar);
   idefix_for("Correct Flux",
              data->beg[KDIR],data->end[KDIR]+koffset,
              data->beg[JDIR],data->end[JDIR]+joffset,
@@ -573,17 +589,17 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
   // If user has requested specific flux functions for the boundaries, here they come
   if(boundary->haveFluxBoundary) boundary->EnforceFluxBoundaries(dir,t);
 
-  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
+  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir,fargoType,rotation>(this,dt);
   /////////////////////////////////////////////////////////////////////////////
   // Final conserved quantity budget from fluxes divergence
   /////////////////////////////////////////////////////////////////////////////
+  // each cell reads its fluxes, volume, spacing and signal speeds, and updates its conservative
+  // variables and its inverse time step (without source terms)
+  IDEFIX_KERNEL_COST("CalcRightHandSide", (3*Phys::nvar+5)*sizeof(real), 3*Phys::nvar+6);
   idefix_for("CalcRightHandSide",
              data->beg[KDIR],data->end[KDIR],
              data->beg[JDIR],data->end[JDIR],
              data->beg[IDIR],data->end[IDIR],
               calcRHS);
-
-
-  idfx::popRegion();
 }
 #endif // FLUID_CALCRIGHTHANDSIDE_HPP_
@@ -86,6 +86,7 @@ void ConstrainedTransport<Phys>::ExchangeX1() {
   MPI_Waitall(2,recvRequestX1,recvStatus);
   MPI_Waitall(2, sendRequestX1, sendStatus);
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  idfx::mpiCallsBytes += 2*bufferSizeX1*sizeof(real);
 
   // Unpack
   BufferLeft=BufferRecvX1[faceLeft];
@@ -182,6 +183,7 @@ void ConstrainedTransport<Phys>::ExchangeX2() {
   MPI_Waitall(2,recvRequestX2,recvStatus);
   MPI_Waitall(2, sendRequestX2, sendStatus);
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  idfx::mpiCallsBytes += 2*bufferSizeX2*sizeof(real);
 
   // Unpack
   BufferLeft=BufferRecvX2[faceLeft];
@@ -281,6 +283,7 @@ void ConstrainedTransport<Phys>::ExchangeX3() {
   MPI_Waitall(2,recvRequestX3,recvStatus);
   MPI_Waitall(2, sendRequestX3, sendStatus);
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  idfx::mpiCallsBytes += 2*bufferSizeX3*sizeof(real);
 
   // Unpack
   BufferLeft=BufferRecvX3[faceLeft];
@@ -58,7 +58,12 @@ void ConstrainedTransport<Phys>::CalcArithmeticAverage() {
   IdefixArray3D<real> ezj = this->ezj;
 
   #if MHD == YES && DIMENSIONS >= 2
-
+  // each edge emf reads two face-centered emfs and writes one corner emf
+  #if DIMENSIONS == 3
+  IDEFIX_KERNEL_COST("CalcArithmeticAverage", 9*sizeof(real), 12);
+  #else
+  IDEFIX_KERNEL_COST("CalcArithmeticAverage", 3*sizeof(real), 4);
+  #endif
   idefix_for("CalcArithmeticAverage",
             data->beg[KDIR],data->end[KDIR]+KOFFSET,
             data->beg[JDIR],data->end[JDIR]+JOFFSET,
@@ -91,6 +96,12 @@ void ConstrainedTransport<Phys>::CalcCellCenteredEMF() {
   IdefixArray3D<real> Ex3 = this->Ex3;
 
 #if MHD == YES && DIMENSIONS >= 2
+  // each cell reads its velocity and field, and writes its EMFs
+  #if DIMENSIONS == 3
+  IDEFIX_KERNEL_COST("CalcCenterEMF", 9*sizeof(real), 9);
+  #else
+  IDEFIX_KERNEL_COST("CalcCenterEMF", 5*sizeof(real), 3);
+  #endif
   idefix_for("CalcCenterEMF",
             0,data->np_tot[KDIR],
             0,data->np_tot[JDIR],
@@ -147,6 +158,14 @@ void ConstrainedTransport<Phys>::CalcUCT0Average() {
   IdefixArray3D<real> Ex3 = this->Ex3;
 
 #if MHD == YES && DIMENSIONS >= 2
+  // each face emf is read and written, and each cell-centered EMF is read once
+  #if DIMENSIONS == 3
+  IDEFIX_KERNEL_COST("CalcUCT0FaceCentered", 15*sizeof(real), 24);
+  IDEFIX_KERNEL_COST("CalcUCT0CornerEMF", 9*sizeof(real), 12);
+  #else
+  IDEFIX_KERNEL_COST("CalcUCT0FaceCentered", 5*sizeof(real), 8);
+  IDEFIX_KERNEL_COST("CalcUCT0CornerEMF", 3*sizeof(real), 4);
+  #endif
   idefix_for("CalcUCT0FaceCentered",
               data->beg[KDIR]-KOFFSET,data->end[KDIR]+KOFFSET,
               data->beg[JDIR]-JOFFSET,data->end[JDIR]+JOFFSET,
@@ -220,7 +239,12 @@ void ConstrainedTransport<Phys>::CalcContactAverage() {
   IdefixArray3D<real> wsz = this->svz;
 
 #if MHD == YES && DIMENSIONS >= 2
-
+  // each edge emf reads the face and cell-centered EMFs and the contact signs around it
+  #if DIMENSIONS == 3
+  IDEFIX_KERNEL_COST("EMF_Integrate_to_Corner", 15*sizeof(real), 99);
+  #else
+  IDEFIX_KERNEL_COST("EMF_Integrate_to_Corner", 6*sizeof(real), 33);
+  #endif
   idefix_for("EMF_Integrate_to_Corner",
             data->beg[KDIR],data->end[KDIR]+KOFFSET,
             data->beg[JDIR],data->end[JDIR]+JOFFSET,
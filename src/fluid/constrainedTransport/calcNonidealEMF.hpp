@@ -39,6 +39,9 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
   if(data->rklCycle) {
     haveResistivity = hydro->resistivityStatus.isRKL;
     haveAmbipolar = hydro->ambipolarStatus.isRKL;
+  } else if(data->implicitCycle) {
+    haveResistivity = hydro->resistivityStatus.isImplicit;
+    haveAmbipolar = hydro->ambipolarStatus.isImplicit;
   } else {
     haveResistivity = hydro->resistivityStatus.isExplicit;
     haveAmbipolar = hydro->ambipolarStatus.isExplicit;
@@ -30,7 +30,8 @@ void ConstrainedTransport<Phys>::EnforceEMFBoundary() {
     this->data->hydro->emfBoundaryFunc(*data, data->t);
 
   if(this->data->hydro->haveAxis) {
-    this->data->hydro->boundary->axis->RegularizeEMFs();
+    // The regularisation is completed once the other EMF boundaries are enforced
+    this->data->hydro->boundary->axis->StartRegularizeEMFs();
   }
 
   #ifdef ENFORCE_EMF_CONSISTENCY
@@ -106,6 +107,10 @@ void ConstrainedTransport<Phys>::EnforceEMFBoundary() {
       }
     #endif //ENFORCE_EMF_CONSISTENCY
   }
+
+  if(this->data->hydro->haveAxis) {
+    this->data->hydro->boundary->axis->FinishRegularizeEMFs();
+  }
 #endif // MHD==YES
   idfx::popRegion();
 }
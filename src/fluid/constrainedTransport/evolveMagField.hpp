@@ -50,6 +50,12 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
 
 
 
+  // each face reads the edge EMFs around it, and updates its field (cartesian estimate)
+  #if DIMENSIONS == 3
+  IDEFIX_KERNEL_COST("EvolvMagField", 9*sizeof(real), 24);
+  #else
+  IDEFIX_KERNEL_COST("EvolvMagField", 5*sizeof(real), 8);
+  #endif
   idefix_for("EvolvMagField",
              data->beg[KDIR],data->end[KDIR]+KOFFSET,
              data->beg[JDIR],data->end[JDIR]+JOFFSET,
@@ -0,0 +1,67 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <sstream>
+#include <string>
+
+#include "diffusivityRefresh.hpp"
+#include "dataBlock.hpp"
+
+DiffusivityRefresh::DiffusivityRefresh(Input &input, const std::string &block,
+                                       const std::string &name) {
+  const std::string entry = name + "Refresh";
+  if(input.CheckEntry(block, entry) < 0) return;
+
+  std::string strPolicy = input.Get<std::string>(block, entry, 0);
+  if(strPolicy.compare("stage") == 0) {
+    policy = everyStage;
+  } else if(strPolicy.compare("cycle") == 0) {
+    policy = everyCycle;
+    period = input.GetOrSet<int>(block, entry, 1, 1);
+    if(period < 1) {
+      IDEFIX_ERROR(block + "/" + entry + ": the refresh period should be at least 1 cycle");
+    }
+  } else if(strPolicy.compare("manual") == 0) {
+    policy = manual;
+  } else {
+    std::stringstream msg;
+    msg << "Unknown refresh policy " << strPolicy << " in " << block << "/" << entry
+        << ". Should be stage, cycle or manual.";
+    IDEFIX_ERROR(msg);
+  }
+}
+
+bool DiffusivityRefresh::NeedsRefresh(const DataBlock &data) {
+  bool refresh = !valid;
+  switch(policy) {
+    case everyStage:
+      refresh = refresh || (data.stageCount != lastStage);
+      break;
+    case everyCycle:
+      // The cycle counter goes back to 0 on restarts
+      refresh = refresh || (data.cycleCount - lastCycle >= period)
+                        || (data.cycleCount < lastCycle);
+      break;
+    case manual:
+      break;
+  }
+  if(refresh) {
+    valid = true;
+    lastCycle = data.cycleCount;
+    lastStage = data.stageCount;
+  }
+  return(refresh);
+}
+
+void DiffusivityRefresh::ShowConfig(const std::string &name) {
+  if(policy == everyCycle) {
+    idfx::cout << name << ": user-defined diffusivity refreshed every " << period
+               << " cycle(s)." << std::endl;
+  } else if(policy == manual) {
+    idfx::cout << name << ": user-defined diffusivity only refreshed on demand." << std::endl;
+  }
+}
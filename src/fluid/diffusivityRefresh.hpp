@@ -0,0 +1,49 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_DIFFUSIVITYREFRESH_HPP_
+#define FLUID_DIFFUSIVITYREFRESH_HPP_
+
+#include <string>
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+// Refresh policy of the arrays filled by a user-defined diffusivity function.
+// The arrays are kept from one call to the next, and the user function is only called again
+// when the policy requires it:
+// - stage: once per stage (including RKL and implicit sub-stages). This is the default.
+// - cycle [N]: at the first stage of every N cycles (N=1 by default)
+// - manual: at the first stage, then only after a call to Invalidate()
+// The policy is read from the <name>Refresh entry of the block which enables the diffusivity.
+class DiffusivityRefresh {
+ public:
+  enum Policy {everyStage, everyCycle, manual};
+
+  DiffusivityRefresh() = default;
+  DiffusivityRefresh(Input &, const std::string &, const std::string &);
+
+  // Whether the user function should be called for the current stage. The arrays are then
+  // considered to be up to date until the policy requires a new call.
+  bool NeedsRefresh(const DataBlock &);
+
+  // Force a call to the user function at the next stage
+  void Invalidate() { valid = false; }
+
+  void ShowConfig(const std::string &);
+
+ private:
+  Policy policy{everyStage};
+  int period{1};
+  bool valid{false};
+  int64_t lastCycle{0};
+  int64_t lastStage{0};
+};
+
+#endif // FLUID_DIFFUSIVITYREFRESH_HPP_
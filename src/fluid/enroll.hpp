@@ -112,6 +112,17 @@ void Fluid<Phys>::EnrollHallDiffusivity(DiffusivityFunc myFunc) {
   this->hallDiffusivityFunc = myFunc;
 }
 
+template<typename Phys>
+void Fluid<Phys>::InvalidateDiffusivities() {
+  ohmicRefresh.Invalidate();
+  ambipolarRefresh.Invalidate();
+  hallRefresh.Invalidate();
+  if(viscosity) viscosity->refresh.Invalidate();
+  if(thermalDiffusion) thermalDiffusion->refresh.Invalidate();
+  if(bragViscosity) bragViscosity->refresh.Invalidate();
+  if(bragThermalDiffusion) bragThermalDiffusion->refresh.Invalidate();
+}
+
 template<typename Phys>
 void Fluid<Phys>::ResetStage() {
   // Reset variables required at the beginning of each stage
@@ -21,4 +21,45 @@
   #include EOS_FILE
 #endif
 
+#include <type_traits>
+#include <utility>
+
+// Some equations of state (e.g. the tabulated one) store the first adiabatic exponent of each
+// cell when they are refreshed, and give it with GetGamma(P, rho, k, j, i). The functions
+// below use this value when it exists, and call GetGamma(P, rho) otherwise.
+template<typename Eos, typename = void>
+struct EosHasCellGamma : std::false_type {};
+
+template<typename Eos>
+struct EosHasCellGamma<Eos, std::void_t<decltype(std::declval<const Eos &>()
+                                          .GetGamma(real(), real(), 0, 0, 0))>>
+  : std::true_type {};
+
+// First adiabatic exponent of the state (P, rho) in cell (k,j,i)
+template<typename Eos>
+KOKKOS_FORCEINLINE_FUNCTION
+real GetCellGamma(const Eos &eos, real P, real rho, int k, int j, int i) {
+  if constexpr(EosHasCellGamma<Eos>::value) {
+    return eos.GetGamma(P, rho, k, j, i);
+  } else {
+    return eos.GetGamma(P, rho);
+  }
+}
+
+// First adiabatic exponent of the state (P, rho) at the interface between cells (k,j,i) and
+// (k,j,i)-1 along dir
+template<const int dir, typename Eos>
+KOKKOS_FORCEINLINE_FUNCTION
+real GetFaceGamma(const Eos &eos, real P, real rho, int k, int j, int i) {
+  if constexpr(EosHasCellGamma<Eos>::value) {
+    constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+    constexpr int joffset = (dir==JDIR) ? 1 : 0;
+    constexpr int koffset = (dir==KDIR) ? 1 : 0;
+    return HALF_F*(eos.GetGamma(P, rho, k, j, i)
+                  +eos.GetGamma(P, rho, k-koffset, j-joffset, i-ioffset));
+  } else {
+    return eos.GetGamma(P, rho);
+  }
+}
+
 #endif // FLUID_EOS_EOS_HPP_
@@ -0,0 +1,168 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_EOS_EOS_TABULATED_HPP_
+#define FLUID_EOS_EOS_TABULATED_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "dataBlock.hpp"
+#include "lookupTable.hpp"
+
+// This is the tabulated implementation of the equation of state.
+// The pressure P(rho, eps), eps being the internal energy per unit mass, is read from a numpy
+// table. The inverse table eps(rho, P/rho) and the first adiabatic exponent
+// Gamma_1(rho, P/rho) are computed once at initialisation, so that the conversions between
+// pressure and internal energy are plain interpolations (no root finding).
+// Gamma_1 of each cell is stored when the EOS is refreshed (at the beginning of each stage),
+// so that the Riemann solvers don't interpolate the tables at each interface.
+// The tables are clamped to their edges.
+class EquationOfState {
+ public:
+  EquationOfState() = default;
+
+  EquationOfState(Input & input, DataBlock *data, std::string prefix) {
+    idfx::pushRegion("EquationOfState::EquationOfState");
+    std::vector<std::string> coords = {input.Get<std::string>(prefix,"eosTable",0),
+                                       input.Get<std::string>(prefix,"eosTable",1)};
+    std::string pressureFile = input.Get<std::string>(prefix,"eosTable",2);
+
+    this->pressureTable = LookupTable<2>(coords, pressureFile, false);
+    BuildInverseTables();
+
+    this->gammaArr = IdefixArray3D<real>(prefix+"_eosGamma",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    idfx::popRegion();
+  }
+
+  void ShowConfig() {
+    idfx::cout << "EquationOfState: tabulated with " << pressureTable.dimensionsHost(0) << "x"
+               << pressureTable.dimensionsHost(1) << " points." << std::endl;
+  }
+
+  // First adiabatic exponent, interpolated from the tables
+  KOKKOS_INLINE_FUNCTION real GetGamma(real P, real rho) const {
+    const real x[2] = {rho, P/rho};
+    return gammaTable.Get(x);
+  }
+
+  // First adiabatic exponent of cell (k,j,i), as computed by the last call to Refresh()
+  KOKKOS_INLINE_FUNCTION real GetGamma(real P, real rho, int k, int j, int i) const {
+    return gammaArr(k,j,i);
+  }
+
+  // Store the first adiabatic exponent of each cell. This is a template so that the gas
+  // primitive variables are only accessed once the Fluid class is complete.
+  template <typename Block>
+  void Refresh(Block &data, real t) {
+    idfx::pushRegion("EquationOfState::Refresh");
+    IdefixArray4D<real> Vc = data.hydro->Vc;
+    IdefixArray3D<real> gammaArr = this->gammaArr;
+    LookupTable<2> gammaTable = this->gammaTable;
+
+    idefix_for("EOS_Gamma",
+                0,data.np_tot[KDIR],
+                0,data.np_tot[JDIR],
+                0,data.np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        const real x[2] = {Vc(RHO,k,j,i), Vc(PRS,k,j,i)/Vc(RHO,k,j,i)};
+        gammaArr(k,j,i) = gammaTable.Get(x);
+      });
+    idfx::popRegion();
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  real GetWaveSpeed(int k, int j, int i) const {
+    Kokkos::abort("GetWaveSpeed should be used only for isothermal EOS");
+    return 0;
+  }
+  KOKKOS_INLINE_FUNCTION
+  real GetInternalEnergy(real P, real rho) const {
+    const real x[2] = {rho, P/rho};
+    return rho*energyTable.Get(x);
+  }
+  KOKKOS_INLINE_FUNCTION
+  real GetPressure(real Eint, real rho) const {
+    const real x[2] = {rho, Eint/rho};
+    return pressureTable.Get(x);
+  }
+
+ private:
+  // Compute eps(rho, P/rho) and Gamma_1(rho, P/rho) from P(rho, eps). Each row of
+  // constant density is inverted on a log-spaced P/rho axis, which covers the whole table.
+  void BuildInverseTables() {
+    const int nrho = pressureTable.dimensionsHost(0);
+    const int neps = pressureTable.dimensionsHost(1);
+    if(nrho < 2 || neps < 2) {
+      IDEFIX_ERROR("The tabulated EOS requires at least 2 points along each axis");
+    }
+    auto rho = [&](int j) { return pressureTable.xinHost(pressureTable.offsetHost(0)+j); };
+    auto eps = [&](int i) { return pressureTable.xinHost(pressureTable.offsetHost(1)+i); };
+    auto P = [&](int j, int i) { return pressureTable.dataHost(j*neps+i); };
+
+    // Gamma_1 = (rho/P) (dP/drho)_eps + (1/rho) (dP/deps)_rho on the nodes of the table
+    std::vector<real> gammaNode(nrho*neps);
+    real qMin = P(0,0)/rho(0);
+    real qMax = qMin;
+    for(int j = 0 ; j < nrho ; j++) {
+      const int jm = std::max(j-1, 0);
+      const int jp = std::min(j+1, nrho-1);
+      for(int i = 0 ; i < neps ; i++) {
+        const int im = std::max(i-1, 0);
+        const int ip = std::min(i+1, neps-1);
+        if(P(j,i) <= 0) {
+          IDEFIX_ERROR("The tabulated pressure should be positive");
+        }
+        if(i > 0 && P(j,i) <= P(j,i-1)) {
+          IDEFIX_ERROR("The tabulated pressure should increase with the internal energy");
+        }
+        const real dPdRho = (P(jp,i) - P(jm,i))/(rho(jp) - rho(jm));
+        const real dPdEps = (P(j,ip) - P(j,im))/(eps(ip) - eps(im));
+        gammaNode[j*neps+i] = rho(j)/P(j,i)*dPdRho + dPdEps/rho(j);
+        qMin = std::min(qMin, P(j,i)/rho(j));
+        qMax = std::max(qMax, P(j,i)/rho(j));
+      }
+    }
+
+    const int nq = 2*neps;
+    IdefixHostArray1D<real> rhoAxis("EOS_rho", nrho);
+    IdefixHostArray1D<real> qAxis("EOS_q", nq);
+    IdefixHostArray2D<real> epsData("EOS_eps", nq, nrho);
+    IdefixHostArray2D<real> gammaData("EOS_gamma", nq, nrho);
+    for(int j = 0 ; j < nrho ; j++) rhoAxis(j) = rho(j);
+    for(int n = 0 ; n < nq ; n++) {
+      qAxis(n) = qMin*std::pow(qMax/qMin, static_cast<real>(n)/(nq-1));
+    }
+
+    for(int j = 0 ; j < nrho ; j++) {
+      int i = 0;
+      for(int n = 0 ; n < nq ; n++) {
+        const real Pt = qAxis(n)*rho(j);
+        while(i < neps-2 && P(j,i+1) < Pt) i++;
+        // Pressures outside of the row are clamped to its edges
+        real w = (Pt - P(j,i))/(P(j,i+1) - P(j,i));
+        w = std::min(std::max(w, ZERO_F), ONE_F);
+        epsData(n,j) = eps(i) + w*(eps(i+1) - eps(i));
+        gammaData(n,j) = gammaNode[j*neps+i] + w*(gammaNode[j*neps+i+1] - gammaNode[j*neps+i]);
+      }
+    }
+
+    this->energyTable = LookupTable<2>(epsData, {rhoAxis, qAxis}, false);
+    this->gammaTable = LookupTable<2>(gammaData, {rhoAxis, qAxis}, false);
+  }
+
+  LookupTable<2> pressureTable;     // P(rho, eps)
+  LookupTable<2> energyTable;       // eps(rho, P/rho)
+  LookupTable<2> gammaTable;        // Gamma_1(rho, P/rho)
+  IdefixArray3D<real> gammaArr;     // Gamma_1 of each cell
+};
+
+#endif // FLUID_EOS_EOS_TABULATED_HPP_
@@ -44,10 +44,11 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   if(needExplicitCurrent) CalcCurrent();
 
   if(hallStatus.status == UserDefFunction) {
-    if(hallDiffusivityFunc)
-      hallDiffusivityFunc(*data, t, xHall);
-    else
+    if(hallDiffusivityFunc) {
+      if(hallRefresh.NeedsRefresh(*data)) hallDiffusivityFunc(*data, t, xHall);
+    } else {
       IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled");
+    }
   }
 
   if constexpr(Phys::eos) {
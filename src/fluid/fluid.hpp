@@ -15,6 +15,7 @@
 #include "idefix.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "diffusivityRefresh.hpp"
 #include "eos.hpp"
 #include "thermalDiffusion.hpp"
 #include "bragThermalDiffusion.hpp"
@@ -36,6 +37,9 @@ class ConstrainedTransport;
 template<typename Phys>
 class RKLegendre;
 
+template<typename Phys>
+class ImplicitParabolic;
+
 template<typename Phys>
 class RiemannSolver;
 
@@ -59,8 +63,10 @@ class Fluid {
   template <int> void CalcParabolicFlux(const real);
   template <int> void AddNonIdealMHDFlux(const real);
   template <int> void CalcRightHandSide(real, real );
+  template <int, int, bool> void CalcRightHandSide(real, real );
   void CalcCurrent();
   void AddSourceTerms(real, real );
+  template <bool, bool> void AddSourceTerms(real);
   void CoarsenFlow(IdefixArray4D<real>&);
   void CoarsenMagField(IdefixArray4D<real>&);
   real CheckDivB();
@@ -82,13 +88,16 @@ class Fluid {
   // Parabolic terms
   bool haveExplicitParabolicTerms{false};
   bool haveRKLParabolicTerms{false};
+  bool haveImplicitParabolicTerms{false};
 
   std::unique_ptr<RKLegendre<Phys>> rkl;
+  std::unique_ptr<ImplicitParabolic<Phys>> implicit;
 
   // Current
   bool haveCurrent{false};
   bool needExplicitCurrent{false};
   bool needRKLCurrent{false};
+  bool needImplicitCurrent{false};
 
   // Nonideal MHD effects coefficients
   ParabolicModuleStatus resistivityStatus, ambipolarStatus, hallStatus;
@@ -159,6 +168,9 @@ class Fluid {
   void EnrollAmbipolarDiffusivity(DiffusivityFunc);
   void EnrollHallDiffusivity(DiffusivityFunc);
 
+  // Force all of the user-defined diffusivities to be recomputed at the next stage
+  void InvalidateDiffusivities();
+
   // Enroll user-defined isothermal sound speed
   void EnrollIsoSoundSpeed(IsoSoundSpeedFunc);
 
@@ -197,6 +209,7 @@ class Fluid {
   friend class ConstrainedTransport<Phys>;
   friend class Fargo;
   friend class RKLegendre<Phys>;
+  friend class ImplicitParabolic<Phys>;
   friend class Boundary<Phys>;
   friend class ShockFlattening<Phys>;
   friend class RiemannSolver<Phys>;
@@ -206,13 +219,13 @@ class Fluid {
   friend class BragThermalDiffusion;
   friend class Drag;
 
-  template <typename P>
+  template <typename P, bool fargo, bool rotation>
   friend struct Fluid_AddSourceTermsFunctor;
 
-  template <typename P, int dir>
+  template <typename P, int dir, int fargo, bool rotation>
   friend struct Fluid_CorrectFluxFunctor;
 
-  template <typename P, int dir>
+  template <typename P, int dir, int fargo, bool rotation>
   friend struct Fluid_CalcRHSFunctor;
 
   template<typename P>
@@ -233,6 +246,9 @@ class Fluid {
   DiffusivityFunc ohmicDiffusivityFunc{NULL};
   DiffusivityFunc ambipolarDiffusivityFunc{NULL};
   DiffusivityFunc hallDiffusivityFunc{NULL};
+  DiffusivityRefresh ohmicRefresh;
+  DiffusivityRefresh ambipolarRefresh;
+  DiffusivityRefresh hallRefresh;
 
   IdefixArray3D<real> cMax;    // Maximum propagation speed
 
@@ -252,6 +268,7 @@ class Fluid {
 #include "constrainedTransport.hpp"
 #include "axis.hpp"
 #include "rkl.hpp"
+#include "implicitParabolic.hpp"
 #include "riemannSolver.hpp"
 #include "viscosity.hpp"
 #include "bragViscosity.hpp"
@@ -275,7 +292,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   // Keep the instance # for later use
   instanceNumber = n;
 
-  #if ORDER < 1 || ORDER > 4
+  #if ORDER < 1 || ORDER > 6
      IDEFIX_ERROR("Reconstruction at chosen order is not implemented. Check your definitions file");
   #endif
 
@@ -351,6 +368,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       viscosityStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      viscosityStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for viscosity: " << opType;
@@ -377,6 +397,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       thermalDiffusionStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      thermalDiffusionStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for thermal diffusion: " << opType;
@@ -403,6 +426,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       bragViscosityStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      bragViscosityStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for braginskii viscosity: " << opType;
@@ -421,6 +447,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       bragThermalDiffusionStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      bragThermalDiffusionStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for braginskii thermal diffusion: " << opType;
@@ -450,6 +479,10 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
           haveRKLParabolicTerms = true;
           resistivityStatus.isRKL = true;
           needRKLCurrent = true;
+        } else if(opType.compare("implicit") == 0 ) {
+          haveImplicitParabolicTerms = true;
+          resistivityStatus.isImplicit = true;
+          needImplicitCurrent = true;
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for resistivity: " << opType;
@@ -462,6 +495,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         } else if(input.Get<std::string>(
             std::string(Phys::prefix),"resistivity",1).compare("userdef") == 0) {
           resistivityStatus.status = UserDefFunction;
+          ohmicRefresh = DiffusivityRefresh(input, std::string(Phys::prefix), "resistivity");
         } else {
           IDEFIX_ERROR("Unknown resistivity definition in idefix.ini. "
                       "Can only be constant or userdef.");
@@ -478,6 +512,10 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
           haveRKLParabolicTerms = true;
           ambipolarStatus.isRKL = true;
           needRKLCurrent = true;
+        } else if(opType.compare("implicit") == 0 ) {
+          haveImplicitParabolicTerms = true;
+          ambipolarStatus.isImplicit = true;
+          needImplicitCurrent = true;
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for ambipolar: " << opType;
@@ -490,6 +528,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         } else if(input.Get<std::string>(
                     std::string(Phys::prefix),"ambipolar",1).compare("userdef") == 0) {
           ambipolarStatus.status = UserDefFunction;
+          ambipolarRefresh = DiffusivityRefresh(input, std::string(Phys::prefix), "ambipolar");
         } else {
           IDEFIX_ERROR("Unknown ambipolar definition in idefix.ini. "
                       "Can only be constant or userdef.");
@@ -503,6 +542,8 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
           needExplicitCurrent = true;
         } else if(opType.compare("rkl") == 0 ) {
           IDEFIX_ERROR("RKL inegration is incompatible with Hall");
+        } else if(opType.compare("implicit") == 0 ) {
+          IDEFIX_ERROR("Implicit integration is incompatible with Hall");
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for hall: " << opType;
@@ -514,6 +555,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         } else if(input.Get<std::string>(
                     std::string(Phys::prefix),"hall",1).compare("userdef") == 0) {
           hallStatus.status = UserDefFunction;
+          hallRefresh = DiffusivityRefresh(input, std::string(Phys::prefix), "hall");
         } else {
           IDEFIX_ERROR("Unknown Hall definition in idefix.ini. Can only be constant or userdef.");
         }
@@ -697,6 +739,11 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   //** Child object allocation section
   //*********************************************
 
+  // Initialise the EOS (before the Riemann solver, which keeps a copy of it)
+  if constexpr(Phys::eos) {
+    this->eos = std::make_unique<EquationOfState>(input, data, this->prefix);
+  }
+
     // Initialise Riemann Solver
   this->rSolver = std::make_unique<RiemannSolver<Phys>>(input, this);
 
@@ -704,11 +751,6 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->emf = std::make_unique<ConstrainedTransport<Phys>>(input, this);
   }
 
-  // Initialise the EOS
-  if constexpr(Phys::eos) {
-    this->eos = std::make_unique<EquationOfState>(input, data, this->prefix);
-  }
-
   // Initialise boundary conditions
   boundary = std::make_unique<Boundary<Phys>>(this);
   this->haveAxis = data->haveAxis;
@@ -717,6 +759,10 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->rkl = std::make_unique<RKLegendre<Phys>>(input,this);
   }
 
+  if(haveImplicitParabolicTerms) {
+    this->implicit = std::make_unique<ImplicitParabolic<Phys>>(input,this);
+  }
+
   // Thermal diffusion
   if(thermalDiffusionStatus.status != Disabled ) {
     this->thermalDiffusion = std::make_unique<ThermalDiffusion>(input, grid, this);
@@ -32,6 +32,7 @@ struct ParabolicModuleStatus {
   HydroModuleStatus status{Disabled};
   bool isExplicit{false};
   bool isRKL{false};
+  bool isImplicit{false};
 };
 
 
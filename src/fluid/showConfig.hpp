@@ -39,6 +39,10 @@ void Fluid<Phys>::ShowConfig() {
     idfx::cout << "3rd order (LimO3)" << std::endl;
   #elif ORDER == 4
     idfx::cout << "4th order (PPM)" << std::endl;
+  #elif ORDER == 5
+    idfx::cout << "5th order (WENO-Z)" << std::endl;
+  #elif ORDER == 6
+    idfx::cout << "5th order (MP5)" << std::endl;
   #endif
 
 
@@ -62,6 +66,7 @@ void Fluid<Phys>::ShowConfig() {
       if(!ohmicDiffusivityFunc) {
         IDEFIX_ERROR("No user-defined Ihmic resistivity function has been enrolled.");
       }
+      ohmicRefresh.ShowConfig(std::string(Phys::prefix) + ": Ohmic resistivity");
     } else {
       IDEFIX_ERROR("Unknown Ohmic resistivity mode");
     }
@@ -72,6 +77,9 @@ void Fluid<Phys>::ShowConfig() {
       idfx::cout << Phys::prefix
                  << ": Ohmic resistivity uses a Runge-Kutta-Legendre time integration."
                  << std::endl;
+    } else if(resistivityStatus.isImplicit) {
+      idfx::cout << Phys::prefix << ": Ohmic resistivity uses an implicit time integration."
+                 << std::endl;
     } else {
       IDEFIX_ERROR("Unknown time integrator for Ohmic resistivity");
     }
@@ -88,6 +96,7 @@ void Fluid<Phys>::ShowConfig() {
       if(!ambipolarDiffusivityFunc) {
         IDEFIX_ERROR("No user-defined ambipolar diffusion function has been enrolled.");
       }
+      ambipolarRefresh.ShowConfig(std::string(Phys::prefix) + ": Ambipolar diffusion");
     } else {
       IDEFIX_ERROR("Unknown Ambipolar diffusion mode");
     }
@@ -98,6 +107,9 @@ void Fluid<Phys>::ShowConfig() {
       idfx::cout << Phys::prefix
                  << ": Ambipolar diffusion uses a Runge-Kutta-Legendre time integration."
                  << std::endl;
+    } else if(ambipolarStatus.isImplicit) {
+      idfx::cout << Phys::prefix << ": Ambipolar diffusion uses an implicit time integration."
+                 << std::endl;
     } else {
       IDEFIX_ERROR("Unknown time integrator for ambipolar diffusion");
     }
@@ -113,6 +125,7 @@ void Fluid<Phys>::ShowConfig() {
       if(!hallDiffusivityFunc) {
         IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled.");
       }
+      hallRefresh.ShowConfig(std::string(Phys::prefix) + ": Hall effect");
     } else {
       IDEFIX_ERROR("Unknown Hall effect mode");
     }
@@ -146,13 +159,17 @@ void Fluid<Phys>::ShowConfig() {
   if(haveRKLParabolicTerms) {
     rkl->ShowConfig();
   }
-  if(viscosityStatus.isExplicit || viscosityStatus.isRKL) {
+  if(haveImplicitParabolicTerms) {
+    implicit->ShowConfig();
+  }
+  if(viscosityStatus.isExplicit || viscosityStatus.isRKL || viscosityStatus.isImplicit) {
     viscosity->ShowConfig();
   }
   if(thermalDiffusionStatus.status != Disabled) {
     thermalDiffusion->ShowConfig();
   }
-  if(bragViscosityStatus.isExplicit || bragViscosityStatus.isRKL) {
+  if(bragViscosityStatus.isExplicit || bragViscosityStatus.isRKL
+                                    || bragViscosityStatus.isImplicit) {
     bragViscosity->ShowConfig();
   }
   if(bragThermalDiffusionStatus.status != Disabled) {
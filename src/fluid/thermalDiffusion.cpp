@@ -26,6 +26,7 @@ void ThermalDiffusion::ShowConfig() {
     if(!diffusivityFunc) {
       IDEFIX_ERROR("No thermal diffusion function has been enrolled");
     }
+    refresh.ShowConfig("Thermal Diffusion");
   } else {
     IDEFIX_ERROR("Unknown thermal diffusion mode");
   }
@@ -34,6 +35,8 @@ void ThermalDiffusion::ShowConfig() {
   } else if(status.isRKL) {
     idfx::cout << "Thermal Diffusion: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(status.isImplicit) {
+    idfx::cout << "Thermal Diffusion: uses an implicit time integration." << std::endl;
   } else {
     IDEFIX_ERROR("Unknown time integrator for viscosity.");
   }
@@ -73,9 +76,11 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
   // Compute thermal diffusion if needed
   if(haveThermalDiffusion == UserDefFunction && dir == IDIR) {
     if(diffusivityFunc) {
-      idfx::pushRegion("UserDef::ThermalDiffusivityFunction");
-      diffusivityFunc(*this->data, t, kappaArr);
-      idfx::popRegion();
+      if(refresh.NeedsRefresh(*this->data)) {
+        idfx::pushRegion("UserDef::ThermalDiffusivityFunction");
+        diffusivityFunc(*this->data, t, kappaArr);
+        idfx::popRegion();
+      }
     } else {
       IDEFIX_ERROR("No user-defined thermal diffusion function has been enrolled");
     }
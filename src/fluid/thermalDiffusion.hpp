@@ -14,6 +14,7 @@
 #include "input.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "diffusivityRefresh.hpp"
 #include "eos.hpp"
 
 
@@ -37,6 +38,9 @@ class ThermalDiffusion {
   IdefixArray4D<real> viscSrc;  // Source terms of the viscous operator
   IdefixArray3D<real> kappaArr;
 
+  // Refresh policy of kappaArr when it is user-defined
+  DiffusivityRefresh refresh;
+
   // pre-computed geometrical factors in non-cartesian geometry
   IdefixArray1D<real> one_dmu;
 
@@ -77,6 +81,7 @@ ThermalDiffusion::ThermalDiffusion(Input &input, Grid &grid, Fluid<Phys> *hydroi
     this->kappaArr = IdefixArray3D<real>("ThermalDiffusionKappaArray",data->np_tot[KDIR],
                                                                  data->np_tot[JDIR],
                                                                  data->np_tot[IDIR]);
+    this->refresh = DiffusivityRefresh(input, std::string(Phys::prefix), "TDiffusion");
   } else {
     IDEFIX_ERROR("Unknown thermal diffusion definition in idefix.ini. "
                   "Can only be constant or userdef.");
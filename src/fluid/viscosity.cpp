@@ -72,6 +72,7 @@ void Viscosity::ShowConfig() {
     if(!viscousDiffusivityFunc) {
       IDEFIX_ERROR("No viscosity function has been enrolled");
     }
+    refresh.ShowConfig("Viscosity");
   } else {
     IDEFIX_ERROR("Unknown viscosity mode");
   }
@@ -80,6 +81,8 @@ void Viscosity::ShowConfig() {
   } else if(this->status.isRKL) {
     idfx::cout << "Viscosity: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(this->status.isImplicit) {
+    idfx::cout << "Viscosity: uses an implicit time integration." << std::endl;
   } else {
     IDEFIX_ERROR("Unknown time integrator for viscosity.");
   }
@@ -135,7 +138,7 @@ void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<real>
   // Compute viscosity if needed
   if(haveViscosity == UserDefFunction && dir == IDIR) {
     if(viscousDiffusivityFunc) {
-      viscousDiffusivityFunc(*data, t, eta1Arr, eta2Arr);
+      if(refresh.NeedsRefresh(*data)) viscousDiffusivityFunc(*data, t, eta1Arr, eta2Arr);
     } else {
       IDEFIX_ERROR("No user-defined viscosity function has been enrolled");
     }
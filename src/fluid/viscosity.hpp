@@ -14,6 +14,7 @@
 #include "input.hpp"
 #include "grid.hpp"
 #include "fluid_defs.hpp"
+#include "diffusivityRefresh.hpp"
 
 
 
@@ -41,6 +42,9 @@ class Viscosity {
   IdefixArray3D<real> eta1Arr;
   IdefixArray3D<real> eta2Arr;
 
+  // Refresh policy of eta1Arr and eta2Arr when they are user-defined
+  DiffusivityRefresh refresh;
+
   // pre-computed geometrical factors in non-cartesian geometry
   IdefixArray1D<real> one_dmu;
 
@@ -85,6 +89,7 @@ Viscosity::Viscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
     this->eta2Arr = IdefixArray3D<real>("ViscosityEta1Array",data->np_tot[KDIR],
                                                               data->np_tot[JDIR],
                                                               data->np_tot[IDIR]);
+    this->refresh = DiffusivityRefresh(input, std::string(Phys::prefix), "viscosity");
   } else {
         IDEFIX_ERROR("Unknown viscosity definition in idefix.ini. "
                      "Can only be constant or userdef.");
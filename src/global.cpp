@@ -5,12 +5,23 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#if __has_include(<filesystem>)
+  #include <filesystem> // NOLINT [build/c++17]
+  namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+  #include <experimental/filesystem>
+  namespace fs = std::experimental::filesystem;
+#else
+  error "Missing the <filesystem> header."
+#endif
 #include <iostream>
+#include <memory>
 #include <string>
 #include <sstream>
 #include "idefix.hpp"
 #include "global.hpp"
 #include "profiler.hpp"
+#include "loopTuner.hpp"
 
 #ifdef WITH_MPI
 #include "mpi.hpp"
@@ -22,18 +33,25 @@ int prank;
 int psize;
 
 double mpiCallsTimer = 0.0;
+int64_t mpiCallsBytes = 0;
 
 bool warningsAreErrors{false};
 
+std::string inputDirectory;
+
 IdefixOutStream cout;
 IdefixErrStream cerr;
 Profiler prof;
+LoopTuner loopTuner;
 LoopPattern defaultLoopPattern;
 
 #ifdef DEBUG
 static int regionIndent = 0;
 #endif
 
+// Instance selected by SetExecutionSpace (the default instance when empty)
+static std::unique_ptr<Kokkos::DefaultExecutionSpace> currentSpace;
+
 int initialize() {
 #ifdef WITH_MPI
   MPI_Comm_size(MPI_COMM_WORLD,&psize);
@@ -54,6 +72,10 @@ int initialize() {
     defaultLoopPattern = LoopPattern::TPX;    // On cpus, works best (generally)
   #endif
 
+  #ifdef LOOP_AUTOTUNE
+    loopTuner.Init();
+  #endif
+
   #ifdef WITH_MPI
     Mpi::CheckConfig();
   #endif
@@ -61,6 +83,13 @@ int initialize() {
   return(0);
 }   // Initialisation routine for idefix
 
+// The members of an ensemble run in their own directory, while their input tables are given
+// relative to the directory where idefix was launched.
+std::string inputPath(const std::string &filename) {
+  if(inputDirectory.empty() || fs::path(filename).is_absolute()) return(filename);
+  return((fs::path(inputDirectory) / filename).string());
+}
+
 void pushRegion(const std::string& kName) {
   Kokkos::Profiling::pushRegion(kName);
   if(prof.perfEnabled) {
@@ -92,6 +121,39 @@ void popRegion() {
 #endif
 }
 
+void pushKernel(const std::string& kName) {
+  prof.StartKernel(kName);
+}
+
+void popKernel(int64_t nIterations) {
+  prof.StopKernel(nIterations);
+}
+
+void setKernelCost(const std::string& kName, double bytes, double flops) {
+  prof.SetKernelCost(kName, bytes, flops);
+}
+
+const LoopVariant& pushLoop(const std::string& kName, int nn, int nk, int nj, int ni) {
+  return(loopTuner.Begin(kName, nn, nk, nj, ni));
+}
+
+void popLoop() {
+  loopTuner.End();
+}
+
+Kokkos::DefaultExecutionSpace GetExecutionSpace() {
+  if(currentSpace) return(*currentSpace);
+  return(Kokkos::DefaultExecutionSpace());
+}
+
+void SetExecutionSpace(const Kokkos::DefaultExecutionSpace &space) {
+  currentSpace = std::make_unique<Kokkos::DefaultExecutionSpace>(space);
+}
+
+void ResetExecutionSpace() {
+  currentSpace.reset();
+}
+
 // Init the iostream with defined rank
 void IdefixOutStream::init(int rank) {
   if(rank==0)
@@ -112,6 +174,17 @@ void IdefixOutStream::enableLogFile() {
   this->logFileEnabled = true;
 }
 
+// Close the log file and reopen it in another directory (when the log file is enabled)
+void IdefixOutStream::moveLogFile(const std::string &directory, bool append) {
+  if(!logFileEnabled) return;
+  std::stringstream sslogFileName;
+  sslogFileName << directory << "/idefix." << idfx::prank << ".log";
+
+  this->my_fstream.close();
+  this->my_fstream.open(sslogFileName.str().c_str(),
+                        append ? std::ios::out | std::ios::app : std::ios::out);
+}
+
 
 /*********************************************/
 /**
@@ -16,22 +16,40 @@ namespace idfx {
 int initialize();   // Initialisation routine for idefix
 real randm();      // Custom random number generator
 void safeExit(int );       // Exit the code
+std::string inputPath(const std::string &);  // Path of an input table (ensemble members)
 class IdefixOutStream;
 class IdefixErrStream;
 class Profiler;
+class LoopTuner;
+struct LoopVariant;
 
 extern int prank;                       //< parallel rank
 extern int psize;
 extern IdefixOutStream cout;              //< custom cout for idefix
 extern IdefixErrStream cerr;              //< custom cerr for idefix
 extern Profiler prof;                   //< profiler (for memory & performance usage)
+extern LoopTuner loopTuner;             //< loop pattern autotuner (with LOOP_AUTOTUNE)
 extern double mpiCallsTimer;            //< time significant MPI calls
+extern int64_t mpiCallsBytes;           //< bytes sent by significant MPI calls
 extern LoopPattern defaultLoopPattern;  //< default loop patterns (for idefix_for loops)
 extern bool warningsAreErrors;    //< whether warnings should be considered as errors
+extern std::string inputDirectory;      //< where relative input tables are read (when not empty)
 
 void pushRegion(const std::string&);
 void popRegion();
 
+void pushKernel(const std::string&);                    // start timing a kernel
+void popKernel(int64_t);                                // stop timing (arg: # of iterations)
+void setKernelCost(const std::string&, double, double); // bytes & flops per kernel iteration
+
+const LoopVariant& pushLoop(const std::string&, int, int, int, int); // loop variant to be used
+void popLoop();                                                      // end of the tuned loop
+
+// Execution space instance in which idefix_for and idefix_reduce launch their kernels
+Kokkos::DefaultExecutionSpace GetExecutionSpace();
+void SetExecutionSpace(const Kokkos::DefaultExecutionSpace &);  // use this instance from now on
+void ResetExecutionSpace();                                     // back to the default instance
+
 template<typename T>
 IdefixArray1D<T> ConvertVectorToIdefixArray(std::vector<T> &inputVector) {
   IdefixArray1D<T> outArr = IdefixArray1D<T>("Vector",inputVector.size());
@@ -50,6 +68,7 @@ class idfx::IdefixOutStream {
  public:
   void init(int);
   void enableLogFile();
+  void moveLogFile(const std::string &, bool = false);  // reopen the log file in a directory
   // for regular output of variables and stuff
   template<typename T> IdefixOutStream& operator<<(const T& something) {
     if(toscreen) std::cout << something;
@@ -0,0 +1,806 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef IMPLICIT_IMPLICITPARABOLIC_HPP_
+#define IMPLICIT_IMPLICITPARABOLIC_HPP_
+
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "dataBlock.hpp"
+#include "viscosity.hpp"
+#include "bragViscosity.hpp"
+#include "iterativesolver.hpp"
+#include "bicgstab.hpp"
+#include "cg.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+// Linearly implicit integration of the parabolic terms.
+// For a parabolic operator L, the increment dU over a timestep dt solves
+//      (1 - theta dt J) dU = dt L(U0)
+// where J is the jacobian of L at U0 (theta=1: backward Euler, theta=1/2: Crank-Nicolson).
+// The system is solved matrix-free with an iterative solver, J.v being approximated by a
+// finite difference of L (Jacobian-free Newton-Krylov, with a single Newton iteration).
+// The P solvers scale the system symmetrically with the approximate diagonal D of the operator,
+// solving D^-1/2 (1 - theta dt J) D^-1/2 y = D^-1/2 dt L(U0) with dU = D^-1/2 y, so that the
+// scaled operator stays symmetric when J is (as required by CG).
+// The unknowns (cell-centered variables and face-centered fields in the active domain) are
+// stored in a flat vector, seen as a (1,1,size) array by the iterative solvers.
+template<typename Phys>
+class ImplicitParabolic {
+ public:
+  ImplicitParabolic(Input &, Fluid<Phys>*);
+  void Cycle();
+  void ShowConfig();
+
+  // Linear operator of the implicit problem, as expected by the iterative solvers
+  void operator() (IdefixArray3D<real> in, IdefixArray3D<real> out);
+
+  IdefixArray4D<real> dU;      // parabolic time derivative of the cell-centered variables
+  IdefixArray4D<real> dB;      // parabolic time derivative of the face-centered field
+
+  IdefixArray1D<int> varList;  // List of variables which should be evolved
+  int nvarImplicit{0};         // # of active variables
+
+  real theta;                  // implicitness of the scheme
+  int niter{0};                // # of iterations of the last solve
+
+ private:
+  enum ImplicitSolver {BICGSTAB, PBICGSTAB, CG, PCG};
+
+  void AddVariable(int, std::vector<int> & );
+  void ComputeDerivative(real);    // Compute dU and dB from the current state
+  void EvolveStage(real);
+  void ResetStage();
+  template<int> void LoopDir(real);   // Dimensional loop
+  template<int> void CalcParabolicRHS(real);
+  void SetBoundaries(real);        // Enforce boundary conditions on the implicit variables
+  void ComputeScale();             // Jacobi scaling of the system
+
+  void Gather(IdefixArray4D<real> &, IdefixArray4D<real> &, IdefixArray3D<real> &);
+  void Scatter(IdefixArray3D<real> &, real);    // Set the state to u0 + eps*vec
+
+  DataBlock *data;
+  Fluid<Phys> *hydro;
+
+#ifdef WITH_MPI
+  Mpi mpi;                      // Implicit-specific MPI layer
+#endif
+
+  bool haveVs{false};           // Whether we have (and need to compute) face-centered variables
+  bool haveVc{false};           // Whether we need to compute cell-centered variables
+  bool computeDiagonal{false};  // Whether the current evaluation fills InvDt
+
+  ImplicitSolver solverType;
+  bool havePreconditioner{false};
+  std::unique_ptr<IterativeSolver<ImplicitParabolic<Phys>>> solver;
+
+  // Layout of the vector of unknowns
+  int size;                     // total number of unknowns
+  int ncell;                    // # of cells in the active domain
+  int faceStart[3];             // position of the face-centered field components
+
+  IdefixArray3D<real> u0;       // state at the beginning of the step
+  IdefixArray3D<real> l0;       // parabolic time derivative at the beginning of the step
+  IdefixArray3D<real> rhs;      // right hand side of the implicit problem
+  IdefixArray3D<real> delta;    // increment over the step (scaled by D^1/2 during the solve)
+  IdefixArray3D<real> scale;    // D^-1/2, D being the approximate diagonal of the operator
+  IdefixArray3D<real> work;     // unscaled direction of the operator
+  real normU0;
+  real t, dt;
+};
+
+#include "fluid.hpp"
+#include "calcParabolicFlux.hpp"
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::AddVariable(int var, std::vector<int> &varListHost ) {
+  for(int i = 0 ; i < varListHost.size() ; i++) {
+    if(varListHost[i] == var) return;
+  }
+  varListHost.push_back(var);
+}
+
+template<typename Phys>
+ImplicitParabolic<Phys>::ImplicitParabolic(Input &input, Fluid<Phys>* hydroin) {
+  idfx::pushRegion("ImplicitParabolic::Init");
+
+  // Save the datablock to which we are attached from now on
+  this->data = hydroin->data;
+  this->hydro = hydroin;
+
+  std::string scheme = input.GetOrSet<std::string>("Implicit","scheme",0,"euler");
+  if(scheme.compare("euler") == 0) {
+    theta = ONE_F;
+  } else if(scheme.compare("crank-nicolson") == 0) {
+    theta = HALF_F;
+  } else {
+    std::stringstream msg;
+    msg << "ImplicitParabolic: Unknown scheme \"" << scheme << "\". "
+        << "Use \"euler\" or \"crank-nicolson\".";
+    IDEFIX_ERROR(msg);
+  }
+
+  std::string strSolver = input.GetOrSet<std::string>("Implicit","solver",0,"PBICGSTAB");
+  if(strSolver.compare("BICGSTAB") == 0) {
+    solverType = BICGSTAB;
+  } else if(strSolver.compare("PBICGSTAB") == 0) {
+    solverType = PBICGSTAB;
+  } else if(strSolver.compare("CG") == 0) {
+    solverType = CG;
+  } else if(strSolver.compare("PCG") == 0) {
+    solverType = PCG;
+  } else {
+    std::stringstream msg;
+    msg << "ImplicitParabolic: Unknown solver \"" << strSolver << "\". "
+        << "Use \"BICGSTAB\", \"PBICGSTAB\", \"CG\" or \"PCG\".";
+    IDEFIX_ERROR(msg);
+  }
+  havePreconditioner = (solverType == PBICGSTAB || solverType == PCG);
+
+  real targetError = input.GetOrSet<real>("Implicit","targetError",0,1e-5);
+  int maxiter = input.GetOrSet<int>("Implicit","maxIter",0,100);
+
+  if(data->haveGridCoarsening) {
+    IDEFIX_ERROR("Implicit parabolic terms are not compatible with grid coarsening");
+  }
+  // The metric terms of stretched and curvilinear grids make the jacobian non symmetric, which
+  // the diagonal scaling does not cure
+  if((solverType == CG || solverType == PCG) && !data->mygrid->isRegularCartesian) {
+    IDEFIX_ERROR("ImplicitParabolic: the CG and PCG solvers require a symmetric problem, "
+                 "hence a regular cartesian grid. Use BICGSTAB or PBICGSTAB instead.");
+  }
+
+  // Make a list of variables (same as RKL)
+  std::vector<int> varListHost;
+  // Viscosity
+  if(hydro->viscosityStatus.isImplicit || hydro->bragViscosityStatus.isImplicit) {
+    haveVc = true;
+    EXPAND( AddVariable(MX1, varListHost);   ,
+            AddVariable(MX2, varListHost);   ,
+            AddVariable(MX3, varListHost);   )
+
+    #if HAVE_ENERGY
+      AddVariable(ENG, varListHost);
+    #endif
+  }
+
+  // Thermal diffusion
+  #if HAVE_ENERGY
+    if(hydro->thermalDiffusionStatus.isImplicit
+        || hydro->bragThermalDiffusionStatus.isImplicit) {
+      haveVc = true;
+      AddVariable(ENG, varListHost);
+    }
+  #endif
+  // Ambipolar diffusion
+  if(hydro->ambipolarStatus.isImplicit || hydro->resistivityStatus.isImplicit) {
+    #ifdef EVOLVE_VECTOR_POTENTIAL
+      IDEFIX_ERROR("Implicit non-ideal MHD is not compatible with EVOLVE_VECTOR_POTENTIAL");
+    #endif
+    #if COMPONENTS == 3 && DIMENSIONS < 3
+      haveVc = true;
+      AddVariable(BX3, varListHost);
+    #endif
+    #if COMPONENTS >= 2 && DIMENSIONS < 2
+      haveVc = true;
+      AddVariable(BX2, varListHost);
+    #endif
+    #if HAVE_ENERGY
+      haveVc = true;
+      AddVariable(ENG, varListHost);
+    #endif
+    haveVs = true;
+  }
+
+  // Copy the list on the device
+  varList = idfx::ConvertVectorToIdefixArray(varListHost);
+  nvarImplicit = varListHost.size();
+
+  #ifdef WITH_MPI
+    mpi.Init(data->mygrid, varListHost, data->nghost.data(), data->np_int.data(), haveVs);
+  #endif
+
+  // Layout of the vector of unknowns: the cell-centered variables, followed by each component
+  // of the face-centered field (which has one more point in its own direction)
+  ncell = data->np_int[IDIR]*data->np_int[JDIR]*data->np_int[KDIR];
+  size = nvarImplicit*ncell;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    faceStart[dir] = size;
+    if(haveVs && dir < DIMENSIONS) {
+      size += (data->np_int[IDIR] + (dir == IDIR ? 1 : 0))
+             *(data->np_int[JDIR] + (dir == JDIR ? 1 : 0))
+             *(data->np_int[KDIR] + (dir == KDIR ? 1 : 0));
+    }
+  }
+
+  // Variable allocation
+  dU = IdefixArray4D<real>("Implicit_dU", NVAR,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  if(haveVs) {
+    dB = IdefixArray4D<real>("Implicit_dB", DIMENSIONS,
+                        data->np_tot[KDIR]+KOFFSET,
+                        data->np_tot[JDIR]+JOFFSET,
+                        data->np_tot[IDIR]+IOFFSET);
+  }
+
+  u0 = IdefixArray3D<real>("Implicit_u0", 1, 1, size);
+  l0 = IdefixArray3D<real>("Implicit_l0", 1, 1, size);
+  rhs = IdefixArray3D<real>("Implicit_rhs", 1, 1, size);
+  delta = IdefixArray3D<real>("Implicit_delta", 1, 1, size);
+  scale = IdefixArray3D<real>("Implicit_scale", 1, 1, size);
+  work = IdefixArray3D<real>("Implicit_work", 1, 1, size);
+
+  std::array<int,3> ntot = {size, 1, 1};
+  std::array<int,3> beg = {0, 0, 0};
+  if(solverType == BICGSTAB || solverType == PBICGSTAB) {
+    solver = std::make_unique<Bicgstab<ImplicitParabolic<Phys>>>(*this, targetError, maxiter,
+                                                                 ntot, beg, ntot);
+  } else {
+    solver = std::make_unique<Cg<ImplicitParabolic<Phys>>>(*this, targetError, maxiter,
+                                                           ntot, beg, ntot);
+  }
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::ShowConfig() {
+  if(theta == ONE_F) {
+    idfx::cout << "ImplicitParabolic: backward Euler scheme ENABLED." << std::endl;
+  } else {
+    idfx::cout << "ImplicitParabolic: Crank-Nicolson scheme ENABLED." << std::endl;
+  }
+  idfx::cout << "ImplicitParabolic: using ";
+  switch(solverType) {
+    case BICGSTAB:
+      idfx::cout << "unpreconditionned BICGSTAB";
+      break;
+    case PBICGSTAB:
+      idfx::cout << "preconditionned BICGSTAB";
+      break;
+    case CG:
+      idfx::cout << "unpreconditionned CG";
+      break;
+    case PCG:
+      idfx::cout << "preconditionned CG";
+      break;
+  }
+  idfx::cout << " solver." << std::endl;
+  if(haveVc) {
+     idfx::cout << "ImplicitParabolic: will evolve cell-centered fields Vc." << std::endl;
+  }
+  if(haveVs) {
+     idfx::cout << "ImplicitParabolic: will evolve face-centered fields Vs." << std::endl;
+  }
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::Cycle() {
+  idfx::pushRegion("ImplicitParabolic::Cycle");
+
+  t = data->t;
+  dt = data->dt;
+
+  // Tell the datablock that we're performing the implicit step
+  data->implicitCycle = true;
+
+  // Apply Boundary conditions on the full set of variables
+  hydro->boundary->SetBoundaries(t);
+
+  // Convert current state into conservative variable, and store it
+  hydro->ConvertPrimToCons();
+  Gather(hydro->Uc, hydro->Vs, u0);
+  normU0 = std::sqrt(solver->ComputeDotProduct(u0, u0));
+
+  // Parabolic time derivative at the beginning of the step
+  computeDiagonal = true;
+  ComputeDerivative(t);
+  computeDiagonal = false;
+  Gather(dU, dB, l0);
+
+  ComputeScale();
+
+  // Right hand side and initial guess
+  IdefixArray3D<real> rhs = this->rhs;
+  IdefixArray3D<real> delta = this->delta;
+  IdefixArray3D<real> l0 = this->l0;
+  IdefixArray3D<real> scale = this->scale;
+  const real dt = this->dt;
+  idefix_for("Implicit_InitSolve", 0, 1, 0, 1, 0, size,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      rhs(k,j,i) = dt*l0(k,j,i)*scale(k,j,i);
+      delta(k,j,i) = ZERO_F;
+    });
+
+  // Nothing to solve when the parabolic terms vanish (the solvers normalise by the rhs)
+  if(solver->ComputeDotProduct(rhs, rhs) > ZERO_F) {
+    niter = solver->Solve(delta, rhs);
+    if(niter < 0) {
+      // BICGSTAB broke down. The solve already started from a null guess, so that restarting
+      // it would not help.
+      std::stringstream msg;
+      msg << "ImplicitParabolic: the solver broke down at t=" << t << "." << std::endl
+          << "Try a smaller CFL or a preconditioned solver.";
+      throw std::runtime_error(msg.str());
+    }
+  } else {
+    niter = 0;
+  }
+
+  // Update the state with the unscaled increment
+  idefix_for("Implicit_Unscale", 0, 1, 0, 1, 0, size,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      delta(k,j,i) *= scale(k,j,i);
+    });
+  Scatter(delta, ONE_F);
+  hydro->ConvertConsToPrim();
+
+  // Tell the datablock that we're done
+  data->implicitCycle = false;
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::operator() (IdefixArray3D<real> in, IdefixArray3D<real> out) {
+  idfx::pushRegion("ImplicitParabolic::Operator");
+
+  // Unscaled direction w = D^-1/2 in
+  IdefixArray3D<real> work = this->work;
+  IdefixArray3D<real> scale = this->scale;
+  idefix_for("Implicit_ScaleDirection", 0, 1, 0, 1, 0, size,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      work(k,j,i) = in(k,j,i)*scale(k,j,i);
+    });
+
+  const real norm = std::sqrt(solver->ComputeDotProduct(work, work));
+  if(norm == ZERO_F) {
+    Kokkos::deep_copy(out, ZERO_F);
+    idfx::popRegion();
+    return;
+  }
+
+  // Finite difference step, scaled with the state and the direction
+  const real eps = std::sqrt(std::numeric_limits<real>::epsilon())*(ONE_F+normU0)/norm;
+
+  Scatter(work, eps);
+  hydro->ConvertConsToPrim();
+  ComputeDerivative(t);
+  Gather(dU, dB, out);
+
+  // out = D^-1/2 (w - theta dt J.w)
+  IdefixArray3D<real> l0 = this->l0;
+  const real factor = theta*dt/eps;
+  idefix_for("Implicit_Operator", 0, 1, 0, 1, 0, size,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      out(k,j,i) = (work(k,j,i) - factor*(out(k,j,i) - l0(k,j,i)))*scale(k,j,i);
+    });
+
+  idfx::popRegion();
+}
+
+// Copy the implicit variables from cell-centered and face-centered arrays to a vector
+template<typename Phys>
+void ImplicitParabolic<Phys>::Gather(IdefixArray4D<real> &cell, IdefixArray4D<real> &face,
+                                     IdefixArray3D<real> &vec) {
+  IdefixArray1D<int> vars = this->varList;
+  const int ni = data->np_int[IDIR];
+  const int nj = data->np_int[JDIR];
+  const int ib = data->beg[IDIR];
+  const int jb = data->beg[JDIR];
+  const int kb = data->beg[KDIR];
+  const int ncell = this->ncell;
+
+  if(nvarImplicit > 0) {
+    idefix_for("Implicit_GatherVc",
+              0, nvarImplicit,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        vec(0,0,n*ncell + ((k-kb)*nj + j-jb)*ni + i-ib) = cell(vars(n),k,j,i);
+      });
+  }
+  if(haveVs) {
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      const int ioffset = (dir == IDIR) ? 1 : 0;
+      const int joffset = (dir == JDIR) ? 1 : 0;
+      const int koffset = (dir == KDIR) ? 1 : 0;
+      const int start = faceStart[dir];
+      idefix_for("Implicit_GatherVs",
+                data->beg[KDIR],data->end[KDIR]+koffset,
+                data->beg[JDIR],data->end[JDIR]+joffset,
+                data->beg[IDIR],data->end[IDIR]+ioffset,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          vec(0,0,start + ((k-kb)*(nj+joffset) + j-jb)*(ni+ioffset) + i-ib) = face(dir,k,j,i);
+        });
+    }
+  }
+}
+
+// Set the implicit variables of Uc and Vs to u0 + eps*vec
+template<typename Phys>
+void ImplicitParabolic<Phys>::Scatter(IdefixArray3D<real> &vec, real eps) {
+  IdefixArray4D<real> Uc = hydro->Uc;
+  IdefixArray3D<real> u0 = this->u0;
+  IdefixArray1D<int> vars = this->varList;
+  const int ni = data->np_int[IDIR];
+  const int nj = data->np_int[JDIR];
+  const int ib = data->beg[IDIR];
+  const int jb = data->beg[JDIR];
+  const int kb = data->beg[KDIR];
+  const int ncell = this->ncell;
+
+  if(nvarImplicit > 0) {
+    idefix_for("Implicit_ScatterVc",
+              0, nvarImplicit,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        const int idx = n*ncell + ((k-kb)*nj + j-jb)*ni + i-ib;
+        Uc(vars(n),k,j,i) = u0(0,0,idx) + eps*vec(0,0,idx);
+      });
+  }
+  if(haveVs) {
+    IdefixArray4D<real> Vs = hydro->Vs;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      const int ioffset = (dir == IDIR) ? 1 : 0;
+      const int joffset = (dir == JDIR) ? 1 : 0;
+      const int koffset = (dir == KDIR) ? 1 : 0;
+      const int start = faceStart[dir];
+      idefix_for("Implicit_ScatterVs",
+                data->beg[KDIR],data->end[KDIR]+koffset,
+                data->beg[JDIR],data->end[JDIR]+joffset,
+                data->beg[IDIR],data->end[IDIR]+ioffset,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          const int idx = start + ((k-kb)*(nj+joffset) + j-jb)*(ni+ioffset) + i-ib;
+          Vs(dir,k,j,i) = u0(0,0,idx) + eps*vec(0,0,idx);
+        });
+    }
+    hydro->boundary->ReconstructVcField(Uc);
+  }
+}
+
+// Inverse square root of the diagonal of the implicit operator, estimated from the parabolic
+// timestep of each cell. Used as a symmetric Jacobi scaling of the system.
+template<typename Phys>
+void ImplicitParabolic<Phys>::ComputeScale() {
+  idfx::pushRegion("ImplicitParabolic::ComputeScale");
+  IdefixArray3D<real> scale = this->scale;
+  if(!havePreconditioner) {
+    Kokkos::deep_copy(scale, ONE_F);
+    idfx::popRegion();
+    return;
+  }
+  IdefixArray3D<real> invDt = hydro->InvDt;
+  const int ni = data->np_int[IDIR];
+  const int nj = data->np_int[JDIR];
+  const int ib = data->beg[IDIR];
+  const int jb = data->beg[JDIR];
+  const int kb = data->beg[KDIR];
+  const int ncell = this->ncell;
+  // invDt = D/(2 dl^2) in each direction, while the diagonal of the discrete laplacian is 2D/dl^2
+  const real factor = 4.0*theta*dt;
+
+  if(nvarImplicit > 0) {
+    idefix_for("Implicit_DiagVc",
+              0, nvarImplicit,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        scale(0,0,n*ncell + ((k-kb)*nj + j-jb)*ni + i-ib) =
+                ONE_F/std::sqrt(ONE_F + factor*invDt(k,j,i));
+      });
+  }
+  if(haveVs) {
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      const int ioffset = (dir == IDIR) ? 1 : 0;
+      const int joffset = (dir == JDIR) ? 1 : 0;
+      const int koffset = (dir == KDIR) ? 1 : 0;
+      const int start = faceStart[dir];
+      const int ie = data->end[IDIR];
+      const int je = data->end[JDIR];
+      const int ke = data->end[KDIR];
+      idefix_for("Implicit_DiagVs",
+                data->beg[KDIR],data->end[KDIR]+koffset,
+                data->beg[JDIR],data->end[JDIR]+joffset,
+                data->beg[IDIR],data->end[IDIR]+ioffset,
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          // Use the cells on both sides of the face (invDt is only known in the active domain)
+          const int kp = (k < ke) ? k : k-1;
+          const int jp = (j < je) ? j : j-1;
+          const int ip = (i < ie) ? i : i-1;
+          const int km = (k-koffset >= kb) ? k-koffset : k;
+          const int jm = (j-joffset >= jb) ? j-joffset : j;
+          const int im = (i-ioffset >= ib) ? i-ioffset : i;
+          scale(0,0,start + ((k-kb)*(nj+joffset) + j-jb)*(ni+ioffset) + i-ib) =
+                ONE_F/std::sqrt(ONE_F + factor*std::fmax(invDt(kp,jp,ip), invDt(km,jm,im)));
+        });
+    }
+  }
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::ComputeDerivative(real t) {
+  SetBoundaries(t);
+  EvolveStage(t);
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::ResetStage() {
+  idfx::pushRegion("ImplicitParabolic::ResetStage");
+  IdefixArray4D<real> dU = this->dU;
+  IdefixArray4D<real> dB = this->dB;
+  IdefixArray3D<real> invDt = hydro->InvDt;
+  IdefixArray1D<int> vars = this->varList;
+  IdefixArray3D<real> ex,ey,ez;
+  if constexpr(Phys::mhd) {
+    ex = hydro->emf->ex;
+    ey = hydro->emf->ey;
+    ez = hydro->emf->ez;
+  }
+  const int nvar = this->nvarImplicit;
+  const bool haveVs = this->haveVs;
+  const bool computeDiagonal = this->computeDiagonal;
+
+  idefix_for("Implicit_ResetStage",
+             0,data->np_tot[KDIR],
+             0,data->np_tot[JDIR],
+             0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      for(int n = 0 ; n < nvar ; n++) {
+        dU(vars(n),k,j,i) = ZERO_F;
+      }
+      if(computeDiagonal) invDt(k,j,i) = ZERO_F;
+      if constexpr(Phys::mhd) {
+        if(haveVs) {
+          for(int n=0; n < DIMENSIONS; n++) {
+            dB(n,k,j,i) = ZERO_F;
+          }
+          D_EXPAND( ez(k,j,i) = 0.0;    ,
+                                        ,
+                    ex(k,j,i) = 0.0;
+                    ey(k,j,i) = 0.0;    )
+        }
+      }
+    });
+  idfx::popRegion();
+}
+
+template<typename Phys>
+template<int dir>
+void ImplicitParabolic<Phys>::LoopDir(real t) {
+  // Reset the fluxes of the implicit variables
+  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray1D<int> vars = this->varList;
+  idefix_for("Implicit_ResetFlux",
+             0,nvarImplicit,
+             0,data->np_tot[KDIR],
+             0,data->np_tot[JDIR],
+             0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int n, int k, int j, int i) {
+      Flux(vars(n),k,j,i) = ZERO_F;
+    });
+
+  hydro->template CalcParabolicFlux<dir>(t);
+
+  CalcParabolicRHS<dir>(t);
+
+  // Recursive: do next dimension
+  if constexpr(dir+1<DIMENSIONS) {
+    LoopDir<dir+1>(t);
+  }
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::EvolveStage(real t) {
+  idfx::pushRegion("ImplicitParabolic::EvolveStage");
+  data->stageCount++;
+
+  ResetStage();
+
+  if(haveVs && hydro->needImplicitCurrent) hydro->CalcCurrent();
+
+  // Loop on dimensions for the parabolic fluxes and RHS, starting from IDIR
+  if(haveVc || computeDiagonal) LoopDir<IDIR>(t);
+
+  if constexpr(Phys::mhd) {
+    if(haveVs) {
+      hydro->emf->CalcNonidealEMF(t);
+      hydro->emf->EnforceEMFBoundary();
+      hydro->emf->EvolveMagField(t, ONE_F, this->dB);
+    }
+  }
+  idfx::popRegion();
+}
+
+template<typename Phys>
+template <int dir>
+void ImplicitParabolic<Phys>::CalcParabolicRHS(real t) {
+  idfx::pushRegion("ImplicitParabolic::CalcParabolicRHS");
+
+  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray3D<real> A    = data->A[dir];
+  IdefixArray3D<real> dV   = data->dV;
+  IdefixArray1D<real> x1m  = data->xl[IDIR];
+  IdefixArray1D<real> x1   = data->x[IDIR];
+  IdefixArray1D<real> sm   = data->sinx2m;
+  IdefixArray1D<real> rt   = data->rt;
+  IdefixArray1D<real> dmu  = data->dmu;
+  IdefixArray1D<real> s    = data->sinx2;
+  IdefixArray1D<real> dx   = data->dx[dir];
+  IdefixArray1D<real> dx2  = data->dx[JDIR];
+  IdefixArray3D<real> invDt = hydro->InvDt;
+  IdefixArray3D<real> dMax = hydro->dMax;
+  IdefixArray4D<real> dU = this->dU;
+  IdefixArray1D<int> varList = this->varList;
+
+  IdefixArray4D<real> viscSrc;
+  bool haveViscosity = hydro->viscosityStatus.isImplicit;
+  if(haveViscosity) viscSrc = hydro->viscosity->viscSrc;
+  IdefixArray4D<real> bragViscSrc;
+  bool haveBragViscosity = hydro->bragViscosityStatus.isImplicit;
+  if(haveBragViscosity) bragViscSrc = hydro->bragViscosity->bragViscSrc;
+
+  constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+  constexpr int joffset = (dir==JDIR) ? 1 : 0;
+  constexpr int koffset = (dir==KDIR) ? 1 : 0;
+
+  idefix_for("Implicit_CalcTotalFlux",
+             0, this->nvarImplicit,
+             data->beg[KDIR],data->end[KDIR]+koffset,
+             data->beg[JDIR],data->end[JDIR]+joffset,
+             data->beg[IDIR],data->end[IDIR]+ioffset,
+    KOKKOS_LAMBDA (int n, int k, int j, int i) {
+      real Ax = A(k,j,i);
+
+#if GEOMETRY != CARTESIAN
+      if(Ax<SMALL_NUMBER)
+        Ax=SMALL_NUMBER;    // Essentially to avoid singularity around poles
+#endif
+
+      const int nv = varList(n);
+
+      Flux(nv,k,j,i) = Flux(nv,k,j,i) * Ax;
+
+      // Curvature terms
+#if    (GEOMETRY == POLAR       && COMPONENTS >= 2) \
+    || (GEOMETRY == CYLINDRICAL && COMPONENTS == 3)
+      if(dir==IDIR && nv==iMPHI) {
+        // Conserve angular momentum, hence flux is R*Vphi
+        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(x1m(i));
+      }
+#endif // GEOMETRY==POLAR OR CYLINDRICAL
+
+#if GEOMETRY == SPHERICAL && COMPONENTS == 3
+      if(dir==IDIR && nv==iMPHI) {
+        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(x1m(i));
+      } else if(dir==JDIR && nv==iMPHI) {
+        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(sm(j));
+      }
+#endif // GEOMETRY == SPHERICAL && COMPONENTS == 3
+    }
+  );
+
+  idefix_for("Implicit_CalcRightHandSide",
+             0, this->nvarImplicit,
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+    KOKKOS_LAMBDA (int n, int k, int j, int i) {
+      const int nv = varList(n);
+
+      real rhs = -  ( Flux(nv, k+koffset, j+joffset, i+ioffset)
+                     - Flux(nv, k, j, i))/dV(k,j,i);
+
+      // Viscosity source terms
+      if( haveViscosity && (nv-VX1 < COMPONENTS) && (nv-VX1>=0)) {
+        rhs += viscSrc(nv-VX1,k,j,i);
+      }
+      // Braginskii Viscosity source terms
+      if (haveBragViscosity && (nv-VX1 < COMPONENTS) && (nv-VX1>=0)) {
+        rhs += bragViscSrc(nv-VX1,k,j,i);
+      }
+
+#if GEOMETRY != CARTESIAN
+  #ifdef iMPHI
+      if((dir==IDIR) && (nv == iMPHI)) {
+        rhs /= x1(i);
+      }
+    #if (GEOMETRY == SPHERICAL) && (COMPONENTS == 3)
+      if((dir==JDIR) && (nv == iMPHI)) {
+        rhs /= FABS(s(j));
+      }
+    #endif // GEOMETRY
+      // Nothing for KDIR
+  #endif  // iMPHI
+#endif // GEOMETRY != CARTESIAN
+
+      dU(nv,k,j,i) += rhs;
+    });
+
+  // Parabolic rate of each cell, for the preconditioner
+  if(computeDiagonal) {
+    idefix_for("Implicit_CalcDt",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        const int ig = ioffset*i + joffset*j + koffset*k;
+        real dl = dx(ig);
+        #if GEOMETRY == POLAR
+          if (dir==JDIR)
+            dl = dl*x1(i);
+
+        #elif GEOMETRY == SPHERICAL
+          if (dir==JDIR)
+            dl = dl*rt(i);
+          else
+            if (dir==KDIR)
+              dl = dl*rt(i)*dmu(j)/dx2(j);
+        #endif
+
+        invDt(k,j,i) += 0.5 * std::fmax(dMax(k+koffset,j+joffset,i+ioffset),
+                                        dMax(k,j,i)) / (dl*dl);
+      });
+  }
+
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::SetBoundaries(real t) {
+  idfx::pushRegion("ImplicitParabolic::SetBoundaries");
+
+  for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
+    // MPI Exchange data when needed
+    // We use our own MPI object to ensure that we only exchange the implicit variables
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          this->mpi.ExchangeX1(hydro->Vc, hydro->Vs);
+          break;
+        case 1:
+          this->mpi.ExchangeX2(hydro->Vc, hydro->Vs);
+          break;
+        case 2:
+          this->mpi.ExchangeX3(hydro->Vc, hydro->Vs);
+          break;
+      }
+    }
+    #endif
+    hydro->boundary->EnforceBoundaryDir(t, dir);
+    if constexpr(Phys::mhd) {
+      // Reconstruct the normal field component when using CT
+      if(haveVs) {
+        hydro->boundary->ReconstructNormalField(dir);
+      }
+    }
+  } // Loop on dimension ends
+
+  if constexpr(Phys::mhd) {
+    // Remake the cell-centered field.
+    if(haveVs) {
+      hydro->boundary->ReconstructVcField(hydro->Vc);
+    }
+  }
+  idfx::popRegion();
+}
+
+#endif // IMPLICIT_IMPLICITPARABOLIC_HPP_
@@ -114,6 +114,7 @@ Input::Input(int argc, char* argv[] ) {
 void Input::ParseCommandLine(int argc, char **argv) {
   std::stringstream msg;
   bool enableLogs = true;
+  bool enableTrace = false;
   for(int i = 1 ; i < argc ; i++) {
     // MPI decomposition argument
     if(std::string(argv[i]) == "-dec") {
@@ -176,6 +177,8 @@ void Input::ParseCommandLine(int argc, char **argv) {
       enableLogs = false;
     } else if(std::string(argv[i]) == "-profile") {
       idfx::prof.EnablePerformanceProfiling();
+    } else if(std::string(argv[i]) == "-trace") {
+      enableTrace = true;
     } else if(std::string(argv[i]) == "-Werror") {
       idfx::warningsAreErrors = true;
     } else if(std::string(argv[i]) == "-version" || std::string(argv[i]) == "-v") {
@@ -193,6 +196,14 @@ void Input::ParseCommandLine(int argc, char **argv) {
   if(enableLogs) {
     idfx::cout.enableLogFile();
   }
+  if(enableTrace) {
+    if(forceNoWrite) {
+      // we can't write the trace, so just profile
+      idfx::prof.EnablePerformanceProfiling();
+    } else {
+      idfx::prof.EnableTracing();
+    }
+  }
 }
 
 
@@ -325,6 +336,23 @@ int Input::CheckEntry(std::string blockName, std::string paramName) {
   return(result);
 }
 
+// Set a parameter of an entry, replacing its current value. Only the parameters that already
+// exist and the one following them can be set.
+void Input::Set(std::string blockName, std::string paramName, int num, std::string value) {
+  int entrySize = std::max(CheckEntry(blockName, paramName), 0);
+  if(num < 0 || num > entrySize) {
+    std::stringstream msg;
+    msg << "Cannot set parameter " << num << " of [" << blockName << "]:" << paramName
+        << ", which has " << entrySize << " parameter(s)." << std::endl;
+    IDEFIX_ERROR(msg);
+  }
+  if(num == entrySize) {
+    inputParameters[blockName][paramName].push_back(value);
+  } else {
+    inputParameters[blockName][paramName][num] = value;
+  }
+}
+
 // Check that a block is present in the ini file.
 // If yes, return true
 bool Input::CheckBlock(std::string blockName) {
@@ -337,6 +365,18 @@ bool Input::CheckBlock(std::string blockName) {
   return(result);
 }
 
+// List the entries of a block (empty if the block is not defined)
+std::vector<std::string> Input::GetEntries(std::string blockName) {
+  std::vector<std::string> entries;
+  IdefixInputContainer::iterator block = inputParameters.find(blockName);
+  if(block != inputParameters.end()) {
+    for(auto const &param : block->second) {
+      entries.push_back(param.first);
+    }
+  }
+  return(entries);
+}
+
 void Input::PrintLogo() {
   idfx::cout << "                                  .:HMMMMHn:.  ..:n.."<< std::endl;
   idfx::cout << "                                .H*'``     `'%HM'''''!x."<< std::endl;
@@ -406,6 +446,9 @@ void Input::PrintOptions() {
   idfx::cout << "         Do not write any log file." << std::endl;
   idfx::cout << " -profile" << std::endl;
   idfx::cout << "         Enable on-the-fly performance profiling." << std::endl;
+  idfx::cout << " -trace" << std::endl;
+  idfx::cout << "         Enable performance profiling and write a timeline of each process";
+  idfx::cout << " (chrome trace format)." << std::endl;
   idfx::cout << " -Werror" << std::endl;
   idfx::cout << "         Consider warnings as errors." << std::endl;
   idfx::cout << " -v/-version" << std::endl;
@@ -44,8 +44,11 @@ class Input {
                                                         ///< (set it to T if not found)
 
 
+  void Set(std::string, std::string, int, std::string);  ///< set (or replace) a parameter
+
   bool CheckBlock(std::string);                         ///< check that whether a block is defined
                                                         ///< in the input file
+  std::vector<std::string> GetEntries(std::string);     ///< names of the entries of a block
   bool CheckForAbort();                                 // have we been asked for an abort?
   void CheckForStopFile();                              // have we been asked for an abort from
                                                         // a stop file?
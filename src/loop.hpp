@@ -12,12 +12,22 @@
 #ifndef LOOP_HPP_
 #define LOOP_HPP_
 
+#include <array>
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
 
 #define KOKKOS_VECTOR_LENGTH  8
 
+// Declare the memory traffic (in bytes) and the number of floating point operations
+// performed by each iteration of a named kernel. These are used by the kernel profiler
+// (Idefix_KERNEL_PROFILING) to compute the achieved bandwidth and flop rate of the kernel.
+#ifdef KERNEL_PROFILING
+  #define IDEFIX_KERNEL_COST(NAME, BYTES, FLOPS) idfx::setKernelCost(NAME, BYTES, FLOPS)
+#else
+  #define IDEFIX_KERNEL_COST(NAME, BYTES, FLOPS)
+#endif
+
 
 #ifdef INNER_TTR_LOOP
   #define TPINNERLOOP Kokkos::TeamThreadRange
@@ -59,7 +69,18 @@ typedef Kokkos::TeamPolicy<>::member_type  member_type;
   #endif
 #endif
 
+namespace idfx {
+// A loop pattern together with its tunable parameters
+struct LoopVariant {
+  LoopPattern pattern{defaultLoop};
+  int vectorLength{KOKKOS_VECTOR_LENGTH};   // vector length of team policies
+  std::array<int,3> tile{0, 0, 0};          // MDRange tile of the innermost indices (0=default)
+};
+} // namespace idfx
 
+// All of the loops below launch their kernels in the execution space instance returned by
+// idfx::GetExecutionSpace(), so that the blocks of a process can run concurrently
+// (see BlockScheduler).
 
 // 1D loop
 template <typename Function>
@@ -69,13 +90,19 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  #ifdef KERNEL_PROFILING
+  idfx::pushKernel(NAME);
+  #endif
   const int NI = IE - IB;
-  Kokkos::parallel_for(NAME, NI,
+  Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::GetExecutionSpace(), 0, NI),
     KOKKOS_LAMBDA (const int& IDX) {
       int i = IDX;
       i += IB;
       function(i);
   });
+  #ifdef KERNEL_PROFILING
+  idfx::popKernel(static_cast<int64_t>(IE-IB));
+  #endif
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
@@ -92,12 +119,15 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  #ifdef KERNEL_PROFILING
+  idfx::pushKernel(NAME);
+  #endif
   // Kokkos 1D Range
   if constexpr(defaultLoop == LoopPattern::RANGE) {
     const int NJ = JE - JB;
     const int NI = IE - IB;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME, NJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::GetExecutionSpace(), 0, NJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int j = IDX  / NI;
         int i = IDX - j*NI;
@@ -110,12 +140,13 @@ inline void idefix_for(const std::string & NAME,
   } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({JB,IB},{JE,IE}), function);
+        (idfx::GetExecutionSpace(), {JB,IB},{JE,IE}), function);
 
     // TeamPolicies with single inner loops
   } else if constexpr(defaultLoop == LoopPattern::TPX || defaultLoop == LoopPattern::TPTTRTVR ) {
     const int NJ = JE - JB;
-    Kokkos::parallel_for(NAME, team_policy (NJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+    Kokkos::parallel_for(NAME,
+      team_policy(idfx::GetExecutionSpace(), NJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         const int j = team_member.league_rank() + JB;
         Kokkos::parallel_for(TPINNERLOOP<>(team_member,IB,IE),
@@ -133,6 +164,9 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
+  #ifdef KERNEL_PROFILING
+  idfx::popKernel(static_cast<int64_t>(JE-JB)*(IE-IB));
+  #endif
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
@@ -140,24 +174,21 @@ inline void idefix_for(const std::string & NAME,
 }
 
 
-// 3D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int & KB, const int & KE,
-                       const int & JB, const int & JE,
-                       const int & IB, const int & IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 3D loop, using a given loop pattern
+template <LoopPattern pattern, typename Function>
+inline void idefix_for_pattern(const std::string & NAME, const idfx::LoopVariant & variant,
+                               const int & KB, const int & KE,
+                               const int & JB, const int & JE,
+                               const int & IB, const int & IE,
+                               Function function) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(pattern == LoopPattern::RANGE) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NI = IE - IB;
     const int NKNJNI = NK*NJ*NI;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME,NKNJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::GetExecutionSpace(), 0, NKNJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int k = IDX / NJNI;
         int j = (IDX - k*NJNI) / NI;
@@ -169,18 +200,25 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
-    Kokkos::parallel_for(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function);
+  } else if constexpr(pattern == LoopPattern::MDRANGE) {
+    if(variant.tile[0] > 0) {
+      Kokkos::parallel_for(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          (idfx::GetExecutionSpace(), {KB,JB,IB},{KE,JE,IE},
+           {variant.tile[0],variant.tile[1],variant.tile[2]}), function);
+    } else {
+      Kokkos::parallel_for(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          (idfx::GetExecutionSpace(), {KB,JB,IB},{KE,JE,IE}), function);
+    }
 
   // TeamPolicy with single inner loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(pattern == LoopPattern::TPX) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy(idfx::GetExecutionSpace(), NKNJ, Kokkos::AUTO,variant.vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() / NJ + KB;
         const int j = team_member.league_rank() % NJ + JB;
@@ -191,10 +229,10 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(pattern == LoopPattern::TPTTRTVR) {
     const int NK = KE - KB;
     Kokkos::parallel_for(NAME,
-      team_policy (NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy(idfx::GetExecutionSpace(), NK, Kokkos::AUTO,variant.vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() + KB;
         Kokkos::parallel_for(
@@ -209,7 +247,7 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(pattern == LoopPattern::SIMDFOR) {
     for (auto k = KB; k < KE; k++)
       for (auto j = JB; j < JE; j++)
 #pragma omp simd
@@ -218,25 +256,63 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
-  #ifdef DEBUG
-  Kokkos::fence();
-  idfx::popRegion();
-  #endif
 }
 
-// 4D loop
+// 3D loop
 template <typename Function>
 inline void idefix_for(const std::string & NAME,
-                       const int NB, const int NE,
-                       const int KB, const int KE,
-                       const int JB, const int JE,
-                       const int IB, const int IE,
+                       const int & KB, const int & KE,
+                       const int & JB, const int & JE,
+                       const int & IB, const int & IE,
                        Function function) {
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  #ifdef KERNEL_PROFILING
+  idfx::pushKernel(NAME);
+  #endif
+  #ifdef LOOP_AUTOTUNE
+  // Let the autotuner decide which pattern should be used for this kernel
+  const idfx::LoopVariant &variant = idfx::pushLoop(NAME, 1, KE-KB, JE-JB, IE-IB);
+  switch(variant.pattern) {
+    case LoopPattern::RANGE:
+      idefix_for_pattern<LoopPattern::RANGE>(NAME, variant, KB, KE, JB, JE, IB, IE, function);
+      break;
+    case LoopPattern::MDRANGE:
+      idefix_for_pattern<LoopPattern::MDRANGE>(NAME, variant, KB, KE, JB, JE, IB, IE, function);
+      break;
+    case LoopPattern::TPX:
+      idefix_for_pattern<LoopPattern::TPX>(NAME, variant, KB, KE, JB, JE, IB, IE, function);
+      break;
+    case LoopPattern::TPTTRTVR:
+      idefix_for_pattern<LoopPattern::TPTTRTVR>(NAME, variant, KB, KE, JB, JE, IB, IE, function);
+      break;
+    default:
+      idefix_for_pattern<defaultLoop>(NAME, variant, KB, KE, JB, JE, IB, IE, function);
+  }
+  idfx::popLoop();
+  #else
+  idefix_for_pattern<defaultLoop>(NAME, idfx::LoopVariant(), KB, KE, JB, JE, IB, IE, function);
+  #endif
+  #ifdef KERNEL_PROFILING
+  idfx::popKernel(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
+  #endif
+  #ifdef DEBUG
+  Kokkos::fence();
+  idfx::popRegion();
+  #endif
+}
+
+// 4D loop, using a given loop pattern
+template <LoopPattern pattern, typename Function>
+inline void idefix_for_pattern(const std::string & NAME, const idfx::LoopVariant & variant,
+                               const int NB, const int NE,
+                               const int KB, const int KE,
+                               const int JB, const int JE,
+                               const int IB, const int IE,
+                               Function function) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(pattern == LoopPattern::RANGE) {
     const int NN = (NE) - (NB);
     const int NK = (KE) - (KB);
     const int NJ = (JE) - (JB);
@@ -244,7 +320,7 @@ inline void idefix_for(const std::string & NAME,
     const int NNNKNJNI = NN*NK*NJ*NI;
     const int NKNJNI = NK*NJ*NI;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME,NNNKNJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::GetExecutionSpace(), 0, NNNKNJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int n = IDX / NKNJNI;
         int k = (IDX - n*NKNJNI) / NJNI;
@@ -258,20 +334,28 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
-    Kokkos::parallel_for(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<4,Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({NB,KB,JB,IB},{NE,KE,JE,IE}), function);
+  } else if constexpr(pattern == LoopPattern::MDRANGE) {
+    if(variant.tile[0] > 0) {
+      Kokkos::parallel_for(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<4,Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          (idfx::GetExecutionSpace(), {NB,KB,JB,IB},{NE,KE,JE,IE},
+           {1,variant.tile[0],variant.tile[1],variant.tile[2]}),
+          function);
+    } else {
+      Kokkos::parallel_for(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<4,Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          (idfx::GetExecutionSpace(), {NB,KB,JB,IB},{NE,KE,JE,IE}), function);
+    }
 
   // TeamPolicy loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(pattern == LoopPattern::TPX) {
     const int NN = NE - NB;
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     const int NNNKNJ = NN * NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NNNKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy(idfx::GetExecutionSpace(), NNNKNJ, Kokkos::AUTO,variant.vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NKNJ;
         int k = (team_member.league_rank() - n*NKNJ) / NJ;
@@ -286,12 +370,12 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(pattern == LoopPattern::TPTTRTVR) {
     const int NN = NE - NB;
     const int NK = KE - KB;
     const int NNNK = NN * NK;
     Kokkos::parallel_for(NAME,
-      team_policy (NNNK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy(idfx::GetExecutionSpace(), NNNK, Kokkos::AUTO,variant.vectorLength),
       KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NK + NB;
         int k = team_member.league_rank() % NK + KB;
@@ -307,7 +391,7 @@ inline void idefix_for(const std::string & NAME,
       });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(pattern == LoopPattern::SIMDFOR) {
     for (auto n = NB; n < NE; n++)
       for (auto k = KB; k < KE; k++)
         for (auto j = JB; j < JE; j++)
@@ -317,6 +401,53 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
+}
+
+// 4D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int NB, const int NE,
+                       const int KB, const int KE,
+                       const int JB, const int JE,
+                       const int IB, const int IE,
+                       Function function) {
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  #ifdef KERNEL_PROFILING
+  idfx::pushKernel(NAME);
+  #endif
+  #ifdef LOOP_AUTOTUNE
+  // Let the autotuner decide which pattern should be used for this kernel
+  const idfx::LoopVariant &variant = idfx::pushLoop(NAME, NE-NB, KE-KB, JE-JB, IE-IB);
+  switch(variant.pattern) {
+    case LoopPattern::RANGE:
+      idefix_for_pattern<LoopPattern::RANGE>(NAME, variant, NB, NE, KB, KE, JB, JE, IB, IE,
+                                             function);
+      break;
+    case LoopPattern::MDRANGE:
+      idefix_for_pattern<LoopPattern::MDRANGE>(NAME, variant, NB, NE, KB, KE, JB, JE, IB, IE,
+                                               function);
+      break;
+    case LoopPattern::TPX:
+      idefix_for_pattern<LoopPattern::TPX>(NAME, variant, NB, NE, KB, KE, JB, JE, IB, IE,
+                                           function);
+      break;
+    case LoopPattern::TPTTRTVR:
+      idefix_for_pattern<LoopPattern::TPTTRTVR>(NAME, variant, NB, NE, KB, KE, JB, JE, IB, IE,
+                                                function);
+      break;
+    default:
+      idefix_for_pattern<defaultLoop>(NAME, variant, NB, NE, KB, KE, JB, JE, IB, IE, function);
+  }
+  idfx::popLoop();
+  #else
+  idefix_for_pattern<defaultLoop>(NAME, idfx::LoopVariant(), NB, NE, KB, KE, JB, JE, IB, IE,
+                                  function);
+  #endif
+  #ifdef KERNEL_PROFILING
+  idfx::popKernel(static_cast<int64_t>(NE-NB)*(KE-KB)*(JE-JB)*(IE-IB));
+  #endif
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
@@ -0,0 +1,197 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "loopTuner.hpp"
+
+namespace idfx {
+
+static const std::map<LoopPattern, std::string> patternNames = {
+                                        {LoopPattern::SIMDFOR, "SIMD"},
+                                        {LoopPattern::RANGE, "Range"},
+                                        {LoopPattern::MDRANGE, "MDRange"},
+                                        {LoopPattern::TPX, "TeamPolicy"},
+                                        {LoopPattern::TPTTRTVR, "TeamPolicyInnerVector"}};
+
+void LoopTuner::Init() {
+  // The compile-time default comes first, so that it wins in case of a tie
+  candidates.push_back(LoopVariant());
+
+  std::vector<LoopVariant> variants;
+  LoopVariant variant;
+
+  variant.pattern = LoopPattern::RANGE;
+  variants.push_back(variant);
+
+  variant.pattern = LoopPattern::MDRANGE;
+  for(std::array<int,3> tile : {std::array<int,3>{0, 0, 0},
+                                std::array<int,3>{1, 4, 32},
+                                std::array<int,3>{1, 8, 64}}) {
+    variant.tile = tile;
+    variants.push_back(variant);
+  }
+  variant.tile = {0, 0, 0};
+
+  const int maxVectorLength = team_policy::vector_length_max();
+  for(LoopPattern pattern : {LoopPattern::TPX, LoopPattern::TPTTRTVR}) {
+    variant.pattern = pattern;
+    for(int vectorLength : {1, KOKKOS_VECTOR_LENGTH, 32}) {
+      if(vectorLength > maxVectorLength && vectorLength != KOKKOS_VECTOR_LENGTH) continue;
+      variant.vectorLength = vectorLength;
+      variants.push_back(variant);
+    }
+  }
+
+  // Skip the variants identical to the default one
+  for(const LoopVariant &v : variants) {
+    if(GetName(v) != GetName(candidates[0])) candidates.push_back(v);
+  }
+
+  enabled = true;
+  idfx::cout << "LoopTuner: autotuning " << candidates.size() << " loop variants ("
+             << nTrials << " calls each) for 3D and 4D kernels." << std::endl;
+  Load();
+}
+
+std::string LoopTuner::GetName(const LoopVariant &variant) {
+  std::stringstream name;
+  name << patternNames.at(variant.pattern);
+  if(variant.pattern == LoopPattern::MDRANGE && variant.tile[0] > 0) {
+    name << "(" << variant.tile[0] << "," << variant.tile[1] << "," << variant.tile[2] << ")";
+  }
+  if(variant.pattern == LoopPattern::TPX || variant.pattern == LoopPattern::TPTTRTVR) {
+    name << "(" << variant.vectorLength << ")";
+  }
+  return(name.str());
+}
+
+// Identify the target on which the tuning was done
+std::string LoopTuner::GetSignature() {
+  std::stringstream signature;
+  signature << Kokkos::DefaultExecutionSpace::name()
+            << "-" << Kokkos::DefaultExecutionSpace().concurrency()
+            << "-" << (sizeof(real) == 4 ? "single" : "double");
+  return(signature.str());
+}
+
+const LoopVariant& LoopTuner::Begin(const std::string &name, int nn, int nk, int nj, int ni) {
+  static const LoopVariant defaultVariant;
+  if(!enabled) return(defaultVariant);
+
+  // The best pattern depends on the loop extents, hence these are part of the kernel key
+  const std::string key = std::to_string(nn) + " " + std::to_string(nk) + " "
+                        + std::to_string(nj) + " " + std::to_string(ni) + " " + name;
+
+  auto it = kernels.find(key);
+  if(it == kernels.end()) {
+    KernelTuning tuning;
+    tuning.times.assign(candidates.size(), -1.0);
+    it = kernels.emplace(key, tuning).first;
+  }
+  KernelTuning &tuning = it->second;
+  if(tuning.best >= 0) return(candidates[tuning.best]);
+
+  // Still tuning: time this call
+  Kokkos::fence();
+  current = &tuning;
+  timer.reset();
+  return(candidates[tuning.candidate]);
+}
+
+void LoopTuner::End() {
+  if(current == nullptr) return;
+  Kokkos::fence();
+  const double t = timer.seconds();
+  KernelTuning &tuning = *current;
+  current = nullptr;
+
+  double &time = tuning.times[tuning.candidate];
+  if(time < 0 || t < time) time = t;
+
+  tuning.trial++;
+  if(tuning.trial >= nTrials) {
+    tuning.trial = 0;
+    tuning.candidate++;
+  }
+  if(tuning.candidate == candidates.size()) {
+    // All the candidates have been timed: pin the fastest
+    tuning.best = 0;
+    for(int n = 1 ; n < candidates.size() ; n++) {
+      if(tuning.times[n] < tuning.times[tuning.best]) tuning.best = n;
+    }
+    // Keep the cache up to date, since some kernels are only called once and never pinned
+    Save();
+  }
+}
+
+void LoopTuner::Save() {
+  if(!enabled || idfx::prank != 0) return;
+  std::ofstream file(filename);
+  if(!file) {
+    IDEFIX_WARNING("LoopTuner: cannot write "+filename);
+    return;
+  }
+  file << "# Idefix loop autotuning cache." << std::endl;
+  file << "# pattern vectorLength tile(3) loop extents(4) kernel name" << std::endl;
+  file << "machine " << GetSignature() << std::endl;
+  for(const auto &[key, tuning] : kernels) {
+    if(tuning.best < 0) continue;
+    const LoopVariant &variant = candidates[tuning.best];
+    file << patternNames.at(variant.pattern) << " " << variant.vectorLength << " "
+         << variant.tile[0] << " " << variant.tile[1] << " " << variant.tile[2] << " "
+         << key << std::endl;
+  }
+}
+
+void LoopTuner::Load() {
+  std::ifstream file(filename);
+  if(!file) return;
+
+  std::string line, word;
+  int nLoaded = 0;
+  while(std::getline(file, line)) {
+    if(line.empty() || line[0] == '#') continue;
+    std::stringstream stream(line);
+    stream >> word;
+    if(word == "machine") {
+      stream >> word;
+      if(word != GetSignature()) {
+        IDEFIX_WARNING("LoopTuner: "+filename+" was produced on a different target ("+word
+                       +"), the loops will be tuned again");
+        return;
+      }
+      continue;
+    }
+    // Find the pattern and the variant
+    LoopVariant variant;
+    variant.pattern = LoopPattern::UNDEFINED;
+    for(const auto &[pattern, name] : patternNames) {
+      if(name == word) variant.pattern = pattern;
+    }
+    if(variant.pattern == LoopPattern::UNDEFINED) continue;
+    stream >> variant.vectorLength >> variant.tile[0] >> variant.tile[1] >> variant.tile[2];
+    std::string key;
+    std::getline(stream, key);
+    key.erase(0, key.find_first_not_of(" "));
+
+    for(int n = 0 ; n < candidates.size() ; n++) {
+      if(GetName(candidates[n]) == GetName(variant)) {
+        KernelTuning tuning;
+        tuning.times.assign(candidates.size(), -1.0);
+        tuning.best = n;
+        kernels[key] = tuning;
+        nLoaded++;
+        break;
+      }
+    }
+  }
+  idfx::cout << "LoopTuner: " << nLoaded << " tuned kernels read from " << filename << std::endl;
+}
+
+}  // namespace idfx
@@ -0,0 +1,54 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef LOOPTUNER_HPP_
+#define LOOPTUNER_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+
+namespace idfx {
+
+// LoopTuner selects at runtime the loop pattern used by each 3D and 4D idefix_for
+// (only when compiled with LOOP_AUTOTUNE).
+// The first calls to a kernel (identified by its name and its loop extents) are used to time
+// each of the candidate loop variants. The fastest variant is then pinned for the rest of the
+// run, and saved in a cache file which is read back by later runs on the same machine.
+class LoopTuner {
+ public:
+  void Init();                              // build the candidate list and read the cache
+  const LoopVariant& Begin(const std::string &, int, int, int, int);
+  void End();
+  void Save();                              // write the pinned kernels to the cache file
+  static std::string GetName(const LoopVariant &);
+
+  bool enabled{false};
+  int nTrials{2};                           // # of timed calls per candidate
+  std::string filename{"idefix.autotune"};  // cache file
+
+ private:
+  struct KernelTuning {
+    std::vector<double> times;              // best time of each candidate
+    int candidate{0};                       // candidate being timed
+    int trial{0};
+    int best{-1};                           // pinned candidate (-1 while tuning)
+  };
+
+  std::string GetSignature();
+  void Load();
+
+  std::vector<LoopVariant> candidates;
+  std::map<std::string, KernelTuning> kernels;
+  KernelTuning *current{nullptr};           // kernel being timed
+  Kokkos::Timer timer;
+};
+
+}  // namespace idfx
+
+#endif // LOOPTUNER_HPP_
@@ -23,7 +23,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <Kokkos_Core.hpp>
 
@@ -37,6 +39,7 @@
 #include "timeIntegrator.hpp"
 #include "setup.hpp"
 #include "output.hpp"
+#include "ensemble.hpp"
 #ifdef WITH_MPI
 #include "mpi.hpp"
 #endif
@@ -44,6 +47,193 @@
 
 
 
+// Run a simulation, and return its return code (see main)
+static int Run(Input &input) {
+  int returnCode = 0;
+  idfx::mpiCallsTimer = 0;
+
+  idfx::cout << "Main: initialization stage." << std::endl;
+
+  // Allocate the grid on device
+  Grid grid(input);
+  // Allocate the grid image on host
+  GridHost gridHost(grid);
+
+  // Actually make the grid on host and sync it on the device
+  gridHost.MakeGrid(input);
+  gridHost.SyncToDevice();
+
+  // instantiate required objects.
+  DataBlock data(grid, input);
+  TimeIntegrator Tint(input,data);
+  Output output(input, data);
+  // The blocks of the process (if any) need their own setup, since they have their own fluids.
+  // The process DataBlock is set up last, so that the static variables of the setup refer to it.
+  std::vector<std::unique_ptr<Setup>> blockSetups;
+  if(data.scheduler->nblocks > 1) {
+    for(auto block : data.scheduler->blocks) {
+      blockSetups.emplace_back(std::make_unique<Setup>(input, grid, *block, output));
+    }
+  }
+  Setup mysetup(input, grid, data, output);
+  idfx::cout << "Main: initialisation finished." << std::endl;
+
+  char host[1024];
+  gethostname(host,1024);
+
+  idfx::cout << "Main: running on " << std::string(host) << std::endl;
+
+  ///////////////////////////////
+  // Show configuration
+  ///////////////////////////////
+  input.ShowConfig();
+  grid.ShowConfig();
+  data.ShowConfig();
+  Tint.ShowConfig();
+
+  ///////////////////////////////
+  // Initial conditions (or restart)
+  ///////////////////////////////
+  // Are we restarting?
+  if(input.restartRequested) {
+    if(input.forceInitRequested) {
+      idfx::pushRegion("Setup::Initflow");
+      mysetup.InitFlow(data);
+      data.DeriveVectorPotential();
+      idfx::popRegion();
+    }
+    idfx::cout << "Main: Restarting from dump file."  << std::endl;
+    bool restartSuccess = output.RestartFromDump(data,input.restartFileNumber);
+    if(!restartSuccess) {
+      idfx::cout << "Main: restart aborted." << std::endl;
+      input.restartRequested = false;
+    } else {
+      data.SetBoundaries();
+    }
+  }
+  if(!input.restartRequested) {
+    idfx::cout << "Main: Creating initial conditions." << std::endl;
+    idfx::pushRegion("Setup::Initflow");
+    mysetup.InitFlow(data);
+    idfx::popRegion();
+    data.DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
+    if(data.haveParticles) data.particles->SyncToDevice();
+    data.SetBoundaries();
+    data.Validate();
+    output.CheckForWrites(data);
+  }
+
+  // Start the blocks of this process from the initial conditions
+  data.scheduler->Scatter();
+
+  ///////////////////////////////
+  // Main Loop
+  ///////////////////////////////
+  idfx::cout << "Main: Cycling Time Integrator..." << std::endl;
+
+  Kokkos::Timer timer;
+  output.ResetTimer();
+
+  real tstop = input.Get<real>("TimeIntegrator","tstop",0);
+
+  while(data.t < tstop) {
+    if(tstop-data.t < data.dt) data.dt = tstop-data.t;
+    try {
+      Tint.Cycle(data);
+    } catch(std::exception &e) {
+      idfx::cout << "Main: WARNING! Caught an exception in TimeIntegrator." << std::endl;
+      #ifdef WITH_MPI
+        if(!Mpi::CheckSync(5)) {
+          std::stringstream message;
+          message << "A non-synchronous exception was raised in TimeIntegrator:" << std::endl;
+          message << e.what();
+          message << std::endl << "No emergency output can be produced." << std::endl;
+          IDEFIX_ERROR(message);
+        }
+      #endif
+      idfx::cout << e.what() << std::endl;
+      idfx::cout << "Main: attempting to save the current state for inspection." << std::endl;
+      output.ForceWriteVtk(data);
+      idfx::cout << "Main: Aborting current calculation." << std::endl;
+      returnCode = 1;
+      break;
+    }
+    output.CheckForWrites(data);
+    if(input.CheckForAbort() || Tint.CheckForMaxRuntime() ) {
+      idfx::cout << "Main: Saving current state and aborting calculation." << std::endl;
+      output.ForceWriteDump(data);
+      returnCode = -1;
+      break;
+    }
+    if(input.maxCycles>=0) {
+      if(Tint.GetNCycles() >= input.maxCycles) {
+        idfx::cout << "Main: Reached maximum number of integration cycles." << std::endl;
+        break;
+      }
+    }
+  }
+
+  int n_days{0}, n_hours{0}, n_minutes{0}, n_seconds{0};
+  div_t divres;
+  divres = div(timer.seconds(), 86400);
+  n_days = divres.quot;
+  divres = div(divres.rem, 3600);
+  n_hours = divres.quot;
+  divres = div(divres.rem, 60);
+  n_minutes = divres.quot;
+  n_seconds = divres.rem;
+
+  double perfs = timer.seconds() / grid.np_int[IDIR] / grid.np_int[JDIR]
+                          / grid.np_int[KDIR] / Tint.GetNCycles() * idfx::psize;
+
+  idfx::cout << "Main: Reached t=" << data.t << std::endl;
+  idfx::cout << "Main: Completed in ";
+  if (n_days > 0) {
+    idfx::cout << n_days << " day";
+    if (n_days != 1) {
+      idfx::cout << "s";
+    }
+    idfx::cout << " ";
+  }
+  if (n_hours > 0) {
+    idfx::cout << n_hours << " hour";
+    if (n_hours != 1) {
+      idfx::cout << "s";
+    }
+    idfx::cout << " ";
+  }
+  if (n_minutes > 0) {
+    idfx::cout << n_minutes << " minute";
+    if (n_minutes != 1) {
+      idfx::cout << "s";
+    }
+    idfx::cout << " ";
+  }
+  idfx::cout << n_seconds << " second";
+  if (n_seconds != 1) {
+    idfx::cout << "s";
+  }
+  idfx::cout << " ";
+  idfx::cout << "and " << Tint.GetNCycles() << " cycle";
+  if (Tint.GetNCycles() != 1) {
+    idfx::cout << "s";
+  }
+  idfx::cout << std::endl;
+  idfx::cout << "Main: ";
+  idfx::cout << "Perfs are " << std::scientific << 1/perfs << std::defaultfloat
+             << " cell updates/second" << std::endl;
+  #ifdef WITH_MPI
+    idfx::cout << "MPI overhead represents "
+               << static_cast<int>(100.0*idfx::mpiCallsTimer/timer.seconds())
+               << "% of total run time." << std::endl;
+  #endif
+
+  idfx::cout << "Outputs represent "
+             << static_cast<int>(100.0*output.GetTimer()/timer.seconds())
+            << "% of total run time." << std::endl;
+  return(returnCode);
+}
+
 int main( int argc, char* argv[] ) {
   bool initKokkosBeforeMPI = false;
 
@@ -77,176 +267,31 @@ int main( int argc, char* argv[] ) {
 
     Input input(argc, argv);
     input.PrintLogo();
-    idfx::cout << "Main: initialization stage." << std::endl;
-
-    // Allocate the grid on device
-    Grid grid(input);
-    // Allocate the grid image on host
-    GridHost gridHost(grid);
-
-    // Actually make the grid on host and sync it on the device
-    gridHost.MakeGrid(input);
-    gridHost.SyncToDevice();
-
-    // instantiate required objects.
-    DataBlock data(grid, input);
-    TimeIntegrator Tint(input,data);
-    Output output(input, data);
-    Setup mysetup(input, grid, data, output);
-    idfx::cout << "Main: initialisation finished." << std::endl;
-
-    char host[1024];
-    gethostname(host,1024);
-
-    idfx::cout << "Main: running on " << std::string(host) << std::endl;
-
-    ///////////////////////////////
-    // Show configuration
-    ///////////////////////////////
     if(initKokkosBeforeMPI) {
       idfx::cout << "Main: detected your configuration needed Kokkos to be initialised before MPI. "
                  << std::endl;
     }
-    input.ShowConfig();
-    grid.ShowConfig();
-    data.ShowConfig();
-    Tint.ShowConfig();
-
-    ///////////////////////////////
-    // Initial conditions (or restart)
-    ///////////////////////////////
-    // Are we restarting?
-    if(input.restartRequested) {
-      if(input.forceInitRequested) {
-        idfx::pushRegion("Setup::Initflow");
-        mysetup.InitFlow(data);
-        data.DeriveVectorPotential();
-        idfx::popRegion();
-      }
-      idfx::cout << "Main: Restarting from dump file."  << std::endl;
-      bool restartSuccess = output.RestartFromDump(data,input.restartFileNumber);
-      if(!restartSuccess) {
-        idfx::cout << "Main: restart aborted." << std::endl;
-        input.restartRequested = false;
-      } else {
-        data.SetBoundaries();
-      }
-    }
-    if(!input.restartRequested) {
-      idfx::cout << "Main: Creating initial conditions." << std::endl;
-      idfx::pushRegion("Setup::Initflow");
-      mysetup.InitFlow(data);
-      idfx::popRegion();
-      data.DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
-      data.SetBoundaries();
-      data.Validate();
-      output.CheckForWrites(data);
-    }
 
-    ///////////////////////////////
-    // Main Loop
-    ///////////////////////////////
-    idfx::cout << "Main: Cycling Time Integrator..." << std::endl;
-
-    Kokkos::Timer timer;
-    output.ResetTimer();
-
-    real tstop = input.Get<real>("TimeIntegrator","tstop",0);
-
-    while(data.t < tstop) {
-      if(tstop-data.t < data.dt) data.dt = tstop-data.t;
-      try {
-        Tint.Cycle(data);
-      } catch(std::exception &e) {
-        idfx::cout << "Main: WARNING! Caught an exception in TimeIntegrator." << std::endl;
-        #ifdef WITH_MPI
-          if(!Mpi::CheckSync(5)) {
-            std::stringstream message;
-            message << "A non-synchronous exception was raised in TimeIntegrator:" << std::endl;
-            message << e.what();
-            message << std::endl << "No emergency output can be produced." << std::endl;
-            IDEFIX_ERROR(message);
-          }
-        #endif
-        idfx::cout << e.what() << std::endl;
-        idfx::cout << "Main: attempting to save the current state for inspection." << std::endl;
-        output.ForceWriteVtk(data);
-        idfx::cout << "Main: Aborting current calculation." << std::endl;
-        returnCode = 1;
-        break;
-      }
-      output.CheckForWrites(data);
-      if(input.CheckForAbort() || Tint.CheckForMaxRuntime() ) {
-        idfx::cout << "Main: Saving current state and aborting calculation." << std::endl;
-        output.ForceWriteDump(data);
-        returnCode = -1;
-        break;
-      }
-      if(input.maxCycles>=0) {
-        if(Tint.GetNCycles() >= input.maxCycles) {
-          idfx::cout << "Main: Reached maximum number of integration cycles." << std::endl;
+    Ensemble ensemble(input);
+    if(ensemble.nmembers == 0) {
+      returnCode = Run(input);
+    } else {
+      ensemble.ShowConfig();
+      for(int m = 0 ; m < ensemble.nmembers ; m++) {
+        Input memberInput = ensemble.GetInput(m);
+        ensemble.Enter(m);
+        int memberCode = Run(memberInput);
+        ensemble.Leave(m, memberCode);
+        // A failed member does not prevent the next ones from running, an interruption does
+        if(memberCode < 0) {
+          returnCode = memberCode;
           break;
         }
+        if(memberCode > 0) returnCode = memberCode;
       }
+      ensemble.ShowSummary();
     }
 
-    int n_days{0}, n_hours{0}, n_minutes{0}, n_seconds{0};
-    div_t divres;
-    divres = div(timer.seconds(), 86400);
-    n_days = divres.quot;
-    divres = div(divres.rem, 3600);
-    n_hours = divres.quot;
-    divres = div(divres.rem, 60);
-    n_minutes = divres.quot;
-    n_seconds = divres.rem;
-
-    double perfs = timer.seconds() / grid.np_int[IDIR] / grid.np_int[JDIR]
-                            / grid.np_int[KDIR] / Tint.GetNCycles() * idfx::psize;
-
-    idfx::cout << "Main: Reached t=" << data.t << std::endl;
-    idfx::cout << "Main: Completed in ";
-    if (n_days > 0) {
-      idfx::cout << n_days << " day";
-      if (n_days != 1) {
-        idfx::cout << "s";
-      }
-      idfx::cout << " ";
-    }
-    if (n_hours > 0) {
-      idfx::cout << n_hours << " hour";
-      if (n_hours != 1) {
-        idfx::cout << "s";
-      }
-      idfx::cout << " ";
-    }
-    if (n_minutes > 0) {
-      idfx::cout << n_minutes << " minute";
-      if (n_minutes != 1) {
-        idfx::cout << "s";
-      }
-      idfx::cout << " ";
-    }
-    idfx::cout << n_seconds << " second";
-    if (n_seconds != 1) {
-      idfx::cout << "s";
-    }
-    idfx::cout << " ";
-    idfx::cout << "and " << Tint.GetNCycles() << " cycle";
-    if (Tint.GetNCycles() != 1) {
-      idfx::cout << "s";
-    }
-    idfx::cout << std::endl;
-    idfx::cout << "Main: ";
-    idfx::cout << "Perfs are " << std::scientific << 1/perfs << " cell updates/second" << std::endl;
-    #ifdef WITH_MPI
-      idfx::cout << "MPI overhead represents "
-                 << static_cast<int>(100.0*idfx::mpiCallsTimer/timer.seconds())
-                 << "% of total run time." << std::endl;
-    #endif
-
-    idfx::cout << "Outputs represent "
-               << static_cast<int>(100.0*output.GetTimer()/timer.seconds())
-              << "% of total run time." << std::endl;
     // Show profiler output
     idfx::prof.Show();
   }
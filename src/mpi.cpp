@@ -324,7 +324,8 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   // Wait for completion before sending out everything
-  Kokkos::fence();
+  // (only the instance of the current block is fenced, the other blocks keep on running)
+  idfx::GetExecutionSpace().fence();
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
@@ -441,6 +442,7 @@ myTimer -= MPI_Wtime();
 #endif
   myTimer += MPI_Wtime();
   bytesSentOrReceived += 4*bufferSizeX1*sizeof(real);
+  idfx::mpiCallsBytes += 2*bufferSizeX1*sizeof(real);
 
   idfx::popRegion();
 }
@@ -522,7 +524,7 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   // Send to the right
-  Kokkos::fence();
+  idfx::GetExecutionSpace().fence();
 
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
@@ -638,6 +640,7 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   bytesSentOrReceived += 4*bufferSizeX2*sizeof(real);
+  idfx::mpiCallsBytes += 2*bufferSizeX2*sizeof(real);
 
   idfx::popRegion();
 }
@@ -722,7 +725,7 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   // Send to the right
-  Kokkos::fence();
+  idfx::GetExecutionSpace().fence();
 
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
@@ -841,6 +844,7 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   bytesSentOrReceived += 4*bufferSizeX3*sizeof(real);
+  idfx::mpiCallsBytes += 2*bufferSizeX3*sizeof(real);
 
   idfx::popRegion();
 }
@@ -931,6 +935,10 @@ void Mpi::SigErrorHandler(int nSignum, siginfo_t* si, void* vcontext) {
   IDEFIX_ERROR(errmsg);
 }
 
+void Mpi::ResetInstances() {
+  nInstances = 0;
+}
+
 // This routine check that all of the processes are synced.
 // Returns true if this is the case, false otherwise
 
@@ -206,6 +206,9 @@ class Mpi {
   // Check that MPI processes are synced
   static bool CheckSync(real);
 
+  // Number the next instances from 1 again (once all of the instances have been destroyed)
+  static void ResetInstances();
+
 
   // Destructor
   ~Mpi();
@@ -19,6 +19,8 @@
 #include <iomanip>
 #include <string>
 #include <cstdio>
+#include <cstring>
+#include <climits>
 #include "dump.hpp"
 #include "version.hpp"
 #include "dataBlockHost.hpp"
@@ -31,6 +33,13 @@
 #define  FILENAMESIZE   256
 #define  HEADERSIZE 128
 
+// The field index is written after the eof field, and is followed by a trailer
+// (index offset, number of entries, magic string) at the very end of the file
+#define  INDEXMAGIC   "IdfxIdx"
+#define  INDEXMAGICSIZE 8
+#define  INDEXENTRYSIZE (NAMESIZE + 5*sizeof(int) + sizeof(int64_t))
+#define  INDEXTRAILERSIZE (sizeof(int64_t) + sizeof(int) + INDEXMAGICSIZE)
+
 // Register a variable to be dumped (and read)
 
 void Dump::RegisterVariable(IdefixArray3D<real>& in,
@@ -63,6 +72,22 @@ void  Dump::RegisterVariable(IdefixHostArray4D<real>& in,
     dumpFieldMap.emplace(name, DumpField(in, varnum, loc, dir));
 }
 
+// Lists distributed among the processes. Their name is limited to NAMESIZE-4 characters,
+// since the number of elements of each process is stored in a field called name#n
+void Dump::RegisterVariable(std::vector<real> *in, std::string name) {
+  if(name.size() > NAMESIZE-4) {
+    IDEFIX_ERROR("Dump I/O: the name of list "+name+" is too long");
+  }
+  dumpFieldMap.emplace(name, DumpField(in));
+}
+
+void Dump::RegisterVariable(std::vector<int> *in, std::string name) {
+  if(name.size() > NAMESIZE-4) {
+    IDEFIX_ERROR("Dump I/O: the name of list "+name+" is too long");
+  }
+  dumpFieldMap.emplace(name, DumpField(in));
+}
+
 
 
 void Dump::CreateMPIDataType(GridBox gb, bool read) {
@@ -225,6 +250,30 @@ Dump::Dump(Input &input, DataBlock *datain) {
   } else {
     outputDirectory = "./";
   }
+
+  // Delta dumps
+  fullPeriod = input.GetOrSet<int>("Output","dmp_full",0, 1);
+  if(fullPeriod < 1) {
+    IDEFIX_ERROR("[Output]:dmp_full should be a positive integer");
+  }
+  std::string compression = input.GetOrSet<std::string>("Output","dmp_full",1, "exact");
+  if(compression.compare("single")==0) {
+    #ifdef SINGLE_PRECISION
+      IDEFIX_WARNING("Single precision delta dumps are useless in single precision. Ignoring.");
+    #else
+      singleDeltas = true;
+    #endif
+  } else if(compression.compare("exact")!=0) {
+    IDEFIX_ERROR("[Output]:dmp_full compression should be either exact or single");
+  }
+
+  // Node-local copies
+  if(input.CheckEntry("Output","dmp_local")>=0) {
+    if(singleDeltas) {
+      IDEFIX_ERROR("[Output]:dmp_local cannot be used with single precision delta dumps");
+    }
+    local = std::make_unique<LocalCheckpoint>(input.Get<std::string>("Output","dmp_local",0));
+  }
   Init(datain);
 }
 
@@ -241,6 +290,12 @@ Dump::~Dump() {
 }
 
 void Dump::WriteString(IdfxFileHandler fileHdl, char *str, int size) {
+  if(writingLocal) {
+    // Serial data is written in the dump file by the root process
+    local->Add(localOffset, str, size, idfx::prank == 0 ? size : 0);
+    localOffset += size;
+    return;
+  }
   #ifdef WITH_MPI
     MPI_Status status;
     MPI_SAFE_CALL(MPI_File_set_view(fileHdl, this->offset,
@@ -271,6 +326,18 @@ void Dump::WriteSerial(IdfxFileHandler fileHdl, int ndim, int *dim,
 
   WriteString(fileHdl, name, NAMESIZE);
 
+  if(writingLocal) {
+    WriteString(fileHdl, reinterpret_cast<char*>(&type), sizeof(int));
+    WriteString(fileHdl, reinterpret_cast<char*>(&ndim), sizeof(int));
+    WriteString(fileHdl, reinterpret_cast<char*>(dim), ndim*sizeof(int));
+    for(int n = 0 ; n < ndim ; n++) {
+      ntot = ntot * dim[n];
+    }
+    AddIndexEntry(fileHdl, name, ndim, dim, type);
+    WriteString(fileHdl, reinterpret_cast<char*>(data), ntot*size);
+    return;
+  }
+
   #ifdef WITH_MPI
     MPI_Status status;
     MPI_Datatype MpiType;
@@ -300,6 +367,7 @@ void Dump::WriteSerial(IdfxFileHandler fileHdl, int ndim, int *dim,
       offset=offset+sizeof(int);
       ntot = ntot * dim[n];
     }
+    AddIndexEntry(fileHdl, name, ndim, dim, type);
 
     // Write raw data
     if(type == DoubleType) MpiType=MPI_DOUBLE;
@@ -329,6 +397,7 @@ void Dump::WriteSerial(IdfxFileHandler fileHdl, int ndim, int *dim,
       }
       ntot = ntot * dim[n];
     }
+    AddIndexEntry(fileHdl, name, ndim, dim, type);
     // Write raw data
     if(fwrite(data, size, ntot, fileHdl) != ntot) {
       IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
@@ -337,16 +406,10 @@ void Dump::WriteSerial(IdfxFileHandler fileHdl, int ndim, int *dim,
 }
 
 void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gdim,
-                                  char* name, IdfxDataDescriptor &descriptor, real* data ) {
+                                  char* name, IdfxDataDescriptor &descriptor, void* data,
+                                  DataType type) {
     int64_t ntot = 1;   // Number of elements to be written
-
-  // Define current datatype
-  DataType type;
-  #ifndef SINGLE_PRECISION
-  type = DoubleType;
-  #else
-  type = SingleType;
-  #endif
+  const int size = (type == DoubleType ? sizeof(double) : sizeof(float));
 
   // Write field name
   WriteString(fileHdl, name, NAMESIZE);
@@ -382,6 +445,7 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
       ntot = ntot * dim[n];
       nglob = nglob * gdim[n];
     }
+    AddIndexEntry(fileHdl, name, ndim, gdim, type);
 
     // Write raw data
     if(type == DoubleType) MpiType=MPI_DOUBLE;
@@ -391,7 +455,7 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
                                     descriptor, "native", MPI_INFO_NULL ));
     MPI_SAFE_CALL(MPI_File_write_all(fileHdl, data, ntot, MpiType, MPI_STATUS_IGNORE));
 
-    offset=offset+nglob*sizeof(real);
+    offset=offset+nglob*size;
 
   #else
     // Write type of data
@@ -411,9 +475,10 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
       }
       ntot = ntot * dim[n];
     }
+    AddIndexEntry(fileHdl, name, ndim, dim, type);
 
     // Write raw data
-    if(fwrite(data, sizeof(real), ntot, fileHdl) != ntot) {
+    if(fwrite(data, size, ntot, fileHdl) != ntot) {
       IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
     }
   #endif
@@ -502,6 +567,12 @@ void Dump::ReadSerial(IdfxFileHandler fileHdl, int ndim, int *dim,
   if(type == IntegerType) size=sizeof(int);
   if(type == BoolType) size=sizeof(bool);
 
+  if(readingLocal) {
+    local->Fetch(localOffset, data, ntot*size);
+    localOffset += ntot*size;
+    return;
+  }
+
   #ifdef WITH_MPI
     MPI_Status status;
     MPI_Datatype MpiType;
@@ -550,34 +621,208 @@ void Dump::Skip(IdfxFileHandler fileHdl, int ndim, int *dim,
   #endif
 }
 
+// Current position in the file
+int64_t Dump::Tell(IdfxFileHandler fileHdl) {
+  if(writingLocal) return(localOffset);
+  #ifdef WITH_MPI
+    return(offset);
+  #else
+    return(ftell(fileHdl));
+  #endif
+}
+
+// Record the field about to be written in the index
+void Dump::AddIndexEntry(IdfxFileHandler fileHdl, char *name, int ndim, int *dim, DataType type) {
+  if(ndim > 3) IDEFIX_ERROR("Dump fields cannot have more than 3 dimensions");
+  DumpIndexEntry entry;
+  entry.type = type;
+  entry.ndim = ndim;
+  entry.dim = {1, 1, 1};
+  for(int n = 0 ; n < ndim ; n++) {
+    entry.dim[n] = dim[n];
+  }
+  entry.offset = Tell(fileHdl);
+  indexToWrite.emplace_back(std::string(name), entry);
+}
+
+void Dump::WriteIndex(IdfxFileHandler fileHdl) {
+  const int64_t indexOffset = Tell(fileHdl);
+  const int nfields = indexToWrite.size();
+
+  // Pack the index and the trailer in a single buffer
+  std::vector<char> buffer(nfields*INDEXENTRYSIZE + INDEXTRAILERSIZE, 0);
+  char *ptr = buffer.data();
+  for(auto const &[name, entry] : indexToWrite) {
+    std::snprintf(ptr, NAMESIZE, "%s", name.c_str());
+    ptr += NAMESIZE;
+    const int desc[5] = {entry.type, entry.ndim, entry.dim[0], entry.dim[1], entry.dim[2]};
+    std::memcpy(ptr, desc, sizeof(desc));
+    ptr += sizeof(desc);
+    std::memcpy(ptr, &entry.offset, sizeof(int64_t));
+    ptr += sizeof(int64_t);
+  }
+  std::memcpy(ptr, &indexOffset, sizeof(int64_t));
+  ptr += sizeof(int64_t);
+  std::memcpy(ptr, &nfields, sizeof(int));
+  ptr += sizeof(int);
+  std::memcpy(ptr, INDEXMAGIC, INDEXMAGICSIZE);
+
+  WriteString(fileHdl, buffer.data(), buffer.size());
+  indexToWrite.clear();
+}
+
+// Read size bytes at a given position of the file (and broadcast them with MPI)
+void Dump::ReadBytes(IdfxFileHandler fileHdl, int64_t position, char *buffer, int size) {
+  if(readingLocal) {
+    local->Fetch(position, buffer, size);
+    return;
+  }
+  #ifdef WITH_MPI
+    MPI_Status status;
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, position, MPI_BYTE,
+                                    MPI_CHAR, "native", MPI_INFO_NULL ));
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_read(fileHdl, buffer, size, MPI_CHAR, &status));
+    }
+    MPI_SAFE_CALL(MPI_Bcast(buffer, size, MPI_CHAR, 0, MPI_COMM_WORLD));
+  #else
+    fseek(fileHdl, position, SEEK_SET);
+    if(fread(buffer, sizeof(char), size, fileHdl) < size) {
+      IDEFIX_ERROR("Error: unexpected end of dump file");
+    }
+  #endif
+}
+
+// Load the field index of the file, if any. Returns false for dumps written
+// by older versions, which can only be read sequentially.
+bool Dump::ReadIndex(IdfxFileHandler fileHdl) {
+  fileIndex.clear();
+  indexed = false;
+
+  int64_t fileSize;
+  if(readingLocal) {
+    fileSize = local->GetSize();
+  } else {
+    #ifdef WITH_MPI
+      MPI_Offset size;
+      MPI_SAFE_CALL(MPI_File_get_size(fileHdl, &size));
+      fileSize = size;
+    #else
+      fseek(fileHdl, 0, SEEK_END);
+      fileSize = ftell(fileHdl);
+    #endif
+  }
+  if(fileSize < static_cast<int64_t>(HEADERSIZE + INDEXTRAILERSIZE)) return(false);
+
+  char trailer[INDEXTRAILERSIZE];
+  ReadBytes(fileHdl, fileSize - INDEXTRAILERSIZE, trailer, INDEXTRAILERSIZE);
+  if(std::memcmp(trailer + INDEXTRAILERSIZE - INDEXMAGICSIZE, INDEXMAGIC, INDEXMAGICSIZE) != 0) {
+    return(false);
+  }
+  int64_t indexOffset;
+  int nfields;
+  std::memcpy(&indexOffset, trailer, sizeof(int64_t));
+  std::memcpy(&nfields, trailer + sizeof(int64_t), sizeof(int));
+
+  std::vector<char> buffer(nfields*INDEXENTRYSIZE);
+  ReadBytes(fileHdl, indexOffset, buffer.data(), buffer.size());
+
+  const char *ptr = buffer.data();
+  char fieldName[NAMESIZE+1];
+  for(int n = 0 ; n < nfields ; n++) {
+    std::memcpy(fieldName, ptr, NAMESIZE);
+    fieldName[NAMESIZE] = 0;
+    ptr += NAMESIZE;
+    int desc[5];
+    std::memcpy(desc, ptr, sizeof(desc));
+    ptr += sizeof(desc);
+    DumpIndexEntry entry;
+    entry.type = static_cast<DataType>(desc[0]);
+    entry.ndim = desc[1];
+    entry.dim = {desc[2], desc[3], desc[4]};
+    std::memcpy(&entry.offset, ptr, sizeof(int64_t));
+    ptr += sizeof(int64_t);
+    fileIndex.emplace(std::string(fieldName), entry);
+  }
+  indexed = true;
+  return(true);
+}
+
+// Position the file on the raw data of a given field, and get its properties.
+// With an index, this is a direct seek. Otherwise, the field must be the next one in the file.
+void Dump::LocateField(IdfxFileHandler fileHdl, const std::string &name,
+                       int &ndim, int *dim, DataType &type) {
+  if(!indexed) {
+    std::string fieldName;
+    ReadNextFieldProperties(fileHdl, ndim, dim, type, fieldName);
+    if(fieldName.compare(name) != 0) {
+      IDEFIX_ERROR("Expecting field "+name+" in dump file, got "+fieldName);
+    }
+    return;
+  }
+  auto it = fileIndex.find(name);
+  if(it == fileIndex.end()) {
+    IDEFIX_ERROR("Cannot find field "+name+" in dump file");
+  }
+  const DumpIndexEntry &entry = it->second;
+  ndim = entry.ndim;
+  for(int n = 0 ; n < ndim ; n++) {
+    dim[n] = entry.dim[n];
+  }
+  type = entry.type;
+  if(readingLocal) {
+    localOffset = entry.offset;
+    return;
+  }
+  #ifdef WITH_MPI
+    offset = entry.offset;
+  #else
+    fseek(fileHdl, entry.offset, SEEK_SET);
+  #endif
+}
+
 void Dump::ReadDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gdim,
-                                 IdfxDataDescriptor &descriptor, void* data) {
+                                 IdfxDataDescriptor &descriptor, void* data, DataType type) {
   int64_t ntot=1;
   int64_t nglob=1;
+  const int size = (type == DoubleType ? sizeof(double) : sizeof(float));
   // Get total size
   for(int i=0; i < ndim; i++) {
     ntot=ntot*dim[i];
     nglob=nglob*gdim[i];
   }
 
-  #ifdef WITH_MPI
-    MPI_Datatype MpiType;
+  if(readingLocal) {
+    // Fetch the lines of the local sub-domain
+    int start[3];
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      start[dir] = this->data->gbeg[dir]-this->data->nghost[dir];
+    }
+    char *ptr = reinterpret_cast<char*>(data);
+    for(int k = 0; k < dim[KDIR]; k++) {
+      for(int j = 0 ; j < dim[JDIR]; j++) {
+        const int64_t line = (static_cast<int64_t>(k+start[KDIR])*gdim[JDIR] + j+start[JDIR])
+                             *gdim[IDIR] + start[IDIR];
+        local->Fetch(localOffset + line*size, ptr, dim[IDIR]*size);
+        ptr += dim[IDIR]*size;
+      }
+    }
+    localOffset += nglob*size;
+    return;
+  }
 
-    #ifndef SINGLE_PRECISION
-    MpiType = MPI_DOUBLE;
-    #else
-    MpiType = MPI_FLOAT;
-    #endif
+  #ifdef WITH_MPI
+    MPI_Datatype MpiType = (type == DoubleType ? MPI_DOUBLE : MPI_FLOAT);
 
     MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MpiType,
                                     descriptor, "native", MPI_INFO_NULL ));
     MPI_SAFE_CALL(MPI_File_read_all(fileHdl, data, ntot, MpiType, MPI_STATUS_IGNORE));
 
-    offset=offset+nglob*sizeof(real);
+    offset=offset+nglob*size;
   #else
     size_t numRead;
     // Read raw data
-    numRead = fread(data,sizeof(real),ntot,fileHdl);
+    numRead = fread(data,size,ntot,fileHdl);
     if(numRead<ntot) {
       IDEFIX_ERROR("Error: unexpected end of dump file");
     }
@@ -625,20 +870,316 @@ int Dump::GetLastDumpInDirectory(fs::path &directory) {
   }
   return(num);
 }
-bool Dump::Read(Output& output, int readNumber ) {
-  fs::path filename;
-  int nx[3];
-  int nxglob[3];
-  std::string fieldName;
-  std::string eof ("eof");
-  DataType type;
+// Fields written by the dump itself, which are not registered
+static bool IsInternalField(const std::string &name) {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const std::string suffix = std::to_string(dir+1);
+    if(name == "x"+suffix || name == "xl"+suffix || name == "xr"+suffix) return(true);
+  }
+  // Number of elements of the distributed lists held by each process
+  if(name.size() > 2 && name.compare(name.size()-2, 2, "#n") == 0) return(true);
+  return(name == "eof" || name == "deltaBase" || name == "deltaMode");
+}
+
+static fs::path GetDumpFilename(const fs::path &directory, int number) {
+  std::stringstream ssdumpFileNum,ssFileName;
+  ssdumpFileNum << std::setfill('0') << std::setw(4) << number;
+  ssFileName << "dump." << ssdumpFileNum.str() << ".dmp";
+  return(directory/ssFileName.str());
+}
+
+// Update the checksum of the local part of an array, and tell whether it has changed
+// since the previous dump on any process
+bool Dump::UpdateChecksum(const std::string &name, real *array, int64_t size) {
+  // FNV-1a hash of the array elements
+  uint64_t hash = 14695981039346656037ULL;
+  for(int64_t i = 0 ; i < size ; i++) {
+    uint64_t word = 0;
+    std::memcpy(&word, array+i, sizeof(real));
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  auto it = checksums.find(name);
+  int changed = (it == checksums.end() || it->second != hash);
+  checksums[name] = hash;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD));
+  #endif
+  return(changed);
+}
+
+// Datatype of the local part of a distributed single precision array (delta dumps)
+void Dump::CreateSingleDescriptor(int *nx, int *nxglob, IdfxDataDescriptor &descriptor) {
+  #ifdef WITH_MPI
+    int start[3];
+    int size[3];
+    int subsize[3];
+    for(int dir = 0; dir < 3 ; dir++) {
+      size[2-dir] = nxglob[dir];
+      start[2-dir] = data->gbeg[dir]-data->nghost[dir];
+      subsize[2-dir] = nx[dir];
+    }
+    MPI_SAFE_CALL(MPI_Type_create_subarray(3, size, subsize, start,
+                                          MPI_ORDER_C, MPI_FLOAT, &descriptor));
+    MPI_SAFE_CALL(MPI_Type_commit(&descriptor));
+  #endif
+}
+
+// Add a distributed array to the local copy of the dump. Only the nx first points of
+// each direction are written in the dump file, but the local copy holds nxRead points.
+void Dump::WriteLocalDistributed(IdfxFileHandler fileHdl, char *name,
+                                 IdefixHostArray3D<real> array, int *nx, int *nxRead,
+                                 int *nxglob) {
+  DataType type = realDataType;
+  int ndim = 3;
+  WriteString(fileHdl, name, NAMESIZE);
+  WriteString(fileHdl, reinterpret_cast<char*>(&type), sizeof(int));
+  WriteString(fileHdl, reinterpret_cast<char*>(&ndim), sizeof(int));
+  WriteString(fileHdl, reinterpret_cast<char*>(nxglob), 3*sizeof(int));
+  AddIndexEntry(fileHdl, name, ndim, nxglob, type);
+
+  int start[3];
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    start[dir] = data->gbeg[dir]-data->nghost[dir];
+  }
+  std::vector<real> line(nxRead[IDIR]);
+  for(int k = 0; k < nxRead[KDIR]; k++) {
+    for(int j = 0 ; j < nxRead[JDIR]; j++) {
+      for(int i = 0; i < nxRead[IDIR]; i++) {
+        line[i] = array(k+data->beg[KDIR], j+data->beg[JDIR], i+data->beg[IDIR]);
+      }
+      const int64_t position = (static_cast<int64_t>(k+start[KDIR])*nxglob[JDIR] + j+start[JDIR])
+                               *nxglob[IDIR] + start[IDIR];
+      const int64_t drainSize = (k < nx[KDIR] && j < nx[JDIR]) ? nx[IDIR]*sizeof(real) : 0;
+      local->Add(localOffset + position*sizeof(real), line.data(),
+                 nxRead[IDIR]*sizeof(real), drainSize);
+    }
+  }
+  localOffset += static_cast<int64_t>(nxglob[IDIR])*nxglob[JDIR]*nxglob[KDIR]*sizeof(real);
+}
+
+// Write a list distributed among the processes: the segments of the processes are stored one
+// after the other, and the number of elements of each process in a companion field.
+void Dump::WriteList(IdfxFileHandler fileHdl, char *name, const DumpField &list) {
+  DataType type = (list.GetType() == DumpField::Type::RealList ? realDataType : IntegerType);
+  const int size = (type == IntegerType ? sizeof(int) : sizeof(real));
+  int count = list.GetListSize();
+
+  std::vector<int> counts(idfx::psize);
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD));
+  #else
+    counts[0] = count;
+  #endif
+  int64_t start = 0;
+  int64_t ntot = 0;
+  for(int p = 0 ; p < idfx::psize ; p++) {
+    if(p < idfx::prank) start += counts[p];
+    ntot += counts[p];
+  }
+  if(ntot > INT_MAX) {
+    IDEFIX_ERROR("Dump I/O: list "+std::string(name)+" is too large");
+  }
+
+  char countName[NAMESIZE+1];
+  std::snprintf(countName, NAMESIZE, "%s#n", name);
+  int nprocs = idfx::psize;
+  WriteSerial(fileHdl, 1, &nprocs, IntegerType, countName, counts.data());
+
+  int ndim = 1;
+  int dim = static_cast<int>(ntot);
+  WriteString(fileHdl, name, NAMESIZE);
+  WriteString(fileHdl, reinterpret_cast<char*>(&type), sizeof(int));
+  WriteString(fileHdl, reinterpret_cast<char*>(&ndim), sizeof(int));
+  WriteString(fileHdl, reinterpret_cast<char*>(&dim), sizeof(int));
+  AddIndexEntry(fileHdl, name, ndim, &dim, type);
+
+  if(writingLocal) {
+    if(count > 0) {
+      local->Add(localOffset + start*size, list.GetListData(), count*size, count*size);
+    }
+    localOffset += ntot*size;
+    return;
+  }
+
+  #ifdef WITH_MPI
+    MPI_Datatype MpiType = (type == IntegerType ? MPI_INT : realMPI);
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+    MPI_SAFE_CALL(MPI_File_write_at_all(fileHdl, start*size, list.GetListData(), count,
+                                        MpiType, MPI_STATUS_IGNORE));
+    offset += ntot*size;
+  #else
+    if(fwrite(list.GetListData(), size, count, fileHdl) != count) {
+      IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
+    }
+  #endif
+}
+
+// Load the segment of a distributed list which belongs to this process. When the number of
+// processes has changed, the list is evenly split between the processes, and the module which
+// registered it is responsible for sending the elements to their owner.
+void Dump::ReadList(IdfxFileHandler fileHdl, const std::string &name, const DumpField &list) {
+  if(!indexed) {
+    IDEFIX_ERROR("Distributed list "+name+" can only be read from dumps with a field index");
+  }
   int ndim;
-  IdfxFileHandler fileHdl;
+  int dim[3];
+  DataType type;
+  LocateField(fileHdl, name+"#n", ndim, dim, type);
+  std::vector<int> counts(dim[0]);
+  ReadSerial(fileHdl, ndim, dim, type, counts.data());
+
+  LocateField(fileHdl, name, ndim, dim, type);
+  const DataType listType = (list.GetType() == DumpField::Type::RealList ? realDataType
+                                                                         : IntegerType);
+  if(type != listType) {
+    IDEFIX_ERROR("Type of list "+name+" does not match");
+  }
+  const int size = (type == IntegerType ? sizeof(int) : sizeof(real));
+  const int64_t ntot = dim[0];
+
+  int64_t start = 0;
+  int64_t count;
+  if(static_cast<int>(counts.size()) == idfx::psize) {
+    for(int p = 0 ; p < idfx::prank ; p++) {
+      start += counts[p];
+    }
+    count = counts[idfx::prank];
+  } else {
+    if(readingLocal) {
+      IDEFIX_ERROR("Cannot read list "+name+" from a local dump with another number of processes");
+    }
+    count = ntot/idfx::psize + (idfx::prank < ntot%idfx::psize ? 1 : 0);
+    start = idfx::prank*(ntot/idfx::psize) + std::min<int64_t>(idfx::prank, ntot%idfx::psize);
+  }
+  list.ResizeList(count);
+
+  if(readingLocal) {
+    if(count > 0) local->Fetch(localOffset + start*size, list.GetListData(), count*size);
+    localOffset += ntot*size;
+    return;
+  }
+
+  #ifdef WITH_MPI
+    MPI_Datatype MpiType = (type == IntegerType ? MPI_INT : realMPI);
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+    MPI_SAFE_CALL(MPI_File_read_at_all(fileHdl, start*size, list.GetListData(), count,
+                                       MpiType, MPI_STATUS_IGNORE));
+    offset += ntot*size;
+  #else
+    fseek(fileHdl, start*size, SEEK_CUR);
+    if(fread(list.GetListData(), size, count, fileHdl) < count) {
+      IDEFIX_ERROR("Error: unexpected end of dump file");
+    }
+  #endif
+}
 
+// Load a registered field, the file being positioned on its raw data
+void Dump::ReadField(IdfxFileHandler fileHdl, const std::string &fieldName, DumpField &scalar,
+                     int ndim, int *nxglob, DataType type) {
+  int nx[3];
+  if(scalar.IsList()) {
+    ReadList(fileHdl, fieldName, scalar);
+  } else if(scalar.GetType() == DumpField::Type::IdefixArray) {
+    // Distributed idefix array
+    int direction = scalar.GetDirection();
+
+    // Load it
+    for(int dir = 0 ; dir < 3; dir++) {
+      nx[dir] = data->np_int[dir];
+    }
+
+    if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
+      nx[direction]++;   // Extra cell in the dir direction for face-centered fields
+    }
+    if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
+      // Extra cell in the dirs perp to field
+      for(int i = 0 ; i < DIMENSIONS ; i++) {
+        if(i!=direction) nx[i] ++;
+      }
+    }
+    auto toRead = scalar.GetHostField<IdefixHostArray3D<real>>();
+
+    if(readingDifferences && type == SingleType) {
+      // Single precision difference with the state loaded from the previous dumps (the
+      // fields written exactly in the delta dump keep the type of real)
+      std::vector<float> difference(static_cast<int64_t>(nx[IDIR])*nx[JDIR]*nx[KDIR]);
+      IdfxDataDescriptor descriptor;
+      CreateSingleDescriptor(nx, nxglob, descriptor);
+      ReadDistributed(fileHdl, ndim, nx, nxglob, descriptor, difference.data(), SingleType);
+      #ifdef WITH_MPI
+        MPI_SAFE_CALL(MPI_Type_free(&descriptor));
+      #endif
+      for(int k = 0; k < nx[KDIR]; k++) {
+        for(int j = 0 ; j < nx[JDIR]; j++) {
+          for(int i = 0; i < nx[IDIR]; i++) {
+            toRead(k+data->beg[KDIR],j+data->beg[JDIR],i+data->beg[IDIR]) +=
+                                            difference[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]];
+          }
+        }
+      }
+      scalar.SyncFrom(toRead);
+      return;
+    }
+
+    if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
+      ReadDistributed(fileHdl, ndim, nx, nxglob, descCR, scrch);
+    } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
+      ReadDistributed(fileHdl, ndim, nx, nxglob, descSR[direction], scrch);
+    } else if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
+      ReadDistributed(fileHdl, ndim, nx, nxglob, descER[direction], scrch);
+    }
+    // Load the scratch space in designated field
+    for(int k = 0; k < nx[KDIR]; k++) {
+      for(int j = 0 ; j < nx[JDIR]; j++) {
+        for(int i = 0; i < nx[IDIR]; i++) {
+          toRead(k+data->beg[KDIR],j+data->beg[JDIR],i+data->beg[IDIR]) =
+                                                  scrch[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]];
+        }
+      }
+    }
+    scalar.SyncFrom(toRead);
+  } else {
+    // Fundamental Type
+    // Check that size matches
+    if(nxglob[0] != scalar.GetSize()) {
+      idfx::cout << "nxglob=" << nxglob[0] << " scalar=" << scalar.GetSize() << std::endl;
+      IDEFIX_ERROR("Size of field "+fieldName+" do not match");
+    }
+    // Todo: check that type matches
+    void *ptr = scalar.GetHostField<void *>();
+
+    ReadSerial(fileHdl, ndim, nxglob, type, ptr);
+  }
+}
+
+bool Dump::Read(Output& output, int readNumber ) {
   idfx::pushRegion("Dump::Read");
 
   fs::path readDir = this->outputDirectory;
 
+  // Prefer the node-local copies, if every process has its own
+  if(local) {
+    int number = (readNumber < 0 ? local->GetLastNumber() : readNumber);
+    int available = (number >= 0 && local->IsAvailable(number));
+    #ifdef WITH_MPI
+      int numberMax = number;
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &numberMax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD));
+      if(numberMax != number) available = 0;
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &available, 1, MPI_INT, MPI_LAND,
+                                  MPI_COMM_WORLD));
+    #endif
+    if(available) {
+      readNumber = number;
+      readingLocal = true;
+    } else if(number >= 0) {
+      idfx::cout << "Dump: the local copies of dump " << number << " and of the dumps it is "
+                 << "based on are not complete on all the processes, reading the dump files "
+                 << "instead." << std::endl;
+    }
+  }
+
   if(readNumber<0) {
     // We actually don't know which file we're supposed to read, so let's guess
     readNumber = GetLastDumpInDirectory(readDir);
@@ -659,39 +1200,92 @@ bool Dump::Read(Output& output, int readNumber ) {
   // Reset timer
   timer.reset();
 
-  // Set filename
-  std::stringstream ssdumpFileNum,ssFileName;
-  ssdumpFileNum << std::setfill('0') << std::setw(4) << readNumber;
-  ssFileName << "dump." << ssdumpFileNum.str() << ".dmp";
-  filename = readDir/ssFileName.str();
+  fs::path filename = GetDumpFilename(readDir, readNumber);
+  idfx::cout << "Dump: Reading " << (readingLocal ? "the local copy of " : "") << filename
+             << "..." << std::flush;
 
-  idfx::cout << "Dump: Reading " << filename << "..." << std::flush;
-  // open file
+  std::unordered_set<std::string> notFound {};
+  for(auto it = dumpFieldMap.begin(); it != dumpFieldMap.end(); it++) {
+    notFound.insert(it->first);
+  }
+
+  ReadFile(readDir, readNumber, notFound);
+  readingLocal = false;
+
+  if (notFound.size() > 0) {
+    std::stringstream msg {};
+    msg << "The following fields were not found in " << filename << ": ";
+    for(auto it = notFound.begin(); it != notFound.end(); it++) {
+      msg << *it << ' ';
+    }
+    IDEFIX_WARNING(msg);
+  }
+
+  // The next delta dump needs a full dump written by this run to start from
+  chainLength = 0;
+  checksums.clear();
+  references.clear();
+
+  idfx::cout << "done in " << timer.seconds() << " s." << std::endl;
+  idfx::cout << "Restarting from t=" << data->t << "." << std::endl;
+
+  idfx::popRegion();
+
+  return(true);
+}
+
+// Load a dump file. Delta dumps first load the dump they are based on.
+void Dump::ReadFile(const fs::path &readDir, int readNumber,
+                    std::unordered_set<std::string> &notFound) {
+  int nx[3];
+  int nxglob[3];
+  std::string fieldName;
+  std::string eof ("eof");
+  DataType type;
+  int ndim;
+  IdfxFileHandler fileHdl{};
+
+  fs::path filename = GetDumpFilename(readDir, readNumber);
+
+  if(readingLocal) {
+    local->Load(readNumber);
+  } else {
+    // open file
 #ifdef WITH_MPI
-  MPI_SAFE_CALL(MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
-                              MPI_MODE_RDONLY | MPI_MODE_UNIQUE_OPEN,
-                              MPI_INFO_NULL, &fileHdl));
-  this->offset = 0;
+    MPI_SAFE_CALL(MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
+                                MPI_MODE_RDONLY | MPI_MODE_UNIQUE_OPEN,
+                                MPI_INFO_NULL, &fileHdl));
+    this->offset = 0;
 #else
-  fileHdl = fopen(filename.c_str(),"rb");
-  if(fileHdl == NULL) {
-    std::stringstream msg;
-    msg << "Failed to open dump file: " << std::string(filename) << std::endl;
-    IDEFIX_ERROR(msg);
-  }
+    fileHdl = fopen(filename.c_str(),"rb");
+    if(fileHdl == NULL) {
+      std::stringstream msg;
+      msg << "Failed to open dump file: " << std::string(filename) << std::endl;
+      IDEFIX_ERROR(msg);
+    }
 #endif
+  }
   // File is open
 
+  // Dumps written by recent versions end with an index of their fields, which allows
+  // for positioned reads of the registered fields only
+  if(!ReadIndex(fileHdl) && readingLocal) {
+    IDEFIX_ERROR("The local copy of "+filename.string()+" is incomplete");
+  }
+
+  if(!readingLocal) {
     // skip the header
 #ifdef WITH_MPI
-  this->offset += HEADERSIZE;
+    this->offset = HEADERSIZE;
 #else
-  fseek(fileHdl, HEADERSIZE, SEEK_SET);
+    fseek(fileHdl, HEADERSIZE, SEEK_SET);
 #endif
+  }
 
   // First thing is compare the total domain size
   for(int dir=0 ; dir < 3; dir++) {
-    ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
+    const std::string suffix = std::to_string(dir+1);
+    LocateField(fileHdl, "x"+suffix, ndim, nx, type);
     if(ndim>1) IDEFIX_ERROR("Wrong coordinate array dimensions while reading restart dump");
     if(nx[0] != data->mygrid->np_int[dir]) {
       idfx::cout << "dir " << dir << ", restart has " << nx[0] << " points " << std::endl;
@@ -702,110 +1296,77 @@ bool Dump::Read(Output& output, int readNumber ) {
     ReadSerial(fileHdl, ndim, nx, type, scrch);
 
     // skip left and right edges arrays
-    for (int iside=0; iside < 2; iside++) {
-      ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
-      ReadSerial(fileHdl, ndim, nx, type, scrch);
+    if(!indexed) {
+      for (int iside=0; iside < 2; iside++) {
+        LocateField(fileHdl, (iside == 0 ? "xl" : "xr")+suffix, ndim, nx, type);
+        ReadSerial(fileHdl, ndim, nx, type, scrch);
+      }
     }
     // Todo: check that coordinates are identical
   }
 
-  std::unordered_set<std::string> notFound {};
-  for(auto it = dumpFieldMap.begin(); it != dumpFieldMap.end(); it++) {
-    notFound.insert(it->first);
+  // Delta dumps only hold what has changed since the dump they are based on
+  int deltaMode = 0;
+  if(indexed && fileIndex.count("deltaBase") > 0) {
+    int deltaBase;
+    LocateField(fileHdl, "deltaBase", ndim, nx, type);
+    ReadSerial(fileHdl, ndim, nx, type, &deltaBase);
+    LocateField(fileHdl, "deltaMode", ndim, nx, type);
+    ReadSerial(fileHdl, ndim, nx, type, &deltaMode);
+
+    auto deltaIndex = fileIndex;
+    ReadFile(readDir, deltaBase, notFound);
+    fileIndex = deltaIndex;
+    indexed = true;
+    if(readingLocal) local->Load(readNumber);
   }
+  readingDifferences = (deltaMode == 1);
+
+  if(indexed) {
+    // Load the registered fields present in the file, seeking each one through the index
+    // (in the alphabetical order of dumpFieldMap, not the order of the file)
+    for(auto &[name, scalar] : dumpFieldMap) {
+      if(fileIndex.count(name) == 0) continue;
+      notFound.erase(name);
+      LocateField(fileHdl, name, ndim, nxglob, type);
+      ReadField(fileHdl, name, scalar, ndim, nxglob, type);
+    }
+    for(auto const &[name, entry] : fileIndex) {
+      if(dumpFieldMap.count(name) > 0 || IsInternalField(name)) continue;
+      IDEFIX_WARNING("Cannot find a field matching " + name
+                     + " in current running code. Skipping.");
+    }
+  } else {
+    // Coordinates are ok, load the bulk
+    while(true) {
+      ReadNextFieldProperties(fileHdl, ndim, nxglob, type, fieldName);
 
-  // Coordinates are ok, load the bulk
-  while(true) {
-    ReadNextFieldProperties(fileHdl, ndim, nxglob, type, fieldName);
-
-    /*idfx::cout << "Next field is " << fieldName << " with " << ndim << " dimensions and (";
-    for(int i = 0 ; i < ndim ; i++) idfx::cout << nxglob[i] << " ";
-    idfx::cout << ") points." << std::endl;*/
-
-    if(fieldName.compare(eof) == 0) {
-      // We have reached end of dump file
-      break;
-    } else {
-      if(auto it = dumpFieldMap.find(fieldName) ; it != dumpFieldMap.end()) {
-        // This key has been registered
-        notFound.erase(fieldName);
-        DumpField &scalar = it->second;
-        if(scalar.GetType() == DumpField::Type::IdefixArray) {
-          // Distributed idefix array
-          int direction = scalar.GetDirection();
-
-          // Load it
-          for(int dir = 0 ; dir < 3; dir++) {
-            nx[dir] = data->np_int[dir];
-          }
-
-          if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
-            nx[direction]++;   // Extra cell in the dir direction for face-centered fields
-          }
-          if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
-            // Extra cell in the dirs perp to field
-            for(int i = 0 ; i < DIMENSIONS ; i++) {
-              if(i!=direction) nx[i] ++;
-            }
-          }
-          if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
-            ReadDistributed(fileHdl, ndim, nx, nxglob, descCR, scrch);
-          } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
-            ReadDistributed(fileHdl, ndim, nx, nxglob, descSR[direction], scrch);
-          } else if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
-            ReadDistributed(fileHdl, ndim, nx, nxglob, descER[direction], scrch);
-          }
-          auto toRead = scalar.GetHostField<IdefixHostArray3D<real>>();
-          // Load the scratch space in designated field
-          for(int k = 0; k < nx[KDIR]; k++) {
-            for(int j = 0 ; j < nx[JDIR]; j++) {
-              for(int i = 0; i < nx[IDIR]; i++) {
-                toRead(k+data->beg[KDIR],j+data->beg[JDIR],i+data->beg[IDIR]) =
-                                                        scrch[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]];
-              }
-            }
-          }
-          scalar.SyncFrom(toRead);
+      if(fieldName.compare(eof) == 0) {
+        // We have reached end of dump file
+        break;
+      } else {
+        if(auto it = dumpFieldMap.find(fieldName) ; it != dumpFieldMap.end()) {
+          // This key has been registered
+          notFound.erase(fieldName);
+          ReadField(fileHdl, fieldName, it->second, ndim, nxglob, type);
         } else {
-          // Fundamental Type
-          // Check that size matches
-          if(nxglob[0] != scalar.GetSize()) {
-            idfx::cout << "nxglob=" << nxglob[0] << " scalar=" << scalar.GetSize() << std::endl;
-            IDEFIX_ERROR("Size of field "+fieldName+" do not match");
-          }
-          // Todo: check that type matches
-          void *ptr = scalar.GetHostField<void *>();
-
-          ReadSerial(fileHdl, ndim, nxglob, type, ptr);
+          Skip(fileHdl, ndim, nxglob, type);
+          // Key has not been registered, throw a warning
+          IDEFIX_WARNING("Cannot find a field matching " + fieldName
+                         + " in current running code. Skipping.");
         }
-      } else {
-        Skip(fileHdl, ndim, nxglob, type);
-        // Key has not been registered, throw a warning
-        IDEFIX_WARNING("Cannot find a field matching " + fieldName
-                       + " in current running code. Skipping.");
       }
     }
   }
-  if (notFound.size() > 0) {
-    std::stringstream msg {};
-    msg << "The following fields were not found in " << filename << ": ";
-    for(auto it = notFound.begin(); it != notFound.end(); it++) {
-      msg << *it << ' ';
-    }
-    IDEFIX_WARNING(msg);
-  }
-  #ifdef WITH_MPI
-  MPI_SAFE_CALL(MPI_File_close(&fileHdl));
-  #else
-  fclose(fileHdl);
-  #endif
-
-  idfx::cout << "done in " << timer.seconds() << " s." << std::endl;
-  idfx::cout << "Restarting from t=" << data->t << "." << std::endl;
-
-  idfx::popRegion();
+  readingDifferences = false;
 
-  return(true);
+  if(!readingLocal) {
+    #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_File_close(&fileHdl));
+    #else
+    fclose(fileHdl);
+    #endif
+  }
 }
 
 
@@ -820,21 +1381,23 @@ int Dump::Write(Output& output) {
   #else
   const DataType realType = SingleType;
   #endif
-  IdfxFileHandler fileHdl;
+  IdfxFileHandler fileHdl{};
 
   idfx::pushRegion("Dump::Write");
 
-  idfx::cout << "Dump: Write file n " << dumpFileNumber << "..." << std::flush;
+  // Between two full dumps, only write what has changed since the previous dump
+  const bool delta = (chainLength > 0) && (chainLength < fullPeriod);
+
+  idfx::cout << "Dump: Write " << (delta ? "delta " : "") << "file n " << dumpFileNumber
+             << "..." << std::flush;
 
   // Reset timer
   timer.reset();
 
 
   // Set filenames
-  std::stringstream ssdumpFileNum,ssFileName;
-  ssdumpFileNum << std::setfill('0') << std::setw(4) << dumpFileNumber;
-  ssFileName << "dump." << ssdumpFileNum.str() << ".dmp";
-  filename = outputDirectory/ssFileName.str();
+  filename = GetDumpFilename(outputDirectory, dumpFileNumber);
+  const int thisDumpNumber = dumpFileNumber;
 
   dumpFileNumber++;   // For next one
 
@@ -845,24 +1408,34 @@ int Dump::Write(Output& output) {
     }
   }
 
+  if(local) {
+    // Write the local copy, which is drained in the dump file in the background
+    #ifdef WITH_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+    #endif
+    writingLocal = true;
+    localOffset = 0;
+    local->Begin();
+  } else {
   // open file
 #ifdef WITH_MPI
-  MPI_Barrier(MPI_COMM_WORLD);
-  // Open file for creating, return error if file already exists.
-  MPI_SAFE_CALL(MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
-                              MPI_MODE_CREATE | MPI_MODE_RDWR
-                              | MPI_MODE_EXCL | MPI_MODE_UNIQUE_OPEN,
-                              MPI_INFO_NULL, &fileHdl));
-  this->offset = 0;
+    MPI_Barrier(MPI_COMM_WORLD);
+    // Open file for creating, return error if file already exists.
+    MPI_SAFE_CALL(MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
+                                MPI_MODE_CREATE | MPI_MODE_RDWR
+                                | MPI_MODE_EXCL | MPI_MODE_UNIQUE_OPEN,
+                                MPI_INFO_NULL, &fileHdl));
+    this->offset = 0;
 #else
-  fileHdl = fopen(filename.c_str(),"wb");
-  if(fileHdl == NULL) {
-    std::stringstream msg;
-    msg << "Unable to open file " << filename << std::endl;
-    msg << "Check that you have write access and that you don't exceed your quota." << std::endl;
-    IDEFIX_ERROR(msg);
-  }
+    fileHdl = fopen(filename.c_str(),"wb");
+    if(fileHdl == NULL) {
+      std::stringstream msg;
+      msg << "Unable to open file " << filename << std::endl;
+      msg << "Check that you have write access and that you don't exceed your quota." << std::endl;
+      IDEFIX_ERROR(msg);
+    }
 #endif
+  }
   // File is open
   // First thing we need are coordinates: init a host mirror and sync it
   GridHost gridHost(*data->mygrid);
@@ -898,12 +1471,24 @@ int Dump::Write(Output& output) {
                 reinterpret_cast<void*> (gridHost.xr[dir].data()+gridHost.nghost[dir]));
   }
 
+  if(delta) {
+    // Dump on which this one is based
+    nx[0] = 1;
+    std::snprintf(fieldName, NAMESIZE, "deltaBase");
+    WriteSerial(fileHdl, 1, nx, IntegerType, fieldName, &lastDumpNumber);
+    int deltaMode = singleDeltas;
+    std::snprintf(fieldName, NAMESIZE, "deltaMode");
+    WriteSerial(fileHdl, 1, nx, IntegerType, fieldName, &deltaMode);
+  }
+
   // Then write raw data from Vc
 
   for(auto const& [name, scalar] : dumpFieldMap) {
     // Todo: replace these C char by std::string
     std::snprintf(fieldName,NAMESIZE,"%s",name.c_str());
-    if(scalar.GetType() == DumpField::Type::IdefixArray) {
+    if(scalar.IsList()) {
+      WriteList(fileHdl, fieldName, scalar);
+    } else if(scalar.GetType() == DumpField::Type::IdefixArray) {
       auto toWrite = scalar.GetHostField<IdefixHostArray3D<real>>();
       int dir = scalar.GetDirection();
       for(int i = 0; i < 3 ; i++) {
@@ -940,6 +1525,53 @@ int Dump::Write(Output& output) {
         }
       }
 
+      if(fullPeriod > 1) {
+        const int64_t ntot = static_cast<int64_t>(nx[IDIR])*nx[JDIR]*nx[KDIR];
+        const bool changed = UpdateChecksum(name, scrch, ntot);
+        if(delta && !changed) continue;
+        // Rounding the face and edge-centered fields (B, A) independently on each face would
+        // break div(B)=0, so that only the cell-centered fields are written as differences
+        const bool roundField = singleDeltas
+                                && scalar.GetLocation() == DumpField::ArrayLocation::Center;
+        if(roundField && !delta) {
+          references[name].assign(scrch, scrch+ntot);
+        } else if(roundField) {
+          // Write the difference with the state restored from the previous dumps,
+          // which is updated accordingly so that errors do not accumulate
+          std::vector<real> &reference = references[name];
+          std::vector<float> difference(ntot);
+          for(int64_t i = 0 ; i < ntot ; i++) {
+            difference[i] = static_cast<float>(scrch[i] - reference[i]);
+            reference[i] += static_cast<real>(difference[i]);
+          }
+          IdfxDataDescriptor descriptor;
+          CreateSingleDescriptor(nx, nxtot, descriptor);
+          WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, descriptor,
+                           difference.data(), SingleType);
+          #ifdef WITH_MPI
+            MPI_SAFE_CALL(MPI_Type_free(&descriptor));
+          #endif
+          continue;
+        }
+      }
+
+      if(writingLocal) {
+        // The local copy holds the whole local sub-domain, including the faces shared with the
+        // next process, so that it can be read back without the other processes
+        int nxRead[3];
+        for(int i = 0; i < 3 ; i++) {
+          nxRead[i] = data->np_int[i];
+        }
+        if(scalar.GetLocation() == DumpField::ArrayLocation::Face) nxRead[dir]++;
+        if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
+          for(int i = 0 ; i < DIMENSIONS ; i++) {
+            if(i != dir) nxRead[i]++;
+          }
+        }
+        WriteLocalDistributed(fileHdl, fieldName, toWrite, nx, nxRead, nxtot);
+        continue;
+      }
+
       if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
         WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descCW, scrch);
       } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
@@ -970,6 +1602,21 @@ int Dump::Write(Output& output) {
   nx[0] = 1;
   WriteSerial(fileHdl, 1, nx, realType, fieldName, scrch);
 
+  // Append the field index, ignored by readers which stop at eof
+  WriteIndex(fileHdl);
+
+  const int deltaBase = (delta ? lastDumpNumber : -1);
+  lastDumpNumber = thisDumpNumber;
+  chainLength = (delta ? chainLength + 1 : 1);
+
+  if(writingLocal) {
+    writingLocal = false;
+    local->Commit(thisDumpNumber, filename, deltaBase);
+    idfx::cout << "done in " << timer.seconds() << " s (draining in the background)." << std::endl;
+    idfx::popRegion();
+    return(0);
+  }
+
 #ifdef WITH_MPI
   MPI_SAFE_CALL(MPI_File_close(&fileHdl));
 #else
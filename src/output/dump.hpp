@@ -9,7 +9,10 @@
 #define OUTPUT_DUMP_HPP_
 #include <string>
 #include <map>
+#include <memory>
 #include <array>
+#include <vector>
+#include <unordered_set>
 #if __has_include(<filesystem>)
   #include <filesystem> // NOLINT [build/c++17]
   namespace fs = std::filesystem;
@@ -22,9 +25,15 @@
 #include "idefix.hpp"
 #include "input.hpp"
 #include "dataBlock.hpp"
+#include "localCheckpoint.hpp"
 
 
 enum DataType {DoubleType, SingleType, IntegerType, BoolType};
+#ifndef SINGLE_PRECISION
+  constexpr DataType realDataType = DoubleType;
+#else
+  constexpr DataType realDataType = SingleType;
+#endif
 
 // Define data descriptor used for distributed I/O when MPI is enabled
 #ifdef WITH_MPI
@@ -41,7 +50,7 @@ class DataBlock;
 
 class DumpField {
  public:
-  enum Type {Int, Single, Double, Bool, IdefixArray};
+  enum Type {Int, Single, Double, Bool, IdefixArray, RealList, IntList};
   enum ArrayType {Device3D, Device4D, Host3D, Host4D};
   enum ArrayLocation {Center, Face, Edge};
 
@@ -73,6 +82,13 @@ class DumpField {
   explicit DumpField(bool * in, const int size = 1 ):
     rawData{static_cast<void*>(in)}, rawSize{size}, type{Bool} {};
 
+  // Lists distributed among the processes, each of them holding a variable number of elements
+  explicit DumpField(std::vector<real> * in):
+    realList{in}, type{RealList} {};
+
+  explicit DumpField(std::vector<int> * in):
+    intList{in}, type{IntList} {};
+
 
 
 
@@ -148,6 +164,28 @@ class DumpField {
     return(direction);
   }
 
+  bool IsList() const {
+    return(type == RealList || type == IntList);
+  }
+
+  // Local part of a distributed list
+  int64_t GetListSize() const {
+    return(type == RealList ? realList->size() : intList->size());
+  }
+
+  void ResizeList(int64_t size) const {
+    if(type == RealList) {
+      realList->resize(size);
+    } else {
+      intList->resize(size);
+    }
+  }
+
+  void *GetListData() const {
+    if(type == RealList) return(static_cast<void*>(realList->data()));
+    return(static_cast<void*>(intList->data()));
+  }
+
 
 
  private:
@@ -159,6 +197,9 @@ class DumpField {
   void *rawData;
   int rawSize;
 
+  std::vector<real> *realList;
+  std::vector<int> *intList;
+
   int var;
   int direction;
   ArrayLocation arrayLocation;
@@ -166,6 +207,14 @@ class DumpField {
   Type type;
 };
 
+// Entry of the field index appended at the end of dump files
+struct DumpIndexEntry {
+  DataType type;
+  int ndim;
+  std::array<int,3> dim;
+  int64_t offset;           // position of the raw data in the file
+};
+
 struct GridBox {
   std::array<int,3> start;
   std::array<int,3> size;
@@ -207,6 +256,10 @@ class Dump {
                         int dir = -1,
                         DumpField::ArrayLocation loc = DumpField::ArrayLocation::Center );
 
+  // Register lists distributed among the processes
+  void RegisterVariable(std::vector<real>*, std::string);
+  void RegisterVariable(std::vector<int>*, std::string);
+
   // Register any other fundamental type
   template<typename T>
   void RegisterVariable(T*,
@@ -224,6 +277,26 @@ class Dump {
 
   std::map<std::string, DumpField> dumpFieldMap;
 
+  // Field index
+  std::vector<std::pair<std::string, DumpIndexEntry>> indexToWrite; // fields of the current write
+  std::map<std::string, DumpIndexEntry> fileIndex;                  // fields of the file being read
+  bool indexed{false};              // whether the file being read has an index
+
+  // Delta dumps
+  int fullPeriod{1};                // a full dump every fullPeriod dumps, deltas in between
+  bool singleDeltas{false};         // store the changed arrays as single precision differences
+  int chainLength{0};               // # of dumps since the last full one (0: next one is full)
+  int lastDumpNumber{-1};           // previous dump, on which the next delta is based
+  bool readingDifferences{false};   // whether the arrays of the file being read are differences
+  std::map<std::string, uint64_t> checksums;            // of the arrays at the previous dump
+  std::map<std::string, std::vector<real>> references;  // arrays as restored from the dumps
+
+  // Node-local copies of the dumps
+  std::unique_ptr<LocalCheckpoint> local;
+  bool writingLocal{false};
+  bool readingLocal{false};
+  int64_t localOffset{0};           // position in the dump file of the local copy
+
 
   // Timer
   Kokkos::Timer timer;
@@ -242,11 +315,27 @@ class Dump {
 
   void WriteString(IdfxFileHandler, char *, int);
   void WriteSerial(IdfxFileHandler, int, int *, DataType, char*, void*);
-  void WriteDistributed(IdfxFileHandler, int, int*, int*, char*, IdfxDataDescriptor&, real*);
+  void WriteDistributed(IdfxFileHandler, int, int*, int*, char*, IdfxDataDescriptor&, void*,
+                        DataType = realDataType);
   void ReadNextFieldProperties(IdfxFileHandler, int&, int*, DataType&, std::string&);
   void ReadSerial(IdfxFileHandler, int, int*, DataType, void*);
-  void ReadDistributed(IdfxFileHandler, int, int*, int*, IdfxDataDescriptor&, void*);
+  void ReadDistributed(IdfxFileHandler, int, int*, int*, IdfxDataDescriptor&, void*,
+                       DataType = realDataType);
   void Skip(IdfxFileHandler, int, int *, DataType);
+  void ReadField(IdfxFileHandler, const std::string &, DumpField &, int, int *, DataType);
+  int64_t Tell(IdfxFileHandler);
+  void AddIndexEntry(IdfxFileHandler, char *, int, int *, DataType);
+  void WriteIndex(IdfxFileHandler);
+  void ReadBytes(IdfxFileHandler, int64_t, char *, int);
+  bool ReadIndex(IdfxFileHandler);
+  void LocateField(IdfxFileHandler, const std::string &, int &, int *, DataType &);
+  void ReadFile(const fs::path &, int, std::unordered_set<std::string> &);
+  bool UpdateChecksum(const std::string &, real *, int64_t);
+  void CreateSingleDescriptor(int *, int *, IdfxDataDescriptor &);
+  void WriteLocalDistributed(IdfxFileHandler, char *, IdefixHostArray3D<real>,
+                             int *, int *, int *);
+  void WriteList(IdfxFileHandler, char *, const DumpField &);
+  void ReadList(IdfxFileHandler, const std::string &, const DumpField &);
   int GetLastDumpInDirectory(fs::path &);
   void CreateMPIDataType(GridBox, bool);
 
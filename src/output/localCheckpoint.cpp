@@ -0,0 +1,261 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "localCheckpoint.hpp"
+
+LocalCheckpoint::LocalCheckpoint(fs::path localDirectory): directory(localDirectory) {
+  // The directory is node-local, so each process makes sure it exists
+  try {
+    fs::create_directories(directory);
+  } catch(std::exception &e) {
+    std::stringstream msg;
+    msg << "Cannot create directory " << directory << std::endl;
+    msg << e.what();
+    IDEFIX_ERROR(msg);
+  }
+}
+
+LocalCheckpoint::~LocalCheckpoint() {
+  // Make sure the last dump has reached its destination before leaving
+  Wait();
+}
+
+fs::path LocalCheckpoint::GetFilename(int number) {
+  std::stringstream ssFileName;
+  ssFileName << "dump." << std::setfill('0') << std::setw(4) << number << "."
+             << std::setw(5) << idfx::prank << ".local";
+  return(directory/ssFileName.str());
+}
+
+// Number of a local copy of this process from its filename (-1 if it is not one)
+static int GetNumber(const fs::path &path) {
+  std::stringstream ssSuffix;
+  ssSuffix << "." << std::setfill('0') << std::setw(5) << idfx::prank << ".local";
+  const std::string suffix = ssSuffix.str();
+  const std::string name = path.filename().string();
+  if(name.size() <= suffix.size() + 5 || name.compare(0, 5, "dump.") != 0) return(-1);
+  if(name.compare(name.size()-suffix.size(), suffix.size(), suffix) != 0) return(-1);
+  try {
+    return(std::stoi(name.substr(5, name.size()-5-suffix.size())));
+  } catch (...) {
+    return(-1);
+  }
+}
+
+void LocalCheckpoint::Begin() {
+  pieces.clear();
+  buffer.clear();
+}
+
+void LocalCheckpoint::Add(int64_t offset, const void *data, int64_t size, int64_t drainSize) {
+  // Merge with the previous piece when they are contiguous in the dump file
+  if(!pieces.empty()) {
+    Piece &last = pieces.back();
+    if(last.offset + last.size == offset
+       && (last.drainSize == last.size || (last.drainSize == 0 && drainSize == 0))) {
+      last.size += size;
+      last.drainSize += drainSize;
+      const char *bytes = static_cast<const char *>(data);
+      buffer.insert(buffer.end(), bytes, bytes+size);
+      return;
+    }
+  }
+  Piece piece{offset, static_cast<int64_t>(buffer.size()), size, drainSize};
+  pieces.push_back(piece);
+  const char *bytes = static_cast<const char *>(data);
+  buffer.insert(buffer.end(), bytes, bytes+size);
+}
+
+void LocalCheckpoint::Commit(int number, const fs::path &dumpFile, int base) {
+  // Only one drain at a time
+  Wait();
+
+  fs::path filename = GetFilename(number);
+  FILE *file = fopen(filename.c_str(), "wb");
+  if(file == NULL) {
+    IDEFIX_ERROR("Unable to open file "+filename.string());
+  }
+  const int64_t npieces = pieces.size();
+  const int64_t header[2] = {npieces, base};
+  bool success = fwrite(header, sizeof(int64_t), 2, file) == 2;
+  success = success && fwrite(pieces.data(), sizeof(Piece), npieces, file) == npieces;
+  success = success && fwrite(buffer.data(), sizeof(char), buffer.size(), file) == buffer.size();
+  fclose(file);
+  if(!success) {
+    IDEFIX_ERROR("Unable to write "+filename.string()+". Check the space left on the device.");
+  }
+
+  // Older local copies are not needed anymore once a full dump has been written
+  if(base < 0) {
+    for(const auto &entry : fs::directory_iterator(directory)) {
+      const int n = GetNumber(entry.path());
+      if(n >= 0 && n < number) fs::remove(entry.path());
+    }
+  }
+
+  // The pieces are drained in a temporary file, created empty by a single process before
+  // the drain threads start
+  drainTarget = dumpFile;
+  drainFile = dumpFile;
+  drainFile += ".part";
+  if(idfx::prank == 0) {
+    int fd = open(drainFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || close(fd) != 0) {
+      IDEFIX_ERROR("Unable to create "+drainFile.string()+" to drain the local dump.");
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+  #endif
+
+  // Drain the pieces in the background
+  drainError.clear();
+  drainThread = std::thread(Drain, std::move(pieces), std::move(buffer),
+                            drainFile.string(), &drainError);
+  pieces.clear();
+  buffer.clear();
+}
+
+// Wait for the drain of all the processes, and rename the temporary file as the dump file.
+// This is a collective call.
+void LocalCheckpoint::Wait() {
+  if(!drainThread.joinable()) return;
+  drainThread.join();
+  int success = drainError.empty();
+  if(!success) {
+    IDEFIX_WARNING(drainError);
+  }
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &success, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD));
+  #endif
+  if(idfx::prank == 0) {
+    if(success) {
+      try {
+        fs::rename(drainFile, drainTarget);
+      } catch(std::exception &e) {
+        std::stringstream msg;
+        msg << "Cannot rename " << drainFile << " as " << drainTarget << std::endl;
+        msg << e.what();
+        IDEFIX_WARNING(msg);
+      }
+    } else {
+      IDEFIX_WARNING("The drain of "+drainTarget.string()+" failed. The incomplete dump is left in "
+                     +drainFile.string());
+    }
+  }
+}
+
+// Write the pieces at their position in the dump file (executed by the drain thread)
+void LocalCheckpoint::Drain(std::vector<Piece> pieces, std::vector<char> buffer,
+                            std::string filename, std::string *error) {
+  // The file has been created by the first process
+  int fd = open(filename.c_str(), O_WRONLY);
+  if(fd < 0) {
+    *error = "Unable to open "+filename+" to drain the local dump.";
+    return;
+  }
+  for(const Piece &piece : pieces) {
+    int64_t written = 0;
+    while(written < piece.drainSize) {
+      ssize_t n = pwrite(fd, buffer.data()+piece.position+written,
+                         piece.drainSize-written, piece.offset+written);
+      if(n <= 0) {
+        *error = "Unable to write "+filename+" while draining the local dump. "
+               + "Check your filesystem permissions and disk quota.";
+        close(fd);
+        return;
+      }
+      written += n;
+    }
+  }
+  if(close(fd) != 0) {
+    *error = "Unable to close "+filename+" while draining the local dump.";
+  }
+}
+
+// Read the pieces of a local copy, and their data unless buffer is null. Returns false if the
+// local copy is missing or incomplete.
+bool LocalCheckpoint::ReadFile(int number, int &base, std::vector<Piece> &pieces,
+                               std::vector<char> *buffer) {
+  fs::path filename = GetFilename(number);
+  FILE *file = fopen(filename.c_str(), "rb");
+  if(file == NULL) return(false);
+  int64_t header[2];
+  bool success = fread(header, sizeof(int64_t), 2, file) == 2 && header[0] >= 0;
+  if(success) {
+    pieces.resize(header[0]);
+    base = header[1];
+    success = fread(pieces.data(), sizeof(Piece), header[0], file) == header[0];
+  }
+  int64_t size = 0;
+  if(success && !pieces.empty()) size = pieces.back().position + pieces.back().size;
+  if(success && buffer != nullptr) {
+    buffer->resize(size);
+    success = fread(buffer->data(), sizeof(char), size, file) == size;
+  }
+  fclose(file);
+  if(success) {
+    const int64_t expected = sizeof(header) + pieces.size()*sizeof(Piece) + size;
+    success = static_cast<int64_t>(fs::file_size(filename)) == expected;
+  }
+  return(success);
+}
+
+// Whether the local copy of a dump, and those of the dumps it is based on, are complete
+bool LocalCheckpoint::IsAvailable(int number) {
+  std::vector<Piece> chainPieces;
+  int base = number;
+  do {
+    number = base;
+    if(!ReadFile(number, base, chainPieces, nullptr) || base >= number) return(false);
+  } while(base >= 0);
+  return(true);
+}
+
+int LocalCheckpoint::GetLastNumber() {
+  int last = -1;
+  for(const auto &entry : fs::directory_iterator(directory)) {
+    last = std::max(last, GetNumber(entry.path()));
+  }
+  return(last);
+}
+
+void LocalCheckpoint::Load(int number) {
+  int base;
+  if(!ReadFile(number, base, pieces, &buffer)) {
+    IDEFIX_ERROR("The local dump file "+GetFilename(number).string()+" is missing or incomplete");
+  }
+}
+
+// Copy size bytes found at a given offset of the dump file
+void LocalCheckpoint::Fetch(int64_t offset, void *data, int64_t size) {
+  auto it = std::upper_bound(pieces.begin(), pieces.end(), offset,
+                             [](int64_t o, const Piece &piece) { return(o < piece.offset); });
+  if(it == pieces.begin() || offset + size > (it-1)->offset + (it-1)->size) {
+    IDEFIX_ERROR("The local dump does not contain the requested data");
+  }
+  --it;
+  std::memcpy(data, buffer.data() + it->position + (offset - it->offset), size);
+}
+
+// Size of the dump file
+int64_t LocalCheckpoint::GetSize() {
+  int64_t size = 0;
+  for(const Piece &piece : pieces) {
+    size = std::max(size, piece.offset + piece.size);
+  }
+  return(size);
+}
@@ -0,0 +1,71 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_LOCALCHECKPOINT_HPP_
+#define OUTPUT_LOCALCHECKPOINT_HPP_
+
+#include <string>
+#include <thread>  // NOLINT [build/c++11]
+#include <vector>
+#if __has_include(<filesystem>)
+  #include <filesystem> // NOLINT [build/c++17]
+  namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+  #include <experimental/filesystem>
+  namespace fs = std::experimental::filesystem;
+#else
+  error "Missing the <filesystem> header."
+#endif
+#include "idefix.hpp"
+
+// Node-local copy of a dump file, set by the dmp_local entry of the [Output] block.
+// Each process keeps the pieces of the dump file it knows about (its own sub-domain and the
+// serial fields) together with their position in the dump file. The pieces are first written
+// in a local file (e.g. on a node-local SSD or tmpfs), and then drained in the background by
+// a thread which writes them at their position in a temporary file, without any MPI call. The
+// temporary file is renamed as the dump file once all the processes have drained their pieces.
+class LocalCheckpoint {
+ public:
+  explicit LocalCheckpoint(fs::path);
+  ~LocalCheckpoint();
+
+  // Write a local copy
+  void Begin();
+  void Add(int64_t, const void *, int64_t, int64_t);  // offset, data, size, drained size
+  void Commit(int, const fs::path &, int);            // number, dump file, base (-1 if full)
+  void Wait();                                        // complete the drain in progress
+
+  // Read a local copy
+  bool IsAvailable(int);
+  int GetLastNumber();
+  void Load(int);
+  void Fetch(int64_t, void *, int64_t);
+  int64_t GetSize();
+
+ private:
+  struct Piece {
+    int64_t offset;       // position in the dump file
+    int64_t position;     // position in the buffer
+    int64_t size;
+    int64_t drainSize;    // # of bytes written in the dump file by this process
+  };
+
+  fs::path GetFilename(int);
+  bool ReadFile(int, int &, std::vector<Piece> &, std::vector<char> *);
+  static void Drain(std::vector<Piece>, std::vector<char>, std::string, std::string *);
+
+  fs::path directory;
+  std::vector<Piece> pieces;
+  std::vector<char> buffer;
+
+  std::thread drainThread;
+  fs::path drainFile;       // temporary file written by the drain thread
+  fs::path drainTarget;     // dump file it becomes
+  std::string drainError;   // set by the drain thread
+};
+
+#endif // OUTPUT_LOCALCHECKPOINT_HPP_
@@ -6,6 +6,7 @@
 // ***********************************************************************************
 
 #include <string>
+#include <vector>
 #include "output.hpp"
 #include "dataBlock.hpp"
 #include "fluid.hpp"
@@ -81,14 +82,18 @@ Output::Output(Input &input, DataBlock &data) {
     for(int var = 0 ; var < nvars ; var++) {
       std::string arrayName = input.Get<std::string>("Output","uservar",var);
       // Create an array to store this user variable
-      // and store the whole thing in the container
-      userDefVariables[arrayName] = IdefixHostArray3D<real>("userVar-"+arrayName,
-                                                                  data.np_tot[KDIR],
-                                                                  data.np_tot[JDIR],
-                                                                  data.np_tot[IDIR]);
-      data.vtk->RegisterVariable(userDefVariables[arrayName],arrayName);
+      // and store the whole thing in the container shared by all the outputs
+      IdefixHostArray3D<real> &array = userDefVariables.variables[arrayName];
+      array = IdefixHostArray3D<real>("userVar-"+arrayName,
+                                      data.np_tot[KDIR],
+                                      data.np_tot[JDIR],
+                                      data.np_tot[IDIR]);
+      data.vtk->RegisterVariable(array,arrayName);
+      #ifdef WITH_HDF5
+      data.xdmf->RegisterVariable(array,arrayName);
+      #endif
     }
-    userDefVariablesEnabled = true;
+    userDefVariables.enabled = true;
   }
 
   // Look for slice outputs (in the form of VTK files)
@@ -110,12 +115,17 @@ Output::Output(Input &input, DataBlock &data) {
         IDEFIX_ERROR("Unknown slice type "+typeStr);
       }
       slices.emplace_back(std::make_unique<Slice>(input, data, n, type, direction, x0, period));
-      if(userDefVariablesEnabled) slices[n-1]->EnrollUserDefVariables(userDefVariables);
+      if(userDefVariables.enabled) slices[n-1]->EnrollUserDefVariables(&userDefVariables);
       // Next iteration
       n++;
     }
   }
 
+  // Look for in-situ reduced outputs
+  for(int n = 1 ; input.CheckEntry("Output","reduction"+std::to_string(n))>0 ; n++) {
+    reductions.emplace_back(std::make_unique<Reduction>(input, data, n));
+  }
+
   // Register variables that are needed in restart dumps
   data.dump->RegisterVariable(&dumpLast, "dumpLast");
   data.dump->RegisterVariable(&analysisLast, "analysisLast");
@@ -137,23 +147,18 @@ int Output::CheckForWrites(DataBlock &data) {
     return(0);
   }
 
+  // The user-defined variables computed during the previous call are outdated
+  userDefVariables.Invalidate();
+
   // Do we need a VTK output?
   if(vtkEnabled) {
     if(data.t >= vtkLast + vtkPeriod) {
       elapsedTime -= timer.seconds();
-      if(userDefVariablesEnabled) {
-        if(haveUserDefVariablesFunc) {
-          // Call user-def function to fill the userdefined variable arrays
-          idfx::pushRegion("UserDef::User-defined variables function");
-          userDefVariablesFunc(data, userDefVariables);
-          idfx::popRegion();
-        } else {
-          IDEFIX_ERROR("Cannot output user-defined variables without "
-                        "enrollment of your user-defined variables function");
-        }
-      }
+      data.scheduler->Gather();
+      userDefVariables.Update(data);
       vtkLast += vtkPeriod;
       data.vtk->Write();
+      if(data.haveParticles) data.particles->WriteVtk();
       nfiles++;
       elapsedTime += timer.seconds();
 
@@ -171,17 +176,8 @@ int Output::CheckForWrites(DataBlock &data) {
   if(xdmfEnabled) {
     if(data.t >= xdmfLast + xdmfPeriod) {
       elapsedTime -= timer.seconds();
-      if(userDefVariablesEnabled) {
-        if(haveUserDefVariablesFunc) {
-          // Call user-def function to fill the userdefined variable arrays
-          idfx::pushRegion("UserDef::User-defined variables function");
-          userDefVariablesFunc(data, userDefVariables);
-          idfx::popRegion();
-        } else {
-          IDEFIX_ERROR("Cannot output user-defined variables without "
-                        "enrollment of your user-defined variables function");
-        }
-      }
+      data.scheduler->Gather();
+      userDefVariables.Update(data);
       xdmfLast += xdmfPeriod;
       data.xdmf->Write();
       nfiles++;
@@ -207,6 +203,7 @@ int Output::CheckForWrites(DataBlock &data) {
                      "enrollment of your analysis function");
       }
       analysisLast += analysisPeriod;
+      data.scheduler->Gather();
       idfx::pushRegion("UserDef::User-defined analysis function");
       analysisFunc(data);
       idfx::popRegion();
@@ -224,9 +221,10 @@ int Output::CheckForWrites(DataBlock &data) {
   }
 
   if(haveSlices) {
-    for(int i = 0 ; i < slices.size() ; i++) {
-      slices[i]->CheckForWrite(data);
-    }
+    WriteSlices(data);
+  }
+  for(auto &reduction : reductions) {
+    reduction->CheckForWrite(data);
   }
   // Do we need a restart dump?
   if(dumpEnabled) {
@@ -254,6 +252,8 @@ int Output::CheckForWrites(DataBlock &data) {
     // so it's important that this part happens last.
     if(havePeriodicDump || haveClockDump) {
       elapsedTime -= timer.seconds();
+      data.scheduler->Gather();
+      if(data.haveParticles) data.particles->SyncToHost();
       data.dump->Write(*this);
       nfiles++;
       elapsedTime += timer.seconds();
@@ -272,11 +272,29 @@ int Output::CheckForWrites(DataBlock &data) {
   return(nfiles);
 }
 
+// Write the slices that are due as a batch: the slices are all filled and their reductions
+// posted before any of them is written, so that the reductions overlap each other and the
+// writes of the cuts held by different processes.
+void Output::WriteSlices(DataBlock &data, bool force) {
+  idfx::pushRegion("Output::WriteSlices");
+  std::vector<Slice *> due;
+  for(auto &slice : slices) {
+    if(slice->StartWrite(data, force)) due.push_back(slice.get());
+  }
+  for(auto slice : due) {
+    slice->FinishWrite();
+  }
+  idfx::popRegion();
+}
+
 bool Output::RestartFromDump(DataBlock &data, int readNumber) {
   idfx::pushRegion("Output::RestartFromDump");
 
   bool result = data.dump->Read(*this, readNumber);
-  if(result) data.DeriveVectorPotential();
+  if(result) {
+    data.DeriveVectorPotential();
+    if(data.haveParticles) data.particles->SyncToDevice();
+  }
 
   idfx::popRegion();
   return(result);
@@ -285,7 +303,11 @@ bool Output::RestartFromDump(DataBlock &data, int readNumber) {
 void Output::ForceWriteDump(DataBlock &data) {
   idfx::pushRegion("Output::ForceWriteDump");
 
-  if(!forceNoWrite) data.dump->Write(*this);
+  if(!forceNoWrite) {
+    data.scheduler->Gather();
+    if(data.haveParticles) data.particles->SyncToHost();
+    data.dump->Write(*this);
+  }
 
   idfx::popRegion();
 }
@@ -294,23 +316,14 @@ void Output::ForceWriteVtk(DataBlock &data) {
   idfx::pushRegion("Output::ForceWriteVtk");
 
   if(!forceNoWrite) {
-    if(userDefVariablesEnabled) {
-      if(haveUserDefVariablesFunc) {
-        // Call user-def function to fill the userdefined variable arrays
-        idfx::pushRegion("UserDef::User-defined variables function");
-        userDefVariablesFunc(data, userDefVariables);
-        idfx::popRegion();
-      } else {
-        IDEFIX_ERROR("Cannot output user-defined variables without "
-                      "enrollment of your user-defined variables function");
-      }
-    }
+    data.scheduler->Gather();
+    userDefVariables.Invalidate();
+    userDefVariables.Update(data);
     vtkLast += vtkPeriod;
     data.vtk->Write();
+    if(data.haveParticles) data.particles->WriteVtk();
     if(haveSlices) {
-      for(int i = 0 ; i < slices.size() ; i++) {
-        slices[i]->CheckForWrite(data,true);
-      }
+      WriteSlices(data, true);
     }
   }
   idfx::popRegion();
@@ -321,17 +334,9 @@ void Output::ForceWriteXdmf(DataBlock &data) {
   idfx::pushRegion("Output::ForceWriteXdmf");
 
   if(!forceNoWrite) {
-    if(userDefVariablesEnabled) {
-        if(haveUserDefVariablesFunc) {
-          // Call user-def function to fill the userdefined variable arrays
-          idfx::pushRegion("UserDef::User-defined variables function");
-          userDefVariablesFunc(data, userDefVariables);
-          idfx::popRegion();
-        } else {
-          IDEFIX_ERROR("Cannot output user-defined variables without "
-                        "enrollment of your user-defined variables function");
-        }
-      }
+    data.scheduler->Gather();
+    userDefVariables.Invalidate();
+    userDefVariables.Update(data);
       xdmfLast += xdmfPeriod;
       data.xdmf->Write();
   }
@@ -354,20 +359,18 @@ void Output::EnrollAnalysis(AnalysisFunc myFunc) {
 
 void Output::EnrollUserDefVariables(UserDefVariablesFunc myFunc) {
   idfx::pushRegion("Output::EnrollUserDefVariable");
-  if(!userDefVariablesEnabled) {
+  if(!userDefVariables.enabled) {
     IDEFIX_ERROR("You are enrolling a user-defined variables function "
                  "but the userdef variables are not set in the input file");
   }
-  userDefVariablesFunc = myFunc;
-  if(haveSlices) {
-    for(int i = 0 ; i < slices.size() ; i++) {
-      slices[i]->EnrollUserDefFunc(myFunc);
-    }
-  }
-  haveUserDefVariablesFunc = true;
+  userDefVariables.Enroll(myFunc);
   idfx::popRegion();
 }
 
+UserDefVariablesContainer& Output::GetUserDefVariables(DataBlock &data) {
+  return(userDefVariables.Update(data));
+}
+
 void Output::ResetTimer() {
   elapsedTime = 0.0;
 }
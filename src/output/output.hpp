@@ -20,12 +20,11 @@
 #endif
 #include "dump.hpp"
 #include "slice.hpp"
+#include "reduction.hpp"
+#include "userDefVariables.hpp"
 
 using AnalysisFunc = void (*) (DataBlock &);
 
-using UserDefVariablesContainer = std::map<std::string,IdefixHostArray3D<real>>;
-using UserDefVariablesFunc = void (*) (DataBlock &, UserDefVariablesContainer &);
-
 
 class Output {
   friend class Dump;    // Allow dump to have R/W access to private variables
@@ -47,6 +46,8 @@ class Output {
   double GetTimer();
   void EnrollAnalysis(AnalysisFunc);
   void EnrollUserDefVariables(UserDefVariablesFunc);
+  // User-defined variables at the current time (computed only if needed)
+  UserDefVariablesContainer& GetUserDefVariables(DataBlock &);
 
  private:
   bool forceNoWrite = false;    //< explicitely disable all writes
@@ -71,13 +72,13 @@ class Output {
   bool haveAnalysisFunc = false;
   AnalysisFunc analysisFunc;
 
-  bool userDefVariablesEnabled = false;
-  bool haveUserDefVariablesFunc = false;
-  UserDefVariablesFunc userDefVariablesFunc;
-  UserDefVariablesContainer userDefVariables;
+  UserDefVariables userDefVariables;
 
   bool haveSlices = false;
   std::vector<std::unique_ptr<Slice>> slices;
+  void WriteSlices(DataBlock &, bool = false);
+
+  std::vector<std::unique_ptr<Reduction>> reductions;
 
   Kokkos::Timer timer;
   double elapsedTime{0.0};
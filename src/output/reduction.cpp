@@ -0,0 +1,426 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "reduction.hpp"
+#include "dataBlock.hpp"
+#include "gridHost.hpp"
+#include "fluid.hpp"
+
+Reduction::Reduction(Input &input, DataBlock &data, int n) {
+  idfx::pushRegion("Reduction::Reduction");
+  const std::string entry = "reduction"+std::to_string(n);
+  this->filename = entry+".csv";
+  this->period = input.Get<real>("Output", entry, 0);
+  this->last = data.t - period;
+  // Register the last output in dumps so that we restart from the right time
+  data.dump->RegisterVariable(&last, std::string("redLast-")+std::to_string(n));
+
+  const int nparams = input.CheckEntry("Output", entry);
+  const std::string typeStr = input.Get<std::string>("Output", entry, 1);
+
+  // Find the index of the fields in Vc
+  auto addVariable = [&](const std::string &name) {
+    const std::vector<std::string> &VcName = data.hydro->VcName;
+    for(int nv = 0 ; nv < VcName.size() ; nv++) {
+      if(VcName[nv] == name) {
+        vars.push_back(nv);
+        varNames.push_back(name);
+        return;
+      }
+    }
+    IDEFIX_ERROR("Unknown variable "+name+" in "+entry);
+  };
+
+  if(typeStr.compare("azimuthal") == 0) {
+    type = Type::Azimuthal;
+    #if GEOMETRY == POLAR
+      reduced[JDIR] = true;
+    #elif GEOMETRY == SPHERICAL
+      reduced[KDIR] = true;
+    #else
+      IDEFIX_ERROR("Azimuthal reductions require POLAR or SPHERICAL geometry");
+    #endif
+    for(int p = 2 ; p < nparams ; p++) addVariable(input.Get<std::string>("Output", entry, p));
+  } else if(typeStr.compare("shell") == 0) {
+    type = Type::Shell;
+    reduced[JDIR] = true;
+    reduced[KDIR] = true;
+    for(int p = 2 ; p < nparams ; p++) addVariable(input.Get<std::string>("Output", entry, p));
+  } else if(typeStr.compare("pdf") == 0) {
+    type = Type::Pdf;
+    addVariable(input.Get<std::string>("Output", entry, 2));
+    nbins = input.Get<int>("Output", entry, 3);
+    vmin = input.Get<real>("Output", entry, 4);
+    vmax = input.Get<real>("Output", entry, 5);
+    if(nparams > 6) {
+      const std::string scale = input.Get<std::string>("Output", entry, 6);
+      if(scale.compare("log") == 0) {
+        logBins = true;
+      } else if(scale.compare("lin") != 0) {
+        IDEFIX_ERROR("The bins of "+entry+" should be either lin or log");
+      }
+    }
+    if(nbins < 1 || vmax <= vmin || (logBins && vmin <= 0)) {
+      IDEFIX_ERROR("Invalid bins in "+entry);
+    }
+    for(int dir = 0 ; dir < 3 ; dir++) reduced[dir] = true;
+  } else if(typeStr.compare("spectrum") == 0) {
+    type = Type::Spectrum;
+    addVariable(input.Get<std::string>("Output", entry, 2));
+    nmodes = input.Get<int>("Output", entry, 3);
+    if(nmodes < 1) IDEFIX_ERROR("Invalid number of modes in "+entry);
+    for(int p = 4 ; p < nparams ; p++) {
+      if(p > 5) IDEFIX_ERROR("Spectra can be computed along at most 2 directions in "+entry);
+      const int dir = input.Get<int>("Output", entry, p);
+      if(dir < 0 || dir >= DIMENSIONS || reduced[dir]) {
+        IDEFIX_ERROR("Invalid direction for the spectrum "+entry);
+      }
+      modeDir[p-4] = dir;
+      reduced[dir] = true;
+    }
+    if(modeDir[0] < 0) IDEFIX_ERROR("No direction given for the spectrum "+entry);
+  } else {
+    IDEFIX_ERROR("Unknown reduction type "+typeStr);
+  }
+  if(vars.size() == 0) IDEFIX_ERROR("No variable given in "+entry);
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    nglob[dir] = reduced[dir] ? 1 : data.mygrid->np_int[dir];
+  }
+
+  #ifdef WITH_MPI
+    if(type == Type::Spectrum) {
+      // The processes which share the same transverse sub-domain sum their Fourier coefficients
+      int remainDims[3] = {reduced[IDIR], reduced[JDIR], reduced[KDIR]};
+      MPI_SAFE_CALL(MPI_Cart_sub(data.mygrid->CartComm, remainDims, &modeComm));
+    }
+  #endif
+
+  WriteHeader(data);
+  idfx::popRegion();
+}
+
+void Reduction::CheckForWrite(DataBlock &data, bool force) {
+  if(!(force || data.t >= last + period)) return;
+  idfx::pushRegion("Reduction::CheckForWrite");
+  data.scheduler->Gather();
+
+  std::vector<real> result;
+  switch(type) {
+    case Type::Azimuthal:
+    case Type::Shell:
+      ComputeAverage(data, result);
+      break;
+    case Type::Pdf:
+      ComputePdf(data, result);
+      break;
+    case Type::Spectrum:
+      ComputeSpectrum(data, result);
+      break;
+  }
+
+  if(idfx::prank == 0) {
+    std::ofstream file(filename, std::ios::app);
+    file.precision(10);
+    file << std::scientific << data.t;
+    for(real value : result) file << "," << value;
+    file << std::endl;
+  }
+
+  last += period;
+  if((last+period <= data.t) && period > 0.0) {
+    while(last <= data.t - period) {
+      last += period;
+    }
+  }
+  idfx::popRegion();
+}
+
+// Extent and global offset of the local part of the result
+void Reduction::GetLocalOffset(DataBlock &data, std::array<int,3> &nloc,
+                               std::array<int,3> &offset) {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    nloc[dir] = reduced[dir] ? 1 : data.np_int[dir];
+    offset[dir] = reduced[dir] ? 0 : data.gbeg[dir] - data.nghost[dir];
+  }
+}
+
+// Copy the local partial sums in a global array and sum it on the root process
+static void SumOnRoot(IdefixArray4D<real> local, const std::array<int,3> &offset,
+                      const std::array<int,3> &nglob, std::vector<real> &global) {
+  auto localHost = Kokkos::create_mirror_view(local);
+  Kokkos::deep_copy(localHost, local);
+
+  global.assign(local.extent(0)*nglob[KDIR]*nglob[JDIR]*nglob[IDIR], ZERO_F);
+  for(int n = 0 ; n < localHost.extent(0) ; n++) {
+    for(int k = 0 ; k < localHost.extent(1) ; k++) {
+      for(int j = 0 ; j < localHost.extent(2) ; j++) {
+        for(int i = 0 ; i < localHost.extent(3) ; i++) {
+          const int64_t idx = ((static_cast<int64_t>(n)*nglob[KDIR] + k + offset[KDIR])
+                                *nglob[JDIR] + j + offset[JDIR])*nglob[IDIR] + i + offset[IDIR];
+          global[idx] = localHost(n,k,j,i);
+        }
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Reduce(idfx::prank == 0 ? MPI_IN_PLACE : global.data(), global.data(),
+                             global.size(), realMPI, MPI_SUM, 0, MPI_COMM_WORLD));
+  #endif
+}
+
+// Volume-weighted averages along the reduced directions
+void Reduction::ComputeAverage(DataBlock &data, std::vector<real> &result) {
+  std::array<int,3> nloc, offset;
+  GetLocalOffset(data, nloc, offset);
+  const int nvars = vars.size();
+
+  IdefixArray1D<int> varIndex("ReductionVars", nvars);
+  auto varIndexHost = Kokkos::create_mirror_view(varIndex);
+  for(int n = 0 ; n < nvars ; n++) varIndexHost(n) = vars[n];
+  Kokkos::deep_copy(varIndex, varIndexHost);
+
+  // The last slot holds the volume
+  IdefixArray4D<real> sum("ReductionSum", nvars+1, nloc[KDIR], nloc[JDIR], nloc[IDIR]);
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray3D<real> dV = data.dV;
+  const bool rk = reduced[KDIR];
+  const bool rj = reduced[JDIR];
+  const bool ri = reduced[IDIR];
+  const int kbeg = data.beg[KDIR], kend = data.end[KDIR];
+  const int jbeg = data.beg[JDIR], jend = data.end[JDIR];
+  const int ibeg = data.beg[IDIR], iend = data.end[IDIR];
+
+  idefix_for("Reduction::Average",
+    0, nloc[KDIR],
+    0, nloc[JDIR],
+    0, nloc[IDIR],
+    KOKKOS_LAMBDA (int ko, int jo, int io) {
+      const int k0 = rk ? kbeg : kbeg + ko;
+      const int k1 = rk ? kend : k0 + 1;
+      const int j0 = rj ? jbeg : jbeg + jo;
+      const int j1 = rj ? jend : j0 + 1;
+      const int i0 = ri ? ibeg : ibeg + io;
+      const int i1 = ri ? iend : i0 + 1;
+      for(int n = 0 ; n <= nvars ; n++) sum(n,ko,jo,io) = ZERO_F;
+      for(int k = k0 ; k < k1 ; k++) {
+        for(int j = j0 ; j < j1 ; j++) {
+          for(int i = i0 ; i < i1 ; i++) {
+            for(int n = 0 ; n < nvars ; n++) {
+              sum(n,ko,jo,io) += Vc(varIndex(n),k,j,i)*dV(k,j,i);
+            }
+            sum(nvars,ko,jo,io) += dV(k,j,i);
+          }
+        }
+      }
+    });
+
+  std::vector<real> global;
+  SumOnRoot(sum, offset, nglob, global);
+
+  const int64_t npoints = nglob[KDIR]*nglob[JDIR]*nglob[IDIR];
+  result.resize(nvars*npoints);
+  for(int n = 0 ; n < nvars ; n++) {
+    for(int64_t p = 0 ; p < npoints ; p++) {
+      result[n*npoints+p] = global[n*npoints+p]/global[nvars*npoints+p];
+    }
+  }
+}
+
+// Volume-weighted probability density function
+void Reduction::ComputePdf(DataBlock &data, std::vector<real> &result) {
+  const int nbins = this->nbins;
+  const bool logBins = this->logBins;
+  const real xmin = logBins ? std::log10(vmin) : vmin;
+  const real dx = ((logBins ? std::log10(vmax) : vmax) - xmin)/nbins;
+  const int var = vars[0];
+
+  IdefixArray1D<real> hist("ReductionPdf", nbins);
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray3D<real> dV = data.dV;
+
+  idefix_for("Reduction::Pdf",
+    data.beg[KDIR], data.end[KDIR],
+    data.beg[JDIR], data.end[JDIR],
+    data.beg[IDIR], data.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real v = Vc(var,k,j,i);
+      if(logBins && v <= ZERO_F) return;
+      const real x = logBins ? log10(v) : v;
+      const int bin = static_cast<int>(floor((x-xmin)/dx));
+      if(bin >= 0 && bin < nbins) Kokkos::atomic_add(&hist(bin), dV(k,j,i));
+    });
+
+  // Volume of the domain, which normalises the pdf
+  real volume;
+  idefix_reduce("Reduction::PdfVolume",
+    data.beg[KDIR], data.end[KDIR],
+    data.beg[JDIR], data.end[JDIR],
+    data.beg[IDIR], data.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+      localSum += dV(k,j,i);
+    },
+    Kokkos::Sum<real>(volume));
+
+  // The last slot holds the volume
+  auto histHost = Kokkos::create_mirror_view(hist);
+  Kokkos::deep_copy(histHost, hist);
+  std::vector<real> global(nbins+1);
+  for(int b = 0 ; b < nbins ; b++) global[b] = histHost(b);
+  global[nbins] = volume;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Reduce(idfx::prank == 0 ? MPI_IN_PLACE : global.data(), global.data(),
+                             global.size(), realMPI, MPI_SUM, 0, MPI_COMM_WORLD));
+  #endif
+
+  result.resize(nbins);
+  for(int b = 0 ; b < nbins ; b++) {
+    result[b] = global[b]/(global[nbins]*dx);
+  }
+}
+
+// Power spectrum along one or two directions, averaged over the other directions
+// (assumes a uniform grid along the directions of the transform)
+void Reduction::ComputeSpectrum(DataBlock &data, std::vector<real> &result) {
+  std::array<int,3> nloc, offset;
+  GetLocalOffset(data, nloc, offset);
+
+  const int d1 = modeDir[0];
+  const int d2 = modeDir[1];
+  const int nmodes = this->nmodes;
+  const int ntot1 = data.mygrid->np_int[d1];
+  const int ntot2 = d2 < 0 ? 1 : data.mygrid->np_int[d2];
+  const int beg1 = data.beg[d1];
+  const int beg2 = d2 < 0 ? 0 : data.beg[d2];
+  const int off1 = data.gbeg[d1] - data.nghost[d1];
+  const int off2 = d2 < 0 ? 0 : data.gbeg[d2] - data.nghost[d2];
+  const int nm = d2 < 0 ? nmodes : nmodes*nmodes;
+  const int var = vars[0];
+
+  // Real and imaginary parts of the Fourier coefficients of each mode
+  IdefixArray4D<real> coef("ReductionSpectrum", 2*nm, nloc[KDIR], nloc[JDIR], nloc[IDIR]);
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  const bool rk = reduced[KDIR];
+  const bool rj = reduced[JDIR];
+  const bool ri = reduced[IDIR];
+  const int kbeg = data.beg[KDIR], kend = data.end[KDIR];
+  const int jbeg = data.beg[JDIR], jend = data.end[JDIR];
+  const int ibeg = data.beg[IDIR], iend = data.end[IDIR];
+
+  idefix_for("Reduction::Spectrum",
+    0, 2*nm,
+    0, nloc[KDIR],
+    0, nloc[JDIR],
+    0, nloc[IDIR],
+    KOKKOS_LAMBDA (int n, int ko, int jo, int io) {
+      const int m1 = (n/2) % nmodes;
+      const int m2 = (n/2) / nmodes;
+      const int k0 = rk ? kbeg : kbeg + ko;
+      const int k1 = rk ? kend : k0 + 1;
+      const int j0 = rj ? jbeg : jbeg + jo;
+      const int j1 = rj ? jend : j0 + 1;
+      const int i0 = ri ? ibeg : ibeg + io;
+      const int i1 = ri ? iend : i0 + 1;
+      real c = ZERO_F;
+      for(int k = k0 ; k < k1 ; k++) {
+        for(int j = j0 ; j < j1 ; j++) {
+          for(int i = i0 ; i < i1 ; i++) {
+            const int g1 = (d1 == IDIR ? i : (d1 == JDIR ? j : k)) - beg1 + off1;
+            const int g2 = (d2 == IDIR ? i : (d2 == JDIR ? j : k)) - beg2 + off2;
+            real phase = 2.0*M_PI*m1*g1/ntot1;
+            if(d2 >= 0) phase += 2.0*M_PI*m2*g2/ntot2;
+            c += Vc(var,k,j,i) * (n % 2 == 0 ? cos(phase) : -sin(phase));
+          }
+        }
+      }
+      coef(n,ko,jo,io) = c;
+    });
+
+  // Sum the coefficients of the processes which share the same transverse sub-domain
+  auto coefHost = Kokkos::create_mirror_view(coef);
+  Kokkos::deep_copy(coefHost, coef);
+  int modeRank = 0;
+  #ifdef WITH_MPI
+    MPI_Comm_rank(modeComm, &modeRank);
+    MPI_SAFE_CALL(MPI_Reduce(modeRank == 0 ? MPI_IN_PLACE : coefHost.data(), coefHost.data(),
+                             coefHost.size(), realMPI, MPI_SUM, 0, modeComm));
+  #endif
+
+  // Power of the transverse points of this sub-domain, summed on the root process
+  const int64_t npoints = nglob[KDIR]*nglob[JDIR]*nglob[IDIR];
+  const real norm = static_cast<real>(ntot1)*ntot2;
+  result.assign(nm, ZERO_F);
+  if(modeRank == 0) {
+    for(int m = 0 ; m < nm ; m++) {
+      for(int k = 0 ; k < nloc[KDIR] ; k++) {
+        for(int j = 0 ; j < nloc[JDIR] ; j++) {
+          for(int i = 0 ; i < nloc[IDIR] ; i++) {
+            const real re = coefHost(2*m,k,j,i)/norm;
+            const real im = coefHost(2*m+1,k,j,i)/norm;
+            result[m] += (re*re + im*im)/npoints;
+          }
+        }
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Reduce(idfx::prank == 0 ? MPI_IN_PLACE : result.data(), result.data(),
+                             nm, realMPI, MPI_SUM, 0, MPI_COMM_WORLD));
+  #endif
+}
+
+void Reduction::WriteHeader(DataBlock &data) {
+  if(idfx::prank != 0) return;
+  // Keep appending to the existing file on restarts
+  if(std::ifstream(filename).good()) return;
+
+  GridHost grid(*data.mygrid);
+  grid.SyncFromDevice();
+
+  std::ofstream file(filename);
+  file.precision(10);
+  file << std::scientific;
+  file << "# Idefix " << filename << ": ";
+  switch(type) {
+    case Type::Azimuthal: file << "azimuthal average"; break;
+    case Type::Shell: file << "shell average"; break;
+    case Type::Pdf: file << "volume-weighted pdf"; break;
+    case Type::Spectrum: file << "power spectrum"; break;
+  }
+  file << " of";
+  for(const std::string &name : varNames) file << " " << name;
+  file << std::endl;
+
+  if(type == Type::Azimuthal || type == Type::Shell) {
+    file << "# each line: t, then the averages of each variable on a ("
+         << nglob[KDIR] << "," << nglob[JDIR] << "," << nglob[IDIR]
+         << ") (x3,x2,x1) array in C order" << std::endl;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      if(reduced[dir] || nglob[dir] == 1) continue;
+      file << "# x" << dir+1;
+      for(int i = 0 ; i < nglob[dir] ; i++) file << "," << grid.x[dir](i+grid.nghost[dir]);
+      file << std::endl;
+    }
+  } else if(type == Type::Pdf) {
+    file << "# each line: t, then the pdf in each bin. "
+         << (logBins ? "log10(bin edges)" : "bin edges") << ":";
+    const real xmin = logBins ? std::log10(vmin) : vmin;
+    const real xmax = logBins ? std::log10(vmax) : vmax;
+    for(int b = 0 ; b <= nbins ; b++) file << "," << xmin + b*(xmax-xmin)/nbins;
+    file << std::endl;
+  } else if(type == Type::Spectrum) {
+    file << "# each line: t, then |c(m)|^2 for m=0.." << nmodes-1 << " along x" << modeDir[0]+1;
+    if(modeDir[1] >= 0) {
+      file << " (fastest index) and m=0.." << nmodes-1 << " along x" << modeDir[1]+1;
+    }
+    file << ", averaged over the other directions" << std::endl;
+  }
+}
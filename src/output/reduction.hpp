@@ -0,0 +1,62 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_REDUCTION_HPP_
+#define OUTPUT_REDUCTION_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+
+// Forward class declaration
+class DataBlock;
+
+// In-situ reduced output, set by a reductionN entry of the [Output] block.
+// The product is reduced on the device, summed accross processes with MPI reductions of the
+// local contributions, and appended by the root process to reductionN.csv, one line per
+// output time.
+class Reduction {
+ public:
+  enum class Type {Azimuthal, Shell, Pdf, Spectrum};
+
+  Reduction(Input &, DataBlock &, int);
+  void CheckForWrite(DataBlock &, bool = false);
+  real period{0.0};
+  real last{0.0};
+
+ private:
+  void ComputeAverage(DataBlock &, std::vector<real> &);
+  void ComputePdf(DataBlock &, std::vector<real> &);
+  void ComputeSpectrum(DataBlock &, std::vector<real> &);
+  void WriteHeader(DataBlock &);
+  void GetLocalOffset(DataBlock &, std::array<int,3> &, std::array<int,3> &);
+
+  Type type;
+  std::string filename;
+  std::vector<int> vars;             // field indices in Vc
+  std::vector<std::string> varNames;
+
+  // Averages and spectra
+  std::array<bool,3> reduced{false, false, false};  // directions summed over
+  std::array<int,3> nglob;           // global extent of the result in each direction
+
+  // Pdf
+  int nbins{0};
+  real vmin, vmax;
+  bool logBins{false};
+
+  // Spectrum
+  std::array<int,2> modeDir{-1, -1}; // directions of the transform
+  int nmodes{0};                     // # of modes in each direction of the transform
+  #ifdef WITH_MPI
+  MPI_Comm modeComm;                 // processes sharing the same transverse sub-domain
+  #endif
+};
+
+#endif // OUTPUT_REDUCTION_HPP_
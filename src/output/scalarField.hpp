@@ -25,6 +25,24 @@ class ScalarField {
   explicit ScalarField(IdefixHostArray3D<real>& in):
     h3Darray{in}, type{Host3D} {};
 
+  bool IsDeviceField() const {
+    return(type==Device3D || type==Device4D);
+  }
+
+  // Only valid for device fields
+  IdefixArray3D<real> GetDeviceField() const {
+    if(type==Device3D) {
+      return(d3Darray);
+    } else if(type==Device4D) {
+      IdefixArray3D<real> arr3D = Kokkos::subview(
+                                      d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+      return(arr3D);
+    } else {
+      IDEFIX_ERROR("GetDeviceField called on a host field");
+      return(d3Darray);
+    }
+  }
+
   IdefixHostArray3D<real> GetHostField() const {
     if(type==Host3D) {
       return(h3Darray);
@@ -5,6 +5,7 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
 #include <string>
 #include <map>
 #include <memory>
@@ -62,128 +63,139 @@ Slice::Slice(Input &input, DataBlock & data, int nSlice, SliceType type,
     this->variableMap.emplace(name, arr);
     vtk->RegisterVariable(arr,name);
   }
+  if(type == SliceType::Average) {
+    avgBuffer.resize(variableMap.size()*sliceData->np_tot[KDIR]
+                                        *sliceData->np_tot[JDIR]
+                                        *sliceData->np_tot[IDIR]);
+  }
   // todo(glesur): add variables for dust and other fluids.
 
   idfx::popRegion();
 }
 
-void Slice::EnrollUserDefVariables(std::map<std::string,IdefixHostArray3D<real>> userDefVar) {
-  this->userDefVariableMap = userDefVar;
-  this->haveUserDefinedVariables = true;
+void Slice::EnrollUserDefVariables(UserDefVariables *userDefVar) {
+  this->userDefVariables = userDefVar;
 }
 
-void Slice::EnrollUserDefFunc(UserDefVariablesFunc myFunc) {
-  userDefVariablesFunc = myFunc;
+void Slice::CheckForWrite(DataBlock &data, bool force) {
+  if(StartWrite(data, force)) FinishWrite();
 }
 
-void Slice::CheckForWrite(DataBlock &data, bool force) {
-  idfx::pushRegion("Slice:CheckForWrite");
-
-  if(force || data.t >= sliceLast + slicePeriod) {
-    // sync time
-    sliceData->t = data.t;
-    if(haveUserDefinedVariables) {
-      // Call user-def function to fill the userdefined variable arrays
-      idfx::pushRegion("UserDef::User-defined variables function");
-      userDefVariablesFunc(data, userDefVariableMap);
-      idfx::popRegion();
-    }
+bool Slice::StartWrite(DataBlock &data, bool force) {
+  if(!force && data.t < sliceLast + slicePeriod) return(false);
+  idfx::pushRegion("Slice::StartWrite");
+  data.scheduler->Gather();
 
-    if(this->type == SliceType::Cut && containsX0) {
-      // index of element in current datablock
-      const int idx = subgrid->index - data.gbeg[direction]
-                                    + data.beg[direction];
-
-      if(direction == IDIR) {
-        for(auto const &it : variableMap) {
-          auto name = it.first;
-          auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
-          auto arrIn = scalar.GetHostField();
-          auto arrOut = variableMap[name];
-          for(int k = 0 ; k < data.np_tot[KDIR] ; k++) {
-            for(int j = 0 ; j < data.np_tot[JDIR] ; j++) {
-              arrOut(k,j,0) = arrIn(k,j,idx);
-            }
-          }
-        }
-      } else if(direction == JDIR) {
-        for(auto const &it : variableMap) {
-          auto name = it.first;
-          auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
-          auto arrIn = scalar.GetHostField();
-          auto arrOut = variableMap[name];
-          for(int k = 0 ; k < data.np_tot[KDIR] ; k++) {
-            for(int i = 0 ; i < data.np_tot[IDIR] ; i++) {
-              arrOut(k,0,i) = arrIn(k,idx,i);
-            }
-          }
-        }
-      } else if(direction == KDIR) {
-        for(auto const &it : variableMap) {
-          auto name = it.first;
-          auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
-          auto arrIn = scalar.GetHostField();
-          auto arrOut = variableMap[name];
+  // sync time
+  sliceData->t = data.t;
+  if(userDefVariables != nullptr) {
+    // Fill the userdefined variable arrays, unless another output already did
+    userDefVariables->Update(data);
+  }
+
+  if(this->type == SliceType::Cut && containsX0) {
+    // index of element in current datablock
+    const int idx = subgrid->index - data.gbeg[direction]
+                                  + data.beg[direction];
+
+    if(direction == IDIR) {
+      for(auto const &it : variableMap) {
+        auto name = it.first;
+        auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
+        auto arrIn = scalar.GetHostField();
+        auto arrOut = variableMap[name];
+        for(int k = 0 ; k < data.np_tot[KDIR] ; k++) {
           for(int j = 0 ; j < data.np_tot[JDIR] ; j++) {
-            for(int i = 0 ; i < data.np_tot[IDIR] ; i++) {
-              arrOut(0,j,i) = arrIn(idx,j,i);
-            }
+            arrOut(k,j,0) = arrIn(k,j,idx);
           }
         }
       }
-      vtk->Write();
-    }
-    if(this->type == SliceType::Average) {
-      // Perform a point average (NB: this does not perform a volume average!)
-      // This is a naive approach which could be optimised using threaded loops
-      // However, since this is only for I/O, we don't do any proper optimisation
-      int beg = data.beg[direction];
-      int end = data.end[direction];
-      int ntot = data.mygrid->np_int[direction];
-      const int dir = direction;
-      // Averaged of registered varaibles
+    } else if(direction == JDIR) {
       for(auto const &it : variableMap) {
         auto name = it.first;
         auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
         auto arrIn = scalar.GetHostField();
         auto arrOut = variableMap[name];
-        for(int k = 0 ; k < arrOut.extent(0) ; k++) {
-          for(int j = 0 ; j < arrOut.extent(1) ; j++) {
-            for(int i = 0 ; i < arrOut.extent(2) ; i++) {
-              arrOut(k,j,i) = 0.0;
-        }}}
-        for(int k = data.beg[KDIR] ; k < data.end[KDIR] ; k++) {
-          for(int j = data.beg[JDIR] ; j < data.end[JDIR] ; j++) {
-            for(int i = data.beg[IDIR] ; i < data.end[IDIR] ; i++) {
-              const int it = (dir == IDIR ? 0 : i);
-              const int jt = (dir == JDIR ? 0 : j);
-              const int kt = (dir == KDIR ? 0 : k);
-              arrOut(kt,jt,it) += arrIn(k,j,i)/ntot;
-        }}}
-        #ifdef WITH_MPI
-          Kokkos::fence();
-          MPI_Allreduce(MPI_IN_PLACE, arrOut.data(),
-                        arrOut.extent(0)*arrOut.extent(1)*arrOut.extent(2)*arrOut.extent(3),
-                        realMPI, MPI_SUM, avgComm);
-        #endif
+        for(int k = 0 ; k < data.np_tot[KDIR] ; k++) {
+          for(int i = 0 ; i < data.np_tot[IDIR] ; i++) {
+            arrOut(k,0,i) = arrIn(k,idx,i);
+          }
+        }
       }
-      if(containsX0) {
-        vtk->Write();
+    } else if(direction == KDIR) {
+      for(auto const &it : variableMap) {
+        auto name = it.first;
+        auto &scalar= data.vtk->vtkScalarMap.find(name)->second;
+        auto arrIn = scalar.GetHostField();
+        auto arrOut = variableMap[name];
+        for(int j = 0 ; j < data.np_tot[JDIR] ; j++) {
+          for(int i = 0 ; i < data.np_tot[IDIR] ; i++) {
+            arrOut(0,j,i) = arrIn(idx,j,i);
+          }
+        }
       }
     }
-    if(!containsX0) {
-      vtk->vtkFileNumber++; // increment file number so that each process stay in sync
+  }
+  if(this->type == SliceType::Average) {
+    // Perform a point average (NB: this does not perform a volume average!)
+    // All the variables are averaged in a single buffer, so that they are summed
+    // accross processes with a single non-blocking reduction, completed in FinishWrite.
+    const int ntot = data.mygrid->np_int[direction];
+    const int dir = direction;
+    const int nx = sliceData->np_tot[IDIR];
+    const int ny = sliceData->np_tot[JDIR];
+    const int64_t size = static_cast<int64_t>(sliceData->np_tot[KDIR])*ny*nx;
+    std::fill(avgBuffer.begin(), avgBuffer.end(), 0.0);
+    int64_t n = 0;
+    for(auto const &it : variableMap) {
+      auto &scalar= data.vtk->vtkScalarMap.find(it.first)->second;
+      auto arrIn = scalar.GetHostField();
+      real *arrOut = avgBuffer.data() + n*size;
+      for(int k = data.beg[KDIR] ; k < data.end[KDIR] ; k++) {
+        for(int j = data.beg[JDIR] ; j < data.end[JDIR] ; j++) {
+          for(int i = data.beg[IDIR] ; i < data.end[IDIR] ; i++) {
+            const int it = (dir == IDIR ? 0 : i);
+            const int jt = (dir == JDIR ? 0 : j);
+            const int kt = (dir == KDIR ? 0 : k);
+            arrOut[(kt*ny + jt)*nx + it] += arrIn(k,j,i)/ntot;
+      }}}
+      n++;
     }
+    #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, avgBuffer.data(), avgBuffer.size(),
+                                   realMPI, MPI_SUM, avgComm, &avgRequest));
+    #endif
+  }
 
-    sliceLast += slicePeriod;
-    if((sliceLast+slicePeriod <= data.t) && slicePeriod > 0.0) {
-      while(sliceLast <= data.t - slicePeriod) {
-        sliceLast += slicePeriod;
-      }
+  sliceLast += slicePeriod;
+  if((sliceLast+slicePeriod <= data.t) && slicePeriod > 0.0) {
+    while(sliceLast <= data.t - slicePeriod) {
+      sliceLast += slicePeriod;
     }
+  }
+  idfx::popRegion();
+  return(true);
+}
+
+void Slice::FinishWrite() {
+  idfx::pushRegion("Slice::FinishWrite");
+  if(this->type == SliceType::Average) {
     #ifdef WITH_MPI
-      MPI_Barrier(MPI_COMM_WORLD);
+      MPI_SAFE_CALL(MPI_Wait(&avgRequest, MPI_STATUS_IGNORE));
     #endif
+    // Unpack the averages
+    int64_t n = 0;
+    for(auto const &it : variableMap) {
+      auto arrOut = it.second;
+      const int64_t size = arrOut.extent(0)*arrOut.extent(1)*arrOut.extent(2);
+      std::copy(avgBuffer.begin() + n*size, avgBuffer.begin() + (n+1)*size, arrOut.data());
+      n++;
+    }
+  }
+  if(containsX0) {
+    vtk->Write();
+  } else {
+    vtk->vtkFileNumber++; // increment file number so that each process stay in sync
   }
   idfx::popRegion();
 }
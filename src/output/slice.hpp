@@ -12,23 +12,25 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <vector>
 #include "idefix.hpp"
 #include "dataBlock.hpp"
 #include "input.hpp"
+#include "userDefVariables.hpp"
 
 class Grid;
 class SubGrid;
 class Vtk;
 
-using UserDefVariablesFunc = void (*) (DataBlock &,
-                                      std::map<std::string,IdefixHostArray3D<real>> &);
-
 class Slice {
  public:
   Slice(Input &, DataBlock &, int, SliceType, int, real, real);
   void CheckForWrite(DataBlock &, bool = false);
-  void EnrollUserDefVariables(std::map<std::string,IdefixHostArray3D<real>>);
-  void EnrollUserDefFunc(UserDefVariablesFunc);
+  // Slices are written in two steps, so that the slices due at the same time are batched:
+  // StartWrite fills the slice and posts its reduction, FinishWrite completes and writes it.
+  bool StartWrite(DataBlock &, bool = false);
+  void FinishWrite();
+  void EnrollUserDefVariables(UserDefVariables *);
   real slicePeriod = 0.0;
   real sliceLast = 0.0;
  private:
@@ -38,12 +40,12 @@ class Slice {
   std::unique_ptr<SubGrid> subgrid;
   std::unique_ptr<DataBlock> sliceData;
   std::unique_ptr<Vtk> vtk;
-  bool haveUserDefinedVariables{false};
   std::map<std::string, IdefixHostArray3D<real>> variableMap;
-  std::map<std::string,IdefixHostArray3D<real>> userDefVariableMap;
-  UserDefVariablesFunc userDefVariablesFunc{NULL};
+  UserDefVariables *userDefVariables{nullptr};  // shared with the parent Output
+  std::vector<real> avgBuffer;  // all the averaged variables, reduced at once
   #ifdef WITH_MPI
     MPI_Comm avgComm;  // Communicator for averages
+    MPI_Request avgRequest{MPI_REQUEST_NULL};
   #endif
 };
 
@@ -0,0 +1,36 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "userDefVariables.hpp"
+#include "dataBlock.hpp"
+
+void UserDefVariables::Enroll(UserDefVariablesFunc myFunc) {
+  func = myFunc;
+  upToDate = false;
+}
+
+void UserDefVariables::Invalidate() {
+  upToDate = false;
+}
+
+UserDefVariablesContainer& UserDefVariables::Update(DataBlock &data) {
+  if(!enabled) return(variables);
+  if(upToDate && data.t == lastTime) return(variables);
+
+  if(func == nullptr) {
+    IDEFIX_ERROR("Cannot output user-defined variables without "
+                 "enrollment of your user-defined variables function");
+  }
+  // Call user-def function to fill the userdefined variable arrays
+  idfx::pushRegion("UserDef::User-defined variables function");
+  func(data, variables);
+  idfx::popRegion();
+
+  upToDate = true;
+  lastTime = data.t;
+  return(variables);
+}
@@ -0,0 +1,39 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_USERDEFVARIABLES_HPP_
+#define OUTPUT_USERDEFVARIABLES_HPP_
+
+#include <map>
+#include <string>
+#include "idefix.hpp"
+
+// Forward class declaration
+class DataBlock;
+
+using UserDefVariablesContainer = std::map<std::string,IdefixHostArray3D<real>>;
+using UserDefVariablesFunc = void (*) (DataBlock &, UserDefVariablesContainer &);
+
+// User-defined variables shared by all the outputs (vtk, xdmf, slices and analysis).
+// The user function is called at most once for a given time and output cycle, whatever
+// the number of outputs requiring the variables at that stage.
+class UserDefVariables {
+ public:
+  void Enroll(UserDefVariablesFunc);
+  void Invalidate();                          // a new output cycle begins
+  UserDefVariablesContainer& Update(DataBlock &);  // compute the variables if needed
+
+  bool enabled{false};
+  UserDefVariablesContainer variables;
+
+ private:
+  UserDefVariablesFunc func{nullptr};
+  bool upToDate{false};
+  real lastTime;
+};
+
+#endif // OUTPUT_USERDEFVARIABLES_HPP_
@@ -117,8 +117,13 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
   this->joffset = datain->mygrid->np_tot[JDIR] == 1 ? 0 : 1;
   this->koffset = datain->mygrid->np_tot[KDIR] == 1 ? 0 : 1;
 
-  // Temporary storage on host for 3D arrays
-  this->vect3D = new float[nx1loc*nx2loc*nx3loc];
+  // Staging buffers for 3D arrays, reused by every file
+  this->packBuffer = IdefixArray3D<float>("VtkPackBuffer", nx3loc, nx2loc, nx1loc);
+  for(int n = 0 ; n < 2 ; n++) {
+    this->hostBuffer[n] = Kokkos::View<float***, Kokkos::LayoutRight,
+                                       Kokkos::SharedHostPinnedSpace>("VtkHostBuffer",
+                                                                      nx3loc, nx2loc, nx1loc);
+  }
 
   // Store coordinates for later use
   this->xnode = new float[nx1+ioffset];
@@ -304,18 +309,21 @@ int Vtk::Write() {
 
   WriteHeader(fileHdl, this->data->t);
 
-  // Write field one by one
+  // Write field one by one. Each field is packed and copied to the host
+  // while the previous one is being written.
+  int slot = 0;
+  const std::string *previous = nullptr;
   for(auto const& [name, scalar] : vtkScalarMap) {
-    auto Vcin = scalar.GetHostField();
-    for(int k = data->beg[KDIR]; k < data->end[KDIR] ; k++ ) {
-      for(int j = data->beg[JDIR]; j < data->end[JDIR] ; j++ ) {
-        for(int i = data->beg[IDIR]; i < data->end[IDIR] ; i++ ) {
-          vect3D[i-data->beg[IDIR] + (j-data->beg[JDIR])*nx1loc + (k-data->beg[KDIR])*nx1loc*nx2loc]
-              = bigEndian(static_cast<float>(Vcin(k,j,i)));
-        }
-      }
-    }
-    WriteScalar(fileHdl, vect3D, name);
+    // wait until the previous field has reached the host
+    Kokkos::fence();
+    PackField(scalar, slot);
+    if(previous != nullptr) WriteScalar(fileHdl, hostBuffer[1-slot].data(), *previous);
+    previous = &name;
+    slot = 1-slot;
+  }
+  if(previous != nullptr) {
+    Kokkos::fence();
+    WriteScalar(fileHdl, hostBuffer[1-slot].data(), *previous);
   }
 
 #ifdef WITH_MPI
@@ -334,6 +342,38 @@ int Vtk::Write() {
 }
 
 
+// Convert a field to big endian floats without ghost zones into hostBuffer[slot].
+// For device fields, the copy to the host is asynchronous and should be fenced before use.
+void Vtk::PackField(const ScalarField &scalar, int slot) {
+  const int ibeg = data->beg[IDIR];
+  const int jbeg = data->beg[JDIR];
+  const int kbeg = data->beg[KDIR];
+  BigEndian bigEndian = this->bigEndian;
+
+  if(scalar.IsDeviceField()) {
+    IdefixArray3D<real> in = scalar.GetDeviceField();
+    IdefixArray3D<float> buffer = this->packBuffer;
+    idefix_for("Vtk::PackField",
+      kbeg, data->end[KDIR],
+      jbeg, data->end[JDIR],
+      ibeg, data->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        buffer(k-kbeg, j-jbeg, i-ibeg) = bigEndian(static_cast<float>(in(k,j,i)));
+      });
+    Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(), hostBuffer[slot], buffer);
+  } else {
+    auto Vcin = scalar.GetHostField();
+    auto buffer = hostBuffer[slot];
+    for(int k = kbeg; k < data->end[KDIR] ; k++ ) {
+      for(int j = jbeg; j < data->end[JDIR] ; j++ ) {
+        for(int i = ibeg; i < data->end[IDIR] ; i++ ) {
+          buffer(k-kbeg, j-jbeg, i-ibeg) = bigEndian(static_cast<float>(Vcin(k,j,i)));
+        }
+      }
+    }
+  }
+}
+
 /* ********************************************************************* */
 void Vtk::WriteHeader(IdfxFileHandler fvtk, real time) {
 /*!
@@ -132,8 +132,10 @@ class Vtk : public BaseVtk {
 
   IdefixHostArray4D<float> node_coord;
 
-  // Array designed to store the temporary vector array
-  float *vect3D;
+  // Staging buffers holding the fields converted to big endian floats without ghost zones.
+  // Two host buffers, so that a field can be written while the next one is copied.
+  IdefixArray3D<float> packBuffer;
+  Kokkos::View<float***, Kokkos::LayoutRight, Kokkos::SharedHostPinnedSpace> hostBuffer[2];
 
   // File name
   std::string filebase;
@@ -146,6 +148,7 @@ class Vtk : public BaseVtk {
 #endif
 
   void WriteHeader(IdfxFileHandler, real);
+  void PackField(const ScalarField &, int);
   void WriteScalar(IdfxFileHandler, float*,  const std::string &);
   void WriteHeaderNodes(IdfxFileHandler);
 
@@ -0,0 +1,221 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "vtkParticles.hpp"
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include "version.hpp"
+#include "idefix.hpp"
+#include "dataBlock.hpp"
+#include "dump.hpp"
+#include "particles.hpp"
+
+VtkParticles::VtkParticles(Input &input, DataBlock *datain, Particles *particlesin) {
+  this->data = datain;
+  this->particles = particlesin;
+
+  // Particle files are written next to the vtk files (which create the directory)
+  if(input.CheckEntry("Output","vtk_dir")>=0) {
+    outputDirectory = input.Get<std::string>("Output","vtk_dir",0);
+  } else {
+    outputDirectory = "./";
+  }
+
+  for (int dir=0; dir<3; dir++) {
+    this->periodicity[dir] = (datain->mygrid->lbound[dir] == periodic);
+  }
+
+  // Register variables that are required in restart dumps
+  data->dump->RegisterVariable(&vtkFileNumber, "vtkPartNumber");
+}
+
+int VtkParticles::Write() {
+  idfx::pushRegion("VtkParticles::Write");
+  IdfxFileHandler fileHdl;
+  timer.reset();
+
+  particles->SyncToHost();
+  const int64_t n = particles->count;
+  ntot = n;
+  start = 0;
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(&n, &ntot, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD));
+    MPI_SAFE_CALL(MPI_Exscan(&n, &start, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD));
+    if(idfx::prank == 0) start = 0;
+  #endif
+
+  std::stringstream ssfileName;
+  ssfileName << "particles." << std::setfill('0') << std::setw(4) << vtkFileNumber << ".vtk";
+  fs::path filename = outputDirectory/ssfileName.str();
+
+  idfx::cout << "Vtk: Write file " << ssfileName.str() << "..." << std::flush;
+
+  if(this->isRoot) {
+    if(fs::exists(filename)) {
+      fs::remove(filename);
+    }
+  }
+
+#ifdef WITH_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_SAFE_CALL(MPI_File_open(MPI_COMM_WORLD, filename.c_str(),
+                              MPI_MODE_CREATE | MPI_MODE_RDWR
+                              | MPI_MODE_EXCL | MPI_MODE_UNIQUE_OPEN,
+                              MPI_INFO_NULL, &fileHdl));
+  this->offset = 0;
+#else
+  fileHdl = fopen(filename.c_str(),"wb");
+
+  if(fileHdl == NULL) {
+    std::stringstream msg;
+    msg << "Unable to open file " << filename << std::endl;
+    msg << "Check that you have write access and that you don't exceed your quota." << std::endl;
+    IDEFIX_ERROR(msg);
+  }
+#endif
+
+  // Header, with the same field data as the grid files
+  std::stringstream ssheader;
+  ssheader << "# vtk DataFile Version 2.0" << std::endl;
+  ssheader << "Idefix " << IDEFIX_VERSION << " VTK Data" << std::endl;
+  ssheader << "BINARY" << std::endl;
+  ssheader << "DATASET POLYDATA" << std::endl;
+  ssheader << "FIELD FieldData 3" << std::endl;
+  ssheader << "GEOMETRY 1 1 int" << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+  int32_t geoBig = bigEndian(this->geometry);
+  WriteHeaderBinary(&geoBig, 1, fileHdl);
+
+  ssheader.str(std::string());
+  ssheader << std::endl << "PERIODICITY 1 3 int" << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+  for (int dir=0; dir<3; dir++) {
+    int32_t perBig = bigEndian(this->periodicity[dir]);
+    WriteHeaderBinary(&perBig, 1, fileHdl);
+  }
+
+  ssheader.str(std::string());
+  ssheader << std::endl << "TIME 1 1 float" << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+  float timeBE = bigEndian(static_cast<float>(data->t));
+  WriteHeaderBinary(&timeBE, 1, fileHdl);
+
+  // Particle positions, in cartesian coordinates
+  ssheader.str(std::string());
+  ssheader << std::endl << "POINTS " << ntot << " float" << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+  std::vector<float> points(3*n);
+  for(int64_t p = 0 ; p < n ; p++) {
+    const real x1 = particles->xHost[IDIR][p];
+    const real x2 = particles->xHost[JDIR][p];
+    const real x3 = particles->xHost[KDIR][p];
+    real xc[3] = {x1, x2, x3};
+    #if GEOMETRY == POLAR
+      xc[0] = x1*std::cos(x2);
+      xc[1] = x1*std::sin(x2);
+    #elif GEOMETRY == SPHERICAL
+      #if DIMENSIONS == 1
+        xc[1] = 0;
+        xc[2] = 0;
+      #elif DIMENSIONS == 2
+        xc[0] = x1*std::sin(x2);
+        xc[1] = x1*std::cos(x2);
+        xc[2] = 0;
+      #elif DIMENSIONS == 3
+        xc[0] = x1*std::sin(x2)*std::cos(x3);
+        xc[1] = x1*std::sin(x2)*std::sin(x3);
+        xc[2] = x1*std::cos(x2);
+      #endif
+    #endif
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      points[3*p+dir] = bigEndian(static_cast<float>(xc[dir]));
+    }
+  }
+  WriteDistributed(points, 3, fileHdl);
+
+  // One vertex per particle
+  ssheader.str(std::string());
+  ssheader << std::endl << "VERTICES " << ntot << " " << 2*ntot << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+  std::vector<int32_t> vertices(2*n);
+  for(int64_t p = 0 ; p < n ; p++) {
+    vertices[2*p] = bigEndian(static_cast<int32_t>(1));
+    vertices[2*p+1] = bigEndian(static_cast<int32_t>(start+p));
+  }
+  WriteDistributed(vertices, 2, fileHdl);
+
+  ssheader.str(std::string());
+  ssheader << std::endl << "POINT_DATA " << ntot << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fileHdl);
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const std::string suffix = std::to_string(dir+1);
+    WriteScalar(particles->xHost[dir], "X"+suffix, fileHdl);
+  }
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const std::string suffix = std::to_string(dir+1);
+    WriteScalar(particles->vHost[dir], "VX"+suffix, fileHdl);
+  }
+  WriteScalar(particles->idHost, "id", fileHdl);
+  WriteScalar(particles->speciesHost, "species", fileHdl);
+
+#ifdef WITH_MPI
+  MPI_SAFE_CALL(MPI_File_close(&fileHdl));
+#else
+  fclose(fileHdl);
+#endif
+
+  vtkFileNumber++;
+  idfx::cout << "done in " << timer.seconds() << " s." << std::endl;
+
+  idfx::popRegion();
+  return(0);
+}
+
+// Write the contribution of each process, one after the other (ncomp values per particle)
+template <typename T>
+void VtkParticles::WriteDistributed(const std::vector<T> &buffer, int ncomp,
+                                    IdfxFileHandler fvtk) {
+#ifdef WITH_MPI
+  MPI_SAFE_CALL(MPI_File_set_view(fvtk, this->offset, MPI_BYTE, MPI_BYTE,
+                                  "native", MPI_INFO_NULL));
+  MPI_SAFE_CALL(MPI_File_write_at_all(fvtk, start*ncomp*sizeof(T), buffer.data(),
+                                      buffer.size()*sizeof(T), MPI_BYTE, MPI_STATUS_IGNORE));
+  this->offset += ntot*ncomp*sizeof(T);
+#else
+  if(fwrite(buffer.data(), sizeof(T), buffer.size(), fvtk) != buffer.size()) {
+    IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
+  }
+#endif
+}
+
+template <typename T>
+void VtkParticles::WriteScalar(const std::vector<T> &in, const std::string &name,
+                               IdfxFileHandler fvtk) {
+  std::stringstream ssheader;
+  ssheader << std::endl << "SCALARS " << name;
+  if constexpr(std::is_integral<T>::value) {
+    ssheader << " int" << std::endl;
+  } else {
+    ssheader << " float" << std::endl;
+  }
+  ssheader << "LOOKUP_TABLE default" << std::endl;
+  WriteHeaderString(ssheader.str().c_str(), fvtk);
+
+  if constexpr(std::is_integral<T>::value) {
+    std::vector<int32_t> buffer(in.size());
+    for(size_t p = 0 ; p < in.size() ; p++) buffer[p] = bigEndian(static_cast<int32_t>(in[p]));
+    WriteDistributed(buffer, 1, fvtk);
+  } else {
+    std::vector<float> buffer(in.size());
+    for(size_t p = 0 ; p < in.size() ; p++) buffer[p] = bigEndian(static_cast<float>(in[p]));
+    WriteDistributed(buffer, 1, fvtk);
+  }
+}
@@ -0,0 +1,40 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_VTKPARTICLES_HPP_
+#define OUTPUT_VTKPARTICLES_HPP_
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "vtk.hpp"
+
+// Forward class declaration
+class Particles;
+
+// Particles written as a vtk polydata file of vertices, with the particle fields as point data
+class VtkParticles : public BaseVtk {
+ public:
+  VtkParticles(Input &, DataBlock *, Particles *);
+  int Write();     // Create a VTK file of the particles
+
+ private:
+  Particles *particles;
+
+  int64_t ntot;    // total number of particles
+  int64_t start;   // index of the first particle of this process
+
+  template <typename T>
+  void WriteDistributed(const std::vector<T> &, int, IdfxFileHandler);
+  template <typename T>
+  void WriteScalar(const std::vector<T> &, const std::string &, IdfxFileHandler);
+
+  // output directory
+  fs::path outputDirectory;
+};
+
+#endif // OUTPUT_VTKPARTICLES_HPP_
@@ -6,9 +6,13 @@
 // ***********************************************************************************
 
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
+#include <limits>
 #include <mutex>    // NOLINT [build/c++11]
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "idefix.hpp"
@@ -35,6 +39,7 @@ extern "C" void kokkosp_allocate_data(const Kokkos_Profiling_SpaceHandle space,
   if(idfx::prof.spaceSize[space_i] > idfx::prof.spaceMax[space_i]) {
     idfx::prof.spaceMax[space_i] = idfx::prof.spaceSize[space_i];
   }
+  idfx::prof.RecordMemory(space_i);
 }
 
 
@@ -51,6 +56,7 @@ const char* label, const void* const ptr, const uint64_t size) {
     idfx::prof.numSpaces++;
   }
   idfx::prof.spaceSize[space_i] -= size;
+  idfx::prof.RecordMemory(space_i);
 }
 
 ///////////////////////////////////
@@ -69,8 +75,10 @@ void idfx::Profiler::Init() {
   Kokkos::Tools::Experimental::set_allocate_data_callback(&kokkosp_allocate_data);
   Kokkos::Tools::Experimental::set_deallocate_data_callback(&kokkosp_deallocate_data);
 
-  // Init region
-
+  #ifdef KERNEL_PROFILING
+  MeasureMachinePeak();
+  kernelProfilingEnabled = true;
+  #endif
 
   idfx::popRegion();
 }
@@ -106,16 +114,353 @@ void idfx::Profiler::Show() {
     rootRegion.Show(rootRegion.GetTimer());
     idfx::cout << "-------------------------------------------------------------------------------";
     idfx::cout << std::endl;
+    ShowRankStatistics();
     idfx::cout << "Profiler: end of performance profiling report." << std::endl;
   }
+  if(traceEnabled) {
+    WriteTrace();
+  }
+  #ifdef KERNEL_PROFILING
+  ShowKernels();
+  #endif
 }
 
 void idfx::Profiler::EnablePerformanceProfiling() {
+  if(perfEnabled) return;
   currentRegion = &rootRegion;
   rootRegion.Start();
   perfEnabled = true;
 }
 
+// Tracing records every region call (start time, duration, MPI activity) in a timeline
+// along with memory usage, which is written to a chrome trace file at the end of the run.
+void idfx::Profiler::EnableTracing() {
+  wallClock.reset();
+  traceEnabled = true;
+  EnablePerformanceProfiling();
+}
+
+double idfx::Profiler::GetWallClock() {
+  return wallClock.seconds();
+}
+
+void idfx::Profiler::RecordEvent(Region *region, double start, double duration,
+                                 double mpiTime, int64_t mpiBytes) {
+  if(static_cast<int64_t>(traceEvents.size()) >= maxTraceEvents) {
+    traceTruncated = true;
+    return;
+  }
+  traceEvents.push_back({region, start, duration, mpiTime, mpiBytes});
+}
+
+// Note: this is called from the Kokkos allocation hooks, which already hold the mutex
+void idfx::Profiler::RecordMemory(int space) {
+  if(!traceEnabled) return;
+  if(static_cast<int64_t>(traceMemory.size()) >= maxTraceEvents) {
+    traceTruncated = true;
+    return;
+  }
+  traceMemory.push_back({wallClock.seconds(), space, spaceSize[space]});
+}
+
+void idfx::Profiler::StartKernel(const std::string &name) {
+  if(!kernelProfilingEnabled) return;
+  Kokkos::fence();
+  currentKernel = name;
+  kernelTimer.reset();
+}
+
+void idfx::Profiler::StopKernel(int64_t nIterations) {
+  if(!kernelProfilingEnabled) return;
+  Kokkos::fence();
+  KernelStats &stats = kernels[currentKernel];
+  stats.time += kernelTimer.seconds();
+  stats.nCalls++;
+  stats.nIterations += nIterations;
+}
+
+void idfx::Profiler::SetKernelCost(const std::string &name, double bytes, double flops) {
+  KernelStats &stats = kernels[name];
+  stats.bytesPerIteration = bytes;
+  stats.flopsPerIteration = flops;
+}
+
+// Measure the bandwidth (STREAM triad) and the flop rate (register-only FMA chains)
+// achievable on the current execution space. When several MPI processes share a node,
+// they run simultaneously so that each process gets its share of the node bandwidth.
+void idfx::Profiler::MeasureMachinePeak() {
+  idfx::pushRegion("Profiler::MeasureMachinePeak");
+  const int n = 1 << 24;
+  const int nRepeat = 10;
+  constexpr int nChains = 8;
+  constexpr int nFma = 32;
+  IdefixArray1D<real> a("StreamA",n);
+  IdefixArray1D<real> b("StreamB",n);
+  IdefixArray1D<real> c("StreamC",n);
+  const real scalar = 3.0;
+
+  idefix_for("StreamInit",0,n,
+    KOKKOS_LAMBDA (int i) {
+      a(i) = ONE_F;
+      b(i) = TWO_F;
+      c(i) = ZERO_F;
+    });
+  Kokkos::fence();
+  #ifdef WITH_MPI
+  MPI_Barrier(MPI_COMM_WORLD);
+  #endif
+
+  Kokkos::Timer timer;
+  double bestTriad = std::numeric_limits<double>::max();
+  double bestFma = std::numeric_limits<double>::max();
+  for(int rep = 0 ; rep < nRepeat ; rep++) {
+    timer.reset();
+    idefix_for("StreamTriad",0,n,
+      KOKKOS_LAMBDA (int i) {
+        a(i) = b(i) + scalar*c(i);
+      });
+    Kokkos::fence();
+    bestTriad = std::min(bestTriad, timer.seconds());
+
+    timer.reset();
+    idefix_for("PeakFlops",0,n,
+      KOKKOS_LAMBDA (int i) {
+        real x[nChains];
+        const real y = b(i)*1e-3;
+        for(int m = 0 ; m < nChains ; m++) x[m] = a(i) + m;
+        for(int l = 0 ; l < nFma ; l++) {
+          for(int m = 0 ; m < nChains ; m++) x[m] = x[m]*y + HALF_F;
+        }
+        real sum = ZERO_F;
+        for(int m = 0 ; m < nChains ; m++) sum += x[m];
+        c(i) = sum;
+      });
+    Kokkos::fence();
+    bestFma = std::min(bestFma, timer.seconds());
+  }
+  peakBandwidth = 3.0*n*sizeof(real)/bestTriad;
+  peakFlops = 2.0*nChains*nFma*n/bestFma;
+
+  idfx::cout << "Profiler: measured peak bandwidth " << std::fixed << std::setprecision(1)
+             << peakBandwidth/1e9 << " GB/s and peak flop rate " << peakFlops/1e9
+             << " GFlop/s per process." << std::endl;
+  idfx::popRegion();
+}
+
+// Show the performance of each kernel, compared to the roofline built from the measured
+// machine peaks
+void idfx::Profiler::ShowKernels() {
+  std::vector<std::pair<std::string, KernelStats>> sorted(kernels.begin(), kernels.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::string, KernelStats> &k1,
+               const std::pair<std::string, KernelStats> &k2) {
+              return k1.second.time > k2.second.time;
+            });
+  double totTime = 0;
+  for(auto &it : sorted) totTime += it.second.time;
+  const double ridge = peakFlops/peakBandwidth;   // arithmetic intensity of the ridge point
+
+  idfx::cout << "Profiler: kernel performances (peak " << std::fixed << std::setprecision(1)
+             << peakBandwidth/1e9 << " GB/s, " << peakFlops/1e9 << " GFlop/s):" << std::endl;
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+  idfx::cout << "<total time>  <% of kernel time>  <number of calls>  <ns/iteration>  <GB/s>  "
+             << "<GFlop/s>  <% of roofline>  <bound>  <name>" << std::endl;
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+  for(auto &it : sorted) {
+    const KernelStats &k = it.second;
+    if(k.nCalls == 0) continue;
+    idfx::cout << std::scientific << std::setprecision(2) << k.time << " sec  "
+               << std::fixed << std::setprecision(1)
+               << (totTime > 0 ? k.time/totTime*100 : 0) << "%  "
+               << k.nCalls << "  ";
+    // Kernels launched on empty ranges (or too short to be timed) have no rate
+    if(k.nIterations == 0 || k.time <= 0) {
+      idfx::cout << "n/a  n/a  n/a  n/a  n/a  " << it.first << std::endl;
+      continue;
+    }
+    idfx::cout << std::setprecision(2) << k.time/k.nIterations*1e9 << "  ";
+    if(k.bytesPerIteration < 0) {
+      idfx::cout << "n/a  n/a  n/a  n/a  ";
+    } else {
+      const double bandwidth = k.bytesPerIteration*k.nIterations/k.time;
+      const double flops = k.flopsPerIteration*k.nIterations/k.time;
+      const double intensity = k.flopsPerIteration/k.bytesPerIteration;
+      const double attainable = std::min(peakFlops, intensity*peakBandwidth);
+      const double efficiency = (k.flopsPerIteration > 0 ? flops/attainable
+                                                          : bandwidth/peakBandwidth);
+      std::string bound;
+      if(efficiency < 0.1) {
+        bound = "latency";
+      } else if(intensity < ridge) {
+        bound = "memory";
+      } else {
+        bound = "compute";
+      }
+      idfx::cout << bandwidth/1e9 << "  " << flops/1e9 << "  "
+                 << std::setprecision(1) << efficiency*100 << "%  " << bound << "  ";
+    }
+    idfx::cout << it.first << std::endl;
+  }
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+}
+
+// Compute the min/avg/max of each region across MPI ranks. The region tree of rank 0 is used
+// as the reference, regions which are absent from a rank are counted with a zero time.
+void idfx::Profiler::ShowRankStatistics() {
+  if(idfx::psize == 1 && !traceEnabled) return;
+
+  std::vector<Region*> regions;
+  rootRegion.Flatten(regions);
+
+  // Collect the region paths of rank 0
+  std::string paths;
+  for(auto &it : regions) {
+    paths += it->GetPath() + "\n";
+  }
+  #ifdef WITH_MPI
+  int pathsSize = paths.size();
+  MPI_Bcast(&pathsSize, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  paths.resize(pathsSize);
+  MPI_Bcast(paths.data(), pathsSize, MPI_CHAR, 0, MPI_COMM_WORLD);
+  #endif
+
+  std::map<std::string, Region*> localRegions;
+  for(auto &it : regions) {
+    localRegions[it->GetPath()] = it;
+  }
+
+  std::vector<std::string> refPaths;
+  std::istringstream pathStream(paths);
+  for(std::string line ; std::getline(pathStream, line) ; ) {
+    refPaths.push_back(line);
+  }
+
+  const int nRegions = refPaths.size();
+  // local values: time, MPI time, number of calls
+  std::vector<double> localVal(3*nRegions, 0.0);
+  for(int n = 0 ; n < nRegions ; n++) {
+    if(localRegions.count(refPaths[n]) > 0) {
+      Region *r = localRegions[refPaths[n]];
+      localVal[3*n  ] = r->GetTimer();
+      localVal[3*n+1] = r->GetMpiTimer();
+      localVal[3*n+2] = static_cast<double>(r->GetNCalls());
+    }
+  }
+
+  // layout compatible with MPI_DOUBLE_INT
+  struct ValueRank {
+    double value;
+    int rank;
+  };
+  std::vector<double> minVal(localVal), sumVal(localVal);
+  std::vector<ValueRank> localMax(nRegions), maxVal(nRegions);
+  for(int n = 0 ; n < nRegions ; n++) {
+    localMax[n].value = localVal[3*n];
+    localMax[n].rank = idfx::prank;
+    maxVal[n] = localMax[n];
+  }
+  #ifdef WITH_MPI
+  MPI_Reduce(localVal.data(), minVal.data(), 3*nRegions, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+  MPI_Reduce(localVal.data(), sumVal.data(), 3*nRegions, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  MPI_Reduce(localMax.data(), maxVal.data(), nRegions, MPI_DOUBLE_INT, MPI_MAXLOC, 0,
+             MPI_COMM_WORLD);
+  #endif
+
+  if(idfx::psize > 1 && idfx::prank == 0) {
+    idfx::cout << "Profiler: statistics across " << idfx::psize << " MPI processes: " << std::endl;
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+    idfx::cout << "<min time>  <avg time>  <max time>  <slowest rank>  <imbalance %>  <name>";
+    idfx::cout << std::endl;
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+    for(int n = 0 ; n < nRegions ; n++) {
+      const double avg = sumVal[3*n]/idfx::psize;
+      for(int i = 0 ; i < regions[n]->level ; i++) {
+        idfx::cout << "|   ";
+      }
+      idfx::cout << "|-> " << std::scientific << std::setprecision(2)
+                 << minVal[3*n] << "  " << avg << "  " << maxVal[n].value << "  "
+                 << maxVal[n].rank << "  "
+                 << std::fixed << std::setprecision(1)
+                 << (avg > 0 ? (maxVal[n].value/avg-1.0)*100 : 0.0) << "%  "
+                 << regions[n]->name << std::endl;
+    }
+    idfx::cout << "-------------------------------------------------------------------------------";
+    idfx::cout << std::endl;
+  }
+
+  // Machine-readable version of the statistics
+  if(traceEnabled && idfx::prank == 0) {
+    std::ofstream file("idefix.profile.json", std::ios::trunc);
+    file << std::scientific << std::setprecision(6);
+    file << "{\"nproc\": " << idfx::psize << ", \"regions\": [" << std::endl;
+    for(int n = 0 ; n < nRegions ; n++) {
+      file << "  {\"path\": \"" << EscapeJson(refPaths[n]) << "\", "
+           << "\"calls\": " << static_cast<int64_t>(sumVal[3*n+2]/idfx::psize) << ", "
+           << "\"time_min\": " << minVal[3*n] << ", "
+           << "\"time_avg\": " << sumVal[3*n]/idfx::psize << ", "
+           << "\"time_max\": " << maxVal[n].value << ", "
+           << "\"time_max_rank\": " << maxVal[n].rank << ", "
+           << "\"mpi_min\": " << minVal[3*n+1] << ", "
+           << "\"mpi_avg\": " << sumVal[3*n+1]/idfx::psize << "}";
+      if(n < nRegions-1) file << ",";
+      file << std::endl;
+    }
+    file << "]}" << std::endl;
+    file.close();
+    idfx::cout << "Profiler: cross-rank statistics written to idefix.profile.json" << std::endl;
+  }
+}
+
+// Write the timeline of the current rank in the chrome trace event format
+// (can be loaded in chrome://tracing or https://ui.perfetto.dev)
+void idfx::Profiler::WriteTrace() {
+  std::stringstream filename;
+  filename << "idefix." << idfx::prank << ".trace.json";
+  std::ofstream file(filename.str(), std::ios::trunc);
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+  file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << idfx::prank
+       << ", \"args\": {\"name\": \"rank " << idfx::prank << "\"}}";
+
+  // Trace events are in microseconds
+  for(auto &ev : traceEvents) {
+    file << "," << std::endl;
+    file << "{\"name\": \"" << EscapeJson(ev.region->name) << "\", \"cat\": \"region\""
+         << ", \"ph\": \"X\", \"pid\": " << idfx::prank << ", \"tid\": 0"
+         << ", \"ts\": " << ev.start*1e6 << ", \"dur\": " << ev.duration*1e6
+         << ", \"args\": {\"mpi_time_us\": " << ev.mpiTime*1e6
+         << ", \"mpi_bytes\": " << ev.mpiBytes << "}}";
+  }
+  for(auto &mem : traceMemory) {
+    file << "," << std::endl;
+    file << "{\"name\": \"memory " << spaceName[mem.space] << "\", \"ph\": \"C\""
+         << ", \"pid\": " << idfx::prank << ", \"ts\": " << mem.time*1e6
+         << ", \"args\": {\"bytes\": " << mem.size << "}}";
+  }
+  file << std::endl << "]}" << std::endl;
+  file.close();
+
+  if(traceTruncated) {
+    IDEFIX_WARNING("Profiler: the trace exceeded the maximum number of events and was truncated");
+  }
+  idfx::cout << "Profiler: timeline written to " << filename.str() << std::endl;
+}
+
+std::string idfx::Profiler::EscapeJson(const std::string &in) {
+  std::string out;
+  for(auto c : in) {
+    if(c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out;
+}
+
 
 ///////////////////////////////////
 // Region functions definitions //
@@ -146,14 +491,58 @@ idfx::Region::~Region() {
 void idfx::Region::Start() {
   this->nCalls++;
   this->timer.reset();
+  this->mpiTimeStart = idfx::mpiCallsTimer;
+  this->mpiBytesStart = idfx::mpiCallsBytes;
+  if(idfx::prof.traceEnabled) {
+    this->startTime = idfx::prof.GetWallClock();
+  }
 }
 
 double idfx::Region::GetTimer() {
   return this->myTime;
 }
 
+double idfx::Region::GetMpiTimer() {
+  return this->mpiTime;
+}
+
+int64_t idfx::Region::GetMpiBytes() {
+  return this->mpiBytes;
+}
+
+int64_t idfx::Region::GetNCalls() {
+  return this->nCalls;
+}
+
 void idfx::Region::Stop() {
-  this->myTime += this->timer.seconds();
+  const double elapsed = this->timer.seconds();
+  const double mpiElapsed = idfx::mpiCallsTimer - this->mpiTimeStart;
+  const int64_t bytes = idfx::mpiCallsBytes - this->mpiBytesStart;
+  this->myTime += elapsed;
+  this->mpiTime += mpiElapsed;
+  this->mpiBytes += bytes;
+  if(idfx::prof.traceEnabled) {
+    idfx::prof.RecordEvent(this, this->startTime, elapsed, mpiElapsed, bytes);
+  }
+}
+
+std::string idfx::Region::GetPath() {
+  if(parent == nullptr) return this->name;
+  return parent->GetPath() + "/" + this->name;
+}
+
+void idfx::Region::Flatten(std::vector<Region*> &list) {
+  list.push_back(this);
+  if(!isLeaf) {
+    std::vector<Region*> sorted;
+    for( auto &it : this->children) {
+      sorted.push_back(it.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), this->Compare);
+    for( auto &it : sorted) {
+      it->Flatten(list);
+    }
+  }
 }
 
 idfx::Region * idfx::Region::GetChild(std::string name) {
@@ -11,6 +11,7 @@
 #include <map>
 #include <mutex>  // NOLINT [build/c++11]
 #include <string>
+#include <vector>
 
 namespace idfx {
 
@@ -31,6 +32,11 @@ class Region {
   void Show(double );
   Region* GetChild(std::string name);
   double GetTimer();
+  double GetMpiTimer();
+  int64_t GetMpiBytes();
+  int64_t GetNCalls();
+  std::string GetPath();
+  void Flatten(std::vector<Region*> &);     // list this region and all of its descendants
   static bool Compare(Region *, Region *);
   bool isLeaf{true};
   std::string name;
@@ -41,6 +47,36 @@ class Region {
   Kokkos::Timer timer;
   double myTime{0};
   int64_t nCalls{0};
+  double startTime{0};                      // time at which the region was last entered
+  double mpiTime{0};                        // time spent in MPI calls within this region
+  double mpiTimeStart{0};
+  int64_t mpiBytes{0};                      // bytes exchanged by MPI calls within this region
+  int64_t mpiBytesStart{0};
+};
+
+// A single event of the timeline recorded when tracing is enabled
+struct TraceEvent {
+  Region *region;
+  double start;     // start time (in seconds since tracing was enabled)
+  double duration;  // duration (in seconds)
+  double mpiTime;   // time spent in MPI calls during this event
+  int64_t mpiBytes; // bytes exchanged by MPI calls during this event
+};
+
+// Performance counters of a named kernel (only used with KERNEL_PROFILING)
+struct KernelStats {
+  int64_t nCalls{0};
+  int64_t nIterations{0};
+  double time{0};
+  double bytesPerIteration{-1};   // <0 when the kernel cost has not been declared
+  double flopsPerIteration{-1};
+};
+
+// A memory counter sample recorded when tracing is enabled
+struct TraceMemorySample {
+  double time;      // time of the sample (in seconds since tracing was enabled)
+  int space;        // index of the memory space
+  int64_t size;     // memory allocated in this space at that time
 };
 
 
@@ -49,6 +85,10 @@ class Profiler {
   void Init();
   void Show();
   void EnablePerformanceProfiling();
+  void EnableTracing();
+  void RecordEvent(Region *, double, double, double, int64_t);
+  void RecordMemory(int);
+  double GetWallClock();
   int numSpaces;
   int64_t spaceSize[16];
   int64_t spaceMax[16];
@@ -56,8 +96,33 @@ class Profiler {
   std::mutex m;
 
   bool perfEnabled{false};
+  bool traceEnabled{false};
   Region rootRegion;
   Region *currentRegion;
+
+  int64_t maxTraceEvents{10000000};     // maximum number of events kept in the timeline
+
+  // Kernel profiling
+  void StartKernel(const std::string &);
+  void StopKernel(int64_t);
+  void SetKernelCost(const std::string &, double, double);
+  double peakBandwidth{0};              // measured machine bandwidth (bytes/s)
+  double peakFlops{0};                  // measured machine flop rate (flop/s)
+ private:
+  void MeasureMachinePeak();
+  void ShowKernels();
+  std::map<std::string, KernelStats> kernels;
+  std::string currentKernel;
+  Kokkos::Timer kernelTimer;
+  bool kernelProfilingEnabled{false};
+
+  void ShowRankStatistics();            // min/avg/max of each region across MPI ranks
+  void WriteTrace();                    // write the timeline of the current rank
+  static std::string EscapeJson(const std::string &);
+  Kokkos::Timer wallClock;
+  std::vector<TraceEvent> traceEvents;
+  std::vector<TraceMemorySample> traceMemory;
+  bool traceTruncated{false};
 };
 
 
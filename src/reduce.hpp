@@ -26,8 +26,14 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    #ifdef KERNEL_PROFILING
+    idfx::pushKernel(NAME);
+    #endif
     Kokkos::parallel_reduce(NAME,
-      Kokkos::RangePolicy<>(IB,IE), function, redFunction);
+      Kokkos::RangePolicy<>(idfx::GetExecutionSpace(), IB, IE), function, redFunction);
+    #ifdef KERNEL_PROFILING
+    idfx::popKernel(static_cast<int64_t>(IE-IB));
+    #endif
     #ifdef DEBUG
     Kokkos::fence();
     idfx::popRegion();
@@ -44,12 +50,19 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    #ifdef KERNEL_PROFILING
+    idfx::pushKernel(NAME);
+    #endif
 
     // We only implement MDRange reductions here since the other implementations are too
     // complicated to be implemented for any reduction operator on any class
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({JB,IB},{JE,IE}), function, redFunction);
+        (idfx::GetExecutionSpace(), {JB,IB},{JE,IE}), function, redFunction);
+
+    #ifdef KERNEL_PROFILING
+    idfx::popKernel(static_cast<int64_t>(JE-JB)*(IE-IB));
+    #endif
 
     #ifdef DEBUG
     Kokkos::fence();
@@ -70,9 +83,16 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    #ifdef KERNEL_PROFILING
+    idfx::pushKernel(NAME);
+    #endif
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
+        (idfx::GetExecutionSpace(), {KB,JB,IB},{KE,JE,IE}), function, redFunction);
+
+    #ifdef KERNEL_PROFILING
+    idfx::popKernel(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
+    #endif
 
     #ifdef DEBUG
     Kokkos::fence();
@@ -94,9 +114,16 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    #ifdef KERNEL_PROFILING
+    idfx::pushKernel(NAME);
+    #endif
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<4, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
+        (idfx::GetExecutionSpace(), {NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
+
+    #ifdef KERNEL_PROFILING
+    idfx::popKernel(static_cast<int64_t>(NE-NB)*(KE-KB)*(JE-JB)*(IE-IB));
+    #endif
 
     #ifdef DEBUG
     Kokkos::fence();
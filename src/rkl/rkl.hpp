@@ -698,6 +698,7 @@ void RKLegendre<Phys>::LoopDir(real t) {
 template<typename Phys>
 void RKLegendre<Phys>::EvolveStage(real t) {
   idfx::pushRegion("RKLegendre::EvolveStage");
+  data->stageCount++;
 
   ResetStage();
 
@@ -7,8 +7,10 @@
 
 //#define WITH_TEMPERATURE_SENSOR
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
+#include <limits>
 #include <string>
 #include <vector>
 #include "idefix.hpp"
@@ -20,7 +22,7 @@
 #include "planetarySystem.hpp"
 
 
-TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
+TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data): diagnostics(input, data) {
   idfx::pushRegion("TimeIntegrator::TimeIntegrator(Input...)");
 
   this->timer.reset();
@@ -44,8 +46,8 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   this->cyclePeriod = input.GetOrSet<int>("Output","log",0, 100);
   this->maxRuntime = 3600*input.GetOrSet<double>("TimeIntegrator","max_runtime",0.0,-1.0);
 
-  // check nan periodicity every 100 loops
-  this->checkNanPeriodicity = input.GetOrSet<int>("TimeIntegrator","check_nan", 0, 100);
+  // check nans at every cycle (on the state at the end of the cycle)
+  this->checkNanPeriodicity = input.GetOrSet<int>("TimeIntegrator","check_nan", 0, 1);
 
   #ifndef SINGLE_PRECISION
     const real maxdivBDefault = 1e-6;
@@ -74,18 +76,23 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   if(data.hydro->haveRKLParabolicTerms) {
     haveRKL = true;
   }
+  if(data.hydro->haveImplicitParabolicTerms) {
+    haveImplicit = true;
+  }
 
   // If multi-stage, create a new state in the datablock called "begin"
   if(nstages>1) {
-    data.states["begin"] = StateContainer();
-    data.states["begin"].AllocateAs(data.states["current"]);
+    for(auto block : data.scheduler->blocks) {
+      block->states["begin"] = StateContainer();
+      block->states["begin"].AllocateAs(block->states["current"]);
+    }
   }
 
   idfx::popRegion();
 }
 
 
-void TimeIntegrator::ShowLog(DataBlock &data) {
+void TimeIntegrator::ShowLog(DataBlock &data, real t, real dt) {
   if(isSilent) return;
   double rawperf = (timer.seconds()-lastLog)/data.mygrid->np_int[IDIR]/data.mygrid->np_int[JDIR]
                       /data.mygrid->np_int[KDIR]/cyclePeriod * idfx::psize;
@@ -122,9 +129,15 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 #if MHD == YES
     idfx::cout << " | " << std::setw(col_width) << "div B";
 #endif
+    for(auto const &name : diagnostics.scalarNames) {
+      idfx::cout << " | " << std::setw(col_width) << name;
+    }
     if(haveRKL) {
       idfx::cout << " | " << std::setw(col_width) << "RKL stages";
     }
+    if(haveImplicit) {
+      idfx::cout << " | " << std::setw(col_width) << "Implicit iter.";
+    }
     if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
       idfx::cout << " | " << std::setw(col_width) << "SG iterations";
       idfx::cout << " | " << std::setw(col_width) << "SG error";
@@ -139,9 +152,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   #endif
   idfx::cout << "TimeIntegrator: ";
   idfx::cout << std::scientific;
-  idfx::cout << std::setw(col_width) << data.t;
+  idfx::cout << std::setw(col_width) << t;
   idfx::cout << " | " << std::setw(col_width) << ncycles;
-  idfx::cout << " | " << std::setw(col_width) << data.dt;
+  idfx::cout << " | " << std::setw(col_width) << dt;
   if(ncycles>=cyclePeriod) {
     idfx::cout << " | " << std::setw(col_width) << 1 / rawperf;
 #ifdef WITH_MPI
@@ -164,7 +177,7 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 
 #if MHD == YES
   // Check divB
-  real divB =  data.hydro->CheckDivB();
+  real divB = diagnostics.divB;
   idfx::cout << std::scientific;
   idfx::cout << " | " << std::setw(col_width) << divB;
 
@@ -174,9 +187,16 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     throw std::runtime_error(msg.str());
   }
 #endif
+  idfx::cout << std::scientific;
+  for(auto const &value : diagnostics.scalars) {
+    idfx::cout << " | " << std::setw(col_width) << value;
+  }
   if(haveRKL) {
     idfx::cout << " | " << std::setw(col_width) << data.hydro->rkl->stage;
   }
+  if(haveImplicit) {
+    idfx::cout << " | " << std::setw(col_width) << data.hydro->implicit->niter;
+  }
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
     if(ncycles>=cyclePeriod) {
       idfx::cout << " | " << std::setw(col_width) << data.gravity->selfGravity.nsteps;
@@ -243,122 +263,121 @@ double TimeIntegrator::ComputeBalance() {
 }
 
 // Compute one full cycle of the time Integrator
+// The stages are applied to each block of the process (see BlockScheduler), which is the
+// process DataBlock itself unless [Grid]:dataBlocks is set.
 void TimeIntegrator::Cycle(DataBlock &data) {
   // Do one cycle
-  IdefixArray3D<real> InvDt = data.hydro->InvDt;
+  BlockScheduler &scheduler = *data.scheduler;
   real newdt;
 
   idfx::pushRegion("TimeIntegrator::Cycle");
 
-  if(ncycles%cyclePeriod==0) ShowLog(data);
+  data.cycleCount = ncycles;
+  const bool logCycle = (ncycles%cyclePeriod==0);
+  const bool checkNan = (ncycles%checkNanPeriodicity==0);
 
   // Launch user step before everything
-  data.LaunchUserStepFirst();
+  scheduler.ForEach([&](DataBlock &block) {
+    block.t = data.t;
+    block.dt = data.dt;
+    block.cycleCount = ncycles;
+    block.LaunchUserStepFirst();
+  });
 
   if(haveRKL && (ncycles%2)==1) {    // Runge-Kutta-Legendre cycle
     data.EvolveRKLStage();
   }
+  if(haveImplicit && (ncycles%2)==1) {    // Implicit parabolic step
+    data.EvolveImplicitStage();
+  }
 
   // save t at the begining of the cycle
   const real t0 = data.t;
 
   // Reinit datablock for a new stage
-  data.ResetStage();
+  scheduler.ForEach([](DataBlock &block) { block.ResetStage(); });
 
-#ifdef WITH_MPI
-  MPI_Request dtReduce;
-#endif
+  // When the blocks overlap, their kernels are not fenced so that the compute time is only
+  // accurate on host backends
+  const bool fenceCompute = (scheduler.nblocks == 1);
 
   /////////////////////////////////////////////////
   // BEGIN STAGES LOOP                           //
   /////////////////////////////////////////////////
   for(int stage=0; stage < nstages ; stage++) {
-    // Apply Boundary conditions
-    data.SetBoundaries();
+    // Apply Boundary conditions, and start evolving each block once its boundaries are set
+    scheduler.SetBoundaries([&](DataBlock &block) {
+      // Remove Fargo velocity so that the integrator works on the residual
+      if(block.haveFargo) block.fargo->SubstractVelocity(block.t);
 
-    // Remove Fargo velocity so that the integrator works on the residual
-    if(data.haveFargo) data.fargo->SubstractVelocity(data.t);
+      // Push the particles once per step, in the gas velocity field at the beginning of the step
+      if(block.haveParticles && stage==0) block.particles->Evolve(block.t, block.dt);
 
-    // Convert current state into conservative variable and save it
-    data.PrimToCons();
-
-    // Store (deep copy) initial stage for multi-stage time integrators
-    if(nstages>1 && stage==0) {
-      data.states["begin"].CopyFrom(data.states["current"]);
-    }
-    // If gravity is needed, update it
-    if(data.haveGravity) {
-      if(ncycles % data.gravity->skipGravity == 0) data.gravity->ComputeGravity(ncycles);
-    }
+      // Convert current state into conservative variable and save it
+      block.PrimToCons();
 
-    Kokkos::fence();
-    computeLastLog -= timer.seconds();
-    // Update Uc & Vs
-    data.EvolveStage();
-    Kokkos::fence();
-    computeLastLog += timer.seconds();
-
-    // evolve dt accordingly
-    data.t += data.dt;
-
-    // Look for Nans every now and then (this actually cost a lot of time on GPUs
-    // because streams are divergent)
-    if(ncycles%checkNanPeriodicity==0) {
-      if(data.CheckNan()>0) {
-        throw std::runtime_error(std::string("Nan found after integration cycle"));
+      // Store (deep copy) initial stage for multi-stage time integrators
+      if(nstages>1 && stage==0) {
+        block.states["begin"].CopyFrom(block.states["current"]);
       }
-    }
-
-    // Compute next time_step during first stage
-    if(stage==0) {
-      if(!haveFixedDt) {
-        newdt = cfl*data.ComputeTimestep();
-        #ifdef WITH_MPI
-          if(idfx::psize>1) {
-            MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN, MPI_COMM_WORLD,
-                                        &dtReduce));
-          }
-        #endif
+      // If gravity is needed, update it
+      if(block.haveGravity) {
+        if(ncycles % block.gravity->skipGravity == 0) block.gravity->ComputeGravity(ncycles);
       }
+
+      if(fenceCompute) Kokkos::fence();
+      computeLastLog -= timer.seconds();
+      // Update Uc & Vs
+      block.EvolveStage();
+      if(fenceCompute) Kokkos::fence();
+      computeLastLog += timer.seconds();
+
+      // evolve dt accordingly
+      block.t += block.dt;
+    });
+
+    // Reduce the diagnostics of the first stage (its time step in particular), the MPI
+    // reduction overlapping the next stages unless it waits for the Nans of the end of the cycle
+    if(stage==0 && (!haveFixedDt || logCycle)) {
+      diagnostics.Reduce(data, true, false, logCycle);
+      if(!checkNan) diagnostics.Start();
     }
 
-    // Is this not the first stage?
-    if(stage>0) {
-      // do the partial evolution required by the multi-step
-      real wcs=wc[stage-1];
-      real w0s=w0[stage-1];
-      data.states["current"].AddAndStore(wcs, w0s, data.states["begin"]);
+    scheduler.ForEach([&](DataBlock &block) {
+      // Is this not the first stage?
+      if(stage>0) {
+        // do the partial evolution required by the multi-step
+        real wcs=wc[stage-1];
+        real w0s=w0[stage-1];
+        block.states["current"].AddAndStore(wcs, w0s, block.states["begin"]);
 
-      // update t
-      data.t = wcs*data.t + w0s*t0;
-    }
-    // Shift solution according to fargo if this is our last stage
-    if(data.haveFargo && stage==nstages-1) {
-      data.fargo->ShiftSolution(t0,data.dt);
-    }
+        // update t
+        block.t = wcs*block.t + w0s*t0;
+      }
+      // Shift solution according to fargo if this is our last stage
+      if(block.haveFargo && stage==nstages-1) {
+        block.fargo->ShiftSolution(t0,block.dt);
+      }
 
-    // Coarsen conservative variables once they have been evolved
-    if(data.haveGridCoarsening) {
-      data.Coarsen();
-    }
+      // Coarsen conservative variables once they have been evolved
+      if(block.haveGridCoarsening) {
+        block.Coarsen();
+      }
 
-    // Back to using Vc
-    data.ConsToPrim();
+      // Back to using Vc
+      block.ConsToPrim();
 
-    // Add back fargo velocity so that boundary conditions are applied on the total V
-    if(data.haveFargo) data.fargo->AddVelocity(data.t);
+      // Add back fargo velocity so that boundary conditions are applied on the total V
+      if(block.haveFargo) block.fargo->AddVelocity(block.t);
+    });
   }
   /////////////////////////////////////////////////
   // END STAGES LOOP                             //
   /////////////////////////////////////////////////
 
-  // Wait for dt MPI reduction
-#ifdef WITH_MPI
-  if(!haveFixedDt && idfx::psize>1) {
-    MPI_SAFE_CALL(MPI_Wait(&dtReduce, MPI_STATUS_IGNORE));
+  if(haveImplicit && (ncycles%2)==0) {    // Implicit parabolic step
+    data.EvolveImplicitStage();
   }
-#endif
-
   if(haveRKL && (ncycles%2)==0) {    // Runge-Kutta-Legendre cycle
     data.EvolveRKLStage();
   }
@@ -368,17 +387,35 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.planetarySystem->EvolveSystem(data, data.dt);
   }
 
-  // Coarsen the grid
-  if(data.haveGridCoarsening) {
-    data.Coarsen();
-  }
+  scheduler.ForEach([&](DataBlock &block) {
+    // Coarsen the grid
+    if(block.haveGridCoarsening) {
+      block.Coarsen();
+    }
 
-  // Launch user step last
-  data.LaunchUserStepLast();
+    // Launch user step last
+    block.LaunchUserStepLast();
 
-  // Update current time (should have already been done, but this gets rid of roundoff errors)
+    // Update current time (should have already been done, but this gets rid of roundoff errors)
+    block.t=t0+data.dt;
+  });
   data.t=t0+data.dt;
 
+  // Count the Nans of the state at the end of the cycle, so that they are caught in the cycle
+  // which produced them, and wait for the diagnostics MPI reduction
+  if(checkNan) {
+    diagnostics.Reduce(data, false, true, false);
+    diagnostics.Start();
+  }
+  diagnostics.Wait();
+  if(checkNan && diagnostics.nNans>0) {
+    // Show where the Nans are
+    scheduler.ForEach([](DataBlock &block) { block.CheckNan(); });
+    throw std::runtime_error(std::string("Nan found after integration cycle"));
+  }
+  if(!haveFixedDt) newdt = cfl*diagnostics.dt;
+  if(logCycle) ShowLog(data, t0, data.dt);
+
   if(haveRKL) {
     // update next time step
     real tt = newdt/data.hydro->rkl->dt;
@@ -407,6 +444,8 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.dt = fixedDt;
   }
 
+  // The process DataBlock is gathered from the blocks when an output needs it
+  scheduler.SetEvolved();
 
   ncycles++;
 
@@ -10,6 +10,7 @@
 
 #include "idefix.hpp"
 #include "dataBlock.hpp"
+#include "diagnostics.hpp"
 #include "rkl.hpp"
 
 
@@ -27,7 +28,7 @@ class TimeIntegrator {
   // check whether we have reached the maximum runtime
   bool CheckForMaxRuntime();
 
-  void ShowLog(DataBlock &);    //<  Display progress log
+  void ShowLog(DataBlock &, real, real);    //<  Display progress log (of a cycle at t, dt)
   void ShowConfig();            //< Show configuration of time integrator
 
   bool isSilent{false};   // Whether the integration should proceed silently
@@ -38,6 +39,9 @@ class TimeIntegrator {
   // Whether we have RKL
   bool haveRKL{false};
 
+  // Whether we have implicit parabolic terms
+  bool haveImplicit{false};
+
   int nstages;
   // Weights of time integrator
   real w0[2];
@@ -45,6 +49,8 @@ class TimeIntegrator {
 
   int checkNanPeriodicity{1};
 
+  Diagnostics diagnostics;  // time step, Nans, div B and log scalars
+
   bool haveFixedDt = false;
   real fixedDt;
 
@@ -33,9 +33,9 @@ class BigEndian {
       this->shouldSwapEndian = true;
   }
 
-  // Swap when needed
+  // Swap when needed (also usable in device kernels)
   template <class T>
-  T operator() (T in_number) {
+  KOKKOS_INLINE_FUNCTION T operator() (T in_number) const {
     static_assert(std::is_arithmetic_v<T> == true);
     T out_number;
     if (this->shouldSwapEndian) {
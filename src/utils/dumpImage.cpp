@@ -5,7 +5,9 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
 #include <string>
+#include <vector>
 #include <cstdio>
 #include "dumpImage.hpp"
 #include "dataBlock.hpp"
@@ -14,7 +16,9 @@
 
 #define  HEADERSIZE 128
 
-DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDecomposition) {
+DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDecomposition,
+                     const std::vector<std::string> &fields):
+                     enableDomainDecomposition{enableDomainDecomposition}, fields{fields} {
   idfx::pushRegion("DumpImage::DumpImage");
 
   int nx[3];
@@ -42,16 +46,20 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
   }
 #endif
 
+  // Use the field index of the dump when there is one
+  dump.ReadIndex(fileHdl);
+
   // skip the header
 #ifdef WITH_MPI
-  dump.offset += HEADERSIZE;
+  dump.offset = HEADERSIZE;
 #else
   fseek(fileHdl, HEADERSIZE, SEEK_SET);
 #endif
 
   // First thing is to load the total domain size
   for(int dir=0 ; dir < 3; dir++) {
-    dump.ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
+    const std::string suffix = std::to_string(dir+1);
+    dump.LocateField(fileHdl, "x"+suffix, ndim, nx, type);
     if(ndim>1) IDEFIX_ERROR("Wrong coordinate array dimensions while reading restart dump");
     // Store the size of the array
     this->np_int[dir] = nx[0];
@@ -63,13 +71,13 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
 
     // Read coordinates
     dump.ReadSerial(fileHdl, ndim, nx, type, reinterpret_cast<void*>( this->x[dir].data()) );
-    dump.ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
+    dump.LocateField(fileHdl, "xl"+suffix, ndim, nx, type);
     dump.ReadSerial(fileHdl, ndim, nx, type, reinterpret_cast<void*>( this->xl[dir].data()) );
-    dump.ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
+    dump.LocateField(fileHdl, "xr"+suffix, ndim, nx, type);
     dump.ReadSerial(fileHdl, ndim, nx, type, reinterpret_cast<void*>( this->xr[dir].data()) );
   }
 
-  if(enableDomainDecomposition) {
+  if(this->enableDomainDecomposition) {
     #ifdef WITH_MPI
       GridBox gridBox = GetBox(data);
       // Create sub-x domains
@@ -92,86 +100,28 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
       dump.CreateMPIDataType(gridBox, true);
     #else
       IDEFIX_WARNING("Can't create a DumpImage with domain decomposition without MPI enabled");
-      enableDomainDecomposition = false;
+      this->enableDomainDecomposition = false;
     #endif
   }
 
   // Read the other fields
-  while(true) {
-    dump.ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
-    if(fieldName.compare(eof) == 0) {
-      break;
-    } else if( ndim == 3) {
-      // Load 3D field (raw data)
-      // Make a new view of the right dimension for the raw data
-
-      if(enableDomainDecomposition) {
-        int nxloc[3];
-        int nType = 0;  // = 0 for cell-centered; = 1 for face-centered, =2 for edge-centered
-        int edgeDir = -1;
-        int surfaceDir = -1;
-        for(int dir = 0 ; dir < 3; dir++) {
-          nxloc[dir] = this->np_int[dir];
-          // Try to guess whether it's an edge or surface array depending on the extension
-          // Surface: only one direction has +1 point, and it is the direction of the field
-          // Edge: 2 directions with +1 point, the direction is that without +1
-          if(nx[dir]==np_glob[dir]+1) {
-            if(nType==0) {
-              // This is either a surface or edge field
-              // probably a surface
-              surfaceDir = dir;
-              // or an edge
-              if(dir==JDIR) {
-                edgeDir = IDIR;
-              }
-            } else {
-              // surely an edge
-              if(dir == JDIR) {
-                edgeDir = KDIR;
-              } else if(dir==KDIR && surfaceDir == -1) {
-                edgeDir = JDIR;
-              }
-            }
-            nType++;
-            nxloc[dir]++;
-          }
-        }
-        // Allocate an array of the right size
-        this->arrays[fieldName] = IdefixHostArray3D<real>
-                                    ("DumpImage"+fieldName,nxloc[2],nxloc[1],nxloc[0] );
-
-        // load the data
-        if(nType==0) {
-          dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descCR,
-                              reinterpret_cast<void*>(this->arrays[fieldName].data()) );
-        } else if(nType==1) {
-          // Edge type
-          dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descSR[surfaceDir],
-                              reinterpret_cast<void*>(this->arrays[fieldName].data()) );
-        } else if(nType==2) {
-          dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descER[edgeDir],
-                              reinterpret_cast<void*>(this->arrays[fieldName].data()) );
-        }
+  if(dump.indexed) {
+    // Positioned reads of the requested fields only
+    for(auto const &[name, entry] : dump.fileIndex) {
+      if(!IsRequested(name, entry.ndim)) continue;
+      dump.LocateField(fileHdl, name, ndim, nx, type);
+      ReadField(dump, fileHdl, name, ndim, nx, type);
+    }
+  } else {
+    while(true) {
+      dump.ReadNextFieldProperties(fileHdl, ndim, nx, type, fieldName);
+      if(fieldName.compare(eof) == 0) {
+        break;
+      } else if(IsRequested(fieldName, ndim)) {
+        ReadField(dump, fileHdl, fieldName, ndim, nx, type);
       } else {
-        this->arrays[fieldName] = IdefixHostArray3D<real>("DumpImage"+fieldName,nx[2],nx[1],nx[0]);
-        // Load it
-        dump.ReadSerial(fileHdl,ndim,nx,type,
-                        reinterpret_cast<void*>(this->arrays[fieldName].data()));
+        dump.Skip(fileHdl, ndim, nx, type);
       }
-    } else if(fieldName.compare("time") == 0) {
-      dump.ReadSerial(fileHdl, ndim, nx, type, &this->time);
-    } else if(fieldName.compare("geometry")==0) {
-      dump.ReadSerial(fileHdl, ndim, nx, type, &this->geometry);
-    } else if(fieldName.compare("centralMass")==0) {
-      dump.ReadSerial(fileHdl, ndim, nx, type, &this->centralMass);
-    } else {
-      int size=sizeof(double);
-      for(int dim =0 ; dim<ndim ; dim++) {
-        size = size*nx[dim];
-      }
-      double *scrch = new double[size];
-      dump.ReadSerial(fileHdl,ndim, nx, type, scrch);
-      delete[] scrch;
     }
   }
   // Close file
@@ -187,6 +137,83 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
   idfx::popRegion();
 }
 
+bool DumpImage::IsRequested(const std::string &name, int ndim) {
+  if(ndim == 3) {
+    return(fields.empty() || std::find(fields.begin(), fields.end(), name) != fields.end());
+  }
+  return(name.compare("time") == 0 || name.compare("geometry") == 0
+         || name.compare("centralMass") == 0);
+}
+
+// Load a field, the file being positioned on its raw data
+void DumpImage::ReadField(Dump &dump, IdfxFileHandler fileHdl, const std::string &fieldName,
+                          int ndim, int *nx, DataType type) {
+  if( ndim == 3) {
+    // Load 3D field (raw data)
+    // Make a new view of the right dimension for the raw data
+
+    if(enableDomainDecomposition) {
+      int nxloc[3];
+      int nType = 0;  // = 0 for cell-centered; = 1 for face-centered, =2 for edge-centered
+      int edgeDir = -1;
+      int surfaceDir = -1;
+      for(int dir = 0 ; dir < 3; dir++) {
+        nxloc[dir] = this->np_int[dir];
+        // Try to guess whether it's an edge or surface array depending on the extension
+        // Surface: only one direction has +1 point, and it is the direction of the field
+        // Edge: 2 directions with +1 point, the direction is that without +1
+        if(nx[dir]==np_glob[dir]+1) {
+          if(nType==0) {
+            // This is either a surface or edge field
+            // probably a surface
+            surfaceDir = dir;
+            // or an edge
+            if(dir==JDIR) {
+              edgeDir = IDIR;
+            }
+          } else {
+            // surely an edge
+            if(dir == JDIR) {
+              edgeDir = KDIR;
+            } else if(dir==KDIR && surfaceDir == -1) {
+              edgeDir = JDIR;
+            }
+          }
+          nType++;
+          nxloc[dir]++;
+        }
+      }
+      // Allocate an array of the right size
+      this->arrays[fieldName] = IdefixHostArray3D<real>
+                                  ("DumpImage"+fieldName,nxloc[2],nxloc[1],nxloc[0] );
+
+      // load the data
+      if(nType==0) {
+        dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descCR,
+                            reinterpret_cast<void*>(this->arrays[fieldName].data()) );
+      } else if(nType==1) {
+        // Edge type
+        dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descSR[surfaceDir],
+                            reinterpret_cast<void*>(this->arrays[fieldName].data()) );
+      } else if(nType==2) {
+        dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descER[edgeDir],
+                            reinterpret_cast<void*>(this->arrays[fieldName].data()) );
+      }
+    } else {
+      this->arrays[fieldName] = IdefixHostArray3D<real>("DumpImage"+fieldName,nx[2],nx[1],nx[0]);
+      // Load it
+      dump.ReadSerial(fileHdl,ndim,nx,type,
+                      reinterpret_cast<void*>(this->arrays[fieldName].data()));
+    }
+  } else if(fieldName.compare("time") == 0) {
+    dump.ReadSerial(fileHdl, ndim, nx, type, &this->time);
+  } else if(fieldName.compare("geometry")==0) {
+    dump.ReadSerial(fileHdl, ndim, nx, type, &this->geometry);
+  } else if(fieldName.compare("centralMass")==0) {
+    dump.ReadSerial(fileHdl, ndim, nx, type, &this->centralMass);
+  }
+}
+
 GridBox DumpImage::GetBox(DataBlock *data) {
   GridBox gridBox;
   for(int dir = 0 ; dir < 3 ; dir ++) {
@@ -9,6 +9,7 @@
 #define UTILS_DUMPIMAGE_HPP_
 #include <string>
 #include <map>
+#include <vector>
 #include "idefix.hpp"
 #include "dump.hpp"
 
@@ -16,7 +17,8 @@ class DataBlock;
 
 class DumpImage {
  public:
-  DumpImage(std::string, DataBlock *, bool = false); // By default, no domain decomposition
+  // By default, no domain decomposition and all of the 3D arrays are loaded
+  DumpImage(std::string, DataBlock *, bool = false, const std::vector<std::string> & = {});
 
   int np_int[3];               // number of local points in each direction
   int np_glob[3];               // number of global points in each direction
@@ -30,6 +32,11 @@ class DumpImage {
   std::map<std::string,IdefixHostArray3D<real>> arrays;  // 3D arrays stored in the dump
  private:
   GridBox GetBox(DataBlock *);
+  bool IsRequested(const std::string &, int);
+  void ReadField(Dump &, IdfxFileHandler, const std::string &, int, int *, DataType);
+
+  bool enableDomainDecomposition;
+  std::vector<std::string> fields;    // 3D arrays to be loaded (all of them if empty)
 };
 
 #endif // UTILS_DUMPIMAGE_HPP_
@@ -8,6 +8,7 @@
 #ifndef UTILS_LOOKUPTABLE_HPP_
 #define UTILS_LOOKUPTABLE_HPP_
 
+#include <cmath>
 #include <string>
 #include <vector>
 #include "idefix.hpp"
@@ -40,6 +41,46 @@ class LookupTable {
 
   bool errorIfOutOfBound{true};
 
+  // Spacing of the coordinates along each axis, detected when the table is built.
+  // The interval of uniform and log-uniform axes is computed directly, while a binary
+  // search is used for arbitrary axes.
+  enum AxisType {uniform, logUniform, arbitrary};
+  AxisType axisType[kDim]{};
+  real axisStart[kDim]{};       // first coordinate (or its log) of (log-)uniform axes
+  real axisInvDelta[kDim]{};    // inverse of the spacing (or of the log spacing)
+
+  // Interpolation scheme. Cubic interpolation uses the 4 closest points along each axis
+  // (Lagrange polynomials), and reverts to linear interpolation on axes with less than 4 points.
+  enum Interpolation {linear, cubic};
+  Interpolation interpolation{linear};
+
+  // Index i of the interval [xin(i), xin(i+1)] which contains x_n along axis n
+  template<typename Tint, typename Treal>
+  KOKKOS_INLINE_FUNCTION
+  int FindIndex(const int n, const real x_n, Tint &dimensions, Tint &offset, Treal &xin) const {
+    const int nx = dimensions(n);
+    const int off = offset(n);
+    int i = 0;
+    if(axisType[n] == arbitrary) {
+      // Binary search of the last of the nx-1 first elements which is <= x_n. The number
+      // of iterations only depends on nx, so that neighbouring threads don't diverge.
+      int len = nx-1;
+      while(len > 1) {
+        const int half = len/2;
+        i = (xin(off+i+half) <= x_n) ? i+half : i;
+        len -= half;
+      }
+      return(i);
+    }
+    const real s = (axisType[n] == logUniform) ? std::log(x_n) : x_n;
+    i = static_cast<int>((s - axisStart[n])*axisInvDelta[n]);
+    i = (i < 0) ? 0 : ((i > nx-2) ? nx-2 : i);
+    // Correct the roundoff errors of the coordinates
+    if(i > 0 && xin(off+i) > x_n) i--;
+    if(i < nx-2 && xin(off+i+1) < x_n) i++;
+    return(i);
+  }
+
   // Generic getter for all kinds of input arrays
   template<typename Tint, typename Treal>
   KOKKOS_INLINE_FUNCTION
@@ -47,6 +88,7 @@ class LookupTable {
   // Fetch function that should be called inside idefix_loop
     int idx[kDim];
     real delta[kDim];
+    real xc[kDim];
 
     for(int n = 0 ; n < kDim ; n++) {
       real xstart = xin(offset(n));
@@ -55,7 +97,6 @@ class LookupTable {
 
       if(std::isnan(x_n)) return(NAN);
 
-      // Compute index of closest element assuming even distribution
       int i;
 
        // Check that we're within bounds
@@ -76,29 +117,20 @@ class LookupTable {
           x_n = xend;
         }
       } else {
-        // Bounds are fine,
-        i = static_cast<int> ( (x_n - xstart) / (xend - xstart) * (dimensions(n)-1));
-        if(i == dimensions(n)-1) i = dimensions(n)-2;
-        // Check if resulting bounding elements are correct
-        if(xin(offset(n) + i) > x_n || xin(offset(n) + i+1) < x_n) {
-          // Nop, so the points are not evenly distributed
-          // Search for the correct index (a dicotomy would be more appropriate...)
-
-          i = 0;
-          while(xin(offset(n) + i) < x_n && i < dimensions(n)-1 ) {
-            i++;
-          }
-          i = i-1; // i is overestimated by one
-        }
+        // Bounds are fine
+        i = FindIndex(n, x_n, dimensions, offset, xin);
       }
 
       // Store the index
       idx[n] = i;
+      xc[n] = x_n;
 
       // Store the elementary ratio
       delta[n] = (x_n - xin(offset(n) + i) ) / (xin(offset(n) + i+1) - xin(offset(n) + i));
     }
 
+    if(interpolation == cubic) return(GetCubic(xc, idx, delta, dimensions, offset, xin, data));
+
     // De a linear interpolation from the neightbouring points to get our value.
     real value = 0;
 
@@ -126,6 +158,59 @@ class LookupTable {
     return(value);
   }
 
+  // Tensor product of the 1D cubic Lagrange interpolations around x
+  template<typename Tint, typename Treal>
+  KOKKOS_INLINE_FUNCTION
+  real GetCubic(const real x[kDim], const int idx[kDim], const real delta[kDim],
+                Tint &dimensions, Tint &offset, Treal &xin, Treal &data) const {
+    int first[kDim];
+    int width[kDim];
+    real w[kDim][4];
+    int nvertices = 1;
+
+    for(int n = 0 ; n < kDim ; n++) {
+      const int nx = dimensions(n);
+      if(nx < 4) {
+        first[n] = idx[n];
+        width[n] = 2;
+        w[n][0] = 1-delta[n];
+        w[n][1] = delta[n];
+      } else {
+        // Stencil centred on the interval, shifted at the edges of the table
+        int i0 = idx[n]-1;
+        i0 = (i0 < 0) ? 0 : ((i0 > nx-4) ? nx-4 : i0);
+        first[n] = i0;
+        width[n] = 4;
+        for(int p = 0 ; p < 4 ; p++) {
+          const real xp = xin(offset(n)+i0+p);
+          real weight = 1.0;
+          for(int q = 0 ; q < 4 ; q++) {
+            if(q == p) continue;
+            const real xq = xin(offset(n)+i0+q);
+            weight *= (x[n] - xq)/(xp - xq);
+          }
+          w[n][p] = weight;
+        }
+      }
+      nvertices *= width[n];
+    }
+
+    real value = 0;
+    for(int v = 0 ; v < nvertices ; v++) {
+      int index = 0;
+      real weight = 1.0;
+      int rem = v;
+      for(int m = 0 ; m < kDim ; m++) {
+        const int p = rem % width[m];
+        rem = rem / width[m];
+        index = index * dimensions(m) + first[m] + p;
+        weight = weight*w[m][p];
+      }
+      value = value + weight*data(index);
+    }
+    return(value);
+  }
+
   // Getter on device
   KOKKOS_INLINE_FUNCTION
   real Get(const real x[kDim]) const {
@@ -137,14 +222,74 @@ class LookupTable {
   real GetHost(const real x[kDim]) const {
     return(Get(x, dimensionsHost, offsetHost, xinHost, dataHost));
   }
+
+ private:
+  void InitAxes();    // detect the spacing of each axis
 };
 
+template <int kDim>
+void LookupTable<kDim>::InitAxes() {
+  // Relative tolerance on the spacing. The index computed on a (log-)uniform axis is then
+  // at most one interval away from the correct one, which is corrected in FindIndex().
+  const real tolerance = 1e-2;
+
+  for(int n = 0 ; n < kDim ; n++) {
+    const int nx = dimensionsHost(n);
+    const int off = offsetHost(n);
+    if(nx < 2) {
+      IDEFIX_ERROR("LookupTable: each coordinate should have at least 2 elements");
+    }
+    for(int i = 0 ; i < nx-1 ; i++) {
+      if(xinHost(off+i+1) <= xinHost(off+i)) {
+        std::stringstream msg;
+        msg << "LookupTable: the coordinates of dimension " << n+1
+            << " should be strictly increasing" << std::endl;
+        IDEFIX_ERROR(msg);
+      }
+    }
+
+    const real x0 = xinHost(off);
+    const real dx = (xinHost(off+nx-1) - x0)/(nx-1);
+    bool isUniform = true;
+    for(int i = 0 ; i < nx ; i++) {
+      if(std::fabs(xinHost(off+i) - (x0 + i*dx)) > tolerance*dx) isUniform = false;
+    }
+
+    bool isLogUniform = (x0 > 0) && !isUniform;
+    real logx0 = 0;
+    real dlogx = 1;
+    if(isLogUniform) {
+      logx0 = std::log(x0);
+      dlogx = (std::log(xinHost(off+nx-1)) - logx0)/(nx-1);
+      for(int i = 0 ; i < nx ; i++) {
+        if(std::fabs(std::log(xinHost(off+i)) - (logx0 + i*dlogx)) > tolerance*dlogx) {
+          isLogUniform = false;
+        }
+      }
+    }
+
+    if(isUniform) {
+      axisType[n] = uniform;
+      axisStart[n] = x0;
+      axisInvDelta[n] = 1.0/dx;
+    } else if(isLogUniform) {
+      axisType[n] = logUniform;
+      axisStart[n] = logx0;
+      axisInvDelta[n] = 1.0/dlogx;
+    } else {
+      axisType[n] = arbitrary;
+    }
+  }
+}
+
 template <int kDim>
 LookupTable<kDim>::LookupTable(std::vector<std::string> filenames,
                                std::string dataSet,
                                bool errOOB) {
   idfx::pushRegion("LookupTable::LookupTable");
   this->errorIfOutOfBound = errOOB;
+  dataSet = idfx::inputPath(dataSet);
+  for(auto &filename : filenames) filename = idfx::inputPath(filename);
 
   std::vector<uint64_t> shape;
   bool fortran_order;
@@ -233,6 +378,8 @@ LookupTable<kDim>::LookupTable(std::vector<std::string> filenames,
     }
   }
 
+  InitAxes();
+
   // Copy to target
   Kokkos::deep_copy(this->xinDev ,xinHost);
   Kokkos::deep_copy(this->dimensionsDev, dimensionsHost);
@@ -248,6 +395,7 @@ template <int kDim>
 LookupTable<kDim>::LookupTable(std::string filename, char delimiter, bool errOOB) {
   idfx::pushRegion("LookupTable::LookupTable");
     this->errorIfOutOfBound = errOOB;
+  filename = idfx::inputPath(filename);
   if(kDim>2) {
     IDEFIX_ERROR("CSV files are only compatible with 1D and 2D tables");
   }
@@ -398,6 +546,8 @@ LookupTable<kDim>::LookupTable(std::string filename, char delimiter, bool errOOB
     MPI_Bcast(dataHost.data(),dataHost.extent(0), realMPI, 0, MPI_COMM_WORLD);
   #endif
 
+  InitAxes();
+
   // Copy to target
   Kokkos::deep_copy(this->xinDev ,xinHost);
   Kokkos::deep_copy(this->dimensionsDev, dimensionsHost);
@@ -504,6 +654,8 @@ LookupTable<kDim>::LookupTable(Kokkos::View<T, Args...> array,
     }
   }
 
+  InitAxes();
+
   // Copy to target
   Kokkos::deep_copy(this->xinDev ,xinHost);
   Kokkos::deep_copy(this->dimensionsDev, dimensionsHost);
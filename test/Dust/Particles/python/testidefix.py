@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Check the motion of tracers and dust grains in a uniform flow, and the momentum conservation
+of the drag feedback
+"""
+import sys
+import numpy as np
+import argparse
+import matplotlib.pyplot as plt
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-noplot",
+                    default=False,
+                    help="disable plotting",
+                    action="store_true")
+
+
+args, unknown=parser.parse_known_args()
+
+# load the dat file produced by the setup
+raw=np.loadtxt('../timevol.dat',skiprows=1)
+t=raw[:,0]
+pgx=raw[:,1]
+pgy=raw[:,2]
+pdx=raw[:,3]
+pdy=raw[:,4]
+errTracer=raw[:,5]
+feedback=raw[0,6]
+
+if not(args.noplot):
+  plt.figure()
+  plt.plot(t,pgx,label="p_gas")
+  plt.plot(t,pdx,label="p_dust")
+  plt.plot(t,pgx+pdx,'--',label="p_tot")
+  plt.legend()
+  plt.xlabel("t")
+  plt.ylabel("Momentum")
+  plt.show()
+
+if feedback:
+  # Total momentum should be conserved, and the dust should end up moving with the gas
+  # (the gas has a unit mass and the dust grains a total mass of 0.1)
+  error=max(abs(pgx[-1]+pdx[-1]-pgx[0]-pdx[0]), abs(pgy[-1]+pdy[-1]-pgy[0]-pdy[0]))
+  error=max(error, abs(pdx[-1]/0.1-pgx[-1]) / pgx[-1])
+  tolerance=1e-3
+else:
+  # Tracers move with the gas, and the drag on the grains is integrated exactly
+  # (stopping time 0.1), once the particles have been pushed
+  error=np.max(errTracer[1:])
+  error=max(error, np.max(np.abs(pdx/0.1 - pgx*(1-np.exp(-t/0.1)))))
+  error=max(error, np.max(np.abs(pdy/0.1 - pgy*(1-np.exp(-t/0.1)))))
+  tolerance=1e-5
+
+print("error=%e"%error)
+if(error<tolerance):
+  print("Success!")
+else:
+  print("Failure!")
+  sys.exit(1)
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include "idefix.hpp"
+#include "setup.hpp"
+
+#define  FILENAME    "timevol.dat"
+
+bool haveFeedback;
+
+// Analyse data to produce an output
+void Analysis(DataBlock & data) {
+  // Total mass and momentum of the gas, which is no longer uniform once the grains
+  // have deposited their momentum
+  DataBlockHost d(data);
+  d.SyncFromDevice();
+  real gas[3] = {0, 0, 0};
+  real pd[2] = {0, 0};
+  real errTracer = 0;
+  for(int k = d.beg[KDIR]; k < d.end[KDIR] ; k++) {
+    for(int j = d.beg[JDIR]; j < d.end[JDIR] ; j++) {
+      for(int i = d.beg[IDIR]; i < d.end[IDIR] ; i++) {
+        const real dm = d.Vc(RHO,k,j,i)*d.dV(k,j,i);
+        gas[0] += dm;
+        for(int n = 0 ; n < 2 ; n++) gas[1+n] += dm*d.Vc(VX1+n,k,j,i);
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, gas, 3, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+  const real pg[2] = {gas[1], gas[2]};
+
+  Particles &particles = *data.particles;
+  particles.SyncToHost();
+  for(int p = 0 ; p < particles.count ; p++) {
+    const int s = particles.speciesHost[p];
+    for(int n = 0 ; n < 2 ; n++) {
+      if(s == 0) {
+        // Only meaningful without feedback, where the gas stays uniform
+        errTracer = std::max(errTracer,
+                             std::fabs(particles.vHost[n][p] - pg[n]/gas[0]));
+      } else {
+        pd[n] += 0.001*particles.vHost[n][p];
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, pd, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &errTracer, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
+  #endif
+
+  if(idfx::prank == 0) {
+    std::ofstream f;
+    f.open(FILENAME,std::ios::app);
+    f.precision(10);
+    f << std::scientific << data.t << "\t" << pg[0] << "\t" << pg[1] << "\t" << pd[0] << "\t"
+      << pd[1] << "\t" << errTracer << "\t" << haveFeedback << std::endl;
+    f.close();
+  }
+}
+
+// Initialisation routine. Can be used to allocate
+// Arrays or variables which are used later on
+Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
+  output.EnrollAnalysis(&Analysis);
+  haveFeedback = input.Get<bool>("Particles","feedback",0);
+  if(!input.restartRequested) {
+      // Initialise the output file
+      std::ofstream f;
+      f.open(FILENAME,std::ios::trunc);
+      f << "t\t\t pgx \t\t pgy \t\t pdx \t\t pdy \t\t errTracer \t feedback" << std::endl;
+      f.close();
+    }
+}
+
+// This routine initialize the flow
+// Note that data is on the device.
+// One can therefore define locally
+// a datahost and sync it, if needed
+void Setup::InitFlow(DataBlock &data) {
+    // Create a host copy
+    DataBlockHost d(data);
+
+    for(int k = 0; k < d.np_tot[KDIR] ; k++) {
+        for(int j = 0; j < d.np_tot[JDIR] ; j++) {
+            for(int i = 0; i < d.np_tot[IDIR] ; i++) {
+                d.Vc(RHO,k,j,i) = 1.0;
+                d.Vc(VX1,k,j,i) = 1.0;
+                d.Vc(VX2,k,j,i) = 0.5;
+                d.Vc(PRS,k,j,i) = 1.0;
+            }
+        }
+    }
+
+    // Send it all, if needed
+    d.SyncToDevice();
+
+    // 100 tracers and 100 dust grains at rest, created by the first process
+    if(idfx::prank == 0) {
+      for(int n = 0 ; n < 100 ; n++) {
+        const real x = (n%10 + 0.25)/10.0;
+        const real y = (n/10 + 0.35)/10.0;
+        data.particles->Add(x, y, 0.0, 0.0, 0.0, 0.0, 0);
+        data.particles->Add(x, y, 0.0, 0.0, 0.0, 0.0, 1);
+      }
+    }
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+"""
+
+@author: glesur
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+def testMe(test):
+  test.configure()
+  test.compile()
+  inifiles=["idefix.ini","idefix-nofeedback.ini"]
+
+  # loop on all the ini files for this test
+  for ini in inifiles:
+    test.run(inputFile=ini)
+    test.standardTest()
+
+
+test=tst.idfxTest()
+
+if not test.all:
+  testMe(test)
+else:
+  test.noplot = True
+  testMe(test)
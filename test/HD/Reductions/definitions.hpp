@@ -0,0 +1,6 @@
+#define     COMPONENTS      2
+#define     DIMENSIONS      2
+
+#define     GEOMETRY        POLAR
+
+#define     ISOTHERMAL
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Check the in-situ reductions of the initial conditions against their analytical values
+"""
+import sys
+import numpy as np
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-noplot",
+                    default=False,
+                    help="disable plotting",
+                    action="store_true")
+
+
+args, unknown=parser.parse_known_args()
+
+# Read the first line of a reduction file, and the x1 coordinates of its header when present
+def readReduction(n):
+  x1 = None
+  with open('../reduction%d.csv'%n) as f:
+    for line in f:
+      if line.startswith('# x1,'):
+        x1 = np.array([float(v) for v in line[5:].split(',')])
+  data = np.loadtxt('../reduction%d.csv'%n, delimiter=',', comments='#', ndmin=2)
+  return data[0,1:], x1
+
+errors = {}
+
+# Azimuthal averages of RHO and VX1
+avg, R = readReduction(1)
+nr = len(R)
+errors["azimuthal"] = max(np.max(np.abs(avg[:nr]-(1+R))), np.max(np.abs(avg[nr:]-R)))
+
+# Shell average of RHO (the same as the azimuthal average in 2D)
+avg, R = readReduction(2)
+errors["shell"] = np.max(np.abs(avg-(1+R)))
+
+# VX2 is uniformly distributed over [0,1]
+pdf, _ = readReduction(3)
+errors["pdf"] = np.max(np.abs(pdf-1.0))
+
+# The logarithmic bins hold the whole domain
+pdf, _ = readReduction(4)
+errors["pdf log"] = np.abs(np.sum(pdf)*(np.log10(10.0)-np.log10(0.1))/len(pdf)-1.0)
+
+# Power of the azimuthal modes: the mean and the m=3 mode of amplitude 0.25
+power, _ = readReduction(5)
+R = 1.0+(np.arange(32)+0.5)/32
+expected = np.zeros(5)
+expected[0] = np.mean((1+R)**2)
+expected[3] = 0.25**2
+errors["spectrum"] = np.max(np.abs(power-expected))
+
+error = max(errors.values())
+for name in errors:
+  print("%s error=%e"%(name, errors[name]))
+# the reductions are written with 10 significant digits
+if(error<1e-8):
+  print("SUCCESS")
+  sys.exit(0)
+else:
+  print("Failed")
+  sys.exit(1)
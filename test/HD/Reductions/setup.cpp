@@ -0,0 +1,34 @@
+#include "idefix.hpp"
+#include "setup.hpp"
+
+// Initialisation routine. Can be used to allocate
+// Arrays or variables which are used later on
+Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
+}
+
+// This routine initialize the flow
+// Note that data is on the device.
+// One can therefore define locally
+// a datahost and sync it, if needed
+void Setup::InitFlow(DataBlock &data) {
+  // Create a host copy
+  DataBlockHost d(data);
+
+  for(int k = 0; k < d.np_tot[KDIR] ; k++) {
+    for(int j = 0; j < d.np_tot[JDIR] ; j++) {
+      for(int i = 0; i < d.np_tot[IDIR] ; i++) {
+        const real R = d.x[IDIR](i);
+        const real phi = d.x[JDIR](j);
+        // azimuthal average 1+R, with a single m=3 mode
+        d.Vc(RHO,k,j,i) = 1.0 + R + 0.5*cos(3.0*phi);
+        // azimuthal average R
+        d.Vc(VX1,k,j,i) = R;
+        // uniformly distributed in [0,1]
+        d.Vc(VX2,k,j,i) = phi/(2.0*M_PI);
+      }
+    }
+  }
+
+  // Send it all, if needed
+  d.SyncToDevice();
+}
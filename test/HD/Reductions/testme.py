@@ -0,0 +1,38 @@
+#!/usr/bin/env python3
+
+"""
+
+@author: glesur
+"""
+import glob
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+def testMe(test):
+  test.configure()
+  test.compile()
+  # the reductions are appended to existing files
+  for f in glob.glob("reduction*.csv"):
+    os.remove(f)
+  test.run()
+  test.standardTest()
+
+
+test=tst.idfxTest()
+if not test.dec:
+  test.dec=['2','2']
+
+if not test.all:
+  testMe(test)
+else:
+  test.noplot = True
+  test.single=False
+  test.reconstruction=2
+  test.mpi=False
+  testMe(test)
+  # the reductions sum the contributions of each process
+  test.mpi=True
+  testMe(test)
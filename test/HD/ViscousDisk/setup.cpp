@@ -9,6 +9,11 @@ real gammaGlob;
 real densityFloorGlob;
 real alphaGlob;
 
+// Check of the refresh policy of the user-defined viscosity ([Hydro]:viscosityRefresh)
+int viscosityCalls = 0;
+int refreshPeriod = 0;          // period N of the "cycle N" policy
+int64_t invalidateCycle = -1;   // cycle at which the "manual" policy is invalidated
+
 
 void MySoundSpeed(DataBlock &data, const real t, IdefixArray3D<real> &cs) {
   IdefixArray1D<real> r=data.x[IDIR];
@@ -22,6 +27,7 @@ void MySoundSpeed(DataBlock &data, const real t, IdefixArray3D<real> &cs) {
 }
 
 void MyViscosity(DataBlock &data, const real t, IdefixArray3D<real> &eta1, IdefixArray3D<real> &eta2) {
+  viscosityCalls++;
   IdefixArray4D<real> Vc=data.hydro->Vc;
   IdefixArray1D<real> r=data.x[IDIR];
   IdefixArray1D<real> th=data.x[JDIR];
@@ -37,6 +43,28 @@ void MyViscosity(DataBlock &data, const real t, IdefixArray3D<real> &eta1, Idefi
 
 }
 
+void InvalidateViscosity(DataBlock &data, const real t, const real dt) {
+  if(data.cycleCount == invalidateCycle) data.hydro->InvalidateDiffusivities();
+}
+
+// Number of calls to the viscosity function expected at the end of the current cycle
+void CheckViscosityCalls(DataBlock &data, const real t, const real dt) {
+  int64_t expected;
+  if(refreshPeriod > 0) {
+    // once at the first stage of every refreshPeriod cycles
+    expected = data.cycleCount/refreshPeriod + 1;
+  } else {
+    // once at the first stage, once again after the invalidation
+    expected = (data.cycleCount >= invalidateCycle) ? 2 : 1;
+  }
+  if(viscosityCalls != expected) {
+    std::stringstream msg;
+    msg << "The viscosity function was called " << viscosityCalls << " times after cycle "
+        << data.cycleCount << " instead of " << expected;
+    IDEFIX_ERROR(msg);
+  }
+}
+
 void FargoVelocity(DataBlock &data, IdefixArray2D<real> &Vphi) {
   IdefixArray1D<real> x1 = data.x[IDIR];
 
@@ -115,6 +143,16 @@ Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
   data.hydro->EnrollUserDefBoundary(&UserdefBoundary);
   data.hydro->EnrollIsoSoundSpeed(&MySoundSpeed);
   data.hydro->viscosity->EnrollViscousDiffusivity(&MyViscosity);
+  if(input.CheckEntry("Hydro","viscosityRefresh") >= 0) {
+    std::string policy = input.Get<std::string>("Hydro","viscosityRefresh",0);
+    if(policy.compare("cycle") == 0) {
+      refreshPeriod = input.GetOrSet<int>("Hydro","viscosityRefresh",1,1);
+    } else if(policy.compare("manual") == 0) {
+      invalidateCycle = input.Get<int>("Setup","invalidateCycle",0);
+      data.EnrollUserStepFirst(&InvalidateViscosity);
+    }
+    data.EnrollUserStepLast(&CheckViscosityCalls);
+  }
   if(data.haveFargo)
     data.fargo->EnrollVelocity(&FargoVelocity);
   epsilonGlob = input.Get<real>("Setup","epsilon",0);
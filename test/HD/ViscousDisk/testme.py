@@ -23,6 +23,10 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # The setup checks at the end of each cycle how many times the viscosity function was called
+  for ini in ["idefix-refresh-cycle.ini","idefix-refresh-manual.ini"]:
+    test.run(inputFile=ini)
+
 
 test=tst.idfxTest()
 if not test.dec:
@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+
+"""
+
+@author: glesur
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+import shutil
+import numpy as np
+
+import pytools.idfx_test as tst
+
+def makeTable(gamma=1.4):
+  # Ideal gas P=(gamma-1) rho eps on log-spaced axes. The pressure is increased at the
+  # extreme densities, far from the states of the flow, so that the rows of the table cover
+  # different ranges of P/rho, which are clamped when the table is inverted.
+  rho=np.logspace(-3,2,41)
+  eps=np.logspace(-2,3,61)
+  P=(gamma-1)*np.outer(rho,eps)
+  P[rho<0.02,:]*=1.5
+  P[rho>20,:]*=1.5
+  np.save("rho.npy",rho)
+  np.save("eps.npy",eps)
+  np.save("pressure.npy",P)
+
+def testMe(test):
+  test.configure()
+  test.compile()
+  # Roe uses the face Gamma_1 (GetFaceGamma), HLLC the cell ones (GetCellGamma)
+  inifiles={"roe":"idefix.ini","hllc":"idefix-hllc.ini"}
+
+  for solver,ini in inifiles.items():
+    test.run(inputFile=ini)
+    test.standardTest()
+    shutil.copy("dump.0001.dmp","dump.%s.dmp"%solver)
+
+  # The same runs as the members of an ensemble, each in its own directory, which
+  # read the tables of the ensemble directory
+  for solver in inifiles:
+    shutil.rmtree(solver, ignore_errors=True)
+  test.run(inputFile="idefix-ensemble.ini")
+  for solver in inifiles:
+    test.compareDump("%s/dump.0001.dmp"%solver,"dump.%s.dmp"%solver)
+
+
+makeTable()
+test=tst.idfxTest()
+
+if not test.all:
+  testMe(test)
+else:
+  test.noplot = True
+  for rec in range(2,4):
+    test.single=False
+    test.reconstruction=rec
+    test.mpi=False
+    testMe(test)
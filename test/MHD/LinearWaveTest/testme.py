@@ -21,7 +21,9 @@ def testMe(test):
     if test.init and not test.mpi:
       test.makeReference(filename="dump.0001.dmp")
     test.standardTest()
-    test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
+    # fifth order schemes are only checked against the exact solution
+    if test.reconstruction <= 4:
+      test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
 
 test=tst.idfxTest()
@@ -49,3 +51,9 @@ else:
 
   test.reconstruction=4
   testMe(test)
+
+  test.reconstruction=5
+  testMe(test)
+
+  test.reconstruction=6
+  testMe(test)
@@ -15,7 +15,21 @@ generators on different architectures.
 // Initialisation routine. Can be used to allocate
 // Arrays or variables which are used later on
 Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
-
+  // A field which never changes, so that the delta dumps have a field to skip. It is only set
+  // for new runs: on restarts, it must be restored from the dumps.
+  if(input.GetOrSet<bool>("Setup","frozenField",0,false)) {
+    IdefixArray3D<real> frozen("FrozenField",
+                               data.np_tot[KDIR], data.np_tot[JDIR], data.np_tot[IDIR]);
+    if(!input.restartRequested) {
+      IdefixArray1D<real> x = data.x[IDIR];
+      IdefixArray1D<real> y = data.x[JDIR];
+      idefix_for("InitFrozenField",0,data.np_tot[KDIR],0,data.np_tot[JDIR],0,data.np_tot[IDIR],
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          frozen(k,j,i) = 1.0 + 0.5*sin(2.0*M_PI*x(i))*cos(2.0*M_PI*y(j));
+        });
+    }
+    data.dump->RegisterVariable(frozen, "FrozenField");
+  }
 }
 
 // This routine initialize the flow
@@ -4,7 +4,9 @@
 
 @author: glesur
 """
+import glob
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -32,6 +34,58 @@ def testMe(test):
 
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  testDumps(test)
+
+# Restarts should reproduce an uninterrupted run exactly, whatever the way the dumps are written,
+# and so should a run with several DataBlocks per process
+def testDumps(test):
+  # the DataBlocks split a direction which is not decomposed between processes
+  dec=test.dec
+  if test.mpi:
+    test.dec=['2','1']
+
+  test.run(inputFile="idefix-dumps.ini")
+  shutil.copy("dump.0003.dmp","dump.ref3.dmp")
+  shutil.copy("dump.0005.dmp","dump.ref5.dmp")
+
+  # Two DataBlocks per process, only gathered when the dumps are written
+  test.run(inputFile="idefix-blocks.ini")
+  test.compareDump("dump.0003.dmp","dump.ref3.dmp")
+  test.compareDump("dump.0005.dmp","dump.ref5.dmp")
+
+  # Delta dumps written straight in the dump files. The frozen field of the setup is skipped by
+  # the delta dumps, and only restored from the full dump 3 on restarts
+  test.run(inputFile="idefix-delta.ini")
+  test.compareDump("dump.0003.dmp","dump.ref3.dmp")
+  # restart from the delta dump 4, based on the full dump 3
+  test.run(inputFile="idefix-delta.ini", restart=4)
+  test.compareDump("dump.0005.dmp","dump.ref5.dmp")
+
+  # Single precision differences (ignored with a warning in single precision): the restart
+  # is only exact up to the rounding of the differences of the cell-centered fields
+  if not test.single:
+    test.run(inputFile="idefix-delta-single.ini")
+    test.compareDump("dump.0003.dmp","dump.ref3.dmp")
+    test.run(inputFile="idefix-delta-single.ini", restart=4)
+    test.compareDump("dump.0005.dmp","dump.ref5.dmp",tolerance=1e-7)
+
+  # Node-local dumps, drained in the dump files in the background
+  shutil.rmtree("local", ignore_errors=True)
+  test.run(inputFile="idefix-local.ini")
+  test.compareDump("dump.0003.dmp","dump.ref3.dmp")
+  # restart from the local copies of the delta dump 4, based on the full dump 3
+  test.run(inputFile="idefix-local.ini", restart=4)
+  test.compareDump("dump.0005.dmp","dump.ref5.dmp")
+
+  # Without the local copies of the base dump, the restart falls back on the dump files
+  test.run(inputFile="idefix-local.ini")
+  for f in glob.glob("local/dump.0003.*.local"):
+    os.remove(f)
+  test.run(inputFile="idefix-local.ini", restart=4)
+  test.compareDump("dump.0005.dmp","dump.ref5.dmp")
+
+  test.dec=dec
+
 
 test=tst.idfxTest()
 if not test.dec:
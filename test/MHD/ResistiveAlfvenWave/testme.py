@@ -25,6 +25,10 @@ def testMe(test):
       mytol=1e-10
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # Implicit resistivity: the damping rate of the wave is checked against the dispersion relation
+  test.run(inputFile="idefix-implicit.ini")
+  test.standardTest()
+
 
 test=tst.idfxTest()
 
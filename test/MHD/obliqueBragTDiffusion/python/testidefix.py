@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+import sys
+import numpy as np
+import argparse
+import matplotlib.pyplot as plt
+
+parser = argparse.ArgumentParser()
+parser.add_argument("-noplot",
+                    default=False,
+                    help="disable plotting",
+                    action="store_true")
+
+
+args, unknown=parser.parse_known_args()
+
+
+# values from the setup to compute the decay rate
+kappa=0.01
+gamma=1.4
+rho0=1.0
+
+#diffusion coefficient
+D=kappa*(gamma-1)/rho0
+
+# wave vector (0, 2pi, 2pi) projected on the field direction (0,1,1)/sqrt(2)
+kpar=2.0*np.sqrt(2.0)*np.pi
+
+# decay rate of the temperature perturbation
+gamma=-kpar**2*D
+
+raw=np.loadtxt('../analysis.dat',skiprows=1)
+t=raw[:,0]
+Tidfx=raw[:,1]
+
+Tth=Tidfx[0]*np.exp(gamma*t)
+error=np.max(np.abs(Tidfx/Tth-1.0))
+
+if(not args.noplot):
+
+    plt.close('all')
+    plt.figure()
+    plt.plot(t,Tidfx/Tth-1.0)
+    plt.ioff()
+    plt.show()
+
+print("Error=%e"%error)
+if(error<1e-2):
+    print("SUCCESS")
+    sys.exit(0)
+else:
+    print("Failed")
+    sys.exit(1)
@@ -0,0 +1,96 @@
+#include "idefix.hpp"
+#include "setup.hpp"
+
+// Anisotropic diffusion of a temperature mode T = 1 + a sin(2 pi (y+z)) along a uniform field
+// B // (0,1,1), so that the heat flux through the y and z faces involves the temperature
+// gradients in both directions.
+
+#define FILENAME  "analysis.dat"
+real amplitude;
+
+// Analyse data to get the amplitude of the temperature mode
+void Analysis(DataBlock & data) {
+  DataBlockHost d(data);
+  d.SyncFromDevice();
+  real sum[2] = {0, 0};
+  for(int k = d.beg[KDIR]; k < d.end[KDIR] ; k++) {
+    for(int j = d.beg[JDIR]; j < d.end[JDIR] ; j++) {
+      for(int i = d.beg[IDIR]; i < d.end[IDIR] ; i++) {
+        real T = d.Vc(PRS,k,j,i) / d.Vc(RHO,k,j,i);
+        sum[0] += (T-1.0) * sin(2.0*M_PI*(d.x[JDIR](j)+d.x[KDIR](k)));
+        sum[1] += 1.0;
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_Allreduce(MPI_IN_PLACE, sum, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+  real Tmode = 2*sum[0]/sum[1];
+
+  if(idfx::prank == 0) {
+    std::ofstream f;
+    f.open(FILENAME,std::ios::app);
+    f.precision(10);
+    f << std::scientific << data.t << "\t" << Tmode << std::endl;
+    f.close();
+  }
+}
+
+void InternalBoundary(Fluid<DefaultPhysics> * hydro, const real t) {
+  IdefixArray4D<real> Vc = hydro->Vc;
+  idefix_for("InternalBoundary",0,hydro->data->np_tot[KDIR],
+                                0,hydro->data->np_tot[JDIR],
+                                0,hydro->data->np_tot[IDIR],
+              KOKKOS_LAMBDA (int k, int j, int i) {
+                // Cancel any motion that could be happening
+                Vc(VX1,k,j,i) = 0.0;
+                Vc(VX2,k,j,i) = 0.0;
+                Vc(VX3,k,j,i) = 0.0;
+              });
+}
+
+// Initialisation routine. Can be used to allocate
+// Arrays or variables which are used later on
+Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
+  output.EnrollAnalysis(&Analysis);
+  data.hydro->EnrollInternalBoundary(&InternalBoundary);
+
+  amplitude = input.Get<real>("Setup","amplitude",0);
+  // Initialise the output file
+  if(idfx::prank == 0) {
+    std::ofstream f;
+    f.open(FILENAME,std::ios::trunc);
+    f << "t\t\t T" << std::endl;
+    f.close();
+  }
+}
+
+// This routine initialize the flow
+// Note that data is on the device.
+// One can therefore define locally
+// a datahost and sync it, if needed
+void Setup::InitFlow(DataBlock &data) {
+  // Create a host copy
+  DataBlockHost d(data);
+  real B0 = 0.1;
+
+  for(int k = 0; k < d.np_tot[KDIR] ; k++) {
+    for(int j = 0; j < d.np_tot[JDIR] ; j++) {
+      for(int i = 0; i < d.np_tot[IDIR] ; i++) {
+        real T = 1.0 + amplitude*sin(2.0*M_PI*(d.x[JDIR](j)+d.x[KDIR](k)));
+        d.Vc(RHO,k,j,i) = 1.0/T;
+        d.Vc(VX1,k,j,i) = ZERO_F;
+        d.Vc(VX2,k,j,i) = ZERO_F;
+        d.Vc(VX3,k,j,i) = ZERO_F;
+        d.Vc(PRS,k,j,i) = 1.0;
+
+        d.Vs(BX1s,k,j,i) = ZERO_F;
+        d.Vs(BX2s,k,j,i) = B0/sqrt(2.0);
+        d.Vs(BX3s,k,j,i) = B0/sqrt(2.0);
+      }
+    }
+  }
+
+  // Send it all, if needed
+  d.SyncToDevice();
+}
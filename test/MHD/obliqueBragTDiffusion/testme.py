@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+"""
+
+@author: glesur
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import pytools.idfx_test as tst
+
+def testMe(test):
+  test.configure()
+  test.compile()
+  # The limited version checks the limited transverse gradients on the faces
+  inifiles=["idefix.ini","idefix-mc.ini"]
+
+  for ini in inifiles:
+    test.run(inputFile=ini)
+    test.standardTest()
+
+
+test=tst.idfxTest()
+
+if not test.all:
+  testMe(test)
+else:
+  test.noplot = True
+  test.single=False
+  test.reconstruction=2
+  testMe(test)
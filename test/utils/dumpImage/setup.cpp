@@ -111,6 +111,26 @@ void Analysis(DataBlock& data) {
     }
   }
 
+  // Check that a partial image only loads the requested field
+  #ifdef WITH_MPI
+  DumpImage partialImage(filename,&data,true,{"Vc-RHO"});
+  #else
+  DumpImage partialImage(filename,&data,false,{"Vc-RHO"});
+  #endif
+  if(partialImage.arrays.size() != 1 || partialImage.arrays.count("Vc-RHO") != 1) {
+    errornum++;
+    idfx::cout << " Partial DumpImage loaded " << partialImage.arrays.size() << " arrays" << std::endl;
+  } else {
+    IdefixHostArray3D<real> arr = partialImage.arrays["Vc-RHO"];
+    IdefixHostArray3D<real> ref = image.arrays["Vc-RHO"];
+    for(int k = 0; k < arr.extent(0) ; k++) {
+      for(int j = 0; j < arr.extent(1) ; j++) {
+        for(int i = 0; i < arr.extent(2) ; i++) {
+          if(arr(k,j,i) != ref(k,j,i)) errornum++;
+        }
+      }
+    }
+  }
 
   idfx::cout << "done with " << errornum << " errors " << std::endl;
   if(errornum>0) {
@@ -152,6 +152,64 @@ int main( int argc, char* argv[] )
       exit(1);
     }
     idfx::cout << "Success" << std::endl;
+    idfx::cout << "--------------------------------------" << std::endl;
+    idfx::cout << "Testing log-uniform and arbitrary axes on device." << std::endl;
+    // 2D table of f(x,y) = x^3 - 2 y^2 + x y, on a log-uniform x axis and a non uniform y axis
+    const int nx = 40;
+    const int ny = 30;
+    IdefixHostArray1D<real> xAxis("xAxis", nx);
+    IdefixHostArray1D<real> yAxis("yAxis", ny);
+    IdefixHostArray2D<real> table("table", ny, nx);
+    for(int i = 0 ; i < nx ; i++) xAxis(i) = 1e-2*std::pow(1e4, i/(nx-1.0));
+    for(int j = 0 ; j < ny ; j++) yAxis(j) = -1.0 + 2.0*(j/(ny-1.0))*(j/(ny-1.0));
+    for(int j = 0 ; j < ny ; j++) {
+      for(int i = 0 ; i < nx ; i++) {
+        const real x = xAxis(i);
+        const real y = yAxis(j);
+        table(j,i) = x*x*x - 2*y*y + x*y;
+      }
+    }
+    LookupTable<2> logTable(table, {xAxis, yAxis});
+    if(logTable.axisType[0] != LookupTable<2>::logUniform
+        || logTable.axisType[1] != LookupTable<2>::arbitrary) {
+      idfx::cerr << "ERROR!! Wrong axis type detection" << std::endl;
+      exit(1);
+    }
+
+    // Linear interpolation on a grid node should be exact
+    const real xNode = xAxis(17);
+    const real yNode = yAxis(11);
+    const real refNode = table(11,17);
+    // Cubic interpolation is exact for cubic polynomials
+    const real xCub = 3.7;
+    const real yCub = 0.23;
+    const real refCub = xCub*xCub*xCub - 2*yCub*yCub + xCub*yCub;
+
+    IdefixArray1D<real> arr2 = IdefixArray1D<real>("Test2",2);
+    IdefixArray1D<real>::HostMirror arr2Host = Kokkos::create_mirror_view(arr2);
+    LookupTable<2> cubicTable = logTable;
+    cubicTable.interpolation = LookupTable<2>::cubic;
+    idefix_for("loop",0, 1, KOKKOS_LAMBDA (int i) {
+      real x[2];
+      x[0] = xNode;
+      x[1] = yNode;
+      arr2(0) = logTable.Get(x);
+      x[0] = xCub;
+      x[1] = yCub;
+      arr2(1) = cubicTable.Get(x);
+    });
+    Kokkos::deep_copy(arr2Host , arr2);
+
+    idfx::cout << "result=" << arr2Host(0) << " and " << arr2Host(1) << std::endl;
+    if(std::fabs(arr2Host(0) - refNode)>1e-10*std::fabs(refNode)
+        || std::fabs(arr2Host(1) - refCub)>1e-10*std::fabs(refCub)) {
+      idfx::cerr << std::scientific;
+      idfx::cerr << "ERROR!!" << std::endl;
+      idfx::cerr << arr2Host(0)-refNode << " " << arr2Host(1)-refCub;
+      exit(1);
+    }
+    idfx::cout << "Success" << std::endl;
+
     idfx::cout << "--------------------------------------" << std::endl;
     idfx::cout << "Done." << std::endl;
 